@@ -234,6 +234,25 @@ Any platforms not detected by the above logic are now now explicitly zeroed out.
 #   define SLANG_BREAKPOINT(id) (*((int*)0) = int(id));
 #endif
 
+// Placed before a loop whose iterations are independent, so the compiler can run N iterations
+// at once in SIMD lanes. Used for the loop over the threads of a compute group.
+// Define SLANG_PRELUDE_OPENMP_SIMD if compiling with -fopenmp-simd (or similar).
+#ifndef SLANG_PRELUDE_SIMD_LOOP
+#   if defined(_OPENMP) || defined(SLANG_PRELUDE_OPENMP_SIMD)
+#       define SLANG_PRELUDE_PRAGMA(x) _Pragma(#x)
+#       define SLANG_PRELUDE_SIMD_LOOP(N) SLANG_PRELUDE_PRAGMA(omp simd simdlen(N))
+#   elif SLANG_CLANG
+#       define SLANG_PRELUDE_PRAGMA(x) _Pragma(#x)
+#       define SLANG_PRELUDE_SIMD_LOOP(N) SLANG_PRELUDE_PRAGMA(clang loop vectorize(enable) vectorize_width(N))
+#   elif SLANG_GCC
+#       define SLANG_PRELUDE_SIMD_LOOP(N) _Pragma("GCC ivdep")
+#   elif SLANG_VC
+#       define SLANG_PRELUDE_SIMD_LOOP(N) __pragma(loop(ivdep))
+#   else
+#       define SLANG_PRELUDE_SIMD_LOOP(N)
+#   endif
+#endif
+
 // If slang.h has been included we don't need any of these definitions
 #ifndef SLANG_H
 
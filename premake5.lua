@@ -135,7 +135,7 @@ newoption {
 
 newoption {
     trigger     = "enable-profile",
-    description = "(Optional) If true will enable slang-profile tool - suitable for gprof usage on linux",
+    description = "(Optional) If true will enable the slang-profile compiler benchmark tool - also suitable for gprof usage on linux",
     value       = "bool",
     default     = "false",
     allowed     = { { "true", "True"}, { "false", "False" } }
@@ -212,6 +212,14 @@ newoption {
     allowed     = { { "true", "True"}, { "false", "False" } }
 }
 
+newoption {
+    trigger     = "enable-concurrent-compile",
+    description = "(Optional) If true the compiler can check and generate code on multiple threads (-check-threads, -codegen-threads). Makes reference counting slower.",
+    value       = "bool",
+    default     = "false",
+    allowed     = { { "true", "True"}, { "false", "False" } }
+}
+
 buildLocation = _OPTIONS["build-location"]
 executeBinary = (_OPTIONS["execute-binary"] == "true")
 buildGlslang = (_OPTIONS["build-glslang"] == "true")
@@ -227,6 +235,7 @@ deployLLVM = (_OPTIONS["deploy-slang-llvm"] == "true")
 deployGLSLang = (_OPTIONS["deploy-slang-glslang"] == "true")
 fullDebugValidation = (_OPTIONS["full-debug-validation"] == "true")
 enableAsan = (_OPTIONS["enable-asan"] == "true")
+enableConcurrentCompile = (_OPTIONS["enable-concurrent-compile"] == "true")
 
 -- If stdlib embedding is enabled, disable stdlib source embedding by default
 disableStdlibSource = enableEmbedStdLib
@@ -597,6 +606,15 @@ function baseSlangProject(name, sourceDir)
         end
     end
 
+    --
+    -- Enable using multiple threads in the compiler if requested. `RefObject` (in a header)
+    -- depends on it, so it is set for every project.
+    --
+
+    if enableConcurrentCompile then
+        defines { "SLANG_ENABLE_CONCURRENT_COMPILE=1" }
+    end
+
 end
 
 
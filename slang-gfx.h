@@ -56,7 +56,7 @@ const uint64_t kTimeoutInfinite = 0xFFFFFFFFFFFFFFFF;
 
 enum class StructType
 {
-    D3D12DeviceExtendedDesc, D3D12ExperimentalFeaturesDesc
+    D3D12DeviceExtendedDesc, D3D12ExperimentalFeaturesDesc, CPUDeviceExtendedDesc
 };
 
 // TODO: Rename to Stage
@@ -2202,6 +2202,7 @@ public:
         SlangOptimizationLevel optimizationLevel = SLANG_OPTIMIZATION_LEVEL_DEFAULT;
         SlangTargetFlags targetFlags = 0;
         SlangLineDirectiveMode lineDirectiveMode = SLANG_LINE_DIRECTIVE_MODE_DEFAULT;
+        const char* moduleCachePath = nullptr; // (optional) Directory to cache checked Slang modules in, so that unchanged modules are loaded without running the front end.
     };
 
     struct ShaderCacheDesc
@@ -2683,4 +2684,12 @@ struct D3D12DeviceExtendedDesc
     uint32_t highestShaderModel = 0;
 };
 
+struct CPUDeviceExtendedDesc
+{
+    StructType structType = StructType::CPUDeviceExtendedDesc;
+    // The number of threads used to run the groups of a compute dispatch. 0 uses as many threads
+    // as there are hardware threads. If this desc is not provided, dispatches run on a single thread.
+    GfxCount computeThreadCount = 0;
+};
+
 }
@@ -664,6 +664,23 @@ extern "C"
 
         /* When set, will generate SPIRV directly instead of going through glslang. */
         SLANG_TARGET_FLAG_GENERATE_SPIRV_DIRECTLY = 1 << 10,
+
+        /* When set, and code is generated for each entry point separately, link the
+           IR for all of the entry points of a program once, and derive the IR for each
+           entry point from it, rather than linking each entry point from scratch.
+        */
+        SLANG_TARGET_FLAG_LINK_ONCE = 1 << 11,
+
+        /* When set, and SPIR-V is generated directly, run the SPIR-V optimizer (from the glslang
+           library) on the output, with the passes for the optimization level. If the optimizer
+           isn't available the SPIR-V is output unoptimized.
+        */
+        SLANG_TARGET_FLAG_OPTIMIZE_DIRECT_SPIRV = 1 << 12,
+
+        /* When set, check generated SPIR-V with the SPIR-V validator (from the glslang library).
+           Validation errors fail the compile.
+        */
+        SLANG_TARGET_FLAG_VALIDATE_SPIRV = 1 << 13,
     };
 
     /*!
@@ -780,6 +797,14 @@ extern "C"
         SLANG_OPTIMIZATION_LEVEL_MAXIMAL,   /**< Include optimizations that may take a very long time, or may involve severe space-vs-speed tradeoffs */
     };
 
+    /* The format used when retrieving a performance trace. */
+    typedef SlangUInt32 SlangPerfTraceFormatIntegral;
+    enum SlangPerfTraceFormat : SlangPerfTraceFormatIntegral
+    {
+        SLANG_PERF_TRACE_FORMAT_CHROME_JSON,    ///< Chrome 'Trace Event Format' JSON, viewable in chrome://tracing
+        SLANG_PERF_TRACE_FORMAT_SUMMARY,        ///< Human readable text summary with times aggregated by phase/pass
+    };
+
     /** A result code for a Slang API operation.
 
     This type is generally compatible with the Windows API `HRESULT` type. In particular, negative values indicate
@@ -1493,6 +1518,12 @@ extern "C"
         int targetIndex,
         bool forceScalarLayout);
 
+    /*! @see slang::ICompileRequest::setTargetCPUSIMDLaneCount */
+    SLANG_API void spSetTargetCPUSIMDLaneCount(
+        SlangCompileRequest*    request,
+        int targetIndex,
+        int laneCount);
+
     /*! @see slang::ICompileRequest::setCodeGenTarget */
     SLANG_API void spSetCodeGenTarget(
         SlangCompileRequest*    request,
@@ -1550,6 +1581,32 @@ extern "C"
         SlangCompileRequest*    request,
         SlangDebugInfoFormat        format);
 
+    /*! @see slang::ICompileRequest::setPerfTraceEnabled */
+    SLANG_API void spSetPerfTraceEnabled(
+        SlangCompileRequest*    request,
+        bool                    enable);
+
+    /*! @see slang::ICompileRequest::getPerfTrace */
+    SLANG_API SlangResult spGetPerfTrace(
+        SlangCompileRequest*    request,
+        SlangPerfTraceFormat    format,
+        ISlangBlob**            outBlob);
+
+    /*! @see slang::ICompileRequest::setCodeGenThreadCount */
+    SLANG_API void spSetCodeGenThreadCount(
+        SlangCompileRequest*    request,
+        int                     threadCount);
+
+    /*! @see slang::ICompileRequest::setModuleCachePath */
+    SLANG_API void spSetModuleCachePath(
+        SlangCompileRequest*    request,
+        const char*             path);
+
+    /*! @see slang::ICompileRequest::setDownstreamCachePath */
+    SLANG_API void spSetDownstreamCachePath(
+        SlangCompileRequest*    request,
+        const char*             path);
+
     /*! @see slang::ICompileRequest::setOptimizationLevel */
     SLANG_API void spSetOptimizationLevel(
         SlangCompileRequest*    request,
@@ -4067,6 +4124,69 @@ namespace slang
 
             /** Set the debug format to be used for debugging information */
         virtual SLANG_NO_THROW void SLANG_MCALL setDebugInfoFormat(SlangDebugInfoFormat debugFormat) = 0;
+
+            /** Enable or disable recording of a performance trace.
+
+            When enabled, the wall time of parsing, semantic checking, lowering to IR and each
+            IR pass is recorded (along with IR instruction counts and memory use) during `compile`.
+            */
+        virtual SLANG_NO_THROW void SLANG_MCALL setPerfTraceEnabled(bool enable) = 0;
+
+            /** Get the performance trace recorded by the request.
+
+            @param format           The format to produce the trace in
+            @param outBlob          The blob holding the trace
+            @returns                SLANG_E_NOT_AVAILABLE if tracing was not enabled
+            */
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL getPerfTrace(
+            SlangPerfTraceFormat    format,
+            ISlangBlob**            outBlob) = 0;
+
+            /** Set the number of threads used to generate code for the entry points of a target.
+
+            When more than one thread is used, code for different entry points is generated
+            concurrently. Output and diagnostics are identical to generating serially, and
+            diagnostics are reported in entry point order. Whole program compilation and
+            pass-through compilation always generate serially.
+
+            @param threadCount      The number of threads. 1 (the default) generates serially,
+                                    0 uses as many threads as there are hardware threads.
+            */
+        virtual SLANG_NO_THROW void SLANG_MCALL setCodeGenThreadCount(int threadCount) = 0;
+
+            /** Set the directory of a persistent cache of checked modules.
+
+            When set, modules loaded through `import` are read from the cache if their source, the
+            files they depend on and the options that affect them are unchanged. Otherwise they are
+            compiled as usual and written into the cache. The cache can be shared between processes.
+
+            @param path             The cache directory. nullptr or an empty path disables the cache.
+            */
+        virtual SLANG_NO_THROW void SLANG_MCALL setModuleCachePath(const char* path) = 0;
+
+            /** Set the number of threads of a compute thread group that CPU targets ask to be run at once in SIMD lanes.
+
+            When set, the threads of a group are run by a single loop (with the entry point inlined into it)
+            that the downstream C++ compiler is asked to vectorize with the given width. Slang doesn't
+            generate vector code itself, so whether the loop is vectorized depends on the downstream
+            compiler. Only applies to CPU targets.
+
+            @param targetIndex      The target
+            @param laneCount        The number of lanes, 0 (the default) or a power of 2 up to 64.
+                                    0 runs the threads of a group with scalar loops.
+            */
+        virtual SLANG_NO_THROW void SLANG_MCALL setTargetCPUSIMDLaneCount(int targetIndex, int laneCount) = 0;
+
+            /** Set the directory of a persistent cache of downstream compiler products.
+
+            When set, the products of downstream compilers (such as host callable shared libraries or
+            PTX) are read from the cache if the source passed to the compiler, the files it includes,
+            the compiler version and the options are unchanged. Otherwise the downstream compiler is
+            invoked and the product written into the cache. The cache can be shared between processes.
+
+            @param path             The cache directory. nullptr or an empty path disables the cache.
+            */
+        virtual SLANG_NO_THROW void SLANG_MCALL setDownstreamCachePath(const char* path) = 0;
     };
 
     #define SLANG_UUID_ICompileRequest ICompileRequest::getTypeGuid()
@@ -4117,6 +4237,11 @@ namespace slang
         You have been warned.
         */
         kSessionFlag_FalcorCustomSharedKeywordSemantics = 1 << 0,
+
+        /** Record a performance trace of all of the compilation work performed through the session.
+        The trace can be retrieved with `ISession::getPerfTrace`.
+        */
+        kSessionFlag_EnablePerfTrace = 1 << 1,
     };
 
     struct PreprocessorMacroDesc
@@ -4153,6 +4278,15 @@ namespace slang
         SlangInt                        preprocessorMacroCount = 0;
 
         ISlangFileSystem* fileSystem = nullptr;
+
+            /** (optional) Directory to cache checked modules in.
+
+            A module that is loaded with the same source, options and dependencies as when it
+            was cached is read from the cache, instead of being parsed, checked and lowered.
+            Each entry holds the files the module depends on along with a digest of their
+            contents, so an entry can be confirmed by hashing those files.
+            */
+        char const* moduleCachePath = nullptr;
     };
 
     enum class ContainerType
@@ -4327,6 +4461,17 @@ namespace slang
             ITypeConformance** outConformance,
             SlangInt conformanceIdOverride,
             ISlangBlob** outDiagnostics) = 0;
+
+            /** Get the performance trace recorded for the session.
+            Tracing is enabled by creating the session with `kSessionFlag_EnablePerfTrace`.
+
+            @param format           The format to produce the trace in
+            @param outBlob          The blob holding the trace
+            @returns                SLANG_E_NOT_AVAILABLE if tracing was not enabled
+            */
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL getPerfTrace(
+            SlangPerfTraceFormat    format,
+            ISlangBlob**            outBlob) = 0;
     };
 
     #define SLANG_UUID_ISession ISession::getTypeGuid()
@@ -501,6 +501,45 @@ void DiagnosticSink::init(SourceManager* sourceManager, SourceLocationLexer sour
     }
 }
 
+void DiagnosticSink::initFrom(const DiagnosticSink& other)
+{
+    init(other.m_sourceManager, other.m_sourceLocationLexer);
+
+    m_sourceLineMaxLength = other.m_sourceLineMaxLength;
+    m_flags = other.m_flags;
+    m_severityOverrides = other.m_severityOverrides;
+
+    writer = nullptr;
+    m_parentSink = nullptr;
+    outputBuffer.Clear();
+}
+
+void DiagnosticSink::appendOutputFrom(const DiagnosticSink& other)
+{
+    // Buffered output is only available if the other sink doesn't have a writer
+    SLANG_ASSERT(other.writer == nullptr);
+
+    m_errorCount += other.m_errorCount;
+
+    const UnownedStringSlice text = other.outputBuffer.getUnownedSlice();
+    if (text.getLength())
+    {
+        if (writer)
+        {
+            writer->write(text.begin(), text.getLength());
+        }
+        else
+        {
+            outputBuffer.append(text);
+        }
+    }
+
+    if (m_parentSink)
+    {
+        m_parentSink->appendOutputFrom(other);
+    }
+}
+
 void DiagnosticSink::reset()
 {
     m_errorCount = 0;
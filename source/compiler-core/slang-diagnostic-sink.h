@@ -229,6 +229,8 @@ public:
         /// Sets an override on the severity of a specific diagnostic message (by numeric identifier)
         /// info can be set to nullptr if only to override 
     void overrideDiagnosticSeverity(int diagnosticId, Severity overrideSeverity, const DiagnosticInfo* info = nullptr);
+        /// Get the overridden severities (keyed by numeric identifier)
+    const Dictionary<int, Severity>& getSeverityOverrides() const { return m_severityOverrides; }
 
         /// Get the (optional) diagnostic sink lexer. This is used to
         /// improve quality of highlighting a locations token. If not set, will just have a single
@@ -250,6 +252,14 @@ public:
         /// Initialize state. 
     void init(SourceManager* sourceManager, SourceLocationLexer sourceLocationLexer);
 
+        /// Initialize such that diagnostics are formatted in the same way as `other`.
+        /// Output will be held in outputBuffer - no writer or parent sink is set.
+    void initFrom(const DiagnosticSink& other);
+
+        /// Append the buffered output and error count of `other` to this sink (and the parent sink if set).
+        /// Used to merge diagnostics that were collected on a separate sink, for example on another thread.
+    void appendOutputFrom(const DiagnosticSink& other);
+
         /// Ctor
     DiagnosticSink(SourceManager* sourceManager, SourceLocationLexer sourceLocationLexer) { init(sourceManager, sourceLocationLexer); }
         /// Default Ctor
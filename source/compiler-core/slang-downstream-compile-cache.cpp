@@ -0,0 +1,309 @@
+// slang-downstream-compile-cache.cpp
+#include "slang-downstream-compile-cache.h"
+
+#include "../core/slang-io.h"
+#include "../core/slang-string-util.h"
+#include "../core/slang-crypto.h"
+
+#include "slang-artifact-impl.h"
+#include "slang-artifact-representation-impl.h"
+#include "slang-artifact-associated-impl.h"
+#include "slang-artifact-desc-util.h"
+#include "slang-artifact-util.h"
+#include "slang-slice-allocator.h"
+
+namespace Slang
+{
+
+// Bump if what is held in the key changes
+static const char kDownstreamCacheVersion[] = "downstream-cache-2";
+
+namespace { // anonymous
+
+struct KeyBuilder
+{
+    void appendString(const UnownedStringSlice& slice)
+    {
+        // Append the length so adjacent strings can't alias
+        m_builder.append(slice.getLength());
+        m_builder.append(slice);
+    }
+    void appendString(const TerminatedCharSlice& slice) { appendString(asStringSlice(slice)); }
+    void appendString(const char* text) { appendString(UnownedStringSlice(text ? text : "")); }
+    template <typename T>
+    void appendValue(const T& value) { m_builder.append(value); }
+    void appendContents(const void* data, size_t size) { m_builder.append(ContentHash::compute(data, SlangInt(size))); }
+
+        /// Append the contents of files included with `#include "..."` in text, recursively
+    void appendIncludes(const UnownedStringSlice& text, const String& directory);
+
+    KeyBuilder(const DownstreamCompileOptions& options) : m_options(options) {}
+
+    DigestBuilder<SHA1> m_builder;
+    const DownstreamCompileOptions& m_options;
+    HashSet<String> m_visitedPaths;
+};
+
+} // anonymous
+
+static bool _findQuotedInclude(const UnownedStringSlice& inLine, UnownedStringSlice& outPath)
+{
+    UnownedStringSlice line = inLine.trim();
+    if (!line.startsWith(toSlice("#")))
+    {
+        return false;
+    }
+    line = UnownedStringSlice(line.begin() + 1, line.end()).trimStart();
+    if (!line.startsWith(toSlice("include")))
+    {
+        return false;
+    }
+    line = UnownedStringSlice(line.begin() + 7, line.end()).trimStart();
+    if (!line.startsWith(toSlice("\"")))
+    {
+        return false;
+    }
+    const Index endIndex = UnownedStringSlice(line.begin() + 1, line.end()).indexOf('"');
+    if (endIndex < 0)
+    {
+        return false;
+    }
+    outPath = UnownedStringSlice(line.begin() + 1, line.begin() + 1 + endIndex);
+    return true;
+}
+
+void KeyBuilder::appendIncludes(const UnownedStringSlice& text, const String& directory)
+{
+    for (const auto& line : LineParser(text))
+    {
+        UnownedStringSlice includePath;
+        if (!_findQuotedInclude(line, includePath))
+        {
+            continue;
+        }
+
+        // Search in the same order as the compiler would
+        List<String> candidates;
+        if (Path::isAbsolute(includePath))
+        {
+            candidates.add(includePath);
+        }
+        else
+        {
+            if (directory.getLength())
+            {
+                candidates.add(Path::combine(directory, includePath));
+            }
+            for (const auto& path : m_options.includePaths)
+            {
+                candidates.add(Path::combine(asStringSlice(path), includePath));
+            }
+        }
+
+        // If not found, it will fail to compile or is found somewhere we don't know about, either
+        // way the path is the best we can do.
+        appendString(includePath);
+
+        for (const auto& candidate : candidates)
+        {
+            if (!File::exists(candidate))
+            {
+                continue;
+            }
+
+            String canonicalPath;
+            if (SLANG_FAILED(Path::getCanonical(candidate, canonicalPath)))
+            {
+                canonicalPath = candidate;
+            }
+
+            // Only need to add the contents the first time the file is seen
+            if (m_visitedPaths.Add(canonicalPath))
+            {
+                List<unsigned char> contents;
+                if (SLANG_SUCCEEDED(File::readAllBytes(canonicalPath, contents)))
+                {
+                    appendContents(contents.getBuffer(), size_t(contents.getCount()));
+                    appendIncludes(UnownedStringSlice((const char*)contents.getBuffer(), contents.getCount()), Path::getParentDirectory(canonicalPath));
+                }
+            }
+            break;
+        }
+    }
+}
+
+static String _getDirectory(IArtifact* artifact)
+{
+    if (auto fileRep = findRepresentation<IOSFileArtifactRepresentation>(artifact))
+    {
+        return Path::getParentDirectory(fileRep->getPath());
+    }
+    if (auto extFileRep = findRepresentation<IExtFileArtifactRepresentation>(artifact))
+    {
+        return Path::getParentDirectory(extFileRep->getPath());
+    }
+    return String();
+}
+
+/* static */SlangResult DownstreamCompileCacheUtil::calcKey(IDownstreamCompiler* compiler, const DownstreamCompileOptions& options, PersistentCache::Key& outKey)
+{
+    // If the output path is set the product must end up there, so we can't use the cache
+    if (options.modulePath.count)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    KeyBuilder builder(options);
+
+    builder.appendString(kDownstreamCacheVersion);
+
+    // The compiler
+    {
+        const auto& desc = compiler->getDesc();
+        builder.appendValue(desc.type);
+        builder.appendValue(desc.version.m_major);
+        builder.appendValue(desc.version.m_minor);
+        builder.appendValue(desc.version.m_patch);
+
+        ComPtr<ISlangBlob> versionString;
+        if (SLANG_SUCCEEDED(compiler->getVersionString(versionString.writeRef())) && versionString)
+        {
+            builder.appendContents(versionString->getBufferPointer(), versionString->getBufferSize());
+        }
+    }
+
+    // The options
+    builder.appendValue(options.optimizationLevel);
+    builder.appendValue(options.debugInfoType);
+    builder.appendValue(options.targetType);
+    builder.appendValue(options.sourceLanguage);
+    builder.appendValue(options.floatingPointMode);
+    builder.appendValue(options.pipelineType);
+    builder.appendValue(options.matrixLayout);
+    builder.appendValue(options.flags);
+    builder.appendValue(options.platform);
+    builder.appendValue(options.stage);
+    builder.appendValue(options.m_debugInfoFormat);
+
+    builder.appendString(options.entryPointName);
+    builder.appendString(options.profileName);
+
+    builder.appendValue(options.defines.count);
+    for (const auto& define : options.defines)
+    {
+        builder.appendString(define.nameWithSig);
+        builder.appendString(define.value);
+    }
+
+    builder.appendValue(options.includePaths.count);
+    for (const auto& path : options.includePaths)
+    {
+        builder.appendString(path);
+    }
+    builder.appendValue(options.libraryPaths.count);
+    for (const auto& path : options.libraryPaths)
+    {
+        builder.appendString(path);
+    }
+    builder.appendValue(options.compilerSpecificArguments.count);
+    for (const auto& arg : options.compilerSpecificArguments)
+    {
+        builder.appendString(arg);
+    }
+    builder.appendValue(options.requiredCapabilityVersions.count);
+    for (const auto& capabilityVersion : options.requiredCapabilityVersions)
+    {
+        builder.appendValue(capabilityVersion.kind);
+        builder.appendValue(capabilityVersion.version.m_major);
+        builder.appendValue(capabilityVersion.version.m_minor);
+        builder.appendValue(capabilityVersion.version.m_patch);
+    }
+
+    // Libraries are either referenced by name (found by the linker), or have contents
+    builder.appendValue(options.libraries.count);
+    for (IArtifact* library : options.libraries)
+    {
+        const auto libraryDesc = library->getDesc();
+        builder.appendValue(libraryDesc.kind);
+        builder.appendValue(libraryDesc.payload);
+        builder.appendValue(libraryDesc.style);
+        builder.appendValue(libraryDesc.flags);
+
+        auto fileRep = findRepresentation<IOSFileArtifactRepresentation>(library);
+        if (fileRep && fileRep->getKind() == IOSFileArtifactRepresentation::Kind::NameOnly)
+        {
+            builder.appendString(fileRep->getPath());
+            continue;
+        }
+
+        ComPtr<ISlangBlob> blob;
+        if (SLANG_FAILED(library->loadBlob(ArtifactKeep::No, blob.writeRef())))
+        {
+            return SLANG_E_NOT_AVAILABLE;
+        }
+        builder.appendContents(blob->getBufferPointer(), blob->getBufferSize());
+    }
+
+    // The source, and anything it includes
+    builder.appendValue(options.sourceArtifacts.count);
+    for (IArtifact* sourceArtifact : options.sourceArtifacts)
+    {
+        ComPtr<ISlangBlob> blob;
+        if (SLANG_FAILED(sourceArtifact->loadBlob(ArtifactKeep::No, blob.writeRef())))
+        {
+            return SLANG_E_NOT_AVAILABLE;
+        }
+        builder.appendContents(blob->getBufferPointer(), blob->getBufferSize());
+
+        const UnownedStringSlice text((const char*)blob->getBufferPointer(), blob->getBufferSize());
+        builder.appendIncludes(text, _getDirectory(sourceArtifact));
+    }
+
+    outKey = builder.m_builder.finalize();
+    return SLANG_OK;
+}
+
+/* static */SlangResult DownstreamCompileCacheUtil::compile(PersistentCache* cache, IDownstreamCompiler* compiler, const DownstreamCompileOptions& options, IArtifact** outArtifact)
+{
+    PersistentCache::Key key;
+    if (SLANG_FAILED(calcKey(compiler, options, key)))
+    {
+        return compiler->compile(options, outArtifact);
+    }
+
+    const auto targetDesc = ArtifactDescUtil::makeDescForCompileTarget(options.targetType);
+
+    {
+        ComPtr<ISlangBlob> blob;
+        if (SLANG_SUCCEEDED(cache->readEntry(key, blob.writeRef())))
+        {
+            auto artifact = ArtifactUtil::createArtifact(targetDesc);
+            artifact->addRepresentationUnknown(blob);
+            // A cached compilation was successful, and its diagnostics are not kept
+            artifact->addAssociated(ArtifactDiagnostics::create());
+
+            *outArtifact = artifact.detach();
+            return SLANG_OK;
+        }
+    }
+
+    ComPtr<IArtifact> artifact;
+    SLANG_RETURN_ON_FAIL(compiler->compile(options, artifact.writeRef()));
+
+    // Only add successful compilations
+    auto diagnostics = findAssociated<IArtifactDiagnostics>(artifact);
+    if (!diagnostics || !diagnostics->hasOfAtLeastSeverity(ArtifactDiagnostic::Severity::Error))
+    {
+        ComPtr<ISlangBlob> blob;
+        if (SLANG_SUCCEEDED(artifact->loadBlob(ArtifactKeep::Yes, blob.writeRef())))
+        {
+            // Failing to write into the cache just means the next compile won't find it
+            cache->writeEntry(key, blob);
+        }
+    }
+
+    *outArtifact = artifact.detach();
+    return SLANG_OK;
+}
+
+}
@@ -0,0 +1,35 @@
+// slang-downstream-compile-cache.h
+#ifndef SLANG_DOWNSTREAM_COMPILE_CACHE_H
+#define SLANG_DOWNSTREAM_COMPILE_CACHE_H
+
+#include "../core/slang-persistent-cache.h"
+
+#include "slang-downstream-compiler.h"
+
+namespace Slang
+{
+
+/* Caches the main product of a downstream compilation (say a shared library or PTX) in a
+PersistentCache, such that compiling identical source with the same compiler and options can
+reuse the product instead of invoking the compiler again.
+
+The key covers the compiler (type, version and version string if available), the compile
+options, the contents of the source artifacts and the contents of the files they include with
+`#include "..."` (such as the prelude). Files included with `#include <...>` are assumed to be
+part of the compiler installation.
+
+Only successful compilations are cached. A product read from the cache has no diagnostics. */
+struct DownstreamCompileCacheUtil
+{
+        /// Calculate the key for compiling with options on compiler.
+        /// Returns SLANG_E_NOT_AVAILABLE if the compilation can't be cached (for example if the output path is set)
+    static SlangResult calcKey(IDownstreamCompiler* compiler, const DownstreamCompileOptions& options, PersistentCache::Key& outKey);
+
+        /// Compile with compiler, using the product from the cache if there is one, and adding the
+        /// product to the cache if there isn't.
+    static SlangResult compile(PersistentCache* cache, IDownstreamCompiler* compiler, const DownstreamCompileOptions& options, IArtifact** outArtifact);
+};
+
+}
+
+#endif
@@ -155,6 +155,7 @@ struct DownstreamCompileOptions
             Verbose                     = 0x02,             ///< Give more verbose diagnostics
             EnableSecurityChecks        = 0x04,             ///< Enable runtime security checks (such as for buffer overruns) - enabling typically decreases performance
             EnableFloat16               = 0x08,             ///< If set compiles with support for float16/half
+            Validate                    = 0x10,             ///< Validate generated code where the compiler supports it (for example SPIR-V with spirv-val)
         };
     };
 
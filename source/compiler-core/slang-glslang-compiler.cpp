@@ -60,6 +60,7 @@ protected:
 
     glslang_CompileFunc_1_0 m_compile_1_0 = nullptr; 
     glslang_CompileFunc_1_1 m_compile_1_1 = nullptr; 
+    glslang_SupportsActionFunc m_supportsAction = nullptr;      ///< Only available on libraries that can optimize SPIR-V
     
     ComPtr<ISlangSharedLibrary> m_sharedLibrary;
 };
@@ -68,6 +69,7 @@ SlangResult GlslangDownstreamCompiler::init(ISlangSharedLibrary* library)
 {
     m_compile_1_0 = (glslang_CompileFunc_1_0)library->findFuncByName("glslang_compile");
     m_compile_1_1 = (glslang_CompileFunc_1_1)library->findFuncByName("glslang_compile_1_1");
+    m_supportsAction = (glslang_SupportsActionFunc)library->findFuncByName("glslang_supportsAction");
 
     if (m_compile_1_0 == nullptr && m_compile_1_1 == nullptr)
     {
@@ -156,12 +158,22 @@ SlangResult GlslangDownstreamCompiler::compile(const CompileOptions& inOptions,
 
     IArtifact* sourceArtifact = options.sourceArtifacts[0];
 
-    if (options.sourceLanguage != SLANG_SOURCE_LANGUAGE_GLSL || options.targetType != SLANG_SPIRV)
+    // A SPIR-V source is optimized (and validated if requested), instead of being compiled
+    const bool isSPIRVSource = sourceArtifact->getDesc().payload == ArtifactPayload::SPIRV;
+
+    if ((options.sourceLanguage != SLANG_SOURCE_LANGUAGE_GLSL && !isSPIRVSource) || options.targetType != SLANG_SPIRV)
     {
-        SLANG_ASSERT(!"Can only compile GLSL to SPIR-V");
+        SLANG_ASSERT(!"Can only compile GLSL or SPIR-V to SPIR-V");
         return SLANG_FAIL;
     }
 
+    // Older libraries can't optimize SPIR-V (and fail any action they don't know), so report
+    // it as not available, so the caller can use the SPIR-V as it is
+    if (isSPIRVSource && !(m_supportsAction && m_supportsAction(GLSLANG_ACTION_OPTIMIZE_SPIRV)))
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
     StringBuilder diagnosticOutput;
     auto diagnosticOutputFunc = [](void const* data, size_t size, void* userData)
     {
@@ -182,7 +194,7 @@ SlangResult GlslangDownstreamCompiler::compile(const CompileOptions& inOptions,
     memset(&request, 0, sizeof(request));
     request.sizeInBytes = sizeof(request);
 
-    request.action = GLSLANG_ACTION_COMPILE_GLSL_TO_SPIRV;
+    request.action = isSPIRVSource ? GLSLANG_ACTION_OPTIMIZE_SPIRV : GLSLANG_ACTION_COMPILE_GLSL_TO_SPIRV;
     request.sourcePath = sourcePath.getBuffer();
 
     request.slangStage = options.stage;
@@ -217,6 +229,21 @@ SlangResult GlslangDownstreamCompiler::compile(const CompileOptions& inOptions,
     request.optimizationLevel = (unsigned)options.optimizationLevel;
     request.debugInfoType = (unsigned)options.debugInfoType;
 
+    // When optimizing SPIR-V, compiler specific arguments are spirv-opt style flags for the
+    // optimization passes to run. They aren't used when compiling GLSL.
+    List<const char*> optimizationPasses;
+    if (isSPIRVSource)
+    {
+        for (const auto& arg : options.compilerSpecificArguments)
+        {
+            optimizationPasses.add(arg);
+        }
+        request.spirvOptimizationPasses = optimizationPasses.getBuffer();
+        request.spirvOptimizationPassCount = size_t(optimizationPasses.getCount());
+    }
+
+    request.validateSPIRV = (options.flags & CompileOptions::Flag::Validate) ? 1 : 0;
+
     const SlangResult invokeResult = _invoke(request);
 
     auto artifact = ArtifactUtil::createArtifactForCompileTarget(options.targetType);
@@ -309,6 +309,12 @@ struct WorkspaceFolder
 struct InitializeParams
 {
     List<WorkspaceFolder> workspaceFolders;
+
+    /**
+     * The initial trace setting. One of "off", "messages" or "verbose".
+     * If omitted trace is disabled ('off').
+     */
+    String trace;
     static const UnownedStringSlice methodName;
     static const StructRttiInfo g_rttiInfo;
 };
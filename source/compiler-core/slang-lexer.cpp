@@ -8,6 +8,8 @@
 #include "slang-name.h"
 #include "slang-source-loc.h"
 
+#include "../core/slang-char-scan-util.h"
+
 #include "slang-core-diagnostics.h"
 
 namespace Slang
@@ -265,6 +267,10 @@ namespace Slang
     {
         for(;;)
         {
+            // Skip to the next character that could end the comment. A backslash could
+            // be an escaped newline, so is handled one character at a time below.
+            lexer->m_cursor = CharScanUtil::findFirstOf(lexer->m_cursor, lexer->m_end, '\n', '\r', '\\');
+
             switch(_peek(lexer))
             {
             case '\n': case '\r': case kEOF:
@@ -281,6 +287,10 @@ namespace Slang
     {
         for(;;)
         {
+            // Only a '*' can start the end of the comment, and a backslash could be an escaped
+            // newline (between the '*' and '/' say), so everything else can be skipped in bulk.
+            lexer->m_cursor = CharScanUtil::findFirstOf(lexer->m_cursor, lexer->m_end, '*', '\\');
+
             switch(_peek(lexer))
             {
             case kEOF:
@@ -314,6 +324,9 @@ namespace Slang
     {
         for(;;)
         {
+            // Skip plain spaces and tabs in bulk, escaped newlines are handled below
+            lexer->m_cursor = CharScanUtil::skipHorizontalWhitespace(lexer->m_cursor, lexer->m_end);
+
             switch(_peek(lexer))
             {
             case ' ': case '\t':
@@ -330,6 +343,9 @@ namespace Slang
     {
         for(;;)
         {
+            // Skip plain identifier characters in bulk, escaped newlines are handled below
+            lexer->m_cursor = CharScanUtil::skipIdentifierChars(lexer->m_cursor, lexer->m_end);
+
             int c = _peek(lexer);
             if(('a' <= c ) && (c <= 'z')
                 || ('A' <= c) && (c <= 'Z')
@@ -691,6 +707,10 @@ namespace Slang
     {
         for(;;)
         {
+            // Skip to the next character that needs handling (the end of the literal, an escape
+            // or escaped newline, or a newline which is an error)
+            lexer->m_cursor = CharScanUtil::findFirstOf(lexer->m_cursor, lexer->m_end, quote, '\\', '\n', '\r');
+
             int c = _peek(lexer);
             if(c == quote)
             {
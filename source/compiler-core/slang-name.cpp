@@ -21,6 +21,8 @@ const char* getCstr(Name* name)
 
 Name* NamePool::getName(String const& text)
 {
+    SharedStateLock lock;
+
     RefPtr<Name> name;
     if (rootPool->names.TryGetValue(text, name))
         return name;
@@ -33,6 +35,8 @@ Name* NamePool::getName(String const& text)
 
 Name* NamePool::tryGetName(String const& text)
 {
+    SharedStateLock lock;
+
     RefPtr<Name> name;
     if (rootPool->names.TryGetValue(text, name))
         return name;
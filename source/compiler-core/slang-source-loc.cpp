@@ -3,6 +3,7 @@
 
 #include "../core/slang-string-util.h"
 #include "../core/slang-string-escape-util.h"
+#include "../core/slang-char-scan-util.h"
 
 #include "slang-artifact-representation-impl.h"
 #include "slang-artifact-impl.h"
@@ -276,16 +277,40 @@ void SourceFile::setLineBreakOffsets(const uint32_t* offsets, UInt numOffsets)
 
 const List<uint32_t>& SourceFile::getLineBreakOffsets()
 {
+    // Diagnostics for a file may be reported from multiple threads
+    SharedStateLock lock;
+
     // We now have a raw input file that we can search for line breaks.
     // We obviously don't want to do a linear scan over and over, so we will
     // cache an array of line break locations in the file.
     if (m_lineBreakOffsets.getCount() == 0)
     {
-        UnownedStringSlice content(getContent()), line;
-        char const* contentBegin = content.begin();
-        while (StringUtil::extractLine(content, line))
+        // Finds the same line starts as StringUtil::extractLine would, but skips between
+        // line breaks in bulk.
+        const UnownedStringSlice content(getContent());
+        char const* const contentBegin = content.begin();
+        char const* const contentEnd = content.end();
+        if (contentBegin)
         {
-            m_lineBreakOffsets.add(uint32_t(line.begin() - contentBegin));
+            m_lineBreakOffsets.add(0);
+
+            char const* cursor = contentBegin;
+            for (;;)
+            {
+                cursor = CharScanUtil::findFirstOf(cursor, contentEnd, '\n', '\r');
+                if (cursor == contentEnd)
+                {
+                    break;
+                }
+
+                // A CR/LF or LF/CR pair is a single line break
+                const char c = *cursor++;
+                if (cursor < contentEnd && (c ^ *cursor) == ('\r' ^ '\n'))
+                {
+                    cursor++;
+                }
+                m_lineBreakOffsets.add(uint32_t(cursor - contentBegin));
+            }
         }
         // Note that we do *not* treat the end of the file as a line
         // break, because otherwise we would report errors like
@@ -394,6 +419,20 @@ void SourceFile::setContents(ISlangBlob* blob)
 
     m_contentBlob = blob;
     m_content = UnownedStringSlice(contentBegin, contentEnd);
+    m_hasContentDigest = false;
+}
+
+const ContentHash::Digest& SourceFile::getContentDigest()
+{
+    // The digest may be requested for the same file from multiple threads
+    SharedStateLock lock;
+
+    if (!m_hasContentDigest)
+    {
+        m_contentDigest = ContentHash::compute(m_content.begin(), m_content.getLength());
+        m_hasContentDigest = true;
+    }
+    return m_contentDigest;
 }
 
 void SourceFile::setContents(const String& content)
@@ -699,6 +738,11 @@ void SourceManager::addSourceFile(const String& uniqueIdentity, SourceFile* sour
     m_sourceFileMap.Add(uniqueIdentity, sourceFile);
 }
 
+void SourceManager::unmapSourceFile(const String& uniqueIdentity)
+{
+    m_sourceFileMap.Remove(uniqueIdentity);
+}
+
 HumaneSourceLoc SourceManager::getHumaneLoc(SourceLoc loc, SourceLocType type)
 {
     SourceView* sourceView = findSourceViewRecursively(loc);
@@ -3,6 +3,7 @@
 #define SLANG_SOURCE_LOC_H_INCLUDED
 
 #include "../core/slang-basic.h"
+#include "../core/slang-crypto.h"
 #include "../core/slang-memory-arena.h"
 #include "../core/slang-string-slice-pool.h"
 
@@ -231,6 +232,10 @@ public:
         /// Get the content
     const UnownedStringSlice& getContent() const { return m_content;  }
 
+        /// Get a digest of the content.
+        /// Note that this is lazily evaluated - the digest is only calculated on the first request
+    const ContentHash::Digest& getContentDigest();
+
         /// Get path info
     const PathInfo& getPathInfo() const { return m_pathInfo;  }
 
@@ -263,6 +268,9 @@ public:
     // we will cache the starting offset of each line break in
     // the input file:
     List<uint32_t> m_lineBreakOffsets;
+
+    ContentHash::Digest m_contentDigest;                        ///< Digest of the contents. Only valid if m_hasContentDigest is set
+    bool m_hasContentDigest = false;
 };
 
 enum class SourceLocType
@@ -429,6 +437,9 @@ struct SourceManager
 
         /// Add a source file, uniqueIdentity must be unique for this manager AND any parents
     void addSourceFile(const String& uniqueIdentity, SourceFile* sourceFile);
+        /// Remove the mapping from uniqueIdentity to its source file on this manager, such that the file will be loaded again
+        /// the next time it is needed. The SourceFile is still owned by the manager, as locations may reference it.
+    void unmapSourceFile(const String& uniqueIdentity);
 
         /// Get the slice pool
     StringSlicePool& getStringSlicePool() { return m_slicePool; }
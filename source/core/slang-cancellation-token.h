@@ -0,0 +1,36 @@
+#ifndef SLANG_CORE_CANCELLATION_TOKEN_H
+#define SLANG_CORE_CANCELLATION_TOKEN_H
+
+#include "slang-smart-pointer.h"
+
+#include <atomic>
+
+namespace Slang
+{
+
+/* Used to ask a long running operation to stop early.
+
+The operation checks `isCancelled` at points where it can stop cleanly. `cancel` can be called
+from any thread. A derived type can override `isCancelled` to work out whether to cancel when
+it is checked (for example by looking for newer requests). */
+class CancellationToken : public RefObject
+{
+public:
+        /// Request cancellation
+    void cancel() { m_isCancelled.store(true, std::memory_order_relaxed); }
+        /// Clear a prior cancellation request, such that the token can be used for another operation
+    virtual void reset() { m_isCancelled.store(false, std::memory_order_relaxed); }
+
+        /// True if cancellation has been requested
+    virtual bool isCancelled() { return isCancellationRequested(); }
+        /// True if `cancel` has been called since the last reset. Unlike `isCancelled` it never
+        /// works out whether to cancel, so it is cheap and only changes when `cancel` is called.
+    bool isCancellationRequested() const { return m_isCancelled.load(std::memory_order_relaxed); }
+
+protected:
+    std::atomic<bool> m_isCancelled = { false };
+};
+
+}
+
+#endif
@@ -0,0 +1,164 @@
+#include "slang-char-scan-util.h"
+
+#if defined(__SSE2__) || (SLANG_VC && (SLANG_PROCESSOR_X86_64 || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)))
+#   define SLANG_CHAR_SCAN_SSE2 1
+#   include <emmintrin.h>
+#elif defined(__ARM_NEON) || (SLANG_VC && SLANG_PROCESSOR_ARM_64)
+#   define SLANG_CHAR_SCAN_NEON 1
+#   include <arm_neon.h>
+#endif
+
+#if SLANG_VC
+#   include <intrin.h>
+#endif
+
+namespace Slang {
+
+namespace { // anonymous
+
+// A block of kBlockSize characters, loaded from any (unaligned) position.
+// Tests produce a 'lane' value per character which is all ones if the test passed, else zero.
+// A mask of lanes has a bit (or for NEON a nibble) for each character.
+#if SLANG_CHAR_SCAN_SSE2
+typedef __m128i Block;
+
+static const Index kBlockSize = 16;
+static const int kMaskShift = 0;
+static const uint64_t kAllLanesMask = 0xffff;
+
+SLANG_FORCE_INLINE Block _load(const char* pos) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos)); }
+SLANG_FORCE_INLINE Block _or(Block a, Block b) { return _mm_or_si128(a, b); }
+SLANG_FORCE_INLINE Block _orChar(Block a, char c) { return _mm_or_si128(a, _mm_set1_epi8(c)); }
+SLANG_FORCE_INLINE Block _equal(Block a, char c) { return _mm_cmpeq_epi8(a, _mm_set1_epi8(c)); }
+    // There is no unsigned compare, so (a - lo) <= (hi - lo) is done as a signed compare with the top bits flipped
+SLANG_FORCE_INLINE Block _inRange(Block a, char lo, char hi)
+{
+    const Block offset = _mm_xor_si128(_mm_sub_epi8(a, _mm_set1_epi8(lo)), _mm_set1_epi8(char(0x80)));
+    return _mm_cmplt_epi8(offset, _mm_set1_epi8(char(((hi - lo) + 1) ^ 0x80)));
+}
+SLANG_FORCE_INLINE uint64_t _toMask(Block a) { return uint64_t(uint32_t(_mm_movemask_epi8(a))); }
+
+#elif SLANG_CHAR_SCAN_NEON
+typedef uint8x16_t Block;
+
+static const Index kBlockSize = 16;
+static const int kMaskShift = 2;
+static const uint64_t kAllLanesMask = 0x8888888888888888ull;
+
+SLANG_FORCE_INLINE Block _load(const char* pos) { return vld1q_u8(reinterpret_cast<const uint8_t*>(pos)); }
+SLANG_FORCE_INLINE Block _or(Block a, Block b) { return vorrq_u8(a, b); }
+SLANG_FORCE_INLINE Block _orChar(Block a, char c) { return vorrq_u8(a, vdupq_n_u8(uint8_t(c))); }
+SLANG_FORCE_INLINE Block _equal(Block a, char c) { return vceqq_u8(a, vdupq_n_u8(uint8_t(c))); }
+SLANG_FORCE_INLINE Block _inRange(Block a, char lo, char hi) { return vcleq_u8(vsubq_u8(a, vdupq_n_u8(uint8_t(lo))), vdupq_n_u8(uint8_t(hi - lo))); }
+    // Narrow each 0x00/0xff lane to a nibble, and keep a single bit per lane
+SLANG_FORCE_INLINE uint64_t _toMask(Block a)
+{
+    const uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(a), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(narrowed), 0) & kAllLanesMask;
+}
+#endif
+
+#if SLANG_CHAR_SCAN_SSE2 || SLANG_CHAR_SCAN_NEON
+#   define SLANG_CHAR_SCAN_BLOCKS 1
+
+SLANG_FORCE_INLINE int _calcTrailingZeros(uint64_t v)
+{
+    SLANG_ASSERT(v);
+#if SLANG_VC
+#   if SLANG_PTR_IS_64
+    unsigned long index;
+    _BitScanForward64(&index, v);
+    return int(index);
+#   else
+    unsigned long index;
+    if (_BitScanForward(&index, uint32_t(v)))
+    {
+        return int(index);
+    }
+    _BitScanForward(&index, uint32_t(v >> 32));
+    return int(index) + 32;
+#   endif
+#else
+    return __builtin_ctzll(v);
+#endif
+}
+#endif
+
+/* Returns the first character in [cursor, end) that is a 'stop' character.
+
+If kStopOnMatch is true a character is a stop character if it matches, otherwise if it doesn't.
+blockMatch tests a Block, and charMatch a single char, and must agree on what matches. */
+template <bool kStopOnMatch, typename BlockMatch, typename CharMatch>
+SLANG_FORCE_INLINE const char* _scan(const char* cursor, const char* end, const BlockMatch& blockMatch, const CharMatch& charMatch)
+{
+#if SLANG_CHAR_SCAN_BLOCKS
+    while (end - cursor >= kBlockSize)
+    {
+        uint64_t mask = _toMask(blockMatch(_load(cursor)));
+        if (!kStopOnMatch)
+        {
+            mask ^= kAllLanesMask;
+        }
+        if (mask)
+        {
+            return cursor + (_calcTrailingZeros(mask) >> kMaskShift);
+        }
+        cursor += kBlockSize;
+    }
+#else
+    SLANG_UNUSED(blockMatch);
+#endif
+
+    while (cursor < end && charMatch(*cursor) != kStopOnMatch)
+    {
+        ++cursor;
+    }
+    return cursor;
+}
+
+// Without SIMD support the block match is never used, so it is just a placeholder
+#if SLANG_CHAR_SCAN_BLOCKS
+#   define SLANG_CHAR_SCAN_BLOCK_MATCH(EXPR) [&](Block block) { return EXPR; }
+#else
+#   define SLANG_CHAR_SCAN_BLOCK_MATCH(EXPR) 0
+#endif
+
+} // anonymous
+
+/* static */const char* CharScanUtil::skipHorizontalWhitespace(const char* cursor, const char* end)
+{
+    return _scan<false>(cursor, end,
+        SLANG_CHAR_SCAN_BLOCK_MATCH(_or(_equal(block, ' '), _equal(block, '\t'))),
+        [](char c) { return c == ' ' || c == '\t'; });
+}
+
+/* static */const char* CharScanUtil::skipIdentifierChars(const char* cursor, const char* end)
+{
+    // Setting bit 5 maps upper case letters onto lower case, and nothing else onto a-z
+    return _scan<false>(cursor, end,
+        SLANG_CHAR_SCAN_BLOCK_MATCH(_or(_or(_inRange(_orChar(block, 0x20), 'a', 'z'), _inRange(block, '0', '9')), _equal(block, '_'))),
+        [](char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_'; });
+}
+
+/* static */const char* CharScanUtil::findFirstOf(const char* cursor, const char* end, char a, char b)
+{
+    return _scan<true>(cursor, end,
+        SLANG_CHAR_SCAN_BLOCK_MATCH(_or(_equal(block, a), _equal(block, b))),
+        [&](char x) { return x == a || x == b; });
+}
+
+/* static */const char* CharScanUtil::findFirstOf(const char* cursor, const char* end, char a, char b, char c)
+{
+    return _scan<true>(cursor, end,
+        SLANG_CHAR_SCAN_BLOCK_MATCH(_or(_or(_equal(block, a), _equal(block, b)), _equal(block, c))),
+        [&](char x) { return x == a || x == b || x == c; });
+}
+
+/* static */const char* CharScanUtil::findFirstOf(const char* cursor, const char* end, char a, char b, char c, char d)
+{
+    return _scan<true>(cursor, end,
+        SLANG_CHAR_SCAN_BLOCK_MATCH(_or(_or(_equal(block, a), _equal(block, b)), _or(_equal(block, c), _equal(block, d)))),
+        [&](char x) { return x == a || x == b || x == c || x == d; });
+}
+
+} // namespace Slang
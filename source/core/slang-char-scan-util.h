@@ -0,0 +1,30 @@
+#ifndef SLANG_CORE_CHAR_SCAN_UTIL_H
+#define SLANG_CORE_CHAR_SCAN_UTIL_H
+
+#include "slang-common.h"
+
+namespace Slang {
+
+/* Functions to find the end of runs of characters in text, as needed by the lexer and anything
+else that scans source.
+
+Each function looks at the range [cursor, end) and returns a pointer to the first character
+that ends the run, or end if there isn't one. Where SSE2 or NEON is available 16 characters are
+tested at a time, otherwise (and for the remaining characters at the end of the range) they are
+tested one at a time. Characters at or after end are never read. */
+struct CharScanUtil
+{
+        /// Returns the first character that isn't a space or a tab
+    static const char* skipHorizontalWhitespace(const char* cursor, const char* end);
+        /// Returns the first character that can't be part of an identifier (ie isn't a-z, A-Z, 0-9 or _)
+    static const char* skipIdentifierChars(const char* cursor, const char* end);
+
+        /// Returns the first character that is one of the characters passed
+    static const char* findFirstOf(const char* cursor, const char* end, char a, char b);
+    static const char* findFirstOf(const char* cursor, const char* end, char a, char b, char c);
+    static const char* findFirstOf(const char* cursor, const char* end, char a, char b, char c, char d);
+};
+
+} // namespace Slang
+
+#endif // SLANG_CORE_CHAR_SCAN_UTIL_H
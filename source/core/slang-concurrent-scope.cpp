@@ -0,0 +1,36 @@
+#include "slang-concurrent-scope.h"
+
+namespace Slang
+{
+
+// The scope the current thread is running in
+static thread_local ConcurrentScope* t_currentScope = nullptr;
+
+/* static */std::atomic<Index> ConcurrentScope::s_activeCount(0);
+
+ConcurrentScope::ConcurrentScope():
+    m_previous(t_currentScope)
+{
+    s_activeCount.fetch_add(1);
+    t_currentScope = this;
+}
+
+ConcurrentScope::~ConcurrentScope()
+{
+    t_currentScope = m_previous;
+    s_activeCount.fetch_sub(1);
+}
+
+/* static */ConcurrentScope* ConcurrentScope::getCurrent()
+{
+    return t_currentScope;
+}
+
+/* static */ConcurrentScope* ConcurrentScope::_setCurrent(ConcurrentScope* scope)
+{
+    ConcurrentScope* previous = t_currentScope;
+    t_currentScope = scope;
+    return previous;
+}
+
+}
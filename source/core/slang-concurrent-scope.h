@@ -0,0 +1,126 @@
+#ifndef SLANG_CORE_CONCURRENT_SCOPE_H
+#define SLANG_CORE_CONCURRENT_SCOPE_H
+
+#include "slang-common.h"
+
+#include <atomic>
+#include <mutex>
+
+// Whether the compiler may use multiple threads (with `-check-threads` and `-codegen-threads`).
+// That requires `RefObject` reference counts to be changed atomically, which costs on every
+// change, so it has to be enabled when building (with the premake option
+// `--enable-concurrent-compile=true`). It must be the same for all of the code that uses `RefObject`.
+#ifndef SLANG_ENABLE_CONCURRENT_COMPILE
+#   define SLANG_ENABLE_CONCURRENT_COMPILE 0
+#endif
+
+namespace Slang
+{
+
+/* Marks a region of execution in which objects that are normally only used by one thread
+may be used by several threads that run at once. For example, the AST and the caches used
+by semantic checking of a linkage are shared while function bodies are checked on multiple threads.
+
+Scopes are only supported if SLANG_ENABLE_CONCURRENT_COMPILE is set, otherwise code must not
+start threads that share state (see `isSupported`).
+
+While any scope is active (on any thread), `RefObject` reference counts are changed atomically.
+A `SharedStateLock` locks the mutex of the scope the current thread is running in. Each scope
+has its own mutex, so threads working on different linkages (in different scopes) don't contend.
+Outside of a scope neither costs more than testing a counter, so code that is only ever run on
+one thread doesn't pay for the locking. Without SLANG_ENABLE_CONCURRENT_COMPILE neither costs
+anything.
+
+A scope must be created before the threads that share state are started, and destroyed after
+they have all finished. The thread that creates the scope runs in it, and each thread that is
+started must run in it by creating a `ConcurrentScope::Thread`. */
+class SLANG_RT_API ConcurrentScope
+{
+public:
+        /// Runs the current thread in a scope for the lifetime of the object
+    class Thread
+    {
+    public:
+        Thread(ConcurrentScope* scope): m_previous(ConcurrentScope::_setCurrent(scope)) {}
+        ~Thread() { ConcurrentScope::_setCurrent(m_previous); }
+
+    private:
+        Thread(const Thread&) = delete;
+        void operator=(const Thread&) = delete;
+
+        ConcurrentScope* m_previous;
+    };
+
+        /// True if threads that share state can be used
+    SLANG_FORCE_INLINE static constexpr bool isSupported() { return SLANG_ENABLE_CONCURRENT_COMPILE != 0; }
+
+        /// True if any scope is active
+    SLANG_FORCE_INLINE static bool isActive()
+    {
+#if SLANG_ENABLE_CONCURRENT_COMPILE
+        return s_activeCount.load(std::memory_order_relaxed) != 0;
+#else
+        return false;
+#endif
+    }
+
+        /// Get the scope the current thread is running in, or nullptr if it isn't running in one
+    static ConcurrentScope* getCurrent();
+
+        /// Get the recursive mutex locked by `SharedStateLock` on threads running in this scope
+    std::recursive_mutex& getSharedStateMutex() { return m_sharedStateMutex; }
+
+    ConcurrentScope();
+    ~ConcurrentScope();
+
+private:
+    ConcurrentScope(const ConcurrentScope&) = delete;
+    void operator=(const ConcurrentScope&) = delete;
+
+        /// Set the scope the current thread is running in. Returns the previous scope.
+    static ConcurrentScope* _setCurrent(ConcurrentScope* scope);
+
+    ConcurrentScope* m_previous;                    ///< The scope the creating thread was running in
+    std::recursive_mutex m_sharedStateMutex;
+
+    static std::atomic<Index> s_activeCount;
+};
+
+/* Serializes access to state that may be shared between the threads of a `ConcurrentScope`, such
+as lazily built caches. The lock is recursive, so functions that take it may call each other.
+
+Only locks if the current thread is running in a `ConcurrentScope`, and then locks the mutex of
+that scope. */
+class SharedStateLock
+{
+public:
+    SharedStateLock():
+        m_mutex(nullptr)
+    {
+        if (ConcurrentScope::isActive())
+        {
+            if (auto scope = ConcurrentScope::getCurrent())
+            {
+                m_mutex = &scope->getSharedStateMutex();
+                m_mutex->lock();
+            }
+        }
+    }
+    ~SharedStateLock()
+    {
+        if (m_mutex)
+        {
+            m_mutex->unlock();
+        }
+    }
+
+private:
+    SharedStateLock(const SharedStateLock&) = delete;
+    void operator=(const SharedStateLock&) = delete;
+
+    std::recursive_mutex* m_mutex;
+};
+
+}
+
+#endif
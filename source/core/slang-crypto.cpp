@@ -6,10 +6,15 @@
  * SHA1 implementation is based on:
  * https://github.com/983/SHA1
  * Original LICENSE is at the bottom of this file.
+ *
+ * MurmurHash3 implementation is based on:
+ * https://github.com/aappleby/smhasher/blob/master/src/MurmurHash3.cpp
+ * which was placed in the public domain by its author, Austin Appleby.
  */
 
 #include "slang-crypto.h"
 #include "../core/slang-char-util.h"
+#include "../core/slang-math.h"
 
 namespace Slang
 {
@@ -541,6 +546,166 @@ void SHA1::processBlock(const uint8_t* ptr)
     return sha1.finalize();
 }
 
+// MurmurHash3
+
+static const uint64_t kMurmurC1 = 0x87c37b91114253d5ull;
+static const uint64_t kMurmurC2 = 0x4cf5ad432745937full;
+
+SLANG_FORCE_INLINE static uint64_t _rotl64(uint64_t x, int r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+SLANG_FORCE_INLINE static uint64_t _fmix64(uint64_t k)
+{
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdull;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ull;
+    k ^= k >> 33;
+    return k;
+}
+
+SLANG_FORCE_INLINE static uint64_t _mixK1(uint64_t k1)
+{
+    k1 *= kMurmurC1;
+    k1 = _rotl64(k1, 31);
+    k1 *= kMurmurC2;
+    return k1;
+}
+
+SLANG_FORCE_INLINE static uint64_t _mixK2(uint64_t k2)
+{
+    k2 *= kMurmurC2;
+    k2 = _rotl64(k2, 33);
+    k2 *= kMurmurC1;
+    return k2;
+}
+
+MurmurHash3::MurmurHash3()
+{
+    init();
+}
+
+void MurmurHash3::init()
+{
+    // Seed is 0
+    m_h1 = 0;
+    m_h2 = 0;
+    m_length = 0;
+    m_index = 0;
+}
+
+void MurmurHash3::update(const void* data, SlangInt len)
+{
+    if (!data || len <= 0)
+    {
+        return;
+    }
+
+    const uint8_t* ptr = reinterpret_cast<const uint8_t*>(data);
+    m_length += uint64_t(len);
+
+    // Fill up buffer if not empty.
+    if (m_index != 0)
+    {
+        const SlangInt count = Math::Min(len, SlangInt(sizeof(m_buf) - m_index));
+        ::memcpy(m_buf + m_index, ptr, size_t(count));
+        m_index += uint32_t(count);
+        ptr += count;
+        len -= count;
+
+        if (m_index < sizeof(m_buf))
+        {
+            return;
+        }
+        processBlock(m_buf);
+        m_index = 0;
+    }
+
+    // Process full blocks.
+    while (len >= SlangInt(sizeof(m_buf)))
+    {
+        processBlock(ptr);
+        ptr += sizeof(m_buf);
+        len -= sizeof(m_buf);
+    }
+
+    // Keep remaining bytes.
+    if (len > 0)
+    {
+        ::memcpy(m_buf, ptr, size_t(len));
+        m_index = uint32_t(len);
+    }
+}
+
+MurmurHash3::Digest MurmurHash3::finalize()
+{
+    uint64_t h1 = m_h1;
+    uint64_t h2 = m_h2;
+
+    // The tail is read as two little endian words
+    uint64_t k1 = 0;
+    uint64_t k2 = 0;
+    for (uint32_t i = m_index; i > 8; --i)
+    {
+        k2 = (k2 << 8) | m_buf[i - 1];
+    }
+    for (uint32_t i = Math::Min(m_index, 8u); i > 0; --i)
+    {
+        k1 = (k1 << 8) | m_buf[i - 1];
+    }
+    if (m_index > 8)
+    {
+        h2 ^= _mixK2(k2);
+    }
+    if (m_index > 0)
+    {
+        h1 ^= _mixK1(k1);
+    }
+
+    h1 ^= m_length;
+    h2 ^= m_length;
+
+    h1 += h2;
+    h2 += h1;
+
+    h1 = _fmix64(h1);
+    h2 = _fmix64(h2);
+
+    h1 += h2;
+    h2 += h1;
+
+    Digest digest;
+    ::memcpy(digest.data, &h1, sizeof(h1));
+    ::memcpy(digest.data + 2, &h2, sizeof(h2));
+    return digest;
+}
+
+void MurmurHash3::processBlock(const uint8_t* ptr)
+{
+    uint64_t k1, k2;
+    ::memcpy(&k1, ptr, sizeof(k1));
+    ::memcpy(&k2, ptr + 8, sizeof(k2));
+
+    m_h1 ^= _mixK1(k1);
+    m_h1 = _rotl64(m_h1, 27);
+    m_h1 += m_h2;
+    m_h1 = m_h1 * 5 + 0x52dce729;
+
+    m_h2 ^= _mixK2(k2);
+    m_h2 = _rotl64(m_h2, 31);
+    m_h2 += m_h1;
+    m_h2 = m_h2 * 5 + 0x38495ab5;
+}
+
+/* static */MurmurHash3::Digest MurmurHash3::compute(const void* data, SlangInt size)
+{
+    MurmurHash3 hash;
+    hash.update(data, size);
+    return hash.finalize();
+}
+
 }
 
 
@@ -125,6 +125,39 @@ namespace Slang
         uint8_t m_buf[64];
     };
 
+    /// 128-bit MurmurHash3 (x64 variant) generator implementing
+    /// https://github.com/aappleby/smhasher/blob/master/src/MurmurHash3.cpp
+    ///
+    /// This is not a cryptographic hash, but it is several times faster than MD5 or SHA1, so
+    /// is suited to digests of contents that are only used to detect changes, such as the
+    /// digests of source files that go into cache keys. Each 16 byte block is mixed into two
+    /// independent 64-bit lanes.
+    class MurmurHash3
+    {
+    public:
+        using Digest = HashDigest<16>;
+
+        MurmurHash3();
+
+        void init();
+        void update(const void* data, SlangInt size);
+        Digest finalize();
+
+        static Digest compute(const void* data, SlangInt size);
+
+    private:
+        void processBlock(const uint8_t* ptr);
+
+        uint64_t m_h1, m_h2;
+        uint64_t m_length;
+        uint32_t m_index;
+        uint8_t m_buf[16];
+    };
+
+    /// The hash used for digests of contents (such as source files) that are only used to
+    /// detect if the contents have changed.
+    using ContentHash = MurmurHash3;
+
     // Helper class for building hashes.
     template<typename Hash>
     struct DigestBuilder
@@ -4,7 +4,7 @@
 #include "slang-list.h"
 #include "slang-linked-list.h"
 #include "slang-common.h"
-#include "slang-uint-set.h"
+#include "slang-flat-hash-control.h"
 #include "slang-exception.h"
 #include "slang-math.h"
 #include "slang-hash.h"
@@ -83,16 +83,10 @@ namespace Slang
     public:
         typedef TValue ValueType;
         typedef TKey KeyType;
-	private:
-		inline int GetProbeOffset(int /*probeId*/) const
-		{
-			// linear probing
-			return 1;
-		}
 	private:
 		int bucketSizeMinusOne;
 		int _count;
-		UIntSet marks;
+		FlatHashControl controls;			///< Holds if each slot is empty, deleted or full (and 7 bits of the hash if full)
 		KeyValuePair<TKey, TValue>* hashMap;
 		void Free()
 		{
@@ -100,87 +94,48 @@ namespace Slang
 				delete[] hashMap;
 			hashMap = 0;
 		}
-		inline bool IsDeleted(int pos) const
-		{
-			return marks.contains((pos << 1) + 1);
-		}
-		inline bool IsEmpty(int pos) const
-		{
-			return !marks.contains((pos << 1));
-		}
-		inline void SetDeleted(int pos, bool val)
-		{
-			if (val)
-				marks.add((pos << 1) + 1);
-			else
-				marks.remove((pos << 1) + 1);
-		}
-		inline void SetEmpty(int pos, bool val)
-		{
-			if (val)
-				marks.remove((pos << 1));
-			else
-				marks.add((pos << 1));
-		}
 		struct FindPositionResult
 		{
 			int ObjectPosition;
 			int InsertionPosition;
+			FlatHashControl::Control H2;
 			FindPositionResult()
 			{
 				ObjectPosition = -1;
 				InsertionPosition = -1;
+				H2 = 0;
 			}
-			FindPositionResult(int objPos, int insertPos)
+			FindPositionResult(int objPos, int insertPos, FlatHashControl::Control h2)
 			{
 				ObjectPosition = objPos;
 				InsertionPosition = insertPos;
+				H2 = h2;
 			}
 
 		};
         template<typename KeyType>
-		inline int GetHashPos(KeyType& key) const
+		inline uint32_t GetMixedHash(KeyType& key) const
         {
-            SLANG_ASSERT(bucketSizeMinusOne > 0);
             const unsigned int hash = (unsigned int)getHashCode(key);
-            return (hash * 2654435761u) % (unsigned int)(bucketSizeMinusOne);
+            return hash * 2654435761u;
 		}
         template<typename KeyType>
 		FindPositionResult FindPosition(const KeyType& key) const
 		{
-			int hashPos = GetHashPos(const_cast<KeyType&>(key));
-			int insertPos = -1;
-			int numProbes = 0;
-			while (numProbes <= bucketSizeMinusOne)
-			{
-				if (IsEmpty(hashPos))
-				{
-					if (insertPos == -1)
-						return FindPositionResult(-1, hashPos);
-					else
-						return FindPositionResult(-1, insertPos);
-				}
-				else if (IsDeleted(hashPos))
-				{
-					if (insertPos == -1)
-						insertPos = hashPos;
-				}
-				else if (hashMap[hashPos].Key == key)
-				{
-					return FindPositionResult(hashPos, -1);
-				}
-				numProbes++;
-				hashPos = (hashPos + GetProbeOffset(numProbes)) & bucketSizeMinusOne;
-			}
-			if (insertPos != -1)
-				return FindPositionResult(-1, insertPos);
-			SLANG_ASSERT_FAILURE("Hash map is full. This indicates an error in Key::Equal or Key::getHashCode.");
+            SLANG_ASSERT(bucketSizeMinusOne > 0);
+			const uint32_t mixedHash = GetMixedHash(const_cast<KeyType&>(key));
+			const int hashPos = int(mixedHash % (unsigned int)(bucketSizeMinusOne));
+			const auto h2 = FlatHashControl::calcH2(mixedHash);
+
+			const auto result = controls.find(hashPos, h2, [&](int pos) { return hashMap[pos].Key == key; });
+			if (result.objectPosition == -1 && result.insertionPosition == -1)
+				SLANG_ASSERT_FAILURE("Hash map is full. This indicates an error in Key::Equal or Key::getHashCode.");
+			return FindPositionResult(result.objectPosition, result.insertionPosition, h2);
 		}
-		TValue & _Insert(KeyValuePair<TKey, TValue>&& kvPair, int pos)
+		TValue & _Insert(KeyValuePair<TKey, TValue>&& kvPair, int pos, FlatHashControl::Control h2)
 		{
 			hashMap[pos] = _Move(kvPair);
-			SetEmpty(pos, false);
-			SetDeleted(pos, false);
+			controls.setFull(pos, h2);
 			return hashMap[pos].Value;
 		}
 		void Rehash()
@@ -195,7 +150,7 @@ namespace Slang
 				Dictionary<TKey, TValue> newDict;
 				newDict.bucketSizeMinusOne = newSize - 1;
 				newDict.hashMap = new KeyValuePair<TKey, TValue>[newSize];
-				newDict.marks.resizeAndClear(newSize * 2);
+				newDict.controls.resizeAndClear(newSize);
 				if (hashMap)
 				{
 					for (auto & kvPair : *this)
@@ -216,7 +171,7 @@ namespace Slang
 			else if (pos.InsertionPosition != -1)
 			{
 				_count++;
-				_Insert(_Move(kvPair), pos.InsertionPosition);
+				_Insert(_Move(kvPair), pos.InsertionPosition, pos.H2);
 				return true;
 			}
 			else
@@ -232,11 +187,11 @@ namespace Slang
 			Rehash();
 			auto pos = FindPosition(kvPair.Key);
 			if (pos.ObjectPosition != -1)
-				return _Insert(_Move(kvPair), pos.ObjectPosition);
+				return _Insert(_Move(kvPair), pos.ObjectPosition, pos.H2);
 			else if (pos.InsertionPosition != -1)
 			{
 				_count++;
-				return _Insert(_Move(kvPair), pos.InsertionPosition);
+				return _Insert(_Move(kvPair), pos.InsertionPosition, pos.H2);
 			}
 			else
                 SLANG_ASSERT_FAILURE("Inconsistent find result returned. This is a bug in Dictionary implementation.");
@@ -260,11 +215,7 @@ namespace Slang
 			{
 				if (pos > dict->bucketSizeMinusOne)
 					return *this;
-				pos++;
-				while (pos <= dict->bucketSizeMinusOne && (dict->IsDeleted(pos) || dict->IsEmpty(pos)))
-				{
-					pos++;
-				}
+				pos = dict->controls.findNextFull(pos + 1);
 				return *this;
 			}
 			Iterator operator ++(int)
@@ -295,15 +246,7 @@ namespace Slang
 
 		Iterator begin() const
 		{
-			int pos = 0;
-			while (pos < bucketSizeMinusOne + 1)
-			{
-				if (IsEmpty(pos) || IsDeleted(pos))
-					pos++;
-				else
-					break;
-			}
-			return Iterator(this, pos);
+			return Iterator(this, controls.findNextFull(0));
 		}
 		Iterator end() const
 		{
@@ -333,7 +276,7 @@ namespace Slang
 			auto pos = FindPosition(key);
 			if (pos.ObjectPosition != -1)
 			{
-				SetDeleted(pos.ObjectPosition, true);
+				controls.setRemoved(pos.ObjectPosition);
 				_count--;
 			}
 		}
@@ -341,7 +284,7 @@ namespace Slang
 		{
 			_count = 0;
 
-			marks.clear();
+			controls.clear();
 		}
 
         TValue* TryGetValueOrAdd(const TKey& key, const TValue& value)
@@ -357,7 +300,7 @@ namespace Slang
                 // Make pair
                 KeyValuePair<TKey, TValue> kvPair(_Move(key), _Move(value));
                 _count++;
-                _Insert(_Move(kvPair), pos.InsertionPosition);
+                _Insert(_Move(kvPair), pos.InsertionPosition, pos.H2);
                 return nullptr;
             }
             else
@@ -379,7 +322,7 @@ namespace Slang
                 // Make pair
                 KeyValuePair<TKey, TValue> kvPair(_Move(key), _Move(defaultValue));
                 _count++;
-                return _Insert(_Move(kvPair), pos.InsertionPosition);
+                return _Insert(_Move(kvPair), pos.InsertionPosition, pos.H2);
             }
             else
                 SLANG_ASSERT_FAILURE("Inconsistent find result returned. This is a bug in Dictionary implementation.");
@@ -518,7 +461,7 @@ namespace Slang
 			bucketSizeMinusOne = other.bucketSizeMinusOne;
 			_count = other._count;
 			hashMap = new KeyValuePair<TKey, TValue>[other.bucketSizeMinusOne + 1];
-			marks = other.marks;
+			controls = other.controls;
 			for (int i = 0; i <= bucketSizeMinusOne; i++)
 				hashMap[i] = other.hashMap[i];
 			return *this;
@@ -531,7 +474,7 @@ namespace Slang
 			bucketSizeMinusOne = other.bucketSizeMinusOne;
 			_count = other._count;
 			hashMap = other.hashMap;
-			marks = _Move(other.marks);
+			controls = _Move(other.controls);
 			other.hashMap = 0;
 			other._count = 0;
 			other.bucketSizeMinusOne = -1;
@@ -667,17 +610,10 @@ namespace Slang
         friend class Iterator;
         friend class ItemProxy;
 
-    private:
-        inline int GetProbeOffset(int /*probeIdx*/) const
-        {
-            // quadratic probing
-            return 1;
-        }
-
     private:
         int bucketSizeMinusOne;
         int _count;
-        UIntSet marks;
+        FlatHashControl controls;
 
         LinkedList<KeyValuePair<TKey, TValue>> kvPairs;
         LinkedNode<KeyValuePair<TKey, TValue>>** hashMap;
@@ -688,79 +624,46 @@ namespace Slang
             hashMap = 0;
             kvPairs.Clear();
         }
-        inline bool IsDeleted(int pos) const { return marks.contains((pos << 1) + 1); }
-        inline bool IsEmpty(int pos) const { return !marks.contains((pos << 1)); }
-        inline void SetDeleted(int pos, bool val)
-        {
-            if (val)
-                marks.add((pos << 1) + 1);
-            else
-                marks.remove((pos << 1) + 1);
-        }
-        inline void SetEmpty(int pos, bool val)
-        {
-            if (val)
-                marks.remove((pos << 1));
-            else
-                marks.add((pos << 1));
-        }
         struct FindPositionResult
         {
             int ObjectPosition;
             int InsertionPosition;
+            FlatHashControl::Control H2;
             FindPositionResult()
             {
                 ObjectPosition = -1;
                 InsertionPosition = -1;
+                H2 = 0;
             }
-            FindPositionResult(int objPos, int insertPos)
+            FindPositionResult(int objPos, int insertPos, FlatHashControl::Control h2)
             {
                 ObjectPosition = objPos;
                 InsertionPosition = insertPos;
+                H2 = h2;
             }
         };
-        template <typename T> inline int GetHashPos(T& key) const
+        template <typename T> inline uint32_t GetMixedHash(T& key) const
         {
             const unsigned int hash = (unsigned int)getHashCode(key);
-            return ((unsigned int)(hash * 2654435761)) % bucketSizeMinusOne;
+            return (unsigned int)(hash * 2654435761u);
         }
         template <typename T> FindPositionResult FindPosition(const T& key) const
         {
-            int hashPos = GetHashPos((T&)key);
-            int insertPos = -1;
-            int numProbes = 0;
-            while (numProbes <= bucketSizeMinusOne)
-            {
-                if (IsEmpty(hashPos))
-                {
-                    if (insertPos == -1)
-                        return FindPositionResult(-1, hashPos);
-                    else
-                        return FindPositionResult(-1, insertPos);
-                }
-                else if (IsDeleted(hashPos))
-                {
-                    if (insertPos == -1)
-                        insertPos = hashPos;
-                }
-                else if (hashMap[hashPos]->Value.Key == key)
-                {
-                    return FindPositionResult(hashPos, -1);
-                }
-                numProbes++;
-                hashPos = (hashPos + GetProbeOffset(numProbes)) & bucketSizeMinusOne;
-            }
-            if (insertPos != -1)
-                return FindPositionResult(-1, insertPos);
-            SLANG_ASSERT_FAILURE("Hash map is full. This indicates an error in Key::Equal or Key::GetHashCode.");
+            const uint32_t mixedHash = GetMixedHash((T&)key);
+            const int hashPos = int(mixedHash % (unsigned int)bucketSizeMinusOne);
+            const auto h2 = FlatHashControl::calcH2(mixedHash);
+
+            const auto result = controls.find(hashPos, h2, [&](int pos) { return hashMap[pos]->Value.Key == key; });
+            if (result.objectPosition == -1 && result.insertionPosition == -1)
+                SLANG_ASSERT_FAILURE("Hash map is full. This indicates an error in Key::Equal or Key::GetHashCode.");
+            return FindPositionResult(result.objectPosition, result.insertionPosition, h2);
         }
-        TValue& _Insert(KeyValuePair<TKey, TValue>&& kvPair, int pos)
+        TValue& _Insert(KeyValuePair<TKey, TValue>&& kvPair, int pos, FlatHashControl::Control h2)
         {
             auto node = kvPairs.AddLast();
             node->Value = _Move(kvPair);
             hashMap[pos] = node;
-            SetEmpty(pos, false);
-            SetDeleted(pos, false);
+            controls.setFull(pos, h2);
             return node->Value.Value;
         }
         void Rehash()
@@ -775,7 +678,7 @@ namespace Slang
                 OrderedDictionary<TKey, TValue> newDict;
                 newDict.bucketSizeMinusOne = newSize - 1;
                 newDict.hashMap = new LinkedNode<KeyValuePair<TKey, TValue>>*[newSize];
-                newDict.marks.resizeAndClear(newSize * 2);
+                newDict.controls.resizeAndClear(newSize);
                 if (hashMap)
                 {
                     for (auto& kvPair : *this)
@@ -796,7 +699,7 @@ namespace Slang
             else if (pos.InsertionPosition != -1)
             {
                 _count++;
-                _Insert(_Move(kvPair), pos.InsertionPosition);
+                _Insert(_Move(kvPair), pos.InsertionPosition, pos.H2);
                 return true;
             }
             else
@@ -814,12 +717,12 @@ namespace Slang
             if (pos.ObjectPosition != -1)
             {
                 hashMap[pos.ObjectPosition]->Delete();
-                return _Insert(_Move(kvPair), pos.ObjectPosition);
+                return _Insert(_Move(kvPair), pos.ObjectPosition, pos.H2);
             }
             else if (pos.InsertionPosition != -1)
             {
                 _count++;
-                return _Insert(_Move(kvPair), pos.InsertionPosition);
+                return _Insert(_Move(kvPair), pos.InsertionPosition, pos.H2);
             }
             else
                 SLANG_ASSERT_FAILURE("Inconsistent find result returned. This is a bug in Dictionary implementation.");
@@ -863,7 +766,7 @@ namespace Slang
                 {
                     kvPairs.Delete(hashMap[pos.ObjectPosition]);
                     hashMap[pos.ObjectPosition] = 0;
-                    SetDeleted(pos.ObjectPosition, true);
+                    controls.setRemoved(pos.ObjectPosition);
                     _count--;
                 }
             }
@@ -872,7 +775,7 @@ namespace Slang
         {
             _count = 0;
             kvPairs.Clear();
-            marks.clear();
+            controls.clear();
         }
         template <typename T> bool ContainsKey(const T& key) const
         {
@@ -1004,7 +907,7 @@ namespace Slang
             bucketSizeMinusOne = other.bucketSizeMinusOne;
             _count = other._count;
             hashMap = other.hashMap;
-            marks = _Move(other.marks);
+            controls = _Move(other.controls);
             other.hashMap = 0;
             other._count = 0;
             other.bucketSizeMinusOne = -1;
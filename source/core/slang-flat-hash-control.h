@@ -0,0 +1,328 @@
+#ifndef SLANG_CORE_FLAT_HASH_CONTROL_H
+#define SLANG_CORE_FLAT_HASH_CONTROL_H
+
+#include "slang-common.h"
+
+#include <string.h>
+
+#if defined(__SSE2__) || (SLANG_VC && (SLANG_PROCESSOR_X86_64 || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)))
+#   define SLANG_FLAT_HASH_SSE2 1
+#   include <emmintrin.h>
+#elif defined(__ARM_NEON) || (SLANG_VC && SLANG_PROCESSOR_ARM_64)
+#   define SLANG_FLAT_HASH_NEON 1
+#   include <arm_neon.h>
+#endif
+
+#if SLANG_VC
+#   include <intrin.h>
+#endif
+
+namespace Slang
+{
+
+/* Holds the per slot 'control bytes' of an open addressing hash table, and implements probing
+for the table.
+
+Each slot has a single control byte which is either
+
+* kEmpty - the slot has never held a value (or can be treated as such)
+* kDeleted - the slot held a value that was removed (a 'tombstone')
+* 0 - 127 - the slot holds a value, and the byte holds 7 bits of the value's hash (the 'h2')
+
+Keeping the control bytes in a single array means a probe normally only touches the control
+bytes (a whole group of them at a time, using SSE2 or NEON where available) and only reads
+the key of a slot when the h2 matches, instead of touching the key array and a separate
+empty/deleted bitset for every slot visited.
+
+The probe sequence is linear, starting at a position determined by the table, so the
+placement of values (and so the iteration order over slots) is the same as a plain linear
+probing table with tombstones. To allow unaligned group loads near the end of the array,
+the first kGroupWidth - 1 control bytes are mirrored after the last slot. */
+class FlatHashControl
+{
+public:
+    typedef uint8_t Control;
+
+    static const Control kEmpty = 0x80;
+    static const Control kDeleted = 0xfe;
+
+        /// The result of a find. If the key is found objectPosition is the slot, else -1.
+        /// If the key is not found insertionPosition is where it should be inserted, else -1.
+    struct FindResult
+    {
+        int objectPosition;
+        int insertionPosition;
+    };
+
+#if SLANG_FLAT_HASH_SSE2 || SLANG_FLAT_HASH_NEON
+    static const int kGroupWidth = 16;
+#else
+    static const int kGroupWidth = 8;
+#endif
+
+        /// Returns the h2 (the 7 bits of the hash held in the control byte) from a (mixed) hash
+    SLANG_FORCE_INLINE static Control calcH2(uint32_t mixedHash) { return Control(mixedHash >> 25); }
+
+        /// The number of slots. Is always 0 or a power of 2.
+    int getCapacity() const { return m_capacity; }
+
+        /// True if the slot holds a value
+    SLANG_FORCE_INLINE bool isFull(int pos) const { return (m_controls[pos] & 0x80) == 0; }
+
+        /// Mark the slot at pos as holding a value with h2
+    SLANG_FORCE_INLINE void setFull(int pos, Control h2) { _set(pos, h2); }
+
+        /// Mark the slot at pos as no longer holding a value.
+        /// If the next slot is empty no probe sequence can pass through pos, so the slot can
+        /// be made empty instead of leaving a tombstone.
+    void setRemoved(int pos)
+    {
+        const int next = (pos + 1) & (m_capacity - 1);
+        _set(pos, (m_controls[next] == kEmpty) ? kEmpty : kDeleted);
+    }
+
+        /// Returns the index of the first slot at or after pos that holds a value, or the capacity if there isn't one.
+    int findNextFull(int pos) const
+    {
+        while (pos < m_capacity && !isFull(pos))
+        {
+            pos++;
+        }
+        return pos;
+    }
+
+        /// Find a key. Probing starts at startPos. isMatch(pos) is called to check the key of a full
+        /// slot that has a matching h2.
+        /// If the key is not found the insertion position is the first empty or deleted slot seen
+        /// before the probe sequence reached an empty slot.
+    template <typename IsMatchFunc>
+    SLANG_FORCE_INLINE FindResult find(int startPos, Control h2, const IsMatchFunc& isMatch) const
+    {
+        const int mask = m_capacity - 1;
+        int insertPos = -1;
+        int pos = startPos;
+
+        for (int probeCount = 0; probeCount < m_capacity; probeCount += kGroupWidth)
+        {
+            const Group group(m_controls + pos);
+
+            // Lanes past the end of the probe sequence (when the table is smaller than a
+            // group, or the probe has wrapped around) are ignored.
+            const int remaining = m_capacity - probeCount;
+            const BitMask::Bits laneMask = (remaining < kGroupWidth) ? BitMask::calcLowLanes(remaining) : ~BitMask::Bits(0);
+
+            const BitMask::Bits emptyBits = group.matchEmpty().bits & laneMask;
+            // Only slots before the first empty slot are part of the probe sequence
+            const BitMask::Bits searchMask = laneMask & (emptyBits ? ((emptyBits & (~emptyBits + 1)) - 1) : ~BitMask::Bits(0));
+
+            for (BitMask match(group.matchH2(h2).bits & searchMask); match.bits; match.removeLowest())
+            {
+                const int matchPos = (pos + match.getLowestIndex()) & mask;
+                if (isMatch(matchPos))
+                {
+                    return FindResult{ matchPos, -1 };
+                }
+            }
+
+            if (insertPos < 0)
+            {
+                const BitMask deleted(group.matchDeleted().bits & searchMask);
+                if (deleted.bits)
+                {
+                    insertPos = (pos + deleted.getLowestIndex()) & mask;
+                }
+            }
+
+            if (emptyBits)
+            {
+                return FindResult{ -1, insertPos >= 0 ? insertPos : ((pos + BitMask(emptyBits).getLowestIndex()) & mask) };
+            }
+
+            pos = (pos + kGroupWidth) & mask;
+        }
+        return FindResult{ -1, insertPos };
+    }
+
+        /// Set all slots to empty
+    void clear()
+    {
+        if (m_controls)
+        {
+            ::memset(m_controls, kEmpty, _getControlCount(m_capacity));
+        }
+    }
+
+        /// Set the capacity (must be a power of 2, or 0). All slots are set to empty.
+    void resizeAndClear(int capacity)
+    {
+        SLANG_ASSERT((capacity & (capacity - 1)) == 0);
+        if (capacity != m_capacity)
+        {
+            _free();
+            m_capacity = capacity;
+            m_controls = capacity ? new Control[_getControlCount(capacity)] : nullptr;
+        }
+        clear();
+    }
+
+    void swapWith(FlatHashControl& rhs)
+    {
+        Swap(m_controls, rhs.m_controls);
+        Swap(m_capacity, rhs.m_capacity);
+    }
+
+    FlatHashControl& operator=(const FlatHashControl& rhs)
+    {
+        if (this != &rhs)
+        {
+            resizeAndClear(rhs.m_capacity);
+            if (m_controls)
+            {
+                ::memcpy(m_controls, rhs.m_controls, _getControlCount(m_capacity));
+            }
+        }
+        return *this;
+    }
+    FlatHashControl& operator=(FlatHashControl&& rhs)
+    {
+        if (this != &rhs)
+        {
+            _free();
+            swapWith(rhs);
+        }
+        return *this;
+    }
+
+    FlatHashControl() {}
+    FlatHashControl(const FlatHashControl& rhs) { *this = rhs; }
+    FlatHashControl(FlatHashControl&& rhs) { swapWith(rhs); }
+    ~FlatHashControl() { _free(); }
+
+protected:
+        /// A mask with a bit set (or for NEON a nibble) for each lane of a group that matched.
+    struct BitMask
+    {
+        typedef uint64_t Bits;
+
+#if SLANG_FLAT_HASH_SSE2
+        static const int kShift = 0;
+#elif SLANG_FLAT_HASH_NEON
+        static const int kShift = 2;
+#else
+        static const int kShift = 3;
+#endif
+            /// Bits for the lanes [0, count). count must be less than kGroupWidth.
+        SLANG_FORCE_INLINE static Bits calcLowLanes(int count) { return (Bits(1) << (count << kShift)) - 1; }
+
+        SLANG_FORCE_INLINE int getLowestIndex() const { return _calcTrailingZeros(bits) >> kShift; }
+        SLANG_FORCE_INLINE void removeLowest() { bits &= bits - 1; }
+
+        SLANG_FORCE_INLINE explicit BitMask(Bits inBits) : bits(inBits) {}
+
+        Bits bits;
+    };
+
+        /// A group of kGroupWidth control bytes, loaded from any (unaligned) position
+    struct Group
+    {
+#if SLANG_FLAT_HASH_SSE2
+        SLANG_FORCE_INLINE explicit Group(const Control* pos) : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos))) {}
+
+        SLANG_FORCE_INLINE BitMask matchH2(Control h2) const { return _toMask(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(char(h2)))); }
+        SLANG_FORCE_INLINE BitMask matchEmpty() const { return _toMask(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(char(kEmpty)))); }
+        SLANG_FORCE_INLINE BitMask matchDeleted() const { return _toMask(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(char(kDeleted)))); }
+
+        SLANG_FORCE_INLINE static BitMask _toMask(__m128i v) { return BitMask(BitMask::Bits(uint32_t(_mm_movemask_epi8(v)))); }
+
+        __m128i ctrl;
+#elif SLANG_FLAT_HASH_NEON
+        SLANG_FORCE_INLINE explicit Group(const Control* pos) : ctrl(vld1q_u8(pos)) {}
+
+        SLANG_FORCE_INLINE BitMask matchH2(Control h2) const { return _toMask(vceqq_u8(ctrl, vdupq_n_u8(h2))); }
+        SLANG_FORCE_INLINE BitMask matchEmpty() const { return _toMask(vceqq_u8(ctrl, vdupq_n_u8(kEmpty))); }
+        SLANG_FORCE_INLINE BitMask matchDeleted() const { return _toMask(vceqq_u8(ctrl, vdupq_n_u8(kDeleted))); }
+
+        // Narrow each 0x00/0xff lane to a nibble, and keep a single bit per lane
+        SLANG_FORCE_INLINE static BitMask _toMask(uint8x16_t v)
+        {
+            const uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(v), 4);
+            return BitMask(vget_lane_u64(vreinterpret_u64_u8(narrowed), 0) & 0x8888888888888888ull);
+        }
+
+        uint8x16_t ctrl;
+#else
+        // Portable fallback, works on 8 control bytes held in a (little endian ordered) 64 bit word
+        SLANG_FORCE_INLINE explicit Group(const Control* pos)
+        {
+            ctrl = 0;
+            for (int i = 0; i < kGroupWidth; ++i)
+            {
+                ctrl |= uint64_t(pos[i]) << (i * 8);
+            }
+        }
+
+        SLANG_FORCE_INLINE BitMask matchH2(Control h2) const
+        {
+            // Can produce false positives, which is fine as the keys are compared
+            const uint64_t x = ctrl ^ (kLsbs * h2);
+            return BitMask((x - kLsbs) & ~x & kMsbs);
+        }
+        // Empty has the top bit set and bit 1 clear, deleted has both set. Full slots never have the top bit set.
+        SLANG_FORCE_INLINE BitMask matchEmpty() const { return BitMask(ctrl & ~(ctrl << 6) & kMsbs); }
+        SLANG_FORCE_INLINE BitMask matchDeleted() const { return BitMask(ctrl & (ctrl << 6) & kMsbs); }
+
+        static const uint64_t kLsbs = 0x0101010101010101ull;
+        static const uint64_t kMsbs = 0x8080808080808080ull;
+
+        uint64_t ctrl;
+#endif
+    };
+
+    SLANG_FORCE_INLINE static int _calcTrailingZeros(uint64_t v)
+    {
+        SLANG_ASSERT(v);
+#if SLANG_VC
+#   if SLANG_PTR_IS_64
+        unsigned long index;
+        _BitScanForward64(&index, v);
+        return int(index);
+#   else
+        unsigned long index;
+        if (_BitScanForward(&index, uint32_t(v)))
+        {
+            return int(index);
+        }
+        _BitScanForward(&index, uint32_t(v >> 32));
+        return int(index) + 32;
+#   endif
+#else
+        return __builtin_ctzll(v);
+#endif
+    }
+
+    static size_t _getControlCount(int capacity) { return size_t(capacity) + kGroupWidth - 1; }
+
+    SLANG_FORCE_INLINE void _set(int pos, Control control)
+    {
+        m_controls[pos] = control;
+        // Mirror the start of the array after the end, so group loads never have to wrap
+        if (pos < kGroupWidth - 1)
+        {
+            m_controls[m_capacity + pos] = control;
+        }
+    }
+
+    void _free()
+    {
+        delete[] m_controls;
+        m_controls = nullptr;
+        m_capacity = 0;
+    }
+
+    Control* m_controls = nullptr;
+    int m_capacity = 0;
+};
+
+}
+
+#endif
@@ -30,6 +30,9 @@
 #   include <dirent.h>
 #   include <sys/stat.h>
 #   include <sys/file.h>
+// For File::mapReadOnly
+#   include <fcntl.h>
+#   include <sys/mman.h>
 #endif
 
 #if SLANG_APPLE_FAMILY
@@ -973,6 +976,124 @@ namespace Slang
         return (sizeInBytes == readSizeInBytes) ? SLANG_OK : SLANG_FAIL;
     }
 
+    namespace { // anonymous
+
+    /* A blob that holds a read only memory mapping of a file. The mapping is released when the blob is destroyed. */
+    class MappedFileBlob : public BlobBase
+    {
+    public:
+        // ISlangBlob
+        SLANG_NO_THROW void const* SLANG_MCALL getBufferPointer() SLANG_OVERRIDE { return m_data; }
+        SLANG_NO_THROW size_t SLANG_MCALL getBufferSize() SLANG_OVERRIDE { return m_sizeInBytes; }
+
+        SlangResult init(const String& path);
+
+        ~MappedFileBlob();
+
+    protected:
+        const void* m_data = nullptr;
+        size_t m_sizeInBytes = 0;
+#ifdef _WIN32
+        HANDLE m_fileHandle = INVALID_HANDLE_VALUE;
+        HANDLE m_mappingHandle = nullptr;
+#endif
+    };
+
+    SlangResult MappedFileBlob::init(const String& path)
+    {
+#ifdef _WIN32
+        m_fileHandle = CreateFileA(path.getBuffer(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (m_fileHandle == INVALID_HANDLE_VALUE)
+        {
+            return SLANG_E_NOT_FOUND;
+        }
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(m_fileHandle, &size) || size.QuadPart <= 0 || UInt64(size.QuadPart) > UInt64(~size_t(0)))
+        {
+            return SLANG_FAIL;
+        }
+
+        m_mappingHandle = CreateFileMappingA(m_fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!m_mappingHandle)
+        {
+            return SLANG_FAIL;
+        }
+
+        m_data = MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0);
+        if (!m_data)
+        {
+            return SLANG_FAIL;
+        }
+        m_sizeInBytes = size_t(size.QuadPart);
+        return SLANG_OK;
+#elif defined(__linux__) || defined(__CYGWIN__) || SLANG_APPLE_FAMILY
+        const int fd = ::open(path.getBuffer(), O_RDONLY);
+        if (fd < 0)
+        {
+            return SLANG_E_NOT_FOUND;
+        }
+
+        struct stat fileStat;
+        if (::fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0 || UInt64(fileStat.st_size) > UInt64(~size_t(0)))
+        {
+            ::close(fd);
+            return SLANG_FAIL;
+        }
+
+        const size_t sizeInBytes = size_t(fileStat.st_size);
+        void* data = ::mmap(nullptr, sizeInBytes, PROT_READ, MAP_PRIVATE, fd, 0);
+        // The mapping stays valid after the file is closed
+        ::close(fd);
+
+        if (data == MAP_FAILED)
+        {
+            return SLANG_FAIL;
+        }
+
+        m_data = data;
+        m_sizeInBytes = sizeInBytes;
+        return SLANG_OK;
+#else
+        SLANG_UNUSED(path);
+        return SLANG_E_NOT_IMPLEMENTED;
+#endif
+    }
+
+    MappedFileBlob::~MappedFileBlob()
+    {
+#ifdef _WIN32
+        if (m_data)
+        {
+            UnmapViewOfFile(m_data);
+        }
+        if (m_mappingHandle)
+        {
+            CloseHandle(m_mappingHandle);
+        }
+        if (m_fileHandle != INVALID_HANDLE_VALUE)
+        {
+            CloseHandle(m_fileHandle);
+        }
+#elif defined(__linux__) || defined(__CYGWIN__) || SLANG_APPLE_FAMILY
+        if (m_data)
+        {
+            ::munmap(const_cast<void*>(m_data), m_sizeInBytes);
+        }
+#endif
+    }
+
+    } // anonymous
+
+    SlangResult File::mapReadOnly(const String& path, ComPtr<ISlangBlob>& outBlob)
+    {
+        MappedFileBlob* blob = new MappedFileBlob;
+        ComPtr<ISlangBlob> scopeBlob(blob);
+        SLANG_RETURN_ON_FAIL(blob->init(path));
+        outBlob.swap(scopeBlob);
+        return SLANG_OK;
+    }
+
     SlangResult File::writeAllBytes(const String& path, const void* data, size_t size)
     {
         FileStream stream;
@@ -19,6 +19,10 @@ namespace Slang
         static SlangResult readAllBytes(const String& fileName, List<unsigned char>& out);
         static SlangResult readAllBytes(const String& fileName, ScopedAllocation& out);
 
+            /// Memory map the file read only. Pages are only read when touched, and the mapping is held
+            /// until the blob is released. Fails for empty files, or if mapping isn't supported on the platform.
+        static SlangResult mapReadOnly(const String& fileName, ComPtr<ISlangBlob>& outBlob);
+
         static SlangResult writeAllText(const String& fileName, const String& text);
 
             /// Write as text in native form for the target (so typically may change line endings )
@@ -8,6 +8,26 @@
 namespace Slang
 {
 
+struct CacheIndexHeader
+{
+    char magic[4];
+    uint32_t version;
+    // Number of records in the snapshot. The records of the log follow.
+    uint32_t count;
+    // Incremented each time the index is rewritten.
+    uint32_t generation;
+};
+
+static const char* kMagic = "SLS$";
+static const uint32_t kVersion = 2;
+
+// Records in the log hold the op in the low bits, and a tag in the high bits.
+static const uint32_t kLogRecordTagMask = 0xffffff00;
+static const uint32_t kLogRecordTag = 0x4c4f4700;
+
+// Minimum number of records in the log before it is compacted.
+static const uint32_t kMinCompactLogCount = 256;
+
 PersistentCache::PersistentCache(const Desc& desc)
 {
     m_cacheDirectory = Path::simplify(desc.directory);
@@ -63,6 +83,7 @@ SlangResult PersistentCache::clear()
     Visitor visitor(m_cacheDirectory, m_lockFileName);
     Path::find(m_cacheDirectory, nullptr, &visitor);
 
+    resetIndex();
     m_stats.entryCount = 0;
 
     return SLANG_OK;
@@ -85,34 +106,29 @@ SlangResult PersistentCache::readEntry(const Key& key, ISlangBlob** outData)
         return SLANG_E_CANNOT_OPEN;
     }
 
-    // Acquire the exclusive lock.
-    std::lock_guard<std::mutex> mutexLock(m_mutex);
-    LockFileGuard fileLock(m_lockFile);
-
-    // Return if index does not exist.
-    if (!File::exists(m_indexFileName))
+    bool shouldRecordUse = false;
     {
-        return SLANG_E_NOT_FOUND;
-    }
+        // Acquire the shared lock.
+        std::lock_guard<std::mutex> mutexLock(m_mutex);
+        LockFileGuard fileLock(m_lockFile, LockFile::LockType::Shared);
 
-    // Read the cache index.
-    CacheIndex cacheIndex;
-    SLANG_RETURN_ON_FAIL(readIndex(m_indexFileName, cacheIndex));
+        SLANG_RETURN_ON_FAIL(syncIndex());
 
-    // Increase the age of all entries in the cache.
-    for (auto& entry : cacheIndex)
-    {
-        ++entry.age;
-    }
+        // Find the entry.
+        uint32_t* lastUse = m_index.TryGetValue(key);
+        if (!lastUse)
+        {
+            return SLANG_E_NOT_FOUND;
+        }
 
-    // Find the entry.
-    Index entryIndex = cacheIndex.findFirstIndex([&key] (const CacheEntry& entry) { return entry.key == key; });
-    if (entryIndex == -1)
-    {
-        return SLANG_E_NOT_FOUND;
+        // Record the use of the entry, unless it was used recently enough that recording it
+        // makes no difference to which entries are evicted.
+        shouldRecordUse = !isRecentlyUsed(*lastUse);
     }
 
     // Read the entry.
+    // Entry files are only written or removed with the exclusive lock held, and an entry file
+    // that is in the index is never overwritten, so it can be read without holding the lock.
     String entryFileName = getEntryFileName(key);
     ScopedAllocation data;
     SlangResult result = File::readAllBytes(entryFileName, data);
@@ -120,18 +136,18 @@ SlangResult PersistentCache::readEntry(const Key& key, ISlangBlob** outData)
     {
         --m_stats.missCount;
         ++m_stats.hitCount;
-        cacheIndex[entryIndex].age = 0;
         auto blob = RawBlob::moveCreate(data);
         *outData = blob.detach();
-    }
-    else
-    {
-        cacheIndex.removeAt(entryIndex);
+
+        if (shouldRecordUse)
+        {
+            appendEntryRecord(RecordOp::Use, key);
+        }
+        return SLANG_OK;
     }
 
-    // Write the cache index.
-    SLANG_RETURN_ON_FAIL(writeIndex(m_indexFileName, cacheIndex));
-    m_stats.entryCount = (Count)cacheIndex.getCount();
+    // The entry file is missing, so remove the entry from the index.
+    appendEntryRecord(RecordOp::Remove, key);
 
     return result;
 }
@@ -149,55 +165,77 @@ SlangResult PersistentCache::writeEntry(const Key& key, ISlangBlob* data)
     std::lock_guard<std::mutex> mutexLock(m_mutex);
     LockFileGuard fileLock(m_lockFile);
 
-    // Read the cache index.
-    // We ignore any errors when reading the index and just write a new one.
-    CacheIndex cacheIndex;
-    readIndex(m_indexFileName, cacheIndex);
+    // Bring the index up to date.
+    // If the index can't be read, or ends in a partial record, a new one is written with what
+    // could be read of it.
+    bool hasPartialRecord = false;
+    bool shouldWriteIndex = SLANG_FAILED(syncIndex(&hasPartialRecord)) || hasPartialRecord;
 
-    // Increase the age of all entries in the cache and get the index of
-    // the oldest entry.
-    Index oldestEntryIndex = -1;
-    uint32_t oldestEntryAge = 0;
-    for (Index entryIndex = 0; entryIndex < cacheIndex.getCount(); ++entryIndex)
+    // Write the cache entry.
+    // Readers don't hold the lock while reading entry files, so don't overwrite an entry
+    // file that is in use.
+    String entryFileName = getEntryFileName(key);
+    const bool isNewEntry = !m_index.ContainsKey(key);
+    if (isNewEntry || !File::exists(entryFileName))
     {
-        auto& entry = cacheIndex[entryIndex];
-        ++entry.age;
-        if (entry.age > oldestEntryAge)
-        {
-            oldestEntryIndex = entryIndex;
-            oldestEntryAge = entry.age;
-        }
+        SLANG_RETURN_ON_FAIL(File::writeAllBytes(entryFileName, data->getBufferPointer(), data->getBufferSize()));
     }
 
-    // Write the cache entry.
-    String entryFileName = getEntryFileName(key);
-    SLANG_RETURN_ON_FAIL(File::writeAllBytes(entryFileName, data->getBufferPointer(), data->getBufferSize()));
+    // Update the index. As we hold the exclusive lock, no other records can be added to the
+    // log, so the records are applied directly.
+    List<IndexRecord> records;
+    auto addRecord = [&](RecordOp op, const Key& recordKey)
+    {
+        records.add(IndexRecord{ recordKey, kLogRecordTag | uint32_t(op) });
+        applyRecord(op, recordKey, m_nextSequence++);
+    };
 
-    // Update the index.
-    if (m_maxEntryCount > 0 && cacheIndex.getCount() >= m_maxEntryCount)
+    if (isNewEntry)
     {
-        // Replace oldest entry.
-        SLANG_ASSERT(oldestEntryIndex >= 0);
-        File::remove(getEntryFileName(cacheIndex[oldestEntryIndex].key));
-        cacheIndex[oldestEntryIndex] = CacheEntry{ key, 0 };
+        // Evict the least recently used entries to make space.
+        if (m_maxEntryCount > 0 && m_index.Count() >= m_maxEntryCount)
+        {
+            const List<IndexRecord> entriesByUse = getEntriesByUse();
+            const Count evictCount = m_index.Count() - m_maxEntryCount + 1;
+            for (Index i = 0; i < evictCount; ++i)
+            {
+                const Key& evictedKey = entriesByUse[i].key;
+                File::remove(getEntryFileName(evictedKey));
+                addRecord(RecordOp::Remove, evictedKey);
+            }
+        }
+        addRecord(RecordOp::Add, key);
     }
     else
     {
-        // Add new entry.
-        cacheIndex.add(CacheEntry{ key, 0 });
+        addRecord(RecordOp::Use, key);
     }
 
-    // Write the cache index.
-    SlangResult result = writeIndex(m_indexFileName, cacheIndex);
-    if (result == SLANG_OK)
+    // Compact the log into a new snapshot once it holds more records than the snapshot.
+    const uint32_t logCount = m_nextSequence - m_indexSnapshotCount;
+    shouldWriteIndex = shouldWriteIndex || logCount > Math::Max(kMinCompactLogCount, m_indexSnapshotCount);
+
+    SlangResult result = SLANG_OK;
+    if (!shouldWriteIndex)
     {
-        m_stats.entryCount = (Count)cacheIndex.getCount();
+        result = appendRecords(records.getBuffer(), records.getCount());
+        if (SLANG_SUCCEEDED(result))
+        {
+            m_indexReadOffset += Int64(records.getCount() * sizeof(IndexRecord));
+        }
     }
-    else
+    if (shouldWriteIndex || SLANG_FAILED(result))
+    {
+        result = writeIndex();
+    }
+
+    if (SLANG_FAILED(result))
     {
         // If writing the index failed, remove the entry file to avoid growing the cache.
         Path::remove(entryFileName);
+        resetIndex();
     }
+    m_stats.entryCount = m_index.Count();
 
     return result;
 }
@@ -209,15 +247,11 @@ SlangResult PersistentCache::initialize()
         return SLANG_E_CANNOT_OPEN;
     }
 
-    // Acquire the exclusive lock.
+    // Acquire the shared lock.
     std::lock_guard<std::mutex> mutexLock(m_mutex);
-    LockFileGuard fileLock(m_lockFile);
+    LockFileGuard fileLock(m_lockFile, LockFile::LockType::Shared);
 
-    CacheIndex cacheIndex;
-    if (SLANG_SUCCEEDED(readIndex(m_indexFileName, cacheIndex)))
-    {
-        m_stats.entryCount = (Count)cacheIndex.getCount();
-    }
+    syncIndex();
 
     return SLANG_OK;
 }
@@ -229,61 +263,241 @@ String PersistentCache::getEntryFileName(const Key& key)
     return str;
 }
 
-struct CacheIndexHeader
+void PersistentCache::resetIndex()
 {
-    char magic[4];
-    uint32_t version;
-    uint32_t count;
-    uint32_t reserved;
-};
-
-static const char* kMagic = "SLS$";
-static const uint32_t kVersion = 1;
+    // The generation is kept, so that a rewritten index gets a new generation.
+    m_index.Clear();
+    m_isIndexLoaded = false;
+    m_indexSnapshotCount = 0;
+    m_nextSequence = 0;
+    m_indexReadOffset = 0;
+}
 
-SlangResult PersistentCache::readIndex(const String& fileName, CacheIndex& outIndex)
+SlangResult PersistentCache::syncIndex(bool* outHasPartialRecord)
 {
+    if (outHasPartialRecord)
+    {
+        *outHasPartialRecord = false;
+    }
+
     FileStream fs;
-    SLANG_RETURN_ON_FAIL(fs.init(fileName, FileMode::Open));
+    if (SLANG_FAILED(fs.init(m_indexFileName, FileMode::Open, FileAccess::Read, FileShare::ReadWrite)))
+    {
+        resetIndex();
+        m_stats.entryCount = 0;
+        return SLANG_E_NOT_FOUND;
+    }
 
     // Get file size.
     SLANG_RETURN_ON_FAIL(fs.seek(SeekOrigin::End, 0));
-    size_t fileSize = (size_t)fs.getPosition();
+    const Int64 fileSize = fs.getPosition();
     SLANG_RETURN_ON_FAIL(fs.seek(SeekOrigin::Start, 0));
 
     CacheIndexHeader header;
-    SLANG_RETURN_ON_FAIL(fs.readExactly(&header, sizeof(header)));
-    if (::memcmp(header.magic, kMagic, 4) != 0 || header.version != kVersion)
+    if (SLANG_FAILED(fs.readExactly(&header, sizeof(header))) ||
+        ::memcmp(header.magic, kMagic, 4) != 0 ||
+        header.version != kVersion)
     {
+        resetIndex();
         return SLANG_E_INTERNAL_FAIL;
     }
 
-    // Return if payload does not have the right size.
-    if (header.count * sizeof(CacheEntry) != fileSize - sizeof(header))
+    // Reload the whole index if it was rewritten since it was loaded.
+    if (!m_isIndexLoaded ||
+        header.generation != m_indexGeneration ||
+        header.count != m_indexSnapshotCount ||
+        fileSize < m_indexReadOffset)
     {
-        return SLANG_E_INTERNAL_FAIL;
+        resetIndex();
+
+        // Return if the snapshot does not fit in the file.
+        const Int64 snapshotSize = Int64(header.count) * Int64(sizeof(IndexRecord));
+        if (snapshotSize > fileSize - Int64(sizeof(header)))
+        {
+            return SLANG_E_INTERNAL_FAIL;
+        }
+
+        List<IndexRecord> snapshot;
+        snapshot.setCount(header.count);
+        SLANG_RETURN_ON_FAIL(fs.readExactly(snapshot.getBuffer(), size_t(snapshotSize)));
+        for (const auto& record : snapshot)
+        {
+            if (record.value >= header.count)
+            {
+                resetIndex();
+                return SLANG_E_INTERNAL_FAIL;
+            }
+            m_index[record.key] = record.value;
+        }
+
+        m_isIndexLoaded = true;
+        m_indexGeneration = header.generation;
+        m_indexSnapshotCount = header.count;
+        m_nextSequence = header.count;
+        m_indexReadOffset = Int64(sizeof(header)) + snapshotSize;
+    }
+    else
+    {
+        SLANG_RETURN_ON_FAIL(fs.seek(SeekOrigin::Start, m_indexReadOffset));
     }
 
-    outIndex.setCount(header.count);
-    SLANG_RETURN_ON_FAIL(fs.readExactly(outIndex.getBuffer(), header.count * sizeof(CacheEntry)));
-    
+    // Apply the records added to the log since the last sync.
+    // Records are only appended with the exclusive lock held, so a partial record at the end was
+    // left by an append that failed. The log is read up to the last complete record, and the
+    // next write rewrites the index.
+    const Int64 logSize = fileSize - m_indexReadOffset;
+    const Count logCount = Count(logSize / Int64(sizeof(IndexRecord)));
+
+    List<IndexRecord> log;
+    log.setCount(logCount);
+    SLANG_RETURN_ON_FAIL(fs.readExactly(log.getBuffer(), size_t(logCount * sizeof(IndexRecord))));
+    for (const auto& record : log)
+    {
+        const uint32_t op = record.value & ~kLogRecordTagMask;
+        if ((record.value & kLogRecordTagMask) != kLogRecordTag ||
+            op < uint32_t(RecordOp::Add) ||
+            op > uint32_t(RecordOp::Remove))
+        {
+            resetIndex();
+            return SLANG_E_INTERNAL_FAIL;
+        }
+        applyRecord(RecordOp(op), record.key, m_nextSequence++);
+    }
+    m_indexReadOffset += Int64(logCount * sizeof(IndexRecord));
+    m_stats.entryCount = m_index.Count();
+
+    if (outHasPartialRecord)
+    {
+        *outHasPartialRecord = (m_indexReadOffset != fileSize);
+    }
     return SLANG_OK;
 }
 
-SlangResult PersistentCache::writeIndex(const String& fileName, const CacheIndex& index)
+void PersistentCache::applyRecord(RecordOp op, const Key& key, uint32_t sequence)
+{
+    switch (op)
+    {
+        case RecordOp::Add:
+        case RecordOp::Use:
+            m_index[key] = sequence;
+            break;
+        case RecordOp::Remove:
+            m_index.Remove(key);
+            break;
+    }
+}
+
+SlangResult PersistentCache::appendRecords(const IndexRecord* records, Count count)
 {
+    // Appends are not atomic on all platforms (on Windows, opening the file for append only
+    // seeks to the end), so records are only appended with the exclusive lock held.
     FileStream fs;
-    SLANG_RETURN_ON_FAIL(fs.init(fileName, FileMode::Create));
+    SLANG_RETURN_ON_FAIL(fs.init(m_indexFileName, FileMode::Append, FileAccess::Write, FileShare::ReadWrite));
+    return fs.write(records, size_t(count) * sizeof(IndexRecord));
+}
+
+void PersistentCache::appendEntryRecord(RecordOp op, const Key& key)
+{
+    // Acquire the exclusive lock.
+    std::lock_guard<std::mutex> mutexLock(m_mutex);
+    LockFileGuard fileLock(m_lockFile);
+
+    // The index may have changed since it was read with the shared lock, so check the record
+    // is still needed. Leave an index that ends in a partial record to be rewritten by a write.
+    bool hasPartialRecord = false;
+    if (SLANG_FAILED(syncIndex(&hasPartialRecord)) || hasPartialRecord)
+    {
+        return;
+    }
+    uint32_t* lastUse = m_index.TryGetValue(key);
+    if (!lastUse)
+    {
+        return;
+    }
+    switch (op)
+    {
+        case RecordOp::Use:
+            if (isRecentlyUsed(*lastUse))
+            {
+                return;
+            }
+            break;
+        case RecordOp::Remove:
+            // The entry may have been written again by another process.
+            if (File::exists(getEntryFileName(key)))
+            {
+                return;
+            }
+            break;
+        default:
+            break;
+    }
+
+    const IndexRecord record = { key, kLogRecordTag | uint32_t(op) };
+    if (SLANG_SUCCEEDED(appendRecords(&record, 1)))
+    {
+        applyRecord(op, key, m_nextSequence++);
+        m_indexReadOffset += Int64(sizeof(IndexRecord));
+        m_stats.entryCount = m_index.Count();
+    }
+}
+
+List<PersistentCache::IndexRecord> PersistentCache::getEntriesByUse()
+{
+    List<IndexRecord> entries;
+    entries.reserve(m_index.Count());
+    for (const auto& pair : m_index)
+    {
+        entries.add(IndexRecord{ pair.Key, pair.Value });
+    }
+    entries.sort([](const IndexRecord& a, const IndexRecord& b) { return a.value < b.value; });
+    return entries;
+}
+
+SlangResult PersistentCache::writeIndex()
+{
+    // Order the entries by last use, and number them in that order.
+    List<IndexRecord> snapshot = getEntriesByUse();
+    for (Index i = 0; i < snapshot.getCount(); ++i)
+    {
+        snapshot[i].value = uint32_t(i);
+    }
 
     CacheIndexHeader header;
     ::memcpy(header.magic, kMagic, 4);
     header.version = kVersion;
-    header.count = (uint32_t)index.getCount();
-    header.reserved = 0;
+    header.count = (uint32_t)snapshot.getCount();
+    header.generation = m_indexGeneration + 1;
+
+    FileStream fs;
+    SLANG_RETURN_ON_FAIL(fs.init(m_indexFileName, FileMode::Create));
     SLANG_RETURN_ON_FAIL(fs.write(&header, sizeof(header)));
+    SLANG_RETURN_ON_FAIL(fs.write(snapshot.getBuffer(), snapshot.getCount() * sizeof(IndexRecord)));
 
-    SLANG_RETURN_ON_FAIL(fs.write(index.getBuffer(), index.getCount() * sizeof(CacheEntry)));
+    for (const auto& record : snapshot)
+    {
+        m_index[record.key] = record.value;
+    }
+    m_isIndexLoaded = true;
+    m_indexGeneration = header.generation;
+    m_indexSnapshotCount = header.count;
+    m_nextSequence = header.count;
+    m_indexReadOffset = Int64(sizeof(header)) + Int64(snapshot.getCount() * sizeof(IndexRecord));
 
     return SLANG_OK;
 }
 
+bool PersistentCache::isRecentlyUsed(uint32_t lastUse) const
+{
+    // Entries are only evicted from a cache with a maximum size.
+    if (m_maxEntryCount <= 0)
+    {
+        return true;
+    }
+    // Uses within the most recent 1/8th of the maximum number of uses are not recorded, which
+    // keeps the log small for entries that are used often.
+    const uint32_t window = uint32_t(m_maxEntryCount / 8);
+    return uint64_t(lastUse) + window + 1 >= m_nextSequence;
+}
+
 }
@@ -1,6 +1,7 @@
 #pragma once
 #include "../../slang.h"
 #include "../core/slang-crypto.h"
+#include "../core/slang-dictionary.h"
 #include "../core/slang-io.h"
 #include "../core/slang-string.h"
 
@@ -12,8 +13,16 @@ namespace Slang
 /// Implements a simple persistent cache on the filesystem for storing key/value pairs.
 /// Keys are SHA1 hashes and values are arbitrary blobs of data.
 /// The cache is save for concurrent access from multiple threads/processes by using
-/// a lock file within the cache directory. Furthermore, the cache implements a LRU
-/// eviction policy.
+/// a lock file within the cache directory. Furthermore, the cache implements an
+/// (approximate) LRU eviction policy.
+///
+/// The index file holds a snapshot of the entries ordered by last use, followed by a log
+/// of records that add, use or remove entries. Each cache instance keeps the index in memory,
+/// and only reads the records appended since it last looked. Reading an entry takes a shared
+/// lock. Records are only appended with the exclusive lock held, so reading an entry that was
+/// not used recently briefly takes the exclusive lock to record the use. To keep the log small,
+/// uses of entries that were used recently are not recorded. Writes take an exclusive lock,
+/// and occasionally compact the log into a new snapshot.
 class PersistentCache : public RefObject
 {
 public:
@@ -55,20 +64,46 @@ public:
     SlangResult writeEntry(const Key& key, ISlangBlob* data);
 
 private:
-    struct CacheEntry
+    enum class RecordOp : uint32_t
     {
-        Key key;
-        uint32_t age;
+        Add = 1,
+        Use,
+        Remove,
     };
 
-    using CacheIndex = List<CacheEntry>;
+    /// A record in the index file. In the snapshot the value is the order of use of the entry,
+    /// in the log it is the `RecordOp` and a tag.
+    struct IndexRecord
+    {
+        Key key;
+        uint32_t value;
+    };
 
     SlangResult initialize();
 
     String getEntryFileName(const Key& key);
 
-    SlangResult readIndex(const String& fileName, CacheIndex& outIndex);
-    SlangResult writeIndex(const String& fileName, const CacheIndex& index);
+    /// Discard the in memory index. It will be reloaded on the next sync.
+    void resetIndex();
+    /// Bring the in memory index up to date with the index file, up to the last complete record.
+    /// Must be called with the lock file held.
+    SlangResult syncIndex(bool* outHasPartialRecord = nullptr);
+    /// Apply a record from the log to the in memory index.
+    void applyRecord(RecordOp op, const Key& key, uint32_t sequence);
+    /// Append records to the log of the index file.
+    /// Must be called with the exclusive lock file held.
+    SlangResult appendRecords(const IndexRecord* records, Count count);
+    /// Append a use or remove record for an entry, if it is still needed once the index is
+    /// up to date. Takes the exclusive lock.
+    void appendEntryRecord(RecordOp op, const Key& key);
+    /// Get the entries of the in memory index, ordered from least to most recently used.
+    List<IndexRecord> getEntriesByUse();
+    /// Write the in memory index as a new snapshot, with an empty log.
+    /// Must be called with the exclusive lock file held.
+    SlangResult writeIndex();
+
+    /// True if the use of an entry last used at `lastUse` doesn't need to be recorded.
+    bool isRecentlyUsed(uint32_t lastUse) const;
 
     String m_cacheDirectory;
     String m_lockFileName;
@@ -82,6 +117,17 @@ private:
 
     Count m_maxEntryCount;
 
+    // The in memory index maps the key of each entry to the sequence number of its last use.
+    // Entries in the snapshot are numbered by their order of use, and records in the log follow on.
+    Dictionary<Key, uint32_t> m_index;
+    bool m_isIndexLoaded = false;
+    // The generation and snapshot size of the index file that was loaded
+    uint32_t m_indexGeneration = 0;
+    uint32_t m_indexSnapshotCount = 0;
+    // The sequence number of the next record in the log, and its offset in the index file
+    uint32_t m_nextSequence = 0;
+    Int64 m_indexReadOffset = 0;
+
     Stats m_stats;
 
     // Used for unit tests.
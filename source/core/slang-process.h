@@ -71,6 +71,9 @@ public:
         /// Get the clock tick.
     static uint64_t getClockTick();
 
+        /// Get the largest amount of physical memory (resident set size) used by the current process so far, in bytes
+    static SlangResult getPeakMemoryUsage(size_t& outBytes);
+
 protected:
     int32_t m_returnValue = 0;                              ///< Value returned if process terminated
     RefPtr<Stream> m_streams[Index(StdStreamType::CountOf)];   ///< Streams to communicate with the process
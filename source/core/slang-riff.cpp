@@ -275,8 +275,12 @@ struct DumpVisitor : public RiffContainer::Visitor
     return write(container->getRoot(), true, stream);
 }
 
-/* static */SlangResult RiffUtil::read(Stream* stream, RiffContainer& outContainer)
+/* Reads the riff structure from the stream into outContainer. If inPlaceData is set, it is the start of the
+memory (of inPlaceSize bytes) the stream is reading from, and data chunk payloads reference that memory rather
+than being copied. */
+static SlangResult _readContainer(Stream* stream, const uint8_t* inPlaceData, size_t inPlaceSize, RiffContainer& outContainer)
 {
+    typedef RiffUtil::Chunk Chunk;
     typedef RiffContainer::ScopeChunk ScopeChunk;
     typedef RiffContainer::ScopeChunk ScopeContainer;
     outContainer.reset();
@@ -285,13 +289,13 @@ struct DumpVisitor : public RiffContainer::Visitor
     {
         RiffListHeader header;
 
-        SLANG_RETURN_ON_FAIL(readHeader(stream, header));
-        if (!isListType(header.chunk.type))
+        SLANG_RETURN_ON_FAIL(RiffUtil::readHeader(stream, header));
+        if (!RiffUtil::isListType(header.chunk.type))
         {
             return SLANG_FAIL;
         }
 
-        remaining = getPadSize(header.chunk.size) - (sizeof(RiffListHeader) - sizeof(RiffHeader));
+        remaining = RiffUtil::getPadSize(header.chunk.size) - (sizeof(RiffListHeader) - sizeof(RiffHeader));
         outContainer.startChunk(Chunk::Kind::List, header.subType);
     }
 
@@ -314,7 +318,7 @@ struct DumpVisitor : public RiffContainer::Visitor
         else
         {
             RiffListHeader header;
-            SLANG_RETURN_ON_FAIL(readHeader(stream, header));
+            SLANG_RETURN_ON_FAIL(RiffUtil::readHeader(stream, header));
 
             // The amount of data can't be larger than what remains
             if (header.chunk.size > remaining)
@@ -331,7 +335,7 @@ struct DumpVisitor : public RiffContainer::Visitor
                 }
 
                 // Work out the pad size
-                const size_t padSize = getPadSize(header.chunk.size);
+                const size_t padSize = RiffUtil::getPadSize(header.chunk.size);
 
                 // Subtract the size of this chunk from remaining of the current chunk
                 remaining -= sizeof(RiffHeader) + padSize;                
@@ -348,11 +352,26 @@ struct DumpVisitor : public RiffContainer::Visitor
             {
                 ScopeChunk scopeChunk(&outContainer, Chunk::Kind::Data, header.chunk.type);
                 RiffContainer::Data* data = outContainer.addData();
-                
-                outContainer.setPayload(data, nullptr, header.chunk.size);
 
                 size_t readSize;
-                SLANG_RETURN_ON_FAIL(readPayload(stream, header.chunk.size, data->getPayload(), readSize));
+                if (inPlaceData)
+                {
+                    // Reference the payload where it is, instead of copying it
+                    const size_t position = size_t(stream->getPosition());
+                    readSize = RiffUtil::getPadSize(header.chunk.size);
+                    if (position + header.chunk.size > inPlaceSize)
+                    {
+                        return SLANG_FAIL;
+                    }
+
+                    outContainer.setUnowned(data, const_cast<uint8_t*>(inPlaceData + position), header.chunk.size);
+                    SLANG_RETURN_ON_FAIL(stream->seek(SeekOrigin::Current, Int64(readSize)));
+                }
+                else
+                {
+                    outContainer.setPayload(data, nullptr, header.chunk.size);
+                    SLANG_RETURN_ON_FAIL(RiffUtil::readPayload(stream, header.chunk.size, data->getPayload(), readSize));
+                }
 
                 // All read sizes must end up aligned
                 SLANG_ASSERT((readSize & kRiffPadMask) == 0);
@@ -366,6 +385,17 @@ struct DumpVisitor : public RiffContainer::Visitor
     return outContainer.isFullyConstructed() ? SLANG_OK : SLANG_FAIL;
 }
 
+/* static */SlangResult RiffUtil::read(Stream* stream, RiffContainer& outContainer)
+{
+    return _readContainer(stream, nullptr, 0, outContainer);
+}
+
+/* static */SlangResult RiffUtil::readInPlace(const void* data, size_t size, RiffContainer& outContainer)
+{
+    MemoryStreamBase stream(FileAccess::Read, data, size);
+    return _readContainer(&stream, (const uint8_t*)data, size, outContainer);
+}
+
 // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!! RiffContainer::Chunk !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
 
 SlangResult RiffContainer::Chunk::visit(Visitor* visitor)
@@ -970,6 +1000,20 @@ static SlangResult _calcAndSetSize(RiffContainer::Chunk* chunk, void* data)
     chunk->visitPostOrder(&_calcAndSetSize, nullptr);
 }
 
+size_t RiffContainer::calcNextChunkOffset() const
+{
+    SLANG_ASSERT(m_dataChunk == nullptr);
+
+    // The payload size of an open list only includes the chunks that have been ended, and the next
+    // chunk is placed directly after them. Each enclosing list contributes its header and its payload so far.
+    size_t offset = 0;
+    for (ListChunk* list = m_listChunk; list; list = list->m_parent)
+    {
+        offset += sizeof(RiffHeader) + list->m_payloadSize;
+    }
+    return offset;
+}
+
 
 
 }
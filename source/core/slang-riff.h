@@ -418,6 +418,10 @@ public:
         /// Traverses over chunk hierarchy and sets the sizes
     static void calcAndSetSize(Chunk* chunk);
 
+        /// Calculate the offset, from the start of the root chunk, that the next chunk started will be written at.
+        /// Can only be called between chunks (ie not inside a data chunk).
+    size_t calcNextChunkOffset() const;
+
         /// Ctor
     RiffContainer();
 
@@ -483,6 +487,9 @@ struct RiffUtil
 
         /// Read the stream into the container
     static SlangResult read(Stream* stream, RiffContainer& outContainer);
+        /// Read the riff held in memory into the container without copying. Data payloads reference `data`
+        /// directly, so it must stay in scope (and unchanged) for as long as the container is used.
+    static SlangResult readInPlace(const void* data, size_t size, RiffContainer& outContainer);
 };
 
 }
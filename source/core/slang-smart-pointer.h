@@ -2,6 +2,7 @@
 #define SLANG_CORE_SMART_POINTER_H
 
 #include "slang-common.h"
+#include "slang-concurrent-scope.h"
 #include "slang-hash.h"
 #include "slang-type-traits.h"
 
@@ -10,10 +11,17 @@
 namespace Slang
 {
     // Base class for all reference-counted objects
+    //
+    // If SLANG_ENABLE_CONCURRENT_COMPILE is set, reference counts are changed atomically while a
+    // `ConcurrentScope` is active, as objects are otherwise only used by one thread.
     class SLANG_RT_API RefObject
     {
     private:
+#if SLANG_ENABLE_CONCURRENT_COMPILE
+        std::atomic<UInt> referenceCount;
+#else
         UInt referenceCount;
+#endif
 
     public:
         RefObject()
@@ -29,6 +37,34 @@ namespace Slang
         virtual ~RefObject()
         {}
 
+#if SLANG_ENABLE_CONCURRENT_COMPILE
+        UInt addReference()
+        {
+            if (ConcurrentScope::isActive())
+            {
+                return referenceCount.fetch_add(1) + 1;
+            }
+            const UInt count = referenceCount.load(std::memory_order_relaxed) + 1;
+            referenceCount.store(count, std::memory_order_relaxed);
+            return count;
+        }
+
+        UInt decreaseReference()
+        {
+            if (ConcurrentScope::isActive())
+            {
+                return referenceCount.fetch_sub(1) - 1;
+            }
+            const UInt count = referenceCount.load(std::memory_order_relaxed) - 1;
+            referenceCount.store(count, std::memory_order_relaxed);
+            return count;
+        }
+
+        UInt debugGetReferenceCount()
+        {
+            return referenceCount.load(std::memory_order_relaxed);
+        }
+#else
         UInt addReference()
         {
             return ++referenceCount;
@@ -39,26 +75,27 @@ namespace Slang
             return --referenceCount;
         }
 
+        UInt debugGetReferenceCount()
+        {
+            return referenceCount;
+        }
+#endif
+
         UInt releaseReference()
         {
-            SLANG_ASSERT(referenceCount != 0);
-            if(--referenceCount == 0)
+            SLANG_ASSERT(debugGetReferenceCount() != 0);
+            const UInt count = decreaseReference();
+            if(count == 0)
             {
                 delete this;
-                return 0;
             }
-            return referenceCount;
+            return count;
         }
 
         bool isUniquelyReferenced()
         {
-            SLANG_ASSERT(referenceCount != 0);
-            return referenceCount == 1;
-        }
-
-        UInt debugGetReferenceCount()
-        {
-            return referenceCount;
+            SLANG_ASSERT(debugGetReferenceCount() != 0);
+            return debugGetReferenceCount() == 1;
         }
     };
 
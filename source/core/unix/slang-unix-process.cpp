@@ -17,6 +17,7 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/wait.h>
+#include <sys/resource.h>
 #include <unistd.h>
 
 #if SLANG_OSX
@@ -487,6 +488,23 @@ static const int kCannotExecute = 126;
     return uint64_t(now.tv_sec) * 1000000000 + now.tv_nsec;
 }
 
+/* static */SlangResult Process::getPeakMemoryUsage(size_t& outBytes)
+{
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return SLANG_FAIL;
+    }
+#if SLANG_APPLE_FAMILY
+    // Is in bytes on Apple platforms
+    outBytes = size_t(usage.ru_maxrss);
+#else
+    // Is in kilobytes on Linux
+    outBytes = size_t(usage.ru_maxrss) * 1024;
+#endif
+    return SLANG_OK;
+}
+
 /* static */void Process::sleepCurrentThread(Int timeInMs)
 {
     struct timespec timeSpec;
@@ -16,6 +16,7 @@
 #   define WIN32_LEAN_AND_MEAN
 #   define NOMINMAX
 #   include <Windows.h>
+#   include <psapi.h>
 #   undef WIN32_LEAN_AND_MEAN
 #   undef NOMINMAX
 #endif
@@ -561,4 +562,15 @@ static const uint64_t g_frequency = _getClockFrequency();
     return counter.QuadPart;
 }
 
+/* static */SlangResult Process::getPeakMemoryUsage(size_t& outBytes)
+{
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        return SLANG_FAIL;
+    }
+    outBytes = size_t(counters.PeakWorkingSetSize);
+    return SLANG_OK;
+}
+
 } // namespace Slang
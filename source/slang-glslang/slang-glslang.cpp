@@ -17,6 +17,7 @@
 
 #include "spirv-tools/optimizer.hpp"
 #include "spirv-tools/libspirv.h"
+#include "spirv-tools/libspirv.hpp"
 
 #ifdef _WIN32
 #   include <Windows.h>
@@ -199,9 +200,30 @@ static void glslang_optimizeSPIRV(spv_target_env targetEnv, const glslang_Compil
     // it might be fixable by raising the multiplier to a larger value.
     spvOptOptions.set_max_id_bound(kDefaultMaxIdBound * 4);
 
+    // Passes specified in the request are used instead of the passes for the optimization level
+    const bool hasRequestPasses = request.spirvOptimizationPasses && request.spirvOptimizationPassCount > 0;
+    if (hasRequestPasses)
+    {
+        const std::vector<std::string> flags(request.spirvOptimizationPasses, request.spirvOptimizationPasses + request.spirvOptimizationPassCount);
+        if (!optimizer.RegisterPassesFromFlags(flags))
+        {
+            SPIRVOptimizationDiagnostic diag;
+            diag.level = SPV_MSG_ERROR;
+            diag.position = spv_position_t{};
+            diag.message = "invalid SPIR-V optimization passes";
+            outDiags.push_back(diag);
+            return;
+        }
+    }
+
     // TODO confirm which passes we want to invoke for each level
-    switch (optimizationLevel)
+    switch (hasRequestPasses ? unsigned(SLANG_OPTIMIZATION_LEVEL_NONE) : optimizationLevel)
     {
+        case SLANG_OPTIMIZATION_LEVEL_NONE:
+        {
+            // Only the passes from the request are run
+            break;
+        }
         default:
         case SLANG_OPTIMIZATION_LEVEL_DEFAULT:
         {
@@ -413,6 +435,27 @@ static void glslang_optimizeSPIRV(spv_target_env targetEnv, const glslang_Compil
     }
 }
 
+// Check the SPIR-V is valid with the SPIRV-Tools validator (which is what spirv-val runs).
+// Returns false if it isn't.
+static bool glslang_validateSPIRV(spv_target_env targetEnv, std::vector<SPIRVOptimizationDiagnostic>& outDiags, const std::vector<unsigned int>& spirv)
+{
+    spvtools::SpirvTools tools(targetEnv);
+    tools.SetMessageConsumer(
+        [&](spv_message_level_t level, const char* source, const spv_position_t& position, const char* message) {
+            SPIRVOptimizationDiagnostic diag;
+            diag.level = level;
+            diag.source = source ? source : "spirv-val";
+            diag.position = position;
+            if (message)
+            {
+                diag.message = message;
+            }
+            outDiags.push_back(diag);
+        });
+
+    return tools.Validate(spirv.data(), spirv.size());
+}
+
 static glslang::EShTargetLanguageVersion _makeTargetLanguageVersion(int majorVersion, int minorVersion)
 {
     return glslang::EShTargetLanguageVersion((uint32_t(majorVersion) << 16) | (uint32_t(minorVersion) << 8));
@@ -509,6 +552,24 @@ static spv_target_env _getUniversalTargetEnv(glslang::EShTargetLanguageVersion i
     return SPV_ENV_UNIVERSAL_1_2;
 }
 
+// Dump the diagnostics from optimizing or validating SPIR-V, and return the number of errors
+static int _dumpOptimizationDiagnostics(const glslang_CompileRequest_1_1& request, const std::vector<SPIRVOptimizationDiagnostic>& diags)
+{
+    int errorCount = 0;
+    for (const auto& diag : diags)
+    {
+        // Count the number of errors
+        errorCount += int(diag.level <= SPV_MSG_ERROR);
+
+        // Note this string does not have \n. 
+        std::string diagString = diag.toString();
+
+        // Dump
+        dump(diagString.c_str(), diagString.length(), request.diagnosticFunc, request.diagnosticUserData, stderr);
+    }
+    return errorCount;
+}
+
 static int glslang_compileGLSLToSPIRV(const glslang_CompileRequest_1_1& request)
 {
     // Check that the encoding matches
@@ -651,24 +712,18 @@ static int glslang_compileGLSLToSPIRV(const glslang_CompileRequest_1_1& request)
 
         int optErrorCount = 0;
 
-        if (request.optimizationLevel != SLANG_OPTIMIZATION_LEVEL_NONE)
+        if (request.validateSPIRV)
+        {
+            std::vector<SPIRVOptimizationDiagnostic> validationDiags;
+            glslang_validateSPIRV(targetEnv, validationDiags, spirv);
+            optErrorCount += _dumpOptimizationDiagnostics(request, validationDiags);
+        }
+
+        if (request.optimizationLevel != SLANG_OPTIMIZATION_LEVEL_NONE && optErrorCount == 0)
         {
             std::vector<SPIRVOptimizationDiagnostic> optDiags;
             glslang_optimizeSPIRV(targetEnv, request, optDiags, spirv);
-
-            {
-                for (const auto& diag : optDiags)
-                {
-                    // Count the number of errors
-                    optErrorCount += int(diag.level <= SPV_MSG_ERROR);
-
-                    // Note this string does not have \n. 
-                    std::string diagString = diag.toString();
-
-                    // Dump
-                    dump(diagString.c_str(), diagString.length(), request.diagnosticFunc, request.diagnosticUserData, stderr);
-                }
-            }
+            optErrorCount += _dumpOptimizationDiagnostics(request, optDiags);
         }
 
         dumpDiagnostics(request, logger.getAllMessages());
@@ -702,6 +757,64 @@ static int glslang_dissassembleSPIRV(const glslang_CompileRequest_1_1& request)
     return 0;
 }
 
+static int glslang_optimizeInputSPIRV(const glslang_CompileRequest_1_1& request)
+{
+    typedef unsigned int SPIRVWord;
+
+    SPIRVWord const* spirvBegin = (SPIRVWord const*)request.inputBegin;
+    SPIRVWord const* spirvEnd   = (SPIRVWord const*)request.inputEnd;
+
+    std::vector<SPIRVWord> spirv(spirvBegin, spirvEnd);
+
+    // The header is 5 words, starting with the magic number
+    const SPIRVWord magicNumber = 0x07230203;
+    if (spirv.size() < 5 || spirv[0] != magicNumber)
+    {
+        dumpDiagnostics(request, "error: input is not SPIR-V\n");
+        return 1;
+    }
+
+    spv_target_env targetEnv = SPV_ENV_UNIVERSAL_1_2;
+    const int spirvTargetIndex = request.spirvTargetName ? _findTargetIndex(request.spirvTargetName) : -1;
+    if (spirvTargetIndex >= 0)
+    {
+        targetEnv = kSpirvTargetInfos[spirvTargetIndex].targetEnv;
+    }
+    else if (request.spirvVersion.major != 0)
+    {
+        targetEnv = _getUniversalTargetEnv(_makeTargetLanguageVersion(request.spirvVersion.major, request.spirvVersion.minor));
+    }
+    else
+    {
+        // Use the version in the header, which is encoded in the same way as a target language version
+        targetEnv = _getUniversalTargetEnv(glslang::EShTargetLanguageVersion(spirv[1]));
+    }
+
+    int errorCount = 0;
+
+    if (request.validateSPIRV)
+    {
+        std::vector<SPIRVOptimizationDiagnostic> validationDiags;
+        glslang_validateSPIRV(targetEnv, validationDiags, spirv);
+        errorCount += _dumpOptimizationDiagnostics(request, validationDiags);
+    }
+
+    if (request.optimizationLevel != SLANG_OPTIMIZATION_LEVEL_NONE && errorCount == 0)
+    {
+        std::vector<SPIRVOptimizationDiagnostic> optDiags;
+        glslang_optimizeSPIRV(targetEnv, request, optDiags, spirv);
+        errorCount += _dumpOptimizationDiagnostics(request, optDiags);
+    }
+
+    if (errorCount > 0)
+    {
+        return 1;
+    }
+
+    dump(spirv.data(), spirv.size() * sizeof(SPIRVWord), request.outputFunc, request.outputUserData, stdout);
+    return 0;
+}
+
 // We need a per process initialization
 class ProcessInitializer
 {
@@ -754,11 +867,34 @@ static int _compile(const glslang_CompileRequest_1_1& request)
         case GLSLANG_ACTION_DISSASSEMBLE_SPIRV:
             result = glslang_dissassembleSPIRV(request);
             break;
+
+        case GLSLANG_ACTION_OPTIMIZE_SPIRV:
+            result = glslang_optimizeInputSPIRV(request);
+            break;
     }
 
     return result;
 }
 
+extern "C"
+#ifdef _MSC_VER
+_declspec(dllexport)
+#else
+__attribute__((__visibility__("default")))
+#endif
+int glslang_supportsAction(unsigned action)
+{
+    switch (action)
+    {
+        case GLSLANG_ACTION_COMPILE_GLSL_TO_SPIRV:
+        case GLSLANG_ACTION_DISSASSEMBLE_SPIRV:
+        case GLSLANG_ACTION_OPTIMIZE_SPIRV:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
 extern "C"
 #ifdef _MSC_VER
 _declspec(dllexport)
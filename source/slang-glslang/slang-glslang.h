@@ -10,6 +10,7 @@ enum
 {
     GLSLANG_ACTION_COMPILE_GLSL_TO_SPIRV,
     GLSLANG_ACTION_DISSASSEMBLE_SPIRV,
+    GLSLANG_ACTION_OPTIMIZE_SPIRV,              ///< Run the SPIRV-Tools optimizer on the input SPIR-V
 };
 
 struct glsl_SPIRVVersion
@@ -89,6 +90,10 @@ struct glslang_CompileRequest_1_1
 
     const char*         spirvTargetName;            /// A valid TargetName. If null will use universal based on the spirVersion.
     glsl_SPIRVVersion   spirvVersion;               ///< The SPIR-V version. If all are 0 will use the default which is 1.2 currently
+
+    const char* const*  spirvOptimizationPasses;    ///< spirv-opt style flags (such as "--eliminate-dead-code-aggressive") of passes to run instead of the passes for the optimizationLevel. Can be nullptr.
+    size_t              spirvOptimizationPassCount;
+    int                 validateSPIRV;              ///< If non zero, SPIR-V is checked with the SPIRV-Tools validator (as spirv-val does) before it is optimized
 };
 
 void glslang_CompileRequest_1_0::set(const glslang_CompileRequest_1_1& in)
@@ -104,4 +109,9 @@ void glslang_CompileRequest_1_1::set(const glslang_CompileRequest_1_0& in)
 typedef int (*glslang_CompileFunc_1_0)(glslang_CompileRequest_1_0* request);
 typedef int (*glslang_CompileFunc_1_1)(glslang_CompileRequest_1_1* request);
 
+    /// Returns non zero if the library can perform the action (one of the GLSLANG_ACTION_ values).
+    /// The library exports it as `glslang_supportsAction`. Libraries that don't export it predate
+    /// GLSLANG_ACTION_OPTIMIZE_SPIRV, and the request fields that follow spirvVersion.
+typedef int (*glslang_SupportsActionFunc)(unsigned action);
+
 #endif
@@ -292,6 +292,13 @@ SLANG_API void spSetTargetForceGLSLScalarBufferLayout(
     request->setTargetForceGLSLScalarBufferLayout(targetIndex, forceScalarLayout);
 }
 
+SLANG_API void spSetTargetCPUSIMDLaneCount(
+    slang::ICompileRequest* request, int targetIndex, int laneCount)
+{
+    SLANG_ASSERT(request);
+    request->setTargetCPUSIMDLaneCount(targetIndex, laneCount);
+}
+
 SLANG_API void spSetTargetLineDirectiveMode(
     slang::ICompileRequest* request,
     int targetIndex,
@@ -393,6 +400,47 @@ SLANG_API void spSetDebugInfoFormat(
     request->setDebugInfoFormat(format);
 }
 
+SLANG_API void spSetPerfTraceEnabled(
+    slang::ICompileRequest* request,
+    bool enable)
+{
+    SLANG_ASSERT(request);
+    request->setPerfTraceEnabled(enable);
+}
+
+SLANG_API SlangResult spGetPerfTrace(
+    slang::ICompileRequest* request,
+    SlangPerfTraceFormat format,
+    ISlangBlob** outBlob)
+{
+    SLANG_ASSERT(request);
+    return request->getPerfTrace(format, outBlob);
+}
+
+SLANG_API void spSetCodeGenThreadCount(
+    slang::ICompileRequest* request,
+    int threadCount)
+{
+    SLANG_ASSERT(request);
+    request->setCodeGenThreadCount(threadCount);
+}
+
+SLANG_API void spSetModuleCachePath(
+    slang::ICompileRequest* request,
+    const char* path)
+{
+    SLANG_ASSERT(request);
+    request->setModuleCachePath(path);
+}
+
+SLANG_API void spSetDownstreamCachePath(
+    slang::ICompileRequest* request,
+    const char* path)
+{
+    SLANG_ASSERT(request);
+    request->setDownstreamCachePath(path);
+}
+
 SLANG_API void spSetOptimizationLevel(
     slang::ICompileRequest*    request,
     SlangOptimizationLevel  level)
@@ -83,6 +83,7 @@ SyntaxClass<NodeBase> SharedASTBuilder::findSyntaxClass(Name* name)
 
 Type* SharedASTBuilder::getStringType()
 {
+    SharedStateLock lock;
     if (!m_stringType)
     {
         auto stringTypeDecl = findMagicDecl("StringType");
@@ -93,6 +94,7 @@ Type* SharedASTBuilder::getStringType()
 
 Type* SharedASTBuilder::getNativeStringType()
 {
+    SharedStateLock lock;
     if (!m_nativeStringType)
     {
         auto nativeStringTypeDecl = findMagicDecl("NativeStringType");
@@ -103,6 +105,7 @@ Type* SharedASTBuilder::getNativeStringType()
 
 Type* SharedASTBuilder::getEnumTypeType()
 {
+    SharedStateLock lock;
     if (!m_enumTypeType)
     {
         auto enumTypeTypeDecl = findMagicDecl("EnumTypeType");
@@ -113,6 +116,7 @@ Type* SharedASTBuilder::getEnumTypeType()
 
 Type* SharedASTBuilder::getDynamicType()
 {
+    SharedStateLock lock;
     if (!m_dynamicType)
     {
         auto dynamicTypeDecl = findMagicDecl("DynamicType");
@@ -123,6 +127,7 @@ Type* SharedASTBuilder::getDynamicType()
 
 Type* SharedASTBuilder::getNullPtrType()
 {
+    SharedStateLock lock;
     if (!m_nullPtrType)
     {
         auto nullPtrTypeDecl = findMagicDecl("NullPtrType");
@@ -133,6 +138,7 @@ Type* SharedASTBuilder::getNullPtrType()
 
 Type* SharedASTBuilder::getNoneType()
 {
+    SharedStateLock lock;
     if (!m_noneType)
     {
         auto noneTypeDecl = findMagicDecl("NoneType");
@@ -143,6 +149,7 @@ Type* SharedASTBuilder::getNoneType()
 
 Type* SharedASTBuilder::getDiffInterfaceType()
 {
+    SharedStateLock lock;
     if (!m_diffInterfaceType)
     {
         auto decl = findMagicDecl("DifferentiableType");
@@ -290,6 +297,9 @@ PtrTypeBase* ASTBuilder::getPtrType(Type* valueType, char const* ptrTypeName)
 
 ArrayExpressionType* ASTBuilder::getArrayType(Type* elementType, IntVal* elementCount)
 {
+    // The cached type is completed after it is created, so must be locked throughout
+    SharedStateLock lock;
+
     if (!elementCount)
         elementCount = getIntVal(getIntType(), kUnsizedArrayMagicLength);
 
@@ -308,6 +318,8 @@ VectorExpressionType* ASTBuilder::getVectorType(
     Type*    elementType,
     IntVal*  elementCount)
 {
+    SharedStateLock lock;
+
     auto result = getOrCreate<VectorExpressionType>(elementType, elementCount);
     if (!result->declRef.decl)
     {
@@ -139,6 +139,8 @@ public:
     template<typename NodeCreateFunc>
     NodeBase* _getOrCreateImpl(NodeDesc const& desc, NodeCreateFunc createFunc)
     {
+        SharedStateLock lock;
+
         if (auto found = m_cachedNodes.TryGetValue(desc))
             return *found;
 
@@ -168,6 +170,8 @@ public:
     template <typename T>
     T* create()
     {
+        SharedStateLock lock;
+
         auto alloced = m_arena.allocate(sizeof(T));
         memset(alloced, 0, sizeof(T));
         return _initAndAdd(new (alloced) T);
@@ -176,6 +180,8 @@ public:
     template<typename T, typename... TArgs>
     T* create(TArgs... args)
     {
+        SharedStateLock lock;
+
         auto alloced = m_arena.allocate(sizeof(T));
         memset(alloced, 0, sizeof(T));
         return _initAndAdd(new (alloced) T(args...));
@@ -52,6 +52,11 @@ void ContainerDecl::buildMemberDictionary()
     if (isMemberDictionaryValid())
         return;
 
+    // Lookups into a container can be made from multiple threads
+    SharedStateLock lock;
+    if (isMemberDictionaryValid())
+        return;
+
     // If it's < 0 it means that the dictionaries are entirely invalid
     if (dictionaryLastCount < 0)
     {
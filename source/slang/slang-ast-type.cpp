@@ -66,9 +66,14 @@ Type* Type::getCanonicalType()
     Type* et = const_cast<Type*>(this);
     if (!et->canonicalType)
     {
-        // TODO(tfoley): worry about thread safety here?
-        auto canType = et->createCanonicalType();
-        et->canonicalType = canType;
+        // The canonical type is created once, but types can be shared by threads checking
+        // function bodies in parallel.
+        SharedStateLock lock;
+        if (!et->canonicalType)
+        {
+            auto canType = et->createCanonicalType();
+            et->canonicalType = canType;
+        }
 
         SLANG_ASSERT(et->canonicalType);
     }
@@ -664,6 +669,8 @@ Val* ExtractExistentialType::_substituteImplOverride(ASTBuilder* astBuilder, Sub
 
 SubtypeWitness* ExtractExistentialType::getSubtypeWitness()
 {
+    SharedStateLock lock;
+
     if (auto cachedValue = this->cachedSubtypeWitness)
         return cachedValue;
 
@@ -678,6 +685,8 @@ SubtypeWitness* ExtractExistentialType::getSubtypeWitness()
 
 DeclRef<InterfaceDecl> ExtractExistentialType::getSpecializedInterfaceDeclRef()
 {
+    SharedStateLock lock;
+
     if (auto cachedValue = this->cachedSpecializedInterfaceDeclRef)
         return cachedValue;
 
@@ -1126,6 +1126,7 @@ namespace Slang
     
         if( cacheKey.isValid())
         {
+            SharedStateLock lock;
             if (typeCheckingCache->conversionCostCache.TryGetValue(cacheKey, cost))
             {
                 if (outCost)
@@ -1159,6 +1160,7 @@ namespace Slang
         {
             if (!rs)
                 cost = kConversionCost_Impossible;
+            SharedStateLock lock;
             typeCheckingCache->conversionCostCache[cacheKey] = cost;
         }
 
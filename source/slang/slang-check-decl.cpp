@@ -14,6 +14,7 @@
 #include "slang-syntax.h"
 #include "slang-ast-synthesis.h"
 #include <limits>
+#include <thread>
 
 namespace Slang
 {
@@ -625,6 +626,8 @@ namespace Slang
         GenericDecl*            genericDecl,
         Substitutions*   outerSubst)
     {
+        SharedStateLock lock;
+
         GenericSubstitution* cachedResult = nullptr;
         if (astBuilder->m_genericDefaultSubst.TryGetValue(genericDecl, cachedResult))
         {
@@ -811,6 +814,17 @@ namespace Slang
         ///
     static void _dispatchDeclCheckingVisitor(Decl* decl, DeclCheckState state, SemanticsContext const& shared);
 
+        /// True if `decl` is declared in the body of a function, and so is checked as part of checking the body
+    static bool _isDeclInFunctionBody(Decl* decl)
+    {
+        for (auto parentDecl = decl->parentDecl; parentDecl; parentDecl = parentDecl->parentDecl)
+        {
+            if (as<ScopeDecl>(parentDecl))
+                return true;
+        }
+        return false;
+    }
+
     // Make sure a declaration has been checked, so we can refer to it.
     // Note that this may lead to us recursively invoking checking,
     // so this may not be the best way to handle things.
@@ -821,6 +835,12 @@ namespace Slang
         //
         if (decl->isChecked(state)) return;
 
+        // When function bodies are checked on multiple threads (see `_checkAllDeclsConcurrently`)
+        // everything outside of the bodies must already be checked, because the check state of
+        // a declaration isn't locked.
+        //
+        SLANG_ASSERT(!ConcurrentScope::getCurrent() || _isDeclInFunctionBody(decl));
+
         // Is the declaration already being checked, somewhere up the
         // call stack from us?
         //
@@ -931,6 +951,12 @@ namespace Slang
         Decl*                       decl,
         DeclCheckState              state)
     {
+        // Stopping between declarations leaves every declaration in a consistent state
+        if (visitor->getLinkage()->isCancelled())
+        {
+            throw AbortCompilationException();
+        }
+
         // Ensure `decl` itself first.
         visitor->ensureDecl(decl, state);
 
@@ -1781,6 +1807,225 @@ namespace Slang
         _registerBuiltinDeclsRec(session, decl);
     }
 
+        /// Bring the tree of declarations under `decl` to `DeclCheckState::Checked`, except for
+        /// the bodies of functions, which are added to `outFuncs` to be checked later.
+    static void _ensureAllDeclsExceptBodiesRec(
+        SemanticsDeclVisitorBase*   visitor,
+        Decl*                       decl,
+        List<FunctionDeclBase*>&    outFuncs)
+    {
+        if (visitor->getLinkage()->isCancelled())
+        {
+            throw AbortCompilationException();
+        }
+
+        // The bodies of functions are checked in the `Checked` step, and nothing else is.
+        // Declarations in the function (such as parameters) are checked as usual.
+        auto funcDecl = as<FunctionDeclBase>(decl);
+        if (funcDecl && funcDecl->body && !funcDecl->isChecked(DeclCheckState::Checked))
+        {
+            visitor->ensureDecl(decl, DeclCheckState::AttributesChecked);
+            outFuncs.add(funcDecl);
+        }
+        else
+        {
+            visitor->ensureDecl(decl, DeclCheckState::Checked);
+        }
+
+        if (auto containerDecl = as<ContainerDecl>(decl))
+        {
+            const auto& members = containerDecl->members;
+            for (Index i = 0; i < members.getCount(); ++i)
+            {
+                Decl* childDecl = members[i];
+                if (as<ScopeDecl>(childDecl))
+                    continue;
+                _ensureAllDeclsExceptBodiesRec(visitor, childDecl, outFuncs);
+            }
+        }
+        if (auto genericDecl = as<GenericDecl>(decl))
+        {
+            _ensureAllDeclsExceptBodiesRec(visitor, genericDecl->inner, outFuncs);
+        }
+    }
+
+        /// Build the member dictionaries of all of the containers under `decl`, so that
+        /// lookups made while checking function bodies don't need to build them.
+    static void _buildMemberDictionariesRec(Decl* decl)
+    {
+        if (auto containerDecl = as<ContainerDecl>(decl))
+        {
+            containerDecl->buildMemberDictionary();
+            for (auto childDecl : containerDecl->members)
+            {
+                if (!as<ScopeDecl>(childDecl))
+                    _buildMemberDictionariesRec(childDecl);
+            }
+        }
+        if (auto genericDecl = as<GenericDecl>(decl))
+        {
+            _buildMemberDictionariesRec(genericDecl->inner);
+        }
+    }
+
+        /// Bring all of the declarations under `moduleDecl` to `DeclCheckState::Checked`, checking
+        /// the bodies of functions on up to `threadCount` threads.
+        ///
+        /// The bodies of functions can only reference other declarations that are already
+        /// checked past their signatures, so once everything else is checked they can be checked
+        /// independently. Each thread has its own `SharedSemanticsContext`, and each function its
+        /// own `DiagnosticSink`. State that is still shared (such as the AST builder and type
+        /// checking cache) is locked with the mutex of the `ConcurrentScope` the threads run in,
+        /// so it doesn't contend with the checking of other linkages.
+    static void _checkAllDeclsConcurrently(
+        SemanticsDeclVisitorBase*   visitor,
+        ModuleDecl*                 moduleDecl,
+        Count                       threadCount)
+    {
+        auto shared = visitor->getShared();
+        auto sink = visitor->getSink();
+
+        List<FunctionDeclBase*> funcs;
+        _ensureAllDeclsExceptBodiesRec(visitor, moduleDecl, funcs);
+
+        const Count funcCount = funcs.getCount();
+        threadCount = Math::Min(threadCount, funcCount);
+        if (threadCount <= 1)
+        {
+            for (auto funcDecl : funcs)
+            {
+                visitor->ensureDecl(funcDecl, DeclCheckState::Checked);
+            }
+            return;
+        }
+
+        PerfTraceScope perfScope(visitor->getLinkage()->getPerfTrace(), "check", "bodiesConcurrent");
+
+        _buildMemberDictionariesRec(moduleDecl);
+        for (auto importedModuleDecl : shared->importedModulesList)
+        {
+            _buildMemberDictionariesRec(importedModuleDecl);
+        }
+
+        // Each function has its own sink, so that diagnostics can be output in declaration
+        // order. Aborting compilation is deferred until all of the diagnostics have been output.
+        List<DiagnosticSink> funcSinks;
+        List<bool> funcAborted;
+        funcSinks.setCount(funcCount);
+        funcAborted.setCount(funcCount);
+        for (Index i = 0; i < funcCount; ++i)
+        {
+            funcSinks[i].initFrom(*sink);
+            funcAborted[i] = false;
+        }
+
+        std::atomic<Index> nextFuncIndex(0);
+
+        auto checkFuncs = [&]()
+        {
+            SharedSemanticsContext threadShared(
+                shared->getLinkage(),
+                shared->getModule(),
+                sink,
+                shared->m_environmentModules);
+            threadShared.importedModulesList = shared->importedModulesList;
+            threadShared.importedModulesSet = shared->importedModulesSet;
+
+            for (;;)
+            {
+                const Index funcIndex = nextFuncIndex++;
+                if (funcIndex >= funcCount)
+                {
+                    break;
+                }
+
+                DiagnosticSink* funcSink = &funcSinks[funcIndex];
+                threadShared.m_sink = funcSink;
+                try
+                {
+                    if (threadShared.getLinkage()->isCancelled())
+                    {
+                        throw AbortCompilationException();
+                    }
+                    _dispatchDeclCheckingVisitor(funcs[funcIndex], DeclCheckState::Checked, SemanticsContext(&threadShared));
+                }
+                catch (const AbortCompilationException&)
+                {
+                    funcAborted[funcIndex] = true;
+                }
+                catch (const Exception& e)
+                {
+                    funcSink->diagnose(SourceLoc(), Diagnostics::compilationAbortedDueToException, typeid(e).name(), e.Message);
+                    funcAborted[funcIndex] = true;
+                }
+                catch (...)
+                {
+                    funcSink->diagnose(SourceLoc(), Diagnostics::compilationAborted);
+                    funcAborted[funcIndex] = true;
+                }
+            }
+        };
+
+        {
+            ConcurrentScope concurrentScope;
+
+            // The calling thread does work too, so we need one less additional thread
+            List<std::thread> threads;
+            for (Index i = 1; i < threadCount; ++i)
+            {
+                threads.add(std::thread([&]()
+                {
+                    ConcurrentScope::Thread scopeThread(&concurrentScope);
+                    checkFuncs();
+                }));
+            }
+            checkFuncs();
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+        }
+
+        bool aborted = false;
+        for (Index i = 0; i < funcCount; ++i)
+        {
+            funcs[i]->setCheckState(DeclCheckState::Checked);
+            sink->appendOutputFrom(funcSinks[i]);
+            aborted = aborted || funcAborted[i];
+        }
+
+        if (aborted)
+        {
+            SLANG_ABORT_COMPILATION("function body checking aborted");
+        }
+    }
+
+        /// Get the number of threads to check function bodies in `moduleDecl` on
+    static Count _getCheckThreadCount(SemanticsDeclVisitorBase* visitor, ModuleDecl* moduleDecl)
+    {
+        auto linkage = visitor->getLinkage();
+
+        // The standard library is checked once per session, and the language server only
+        // checks the bodies of functions it needs to, so both are checked serially.
+        if (isFromStdLib(moduleDecl) || linkage->isInLanguageServer())
+        {
+            return 1;
+        }
+
+        // Checking shares the AST (and other reference counted objects) between threads
+        if (!ConcurrentScope::isSupported())
+        {
+            return 1;
+        }
+
+        Count threadCount = linkage->m_checkThreadCount;
+        if (threadCount <= 0)
+        {
+            threadCount = Count(std::thread::hardware_concurrency());
+        }
+        return threadCount;
+    }
+
     void SemanticsDeclVisitorBase::checkModule(ModuleDecl* moduleDecl)
     {
         // When we are dealing with code from the standard library,
@@ -1872,6 +2117,7 @@ namespace Slang
             DeclCheckState::ReadyForLookup,
             DeclCheckState::Checked
         };
+        const Count checkThreadCount = _getCheckThreadCount(this, moduleDecl);
         for(auto s : states)
         {
             // When advancing to state `s` we will recursively
@@ -1888,6 +2134,14 @@ namespace Slang
             // to the subset of declarations coming from a given source
             // file.
             //
+            // The bodies of functions can optionally be checked concurrently
+            // in the final push (see `_checkAllDeclsConcurrently`).
+            //
+            if (s == DeclCheckState::Checked && checkThreadCount > 1)
+            {
+                _checkAllDeclsConcurrently(this, moduleDecl, checkThreadCount);
+                continue;
+            }
             _ensureAllDeclsRec(this, moduleDecl, s);
         }
 
@@ -1660,6 +1660,7 @@ namespace Slang
             if (key.fromOperatorExpr(opExpr))
             {
                 OverloadCandidate candidate;
+                SharedStateLock lock;
                 if (typeCheckingCache->resolvedOperatorOverloadCache.TryGetValue(key, candidate))
                 {
                     context.bestCandidateStorage = candidate;
@@ -1843,7 +1844,10 @@ namespace Slang
             // We will report errors for this one candidate, then, to give
             // the user the most help we can.
             if (shouldAddToCache)
+            {
+                SharedStateLock lock;
                 typeCheckingCache->resolvedOperatorOverloadCache[key] = *context.bestCandidate;
+            }
             return CompleteOverloadCandidate(context, *context.bestCandidate);
         }
         else
@@ -73,6 +73,7 @@ namespace Slang
 
             // Set the loader
             m_sharedLibraryLoader = loader;
+            m_hashGeneration++;
         }
     }
 
@@ -81,10 +82,16 @@ namespace Slang
         // Mark as initialized
         m_downstreamCompilerInitialized &= ~(1 << int(type));
         m_downstreamCompilers[int(type)].setNull();
+        // The compiler (and so its version) may be different when it is next loaded
+        m_hashGeneration++;
     }
 
     IDownstreamCompiler* Session::getOrLoadDownstreamCompiler(PassThroughMode type, DiagnosticSink* sink)
     {
+        // Code generation for entry points may run on several threads, which can all ask for
+        // a compiler. The lock is recursive because loading the generic C/C++ compiler loads the others.
+        std::lock_guard<std::recursive_mutex> lock(m_downstreamCompilerMutex);
+
         if (m_downstreamCompilerInitialized & (1 << int(type)))
         {
             return m_downstreamCompilers[int(type)];
@@ -21,6 +21,7 @@
 #include "../compiler-core/slang-artifact-util.h"
 #include "../compiler-core/slang-artifact-associated.h"
 #include "../compiler-core/slang-artifact-diagnostic-util.h"
+#include "../compiler-core/slang-downstream-compile-cache.h"
 
 // Artifact output
 #include "slang-artifact-output-util.h"
@@ -38,6 +39,10 @@
 #include "slang-serialize-ast.h"
 #include "slang-serialize-container.h"
 
+#include <atomic>
+#include <thread>
+#include <typeinfo>
+
 namespace Slang
 {
 
@@ -887,6 +892,84 @@ namespace Slang
         }
     }
 
+    static void _reportDownstreamDiagnostics(IDownstreamCompiler* compiler, IArtifactDiagnostics* diagnostics, DiagnosticSink* sink)
+    {
+        if (diagnostics->getCount())
+        {
+            StringBuilder compilerText;
+            DownstreamCompilerUtil::appendAsText(compiler->getDesc(), compilerText);
+
+            StringBuilder builder;
+
+            auto const diagnosticCount = diagnostics->getCount();
+            for (Index i = 0; i < diagnosticCount; ++i)
+            {
+                const auto& diagnostic = *diagnostics->getAt(i);
+
+                builder.Clear();
+
+                const Severity severity = _getDiagnosticSeverity(diagnostic.severity);
+                
+                if (diagnostic.filePath.count == 0 && diagnostic.location.line == 0 && severity == Severity::Note)
+                {
+                    // If theres no filePath line number and it's info, output severity and text alone
+                    builder << getSeverityName(severity) << " : ";
+                }
+                else
+                {
+                    if (diagnostic.filePath.count)
+                    {
+                        builder << asStringSlice(diagnostic.filePath);
+                    }
+
+                    if (diagnostic.location.line)
+                    {
+                        builder << "(" << diagnostic.location.line <<")";
+                    }
+
+                    builder << ": ";
+
+                    if (diagnostic.stage == ArtifactDiagnostic::Stage::Link)
+                    {
+                        builder << "link ";
+                    }
+
+                    builder << getSeverityName(severity);
+                    builder << " " << asStringSlice(diagnostic.code) << ": ";
+                }
+
+                builder << asStringSlice(diagnostic.text);
+                reportExternalCompileError(compilerText.getBuffer(), severity, SLANG_OK, builder.getUnownedSlice(), sink);
+            }
+        }
+    }
+
+    static DownstreamCompileOptions::OptimizationLevel _getDownstreamOptimizationLevel(OptimizationLevel level)
+    {
+        switch (level)
+        {
+            case OptimizationLevel::None:       return DownstreamCompileOptions::OptimizationLevel::None;
+            case OptimizationLevel::Default:    return DownstreamCompileOptions::OptimizationLevel::Default;
+            case OptimizationLevel::High:       return DownstreamCompileOptions::OptimizationLevel::High;
+            case OptimizationLevel::Maximal:    return DownstreamCompileOptions::OptimizationLevel::Maximal;
+            default: SLANG_ASSERT(!"Unhandled optimization level"); break;
+        }
+        return DownstreamCompileOptions::OptimizationLevel::Default;
+    }
+
+    static DownstreamCompileOptions::DebugInfoType _getDownstreamDebugInfoType(DebugInfoLevel level)
+    {
+        switch (level)
+        {
+            case DebugInfoLevel::None:          return DownstreamCompileOptions::DebugInfoType::None;
+            case DebugInfoLevel::Minimal:       return DownstreamCompileOptions::DebugInfoType::Minimal;
+            case DebugInfoLevel::Standard:      return DownstreamCompileOptions::DebugInfoType::Standard;
+            case DebugInfoLevel::Maximal:       return DownstreamCompileOptions::DebugInfoType::Maximal;
+            default: SLANG_ASSERT(!"Unhandled debug level"); break;
+        }
+        return DownstreamCompileOptions::DebugInfoType::Standard;
+    }
+
     static RefPtr<ExtensionTracker> _newExtensionTracker(CodeGenTarget target)
     {
         switch (target)
@@ -1237,6 +1320,11 @@ namespace Slang
             
             options.stage = SlangStage(profile.getStage());
 
+            if (compilerType == PassThroughMode::Glslang && targetReq->shouldValidateSPIRV())
+            {
+                options.flags |= CompileOptions::Flag::Validate;
+            }
+
             if (compilerType == PassThroughMode::Dxc)
             {
                 // We will enable the flag to generate proper code for 16 - bit types
@@ -1293,24 +1381,8 @@ namespace Slang
         {
             auto linkage = getLinkage();
 
-            switch (linkage->optimizationLevel)
-            {
-                case OptimizationLevel::None:       options.optimizationLevel = DownstreamCompileOptions::OptimizationLevel::None; break;
-                case OptimizationLevel::Default:    options.optimizationLevel = DownstreamCompileOptions::OptimizationLevel::Default;  break;
-                case OptimizationLevel::High:       options.optimizationLevel = DownstreamCompileOptions::OptimizationLevel::High;  break;
-                case OptimizationLevel::Maximal:    options.optimizationLevel = DownstreamCompileOptions::OptimizationLevel::Maximal;  break;
-                default: SLANG_ASSERT(!"Unhandled optimization level"); break;
-            }
-
-            switch (linkage->debugInfoLevel)
-            {
-                case DebugInfoLevel::None:          options.debugInfoType = DownstreamCompileOptions::DebugInfoType::None; break;
-                case DebugInfoLevel::Minimal:       options.debugInfoType = DownstreamCompileOptions::DebugInfoType::Minimal; break;
-                
-                case DebugInfoLevel::Standard:      options.debugInfoType = DownstreamCompileOptions::DebugInfoType::Standard; break;
-                case DebugInfoLevel::Maximal:       options.debugInfoType = DownstreamCompileOptions::DebugInfoType::Maximal; break;
-                default: SLANG_ASSERT(!"Unhandled debug level"); break;
-            }
+            options.optimizationLevel = _getDownstreamOptimizationLevel(linkage->optimizationLevel);
+            options.debugInfoType = _getDownstreamDebugInfoType(linkage->debugInfoLevel);
 
             switch( getTargetReq()->getFloatingPointMode())
             {
@@ -1403,75 +1475,136 @@ namespace Slang
         // Compile
         ComPtr<IArtifact> artifact;
         auto downstreamStartTime = std::chrono::high_resolution_clock::now();
-        SLANG_RETURN_ON_FAIL(compiler->compile(options, artifact.writeRef()));
+        {
+            PerfTraceScope perfScope(getPerfTrace(), "downstream", TypeTextUtil::getPassThroughName(SlangPassThrough(compilerType)));
+            if (auto downstreamCache = getLinkage()->getDownstreamCache())
+            {
+                SLANG_RETURN_ON_FAIL(DownstreamCompileCacheUtil::compile(downstreamCache, compiler, options, artifact.writeRef()));
+            }
+            else
+            {
+                SLANG_RETURN_ON_FAIL(compiler->compile(options, artifact.writeRef()));
+            }
+        }
         auto downstreamElapsedTime =
             (std::chrono::high_resolution_clock::now() - downstreamStartTime).count() * 0.000000001;
         getSession()->addDownstreamCompileTime(downstreamElapsedTime);
 
         auto diagnostics = findAssociated<IArtifactDiagnostics>(artifact);
 
-        if (diagnostics->getCount())
+        _reportDownstreamDiagnostics(compiler, diagnostics, sink);
+
+        // If any errors are emitted, then we are done
+        if (diagnostics->hasOfAtLeastSeverity(ArtifactDiagnostic::Severity::Error))
         {
-            StringBuilder compilerText;
-            DownstreamCompilerUtil::appendAsText(compiler->getDesc(), compilerText);
+            return SLANG_FAIL;
+        }
 
-            StringBuilder builder;
+        if (metadata)
+        {
+            artifact->addAssociated(metadata);
+        }
 
-            auto const diagnosticCount = diagnostics->getCount();
-            for (Index i = 0; i < diagnosticCount; ++i)
-            {
-                const auto& diagnostic = *diagnostics->getAt(i);
+        // Set the artifact
+        outArtifact.swap(artifact);
+        return SLANG_OK;
+    }
 
-                builder.Clear();
+    SlangResult CodeGenContext::_optimizeSPIRVWithDownstream(ComPtr<IArtifact>& ioArtifact)
+    {
+        auto linkage = getLinkage();
+        auto targetReq = getTargetReq();
 
-                const Severity severity = _getDiagnosticSeverity(diagnostic.severity);
-                
-                if (diagnostic.filePath.count == 0 && diagnostic.location.line == 0 && severity == Severity::Note)
-                {
-                    // If theres no filePath line number and it's info, output severity and text alone
-                    builder << getSeverityName(severity) << " : ";
-                }
-                else
-                {
-                    if (diagnostic.filePath.count)
-                    {
-                        builder << asStringSlice(diagnostic.filePath);
-                    }
+        // Both are opt in, so by default the output is exactly what the emitter produced
+        const bool shouldOptimize = targetReq->shouldOptimizeDirectSPIRV() && linkage->optimizationLevel != OptimizationLevel::None;
+        const bool shouldValidate = targetReq->shouldValidateSPIRV();
 
-                    if (diagnostic.location.line)
-                    {
-                        builder << "(" << diagnostic.location.line <<")";
-                    }
+        if (!shouldOptimize && !shouldValidate)
+        {
+            return SLANG_OK;
+        }
 
-                    builder << ": ";
+        // SPIR-V is optimized with SPIRV-Tools in the glslang library. Without it the output
+        // is still valid, just unoptimized, so it's not an error if it's not available.
+        auto session = getSession();
+        IDownstreamCompiler* compiler = session->getOrLoadDownstreamCompiler(PassThroughMode::Glslang, nullptr);
+        if (!compiler)
+        {
+            return SLANG_OK;
+        }
 
-                    if (diagnostic.stage == ArtifactDiagnostic::Stage::Link)
-                    {
-                        builder << "link ";
-                    }
+        auto sink = getSink();
 
-                    builder << getSeverityName(severity);
-                    builder << " " << asStringSlice(diagnostic.code) << ": ";
+        // Arguments for glslang are the spirv-opt style flags of the passes to run
+        List<String> compilerSpecificArguments;
+        {
+            const Index nameIndex = linkage->m_downstreamArgs.findName(TypeTextUtil::getPassThroughName(SLANG_PASS_THROUGH_GLSLANG));
+            if (nameIndex >= 0)
+            {
+                for (const auto& arg : linkage->m_downstreamArgs.getArgsAt(nameIndex).m_args)
+                {
+                    compilerSpecificArguments.add(arg.value);
                 }
+            }
+        }
 
-                builder << asStringSlice(diagnostic.text);
-                reportExternalCompileError(compilerText.getBuffer(), severity, SLANG_OK, builder.getUnownedSlice(), sink);
+        SliceAllocator allocator;
+        IArtifact* sourceArtifacts[] = { ioArtifact };
+
+        DownstreamCompileOptions options;
+        options.sourceLanguage = SLANG_SOURCE_LANGUAGE_UNKNOWN;
+        options.targetType = SLANG_SPIRV;
+        options.optimizationLevel = shouldOptimize ? _getDownstreamOptimizationLevel(linkage->optimizationLevel) : DownstreamCompileOptions::OptimizationLevel::None;
+        options.debugInfoType = _getDownstreamDebugInfoType(linkage->debugInfoLevel);
+        options.sourceArtifacts = makeSlice(sourceArtifacts, 1);
+        if (shouldOptimize)
+        {
+            options.compilerSpecificArguments = allocator.allocate(compilerSpecificArguments);
+        }
+        if (shouldValidate)
+        {
+            options.flags |= DownstreamCompileOptions::Flag::Validate;
+        }
+
+        ComPtr<IArtifact> artifact;
+        SlangResult compileResult = SLANG_OK;
+        auto downstreamStartTime = std::chrono::high_resolution_clock::now();
+        {
+            PerfTraceScope perfScope(getPerfTrace(), "downstream", "spirv-opt");
+            if (auto downstreamCache = linkage->getDownstreamCache())
+            {
+                compileResult = DownstreamCompileCacheUtil::compile(downstreamCache, compiler, options, artifact.writeRef());
+            }
+            else
+            {
+                compileResult = compiler->compile(options, artifact.writeRef());
             }
         }
+        auto downstreamElapsedTime =
+            (std::chrono::high_resolution_clock::now() - downstreamStartTime).count() * 0.000000001;
+        session->addDownstreamCompileTime(downstreamElapsedTime);
+
+        // The glslang library is too old to optimize SPIR-V, so it's output as it is
+        if (compileResult == SLANG_E_NOT_AVAILABLE)
+        {
+            return SLANG_OK;
+        }
+        SLANG_RETURN_ON_FAIL(compileResult);
+
+        auto diagnostics = findAssociated<IArtifactDiagnostics>(artifact);
+        _reportDownstreamDiagnostics(compiler, diagnostics, sink);
 
-        // If any errors are emitted, then we are done
         if (diagnostics->hasOfAtLeastSeverity(ArtifactDiagnostic::Severity::Error))
         {
             return SLANG_FAIL;
         }
 
-        if (metadata)
+        if (auto metadata = findAssociated<IArtifactPostEmitMetadata>(ioArtifact))
         {
             artifact->addAssociated(metadata);
         }
 
-        // Set the artifact
-        outArtifact.swap(artifact);
+        ioArtifact.swap(artifact);
         return SLANG_OK;
     }
 
@@ -1521,6 +1654,7 @@ namespace Slang
                 if (getTargetReq()->shouldEmitSPIRVDirectly())
                 {
                     SLANG_RETURN_ON_FAIL(emitSPIRVForEntryPointsDirectly(this, outArtifact));
+                    SLANG_RETURN_ON_FAIL(_optimizeSPIRVWithDownstream(outArtifact));
                     return SLANG_OK;
                 }
                 /* fall through to: */
@@ -1741,6 +1875,148 @@ namespace Slang
         return m_entryPointResults[entryPointIndex];
     }
 
+    void TargetProgram::_createEntryPointResultsConcurrently(
+        Count                   threadCount,
+        DiagnosticSink*         sink,
+        EndToEndCompileRequest* endToEndReq)
+    {
+        const Count entryPointCount = m_program->getEntryPointCount();
+        if (entryPointCount > m_entryPointResults.getCount())
+            m_entryPointResults.setCount(entryPointCount);
+
+        if (!ConcurrentScope::isSupported())
+        {
+            // Code generation shares reference counted objects between threads
+            threadCount = 1;
+        }
+        else if (threadCount <= 0)
+        {
+            threadCount = Count(std::thread::hardware_concurrency());
+        }
+        threadCount = Math::Min(threadCount, entryPointCount);
+
+        // The layout IR module is shared by all entry points, so make sure it is created
+        // before any work starts.
+        if (threadCount <= 1 || !getOrCreateIRModuleForLayout(sink))
+        {
+            for (Index i = 0; i < entryPointCount; ++i)
+            {
+                _createEntryPointResult(i, sink, endToEndReq);
+            }
+            return;
+        }
+
+        PerfTraceScope perfScope(m_program->getLinkage()->getPerfTrace(), "codegen", "entryPointsConcurrent");
+
+        // The IR of a module may be created on first use (see `Module::getIRModule`), so make
+        // sure all of the IR that linking will use exists before any work starts.
+        {
+            auto session = m_program->getLinkage()->getSessionImpl();
+            for (auto& stdlibModule : session->stdlibModules)
+            {
+                stdlibModule->getIRModule();
+            }
+            m_program->enumerateIRModules([](IRModule*) {});
+
+            // Downstream compilers are loaded on first use. Load the ones code generation for
+            // the target can use now, so the workers only ever find them already loaded.
+            // For SPIR-V that includes glslang, which also optimizes SPIR-V that is emitted directly.
+            const CodeGenTarget target = m_targetReq->getTarget();
+            const PassThroughMode requiredCompiler = getDownstreamCompilerRequiredForTarget(target);
+            if (requiredCompiler != PassThroughMode::None)
+            {
+                session->getOrLoadDownstreamCompiler(requiredCompiler, nullptr);
+
+                const PassThroughMode transitionCompiler = PassThroughMode(session->getDownstreamCompilerForTransition(
+                    SlangCompileTarget(_getDefaultSourceForTarget(target)), SlangCompileTarget(target)));
+                if (transitionCompiler != PassThroughMode::None)
+                {
+                    session->getOrLoadDownstreamCompiler(transitionCompiler, nullptr);
+                }
+            }
+        }
+
+        // Each entry point has its own sink, so that diagnostics can be output in entry point
+        // order. Aborting compilation (for example from a fatal diagnostic) is deferred until
+        // all of the diagnostics have been output.
+        List<DiagnosticSink> entryPointSinks;
+        List<bool> entryPointAborted;
+        entryPointSinks.setCount(entryPointCount);
+        entryPointAborted.setCount(entryPointCount);
+        for (Index i = 0; i < entryPointCount; ++i)
+        {
+            entryPointSinks[i].initFrom(*sink);
+            entryPointAborted[i] = false;
+        }
+
+        std::atomic<Index> nextEntryPointIndex(0);
+
+        auto generateEntryPoints = [&]()
+        {
+            for (;;)
+            {
+                const Index entryPointIndex = nextEntryPointIndex++;
+                if (entryPointIndex >= entryPointCount)
+                {
+                    break;
+                }
+
+                DiagnosticSink* entryPointSink = &entryPointSinks[entryPointIndex];
+                try
+                {
+                    _createEntryPointResult(entryPointIndex, entryPointSink, endToEndReq);
+                }
+                catch (const AbortCompilationException&)
+                {
+                    entryPointAborted[entryPointIndex] = true;
+                }
+                catch (const Exception& e)
+                {
+                    entryPointSink->diagnose(SourceLoc(), Diagnostics::compilationAbortedDueToException, typeid(e).name(), e.Message);
+                    entryPointAborted[entryPointIndex] = true;
+                }
+                catch (...)
+                {
+                    entryPointSink->diagnose(SourceLoc(), Diagnostics::compilationAborted);
+                    entryPointAborted[entryPointIndex] = true;
+                }
+            }
+        };
+
+        {
+            // Code generation reads the AST, which can create and share nodes
+            ConcurrentScope concurrentScope;
+
+            // The calling thread does work too, so we need one less additional thread
+            List<std::thread> threads;
+            for (Index i = 1; i < threadCount; ++i)
+            {
+                threads.add(std::thread([&]()
+                {
+                    ConcurrentScope::Thread scopeThread(&concurrentScope);
+                    generateEntryPoints();
+                }));
+            }
+            generateEntryPoints();
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+        }
+
+        bool aborted = false;
+        for (Index i = 0; i < entryPointCount; ++i)
+        {
+            sink->appendOutputFrom(entryPointSinks[i]);
+            aborted = aborted || entryPointAborted[i];
+        }
+
+        if (aborted)
+        {
+            SLANG_ABORT_COMPILATION("entry point code generation aborted");
+        }
+    }
+
     IArtifact* TargetProgram::getOrCreateWholeProgramResult(
         DiagnosticSink* sink)
     {
@@ -1796,6 +2072,13 @@ namespace Slang
         {
             targetProgram->_createWholeProgramResult(getSink(), this);
         }
+        else if (getLinkage()->m_codeGenThreadCount != 1 && m_passThrough == PassThroughMode::None)
+        {
+            targetProgram->_createEntryPointResultsConcurrently(
+                getLinkage()->m_codeGenThreadCount,
+                getSink(),
+                this);
+        }
         else
         {
             for (Index ii = 0; ii < entryPointCount; ++ii)
@@ -2025,6 +2308,9 @@ namespace Slang
         auto linkage = getLinkage();
         for (auto targetReq : linkage->targets)
         {
+            // Trace each target on its own, so the cost of each can be told apart
+            PerfTraceScope perfScope(linkage->getPerfTrace(), "codegen", TypeTextUtil::getCompileTargetName(SlangCompileTarget(targetReq->getTarget())));
+
             auto targetProgram = program->getTargetProgram(targetReq);
             generateOutput(targetProgram);
         }
@@ -2222,4 +2508,22 @@ namespace Slang
         }
         return false;
     }
+
+    bool CodeGenContext::isSpecializationCacheDisabled()
+    {
+        if (auto endToEndReq = isEndToEndCompile())
+        {
+            return endToEndReq->disableSpecializationCache;
+        }
+        return false;
+    }
+
+    bool CodeGenContext::isIncrementalSimplificationDisabled()
+    {
+        if (auto endToEndReq = isEndToEndCompile())
+        {
+            return endToEndReq->disableIncrementalSimplification;
+        }
+        return false;
+    }
 }
@@ -4,6 +4,8 @@
 #include "../core/slang-basic.h"
 #include "../core/slang-shared-library.h"
 #include "../core/slang-crypto.h"
+#include "../core/slang-persistent-cache.h"
+#include "../core/slang-cancellation-token.h"
 
 #include "../compiler-core/slang-downstream-compiler.h"
 #include "../compiler-core/slang-downstream-compiler-util.h"
@@ -18,11 +20,13 @@
 
 #include "slang-capability.h"
 #include "slang-diagnostics.h"
+#include "slang-ir-specialization-cache.h"
 
 #include "slang-preprocessor.h"
 #include "slang-profile.h"
 #include "slang-syntax.h"
 #include "slang-content-assist-info.h"
+#include "slang-perf-trace.h"
 
 #include "slang-serialize-ir-types.h"
 
@@ -30,15 +34,21 @@
 
 #include "../../slang.h"
 
+#include <atomic>
+#include <mutex>
+
 namespace Slang
 {
     struct PathInfo;
     struct IncludeHandler;
+    struct IRFunc;
+    struct IRVarLayout;
     class ProgramLayout;
     class PtrType;
     class TargetProgram;
     class TargetRequest;
     class TypeLayout;
+    class TypeLayoutCache;
     class Artifact;
 
     enum class CompilerMode
@@ -1174,6 +1184,19 @@ namespace Slang
 
     class SourceFile;
 
+        /// Creates the IR for a module on demand.
+        ///
+        /// Used for modules that are loaded from a serialized form, where producing
+        /// the IR is expensive and it may never be needed (for example if only the
+        /// front end is used).
+        ///
+    class IRModuleFactory : public RefObject
+    {
+    public:
+            /// Create the IR module. Returns nullptr on failure.
+        virtual RefPtr<IRModule> createIRModule() = 0;
+    };
+
         /// A module of code that has been compiled through the front-end
         ///
         /// A module comprises all the code from one translation unit (which
@@ -1295,8 +1318,11 @@ namespace Slang
             /// Get the AST for the module (if it has been parsed)
         ModuleDecl* getModuleDecl() { return m_moduleDecl; }
 
-            /// The the IR for the module (if it has been generated)
-        IRModule* getIRModule() { return m_irModule; }
+            /// The the IR for the module (if it has been generated).
+            /// If the module was set up with an `IRModuleFactory` the IR is created on first use.
+            /// Modules (such as the stdlib modules) may be shared by sessions used on different threads,
+            /// so the IR is only created once, by whichever thread gets it first.
+        IRModule* getIRModule();
 
             /// Get the list of other modules this module depends on
         List<Module*> const& getModuleDependencyList() { return m_moduleDependencyList.getModuleList(); }
@@ -1322,6 +1348,13 @@ namespace Slang
             ///
         void setIRModule(IRModule* irModule) { m_irModule = irModule; }
 
+            /// Set a factory to create the IR for this module when it is first needed.
+            ///
+            /// This should only be called once, during creation of the module, and
+            /// instead of `setIRModule`.
+            ///
+        void setIRModuleFactory(IRModuleFactory* factory) { m_irModuleFactory = factory; }
+
         Index getEntryPointCount() SLANG_OVERRIDE { return 0; }
         RefPtr<EntryPoint> getEntryPoint(Index index) SLANG_OVERRIDE { SLANG_UNUSED(index); return nullptr; }
         String getEntryPointMangledName(Index index) SLANG_OVERRIDE { SLANG_UNUSED(index); return String(); }
@@ -1374,6 +1407,8 @@ namespace Slang
 
         List<RefPtr<EntryPoint>> const& getEntryPoints() { return m_entryPoints; }
         void _addEntryPoint(EntryPoint* entryPoint);
+            /// Add an entry point for each function in the module with a `[shader(...)]` attribute
+        void _discoverEntryPoints(DiagnosticSink* sink);
         void _processFindDeclsExportSymbolsRec(Decl* decl);
 
     protected:
@@ -1391,6 +1426,11 @@ namespace Slang
         // The IR for the module
         RefPtr<IRModule> m_irModule = nullptr;
 
+        // If set, used to create m_irModule on first use
+        RefPtr<IRModuleFactory> m_irModuleFactory;
+        // Makes sure m_irModule is only created from m_irModuleFactory once
+        std::once_flag m_irModuleOnceFlag;
+
         List<ShaderParamInfo> m_shaderParams;
         SpecializationParams m_specializationParams;
 
@@ -1533,27 +1573,32 @@ namespace Slang
         void addTargetFlags(SlangTargetFlags flags)
         {
             targetFlags |= flags;
+            hashGeneration++;
         }
-        void setTargetProfile(Slang::Profile profile)
-        {
-            targetProfile = profile;
-        }
+        void setTargetProfile(Slang::Profile profile);
         void setFloatingPointMode(FloatingPointMode mode)
         {
             floatingPointMode = mode;
+            hashGeneration++;
         }
         void setLineDirectiveMode(LineDirectiveMode mode)
         {
             lineDirectiveMode = mode;
+            hashGeneration++;
         }
         
         void setDumpIntermediates(bool value)
         {
             dumpIntermediates = value;
+            hashGeneration++;
         }
-        void setForceGLSLScalarBufferLayout(bool value)
+        void setForceGLSLScalarBufferLayout(bool value);
+            /// Set the number of compute threads of a group run at once in SIMD lanes on CPU targets.
+            /// 0 runs threads with scalar loops.
+        void setCPUSIMDLaneCount(Count value)
         {
-            forceGLSLScalarBufferLayout = value;
+            cpuSIMDLaneCount = value;
+            hashGeneration++;
         }
 
         void addCapability(CapabilityAtom capability);
@@ -1568,9 +1613,24 @@ namespace Slang
             return (targetFlags & SLANG_TARGET_FLAG_GENERATE_WHOLE_PROGRAM) != 0;
         }
 
+        bool shouldLinkOnce()
+        {
+            return (targetFlags & SLANG_TARGET_FLAG_LINK_ONCE) != 0;
+        }
+
+        bool shouldOptimizeDirectSPIRV()
+        {
+            return (targetFlags & SLANG_TARGET_FLAG_OPTIMIZE_DIRECT_SPIRV) != 0;
+        }
+
+        bool shouldValidateSPIRV()
+        {
+            return (targetFlags & SLANG_TARGET_FLAG_VALIDATE_SPIRV) != 0;
+        }
+
         bool shouldDumpIntermediates() { return dumpIntermediates; }
 
-        void setTrackLiveness(bool enable) { enableLivenessTracking = enable; }
+        void setTrackLiveness(bool enable) { enableLivenessTracking = enable; hashGeneration++; }
 
         bool shouldTrackLiveness() { return enableLivenessTracking; }
 
@@ -1582,6 +1642,11 @@ namespace Slang
         SlangTargetFlags getTargetFlags() { return targetFlags; }
         CapabilitySet getTargetCaps();
         bool getForceGLSLScalarBufferLayout() { return forceGLSLScalarBufferLayout; }
+        Count getCPUSIMDLaneCount() { return cpuSIMDLaneCount; }
+
+            /// Get the generation of the target's options. It changes whenever an option is set,
+            /// so a digest of the options made at another generation is stale.
+        Count getHashGeneration() const { return hashGeneration; }
 
         Session* getSession();
         MatrixLayoutMode getDefaultMatrixLayoutMode();
@@ -1593,6 +1658,11 @@ namespace Slang
 
         TypeLayout* getTypeLayout(Type* type);
 
+            /// Get the cache of type layouts made for this target, shared by parameter binding and reflection
+        TypeLayoutCache* getTypeLayoutCache();
+            /// Drop the cached type layouts, when an option they depend on is changed
+        void invalidateTypeLayoutCache();
+
     private:
         Linkage*                linkage = nullptr;
         CodeGenTarget           format = CodeGenTarget::Unknown;
@@ -1605,6 +1675,9 @@ namespace Slang
         bool                    dumpIntermediates = false;
         bool                    forceGLSLScalarBufferLayout = false;
         bool                    enableLivenessTracking = false;
+        Count                   cpuSIMDLaneCount = 0;
+        Count                   hashGeneration = 0;
+        RefPtr<TypeLayoutCache> typeLayoutCache;
     };
 
         /// Are we generating code for a D3D API?
@@ -1720,12 +1793,23 @@ namespace Slang
             ISlangBlob** outDiagnostics) override;
         SLANG_NO_THROW SlangResult SLANG_MCALL createCompileRequest(
             SlangCompileRequest**   outCompileRequest) override;
+        SLANG_NO_THROW SlangResult SLANG_MCALL getPerfTrace(
+            SlangPerfTraceFormat    format,
+            ISlangBlob**            outBlob) override;
 
         // Updates the supplied builder with linkage-related information, which includes preprocessor
         // defines, the compiler version, and other compiler options. This is then merged with the hash
         // produced for the program to produce a key that can be used with the shader cache.
         void buildHash(DigestBuilder<SHA1>& builder, SlangInt targetIndex);
 
+            /// Get the digest of what `buildHash` adds for the target.
+            /// The digest is calculated on the first request for each target, and is only recalculated
+            /// after `invalidateHashes` (which changing options through the linkage, adding a target or
+            /// starting a compile does), or when the options of the target or global session have changed.
+        const SHA1::Digest& getHash(SlangInt targetIndex);
+            /// Discard the digests held for each target
+        void invalidateHashes() { m_hashForTarget.Clear(); }
+
         void addTarget(
             slang::TargetDesc const& desc);
         SlangResult addSearchPath(
@@ -1800,6 +1884,9 @@ namespace Slang
         // Map from the logical name of a module to its definition
         Dictionary<Name*, RefPtr<LoadedModule>> mapNameToLoadedModules;
 
+        // Modules that have been unloaded with `unloadModulesDependingOnFiles`, or whose checking was abandoned
+        List<RefPtr<LoadedModule>> m_unloadedModules;
+
         // Map from the mangled name of RTTI objects to sequential IDs
         // used by `switch`-based dynamic dispatch.
         Dictionary<String, uint32_t> mapMangledNameToRTTIObjectIndex;
@@ -1811,6 +1898,15 @@ namespace Slang
         List<RefPtr<IRModule>> compiledModules;
 
         ContentAssistInfo contentAssistInfo;
+
+            /// If set, semantic checking stops between declarations once cancellation is requested
+            /// (by throwing AbortCompilationException). A module whose checking was stopped is unloaded.
+        RefPtr<CancellationToken> m_cancellationToken;
+
+            /// True if cancellation of the current operation on the linkage has been requested
+        bool isCancelled() { return m_cancellationToken && m_cancellationToken->isCancelled(); }
+            /// True if cancellation has already been requested, without checking whether to cancel
+        bool isCancellationRequested() { return m_cancellationToken && m_cancellationToken->isCancellationRequested(); }
         
         /// File system implementation to use when loading files from disk.
         ///
@@ -1870,6 +1966,19 @@ namespace Slang
             DiagnosticSink*     sink,
             const LoadedModuleDictionary* loadedModules = nullptr);
 
+            /// Unload the loaded modules that depend on any of the files in `paths` (matched against the
+            /// unique identity or found path of the files), such that they are loaded and checked again
+            /// the next time they are needed. The files are also dropped from the source manager and
+            /// file system caches, so that their current contents is read. Prior failed loads are
+            /// forgotten, as the files may now be found.
+            ///
+            /// The unloaded modules are kept alive (see m_unloadedModules), as types and other
+            /// objects cached on the linkage may still reference them.
+        void unloadModulesDependingOnFiles(const HashSet<String>& paths);
+
+            /// Get the number of modules unloaded by `unloadModulesDependingOnFiles`
+        Count getUnloadedModuleCount() const { return m_unloadedModules.getCount(); }
+
         SourceManager* getSourceManager()
         {
             return m_sourceManager;
@@ -1901,13 +2010,59 @@ namespace Slang
 
         OptimizationLevel optimizationLevel = OptimizationLevel::Default;
 
-        SerialCompressionType serialCompressionType = SerialCompressionType::VariableByteLite;
+        SerialCompressionType serialCompressionType = SerialCompressionType::None;
 
         DiagnosticSink::Flags diagnosticSinkFlags = 0;
 
         bool m_requireCacheFileSystem = false;
         bool m_useFalcorCustomSharedKeywordSemantics = false;
 
+            /// The number of threads used to generate code for entry points. 1 generates serially,
+            /// 0 means use all hardware threads.
+        Count m_codeGenThreadCount = 1;
+
+            /// The number of threads used to check the bodies of functions in a module. 1 checks serially,
+            /// 0 means use all hardware threads.
+        Count m_checkThreadCount = 1;
+
+            /// Get the performance trace. Returns nullptr if tracing is not enabled.
+        PerfTrace* getPerfTrace() { return m_perfTrace; }
+            /// Enable or disable performance tracing. Enabling when already enabled retains the current trace.
+        void setPerfTraceEnabled(bool enable);
+            /// Write the trace in the specified format into a blob
+        SlangResult writePerfTrace(SlangPerfTraceFormat format, ISlangBlob** outBlob);
+
+        RefPtr<PerfTrace> m_perfTrace;
+
+            /// Get the persistent cache of checked modules. Returns nullptr if module caching is not enabled.
+        PersistentCache* getModuleCache() { return m_moduleCache; }
+            /// Set the directory of the module cache. An empty path disables module caching.
+        void setModuleCachePath(const String& path);
+
+        RefPtr<PersistentCache> m_moduleCache;
+
+            /// A digest calculated by getHash, along with the generations of the options it was calculated from
+        struct HashEntry
+        {
+            SHA1::Digest digest;
+            Count targetGeneration = 0;
+            Count sessionGeneration = 0;
+        };
+        Dictionary<SlangInt, HashEntry> m_hashForTarget;
+
+            /// Get the persistent cache of downstream compiler products. Returns nullptr if not enabled.
+        PersistentCache* getDownstreamCache() { return m_downstreamCache; }
+            /// Set the directory of the downstream cache. An empty path disables the cache.
+        void setDownstreamCachePath(const String& path);
+
+        RefPtr<PersistentCache> m_downstreamCache;
+
+            /// Get the cache of tokens of files included with `#include`, shared by all translation units
+            /// preprocessed with the linkage
+        IncludeTokenCache* getIncludeTokenCache() { return m_includeTokenCache; }
+
+        RefPtr<IncludeTokenCache> m_includeTokenCache;
+
         // Modules that have been read in with the -r option
         List<ComPtr<IArtifact>> m_libModules;
 
@@ -1960,6 +2115,11 @@ namespace Slang
         // Any modules currently being imported will be listed here
         ModuleBeingImportedRAII*m_modulesBeingImported = nullptr;
 
+            /// Sink recording the diagnostics of the module being compiled for the module cache (or nullptr).
+            /// Diagnostics produced when loading a module it imports are removed from the recording,
+            /// as they are output when that module is loaded (from the cache or by compiling it).
+        DiagnosticSink* m_moduleDiagnosticsRecorder = nullptr;
+
             /// Is the given module in the middle of being imported?
         bool isBeingImported(Module* module);
 
@@ -2261,6 +2421,20 @@ namespace Slang
             DiagnosticSink*         sink,
             EndToEndCompileRequest* endToEndReq = nullptr);
 
+            /// Generate code for all of the entry points in the program, using up to
+            /// `threadCount` threads.
+            ///
+            /// Each entry point is linked and optimized in its own `IRModule`, so the
+            /// work for different entry points is independent. The results are stored
+            /// in entry point order, and diagnostics are reported to `sink` in entry point
+            /// order once all of the work is complete, so the output does not depend on
+            /// the order work completes in.
+            ///
+        void _createEntryPointResultsConcurrently(
+            Count                   threadCount,
+            DiagnosticSink*         sink,
+            EndToEndCompileRequest* endToEndReq = nullptr);
+
         RefPtr<IRModule> getOrCreateIRModuleForLayout(DiagnosticSink* sink);
 
         RefPtr<IRModule> getExistingIRModuleForLayout()
@@ -2268,6 +2442,28 @@ namespace Slang
             return m_irModuleForLayout;
         }
 
+            /// Get the cache of generic specializations, shared by the IR modules
+            /// linked for the entry points of the program
+        IRSpecializationCache* getSpecializationCache() { return m_specializationCache; }
+
+            /// The IR for all of the entry points of the program linked into a single module.
+            ///
+            /// Used when the target links once (see `TargetRequest::shouldLinkOnce`), so that
+            /// the IR for each entry point can be extracted from it, rather than linked from the
+            /// input modules. The other members are set once, with the mutex held.
+        struct SharedLinkedIR
+        {
+            std::mutex          mutex;
+            bool                isLinked = false;                   ///< True once linking has been done
+            RefPtr<IRModule>    module;                             ///< nullptr if entry points can't be extracted from a shared module
+            IRVarLayout*        globalScopeVarLayout = nullptr;
+            List<IRFunc*>       entryPoints;                        ///< Indexed by entry point index
+            DiagnosticSink      sink;                               ///< Diagnostics from linking, output to the sink of each entry point extracted
+        };
+
+            /// Get the IR shared by the entry points of the program
+        SharedLinkedIR& getSharedLinkedIR() { return m_sharedLinkedIR; }
+
     private:
         RefPtr<IRModule> createIRModuleForLayout(DiagnosticSink* sink);
 
@@ -2287,6 +2483,10 @@ namespace Slang
         List<ComPtr<IArtifact>> m_entryPointResults;
 
         RefPtr<IRModule> m_irModuleForLayout;
+
+        RefPtr<IRSpecializationCache> m_specializationCache;
+
+        SharedLinkedIR m_sharedLinkedIR;
     };
 
         /// A back-end-specific object to track optional feaures/capabilities/extensions
@@ -2420,6 +2620,12 @@ namespace Slang
             return getLinkage()->getSessionImpl();
         }
 
+            /// Get the performance trace, or nullptr if tracing is not enabled
+        PerfTrace* getPerfTrace()
+        {
+            return getLinkage()->getPerfTrace();
+        }
+
             /// Get the source manager
         SourceManager* getSourceManager()
         {
@@ -2470,6 +2676,9 @@ namespace Slang
 
         bool isSpecializationDisabled();
 
+        bool isSpecializationCacheDisabled();
+        bool isIncrementalSimplificationDisabled();
+
         SlangResult requireTranslationUnitSourceFiles();
 
         //
@@ -2500,6 +2709,12 @@ namespace Slang
             
         SlangResult emitWithDownstreamForEntryPoints(ComPtr<IArtifact>& outArtifact);
 
+            /// Optimize SPIR-V emitted directly with the SPIRV-Tools optimizer (in the glslang library),
+            /// using the passes for the optimization level, or passes specified with `-Xglslang`, if
+            /// `-optimize-direct-spirv` is set. Validates it first if `-validate-spirv` is set.
+            /// If the glslang library can't optimize SPIR-V, the artifact is left unchanged.
+        SlangResult _optimizeSPIRVWithDownstream(ComPtr<IArtifact>& ioArtifact);
+
         /* Determines a suitable filename to identify the input for a given entry point being compiled.
         If the end-to-end compile is a pass-through case, will attempt to find the (unique) source file
         pathname for the translation unit containing the entry point at `entryPointIndex.
@@ -2551,6 +2766,7 @@ namespace Slang
         virtual SLANG_NO_THROW void SLANG_MCALL setTargetFloatingPointMode(int targetIndex, SlangFloatingPointMode mode) SLANG_OVERRIDE;
         virtual SLANG_NO_THROW void SLANG_MCALL setTargetMatrixLayoutMode(int targetIndex, SlangMatrixLayoutMode mode) SLANG_OVERRIDE;
         virtual SLANG_NO_THROW void SLANG_MCALL setTargetForceGLSLScalarBufferLayout(int targetIndex, bool value) SLANG_OVERRIDE;
+        virtual SLANG_NO_THROW void SLANG_MCALL setTargetCPUSIMDLaneCount(int targetIndex, int laneCount) SLANG_OVERRIDE;
         virtual SLANG_NO_THROW void SLANG_MCALL setMatrixLayoutMode(SlangMatrixLayoutMode mode) SLANG_OVERRIDE;
         virtual SLANG_NO_THROW void SLANG_MCALL setDebugInfoLevel(SlangDebugInfoLevel level) SLANG_OVERRIDE;
         virtual SLANG_NO_THROW void SLANG_MCALL setOptimizationLevel(SlangOptimizationLevel level) SLANG_OVERRIDE;
@@ -2610,6 +2826,11 @@ namespace Slang
         virtual SLANG_NO_THROW SlangDiagnosticFlags SLANG_MCALL getDiagnosticFlags() SLANG_OVERRIDE;
         virtual SLANG_NO_THROW void SLANG_MCALL setDiagnosticFlags(SlangDiagnosticFlags flags) SLANG_OVERRIDE;
         virtual SLANG_NO_THROW void SLANG_MCALL setDebugInfoFormat(SlangDebugInfoFormat format) SLANG_OVERRIDE;
+        virtual SLANG_NO_THROW void SLANG_MCALL setPerfTraceEnabled(bool enable) SLANG_OVERRIDE;
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL getPerfTrace(SlangPerfTraceFormat format, ISlangBlob** outBlob) SLANG_OVERRIDE;
+        virtual SLANG_NO_THROW void SLANG_MCALL setCodeGenThreadCount(int threadCount) SLANG_OVERRIDE;
+        virtual SLANG_NO_THROW void SLANG_MCALL setModuleCachePath(const char* path) SLANG_OVERRIDE;
+        virtual SLANG_NO_THROW void SLANG_MCALL setDownstreamCachePath(const char* path) SLANG_OVERRIDE;
 
         EndToEndCompileRequest(
             Session* session);
@@ -2650,6 +2871,12 @@ namespace Slang
             /// If set, if a compilation failure occurs will attempt to save off a dump repro with a unique name
         bool m_dumpReproOnError = false;
 
+            /// If set, a performance summary is written to the diagnostic output after compilation
+        bool m_reportPerf = false;
+
+            /// If set, the performance trace is written to this path (in Chrome trace JSON format) after compilation
+        String m_perfTraceFilePath;
+
             /// A blob holding the diagnostic output
         ComPtr<ISlangBlob> m_diagnosticOutputBlob;
 
@@ -2751,6 +2978,12 @@ namespace Slang
         // If true will disable generics/existential value specialization pass.
         bool disableSpecialization = false;
 
+        // If true will not reuse specializations across the entry points of a program.
+        bool disableSpecializationCache = false;
+
+        // If true IR simplification revisits every function on each iteration during linking and optimization.
+        bool disableIncrementalSimplification = false;
+
         // If true will disable generating dynamic dispatch code.
         bool disableDynamicDispatch = false;
 
@@ -2902,7 +3135,7 @@ namespace Slang
         SLANG_NO_THROW SlangPassThrough SLANG_MCALL getDownstreamCompilerForTransition(SlangCompileTarget source, SlangCompileTarget target) override;
         SLANG_NO_THROW double SLANG_MCALL getDownstreamCompilerElapsedTime() override
         {
-            return m_downstreamCompileTime;
+            return m_downstreamCompileTime.load();
         }
         
             /// Get the downstream compiler for a transition
@@ -2967,6 +3200,10 @@ namespace Slang
             /// Get the prelude associated with the language
         const String& getPreludeForLanguage(SourceLanguage language) { return m_languagePreludes[int(language)]; }
 
+            /// Get the generation of the session options that `Linkage::buildHash` reads (preludes and downstream compilers).
+            /// It changes whenever one of those options does, so a digest made at another generation is stale.
+        Count getHashGeneration() const { return m_hashGeneration; }
+
             /// Get the built in linkage -> handy to get the stdlibs from
         Linkage* getBuiltinLinkage() const { return m_builtinLinkage; }
 
@@ -2980,11 +3217,19 @@ namespace Slang
             ISlangBlob*             sourceBlob);
         ~Session();
 
-        void addDownstreamCompileTime(double time) { m_downstreamCompileTime += time; }
+            /// Add to the total time spent in downstream compilers. May be called from several threads at once.
+        void addDownstreamCompileTime(double time)
+        {
+            double current = m_downstreamCompileTime.load(std::memory_order_relaxed);
+            while (!m_downstreamCompileTime.compare_exchange_weak(current, current + time))
+            {
+            }
+        }
 
         ComPtr<ISlangSharedLibraryLoader> m_sharedLibraryLoader;                    ///< The shared library loader (never null)
 
         int m_downstreamCompilerInitialized = 0;                                        
+        std::recursive_mutex m_downstreamCompilerMutex;                                         ///< Held while a downstream compiler is looked up or loaded
 
         RefPtr<DownstreamCompilerSet> m_downstreamCompilerSet;                                  ///< Information about all available downstream compilers.
         ComPtr<IDownstreamCompiler> m_downstreamCompilers[int(PassThroughMode::CountOf)];        ///< A downstream compiler for a pass through
@@ -3009,7 +3254,9 @@ namespace Slang
         // Describes a conversion from one code gen target (source) to another (target)
         CodeGenTransitionMap m_codeGenTransitionMap;
 
-        double m_downstreamCompileTime = 0.0;
+        Count m_hashGeneration = 0;                                               ///< See getHashGeneration
+
+        std::atomic<double> m_downstreamCompileTime{ 0.0 };
     };
 
     void checkTranslationUnit(
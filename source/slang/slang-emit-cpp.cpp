@@ -857,6 +857,15 @@ void CPPSourceEmitter::emitSimpleFuncImpl(IRFunc* func)
         // Because the workhorse function doesn't have the right signature to service
         // general-purpose calls, it is being emitted with a `_` prefix.
         //
+        // When the threads of a compute group are run in SIMD lanes, the workhorse is inlined into
+        // the loop over the threads, otherwise the loop is just a sequence of opaque calls that
+        // the downstream compiler can't vectorize.
+        if (entryPointDecor->getProfile().getStage() == Stage::Compute &&
+            getTargetReq()->getCPUSIMDLaneCount() > 1)
+        {
+            m_writer->emit("SLANG_FORCE_INLINE ");
+        }
+
         StringBuilder prefixName;
         prefixName << "_" << name;
         emitType(resultType, prefixName);
@@ -1813,6 +1822,42 @@ void CPPSourceEmitter::_emitEntryPointGroup(const Int sizeAlongAxis[kThreadGroup
     }
 }
 
+void CPPSourceEmitter::_emitEntryPointGroupSIMD(const Int sizeAlongAxis[kThreadGroupAxisCount], const String& funcName, Count laneCount)
+{
+    // All of the threads in the group are run by a single loop, marked such that the downstream
+    // compiler can run laneCount iterations at once in SIMD lanes. The workhorse function is
+    // force inlined (see emitSimpleFuncImpl), so the body of the thread is in the loop. Whether it
+    // is actually vectorized is up to the downstream compiler.
+    //
+    // Each iteration works out its groupThreadID from the loop index. The group sizes are
+    // constants, so the divisions are cheap (and free for power of 2 sizes).
+    const Int sizeX = sizeAlongAxis[0];
+    const Int sizeXY = sizeX * sizeAlongAxis[1];
+    const Int threadCount = sizeXY * sizeAlongAxis[2];
+
+    StringBuilder builder;
+    builder << "SLANG_PRELUDE_SIMD_LOOP(" << laneCount << ")\n";
+    builder << "for (uint32_t i = 0; i < " << threadCount << "; ++i)\n{\n";
+    m_writer->emit(builder);
+    m_writer->indent();
+
+    // Each lane has its own copy of the input, so there are no dependencies between iterations
+    m_writer->emit("ComputeThreadVaryingInput laneInput = threadInput;\n");
+
+    builder.Clear();
+    builder << "laneInput.groupThreadID.x = i % " << sizeX << ";\n";
+    builder << "laneInput.groupThreadID.y = (i / " << sizeX << ") % " << sizeAlongAxis[1] << ";\n";
+    builder << "laneInput.groupThreadID.z = i / " << sizeXY << ";\n";
+    m_writer->emit(builder);
+
+    m_writer->emit("_");
+    m_writer->emit(funcName);
+    m_writer->emit("(&laneInput, entryPointParams, globalParams);\n");
+
+    m_writer->dedent();
+    m_writer->emit("}\n");
+}
+
 void CPPSourceEmitter::_emitEntryPointGroupRange(const Int sizeAlongAxis[kThreadGroupAxisCount], const String& funcName)
 {
     List<AxisWithSize> axes;
@@ -1998,7 +2043,15 @@ void CPPSourceEmitter::emitModuleImpl(IRModule* module, DiagnosticSink* sink)
                     m_writer->emit("ComputeThreadVaryingInput threadInput = {};\n");
                     m_writer->emit("threadInput.groupID = varyingInput->startGroupID;\n");
 
-                    _emitEntryPointGroup(groupThreadSize, funcName);
+                    const Count laneCount = getTargetReq()->getCPUSIMDLaneCount();
+                    if (laneCount > 1)
+                    {
+                        _emitEntryPointGroupSIMD(groupThreadSize, funcName, laneCount);
+                    }
+                    else
+                    {
+                        _emitEntryPointGroup(groupThreadSize, funcName);
+                    }
                     _emitEntryPointDefinitionEnd(func);
                 }
 
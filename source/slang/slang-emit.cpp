@@ -193,6 +193,12 @@ Result linkAndOptimizeIR(
     auto target = codeGenContext->getTargetFormat();
     auto targetRequest = codeGenContext->getTargetReq();
 
+    PerfTrace* perfTrace = codeGenContext->getPerfTrace();
+    PerfTraceScope perfScope(perfTrace, "ir", "linkAndOptimizeIR");
+
+    IRSimplificationOptions simplificationOptions;
+    simplificationOptions.fullRescan = codeGenContext->isIncrementalSimplificationDisabled();
+
     // Get the artifact desc for the target 
     const auto artifactDesc = ArtifactDescUtil::makeDescForCompileTarget(asExternal(target));
 
@@ -204,7 +210,11 @@ Result linkAndOptimizeIR(
     // modules, and also select between the definitions of
     // any "profile-overloaded" symbols.
     //
-    outLinkedIR = linkIR(codeGenContext);
+    {
+        PerfTraceScope linkScope(perfTrace, "ir", "linkIR");
+        outLinkedIR = linkIR(codeGenContext);
+        linkScope.setModule(outLinkedIR.module);
+    }
     auto irModule = outLinkedIR.module;
     auto irEntryPoints = outLinkedIR.entryPoints;
 
@@ -221,7 +231,7 @@ Result linkAndOptimizeIR(
 
     // Replace any global constants with their values.
     //
-    replaceGlobalConstants(irModule);
+    SLANG_PERF_TRACE_PASS(perfTrace, irModule, "replaceGlobalConstants", replaceGlobalConstants(irModule));
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "GLOBAL CONSTANTS REPLACED");
 #endif
@@ -235,7 +245,7 @@ Result linkAndOptimizeIR(
     // shader parameters for those slots, to be wired up to
     // use sites.
     //
-    bindExistentialSlots(irModule, sink);
+    SLANG_PERF_TRACE_PASS(perfTrace, irModule, "bindExistentialSlots", bindExistentialSlots(irModule, sink));
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "EXISTENTIALS BOUND");
 #endif
@@ -259,7 +269,7 @@ Result linkAndOptimizeIR(
     // can assume that all ordinary/uniform data is strictly
     // passed using constant buffers.
     //
-    collectGlobalUniformParameters(irModule, outLinkedIR.globalScopeVarLayout);
+    SLANG_PERF_TRACE_PASS(perfTrace, irModule, "collectGlobalUniformParameters", collectGlobalUniformParameters(irModule, outLinkedIR.globalScopeVarLayout));
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "GLOBAL UNIFORMS COLLECTED");
 #endif
@@ -280,7 +290,7 @@ Result linkAndOptimizeIR(
         case CodeGenTarget::HostCPPSource:
             break;
         case CodeGenTarget::CUDASource:
-            collectOptiXEntryPointUniformParams(irModule);
+            SLANG_PERF_TRACE_PASS(perfTrace, irModule, "collectOptiXEntryPointUniformParams", collectOptiXEntryPointUniformParams(irModule));
             #if 0
             dumpIRIfEnabled(codeGenContext, irModule, "OPTIX ENTRY POINT UNIFORMS COLLECTED");
             #endif
@@ -290,7 +300,7 @@ Result linkAndOptimizeIR(
         case CodeGenTarget::CPPSource:
             passOptions.alwaysCreateCollectedParam = true;
         default:
-            collectEntryPointUniformParams(irModule, passOptions);
+            SLANG_PERF_TRACE_PASS(perfTrace, irModule, "collectEntryPointUniformParams", collectEntryPointUniformParams(irModule, passOptions));
         #if 0
             dumpIRIfEnabled(codeGenContext, irModule, "ENTRY POINT UNIFORMS COLLECTED");
         #endif
@@ -302,7 +312,7 @@ Result linkAndOptimizeIR(
     switch( target )
     {
     default:
-        moveEntryPointUniformParamsToGlobalScope(irModule);
+        SLANG_PERF_TRACE_PASS(perfTrace, irModule, "moveEntryPointUniformParamsToGlobalScope", moveEntryPointUniformParamsToGlobalScope(irModule));
     #if 0
         dumpIRIfEnabled(codeGenContext, irModule, "ENTRY POINT UNIFORMS MOVED");
     #endif
@@ -314,29 +324,29 @@ Result linkAndOptimizeIR(
         break;
     }
 
-    lowerOptionalType(irModule, sink);
-    simplifyIR(irModule);
+    SLANG_PERF_TRACE_PASS(perfTrace, irModule, "lowerOptionalType", lowerOptionalType(irModule, sink));
+    SLANG_PERF_TRACE_PASS(perfTrace, irModule, "simplifyIR", simplifyIR(irModule, simplificationOptions));
 
     switch (target)
     {
     case CodeGenTarget::CPPSource:
     case CodeGenTarget::HostCPPSource:
     {
-        lowerComInterfaces(irModule, artifactDesc.style, sink);
-        generateDllImportFuncs(codeGenContext->getTargetReq(), irModule, sink);
-        generateDllExportFuncs(irModule, sink);
+        SLANG_PERF_TRACE_PASS(perfTrace, irModule, "lowerComInterfaces", lowerComInterfaces(irModule, artifactDesc.style, sink));
+        SLANG_PERF_TRACE_PASS(perfTrace, irModule, "generateDllImportFuncs", generateDllImportFuncs(codeGenContext->getTargetReq(), irModule, sink));
+        SLANG_PERF_TRACE_PASS(perfTrace, irModule, "generateDllExportFuncs", generateDllExportFuncs(irModule, sink));
         break;
     }
     default: break;
     }
 
     // Lower `Result<T,E>` types into ordinary struct types.
-    lowerResultType(irModule, sink);
+    SLANG_PERF_TRACE_PASS(perfTrace, irModule, "lowerResultType", lowerResultType(irModule, sink));
 
     // Desguar any union types, since these will be illegal on
     // various targets.
     //
-    desugarUnionTypes(irModule);
+    SLANG_PERF_TRACE_PASS(perfTrace, irModule, "desugarUnionTypes", desugarUnionTypes(irModule));
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "UNIONS DESUGARED");
 #endif
@@ -363,24 +373,40 @@ Result linkAndOptimizeIR(
     //
     // Specialization passes and auto-diff passes runs in an iterative loop
     // since each pass can enable the other pass to progress further.
+    // When each entry point of a program is linked into its own module, the
+    // specializations made for one entry point are cached so they can be
+    // reused by the others.
+    //
+    IRSpecializationCache* specializationCache = nullptr;
+    if (auto targetProgram = codeGenContext->getTargetProgram())
+    {
+        if (!codeGenContext->isSpecializationCacheDisabled() &&
+            codeGenContext->getEntryPointIndices().getCount() == 1 &&
+            targetProgram->getProgram()->getEntryPointCount() > 1)
+        {
+            specializationCache = targetProgram->getSpecializationCache();
+        }
+    }
+
     for (;;)
     {
         bool changed = false;
 
         dumpIRIfEnabled(codeGenContext, irModule, "BEFORE-SPECIALIZE");
         if (!codeGenContext->isSpecializationDisabled())
-            changed |= specializeModule(irModule);
+            SLANG_PERF_TRACE_PASS(perfTrace, irModule, "specializeModule", changed |= specializeModule(irModule, specializationCache));
         dumpIRIfEnabled(codeGenContext, irModule, "AFTER-SPECIALIZE");
 
         validateIRModuleIfEnabled(codeGenContext, irModule);
     
         // Inline calls to any functions marked with [__unsafeInlineEarly] again,
         // since we may be missing out cases prevented by the functions that we just specialzied.
-        performMandatoryEarlyInlining(irModule);
+        SLANG_PERF_TRACE_PASS(perfTrace, irModule, "performMandatoryEarlyInlining", performMandatoryEarlyInlining(irModule));
 
         // Unroll loops.
         if (codeGenContext->getSink()->getErrorCount() == 0)
         {
+            PerfTraceScope unrollScope(perfTrace, "ir", "unrollLoopsInModule", irModule);
             if (!unrollLoopsInModule(irModule, codeGenContext->getSink()))
                 return SLANG_FAIL;
         }
@@ -388,7 +414,7 @@ Result linkAndOptimizeIR(
 
         dumpIRIfEnabled(codeGenContext, irModule, "BEFORE-AUTODIFF");
         enableIRValidationAtInsert();
-        changed |= processAutodiffCalls(irModule, sink);
+        SLANG_PERF_TRACE_PASS(perfTrace, irModule, "processAutodiffCalls", changed |= processAutodiffCalls(irModule, sink));
         disableIRValidationAtInsert();
         dumpIRIfEnabled(codeGenContext, irModule, "AFTER-AUTODIFF");
 
@@ -396,9 +422,9 @@ Result linkAndOptimizeIR(
             break;
     }
 
-    finalizeAutoDiffPass(irModule);
+    SLANG_PERF_TRACE_PASS(perfTrace, irModule, "finalizeAutoDiffPass", finalizeAutoDiffPass(irModule));
 
-    finalizeSpecialization(irModule);
+    SLANG_PERF_TRACE_PASS(perfTrace, irModule, "finalizeSpecialization", finalizeSpecialization(irModule));
 
     // If we have a target that is GPU like we use the string hashing mechanism
     // but for that to work we need to inline such that calls (or returns) of strings
@@ -407,14 +433,14 @@ Result linkAndOptimizeIR(
     {
         // We could fail because
         // 1) It's not inlinable for some reason (for example if it's recursive)
-        SLANG_RETURN_ON_FAIL(performStringInlining(irModule, sink));
+        SLANG_PERF_TRACE_PASS(perfTrace, irModule, "performStringInlining", SLANG_RETURN_ON_FAIL(performStringInlining(irModule, sink)));
     }
 
-    lowerReinterpret(targetRequest, irModule, sink);
+    SLANG_PERF_TRACE_PASS(perfTrace, irModule, "lowerReinterpret", lowerReinterpret(targetRequest, irModule, sink));
 
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
-    simplifyIR(irModule);
+    SLANG_PERF_TRACE_PASS(perfTrace, irModule, "simplifyIR", simplifyIR(irModule, simplificationOptions));
 
     if (!ArtifactDescUtil::isCpuLikeTarget(artifactDesc))
     {
@@ -426,7 +452,7 @@ Result linkAndOptimizeIR(
     // generics / interface types to ordinary functions and types using
     // function pointers.
     dumpIRIfEnabled(codeGenContext, irModule, "BEFORE-LOWER-GENERICS");
-    lowerGenerics(targetRequest, irModule, sink);
+    SLANG_PERF_TRACE_PASS(perfTrace, irModule, "lowerGenerics", lowerGenerics(targetRequest, irModule, sink));
     dumpIRIfEnabled(codeGenContext, irModule, "AFTER-LOWER-GENERICS");
 
     if (sink->getErrorCount() != 0)
@@ -441,13 +467,13 @@ Result linkAndOptimizeIR(
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
     // Inline calls to any functions marked with [__unsafeInlineEarly] or [ForceInline].
-    performForceInlining(irModule);
+    SLANG_PERF_TRACE_PASS(perfTrace, irModule, "performForceInlining", performForceInlining(irModule));
 
     // Specialization can introduce dead code that could trip
     // up downstream passes like type legalization, so we
     // will run a DCE pass to clean up after the specialization.
     //
-    simplifyIR(irModule);
+    SLANG_PERF_TRACE_PASS(perfTrace, irModule, "simplifyIR", simplifyIR(irModule, simplificationOptions));
 
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "AFTER DCE");
@@ -483,10 +509,10 @@ Result linkAndOptimizeIR(
         //  we need to replace it with just an `X`, after which we
         //  will have (more) legal shader code.
         //
-        legalizeExistentialTypeLayout(
+        SLANG_PERF_TRACE_PASS(perfTrace, irModule, "legalizeExistentialTypeLayout", legalizeExistentialTypeLayout(
             irModule,
-            sink);
-        eliminateDeadCode(irModule);
+            sink));
+        SLANG_PERF_TRACE_PASS(perfTrace, irModule, "eliminateDeadCode", eliminateDeadCode(irModule));
 
 #if 0
         dumpIRIfEnabled(codeGenContext, irModule, "EXISTENTIALS LEGALIZED");
@@ -504,10 +530,10 @@ Result linkAndOptimizeIR(
         // What used to be individual variables/parameters/arguments/etc.
         // then become multiple variables/parameters/arguments/etc.
         //
-        legalizeResourceTypes(
+        SLANG_PERF_TRACE_PASS(perfTrace, irModule, "legalizeResourceTypes", legalizeResourceTypes(
             irModule,
-            sink);
-        eliminateDeadCode(irModule);
+            sink));
+        SLANG_PERF_TRACE_PASS(perfTrace, irModule, "eliminateDeadCode", eliminateDeadCode(irModule));
 
         //  Debugging output of legalization
     #if 0
@@ -521,7 +547,7 @@ Result linkAndOptimizeIR(
     // to see if we can clean up any temporaries created by legalization.
     // (e.g., things that used to be aggregated might now be split up,
     // so that we can work with the individual fields).
-    simplifyIR(irModule);
+    SLANG_PERF_TRACE_PASS(perfTrace, irModule, "simplifyIR", simplifyIR(irModule, simplificationOptions));
 
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "AFTER SSA");
@@ -537,24 +563,24 @@ Result linkAndOptimizeIR(
     // resource types can be used, so that having them as
     // function parameters, reults, etc. is invalid.
     // We clean up the usages of resource values here.
-    specializeResourceUsage(codeGenContext, irModule);
-    specializeFuncsForBufferLoadArgs(codeGenContext, irModule);
+    SLANG_PERF_TRACE_PASS(perfTrace, irModule, "specializeResourceUsage", specializeResourceUsage(codeGenContext, irModule));
+    SLANG_PERF_TRACE_PASS(perfTrace, irModule, "specializeFuncsForBufferLoadArgs", specializeFuncsForBufferLoadArgs(codeGenContext, irModule));
 
     //
-    simplifyIR(irModule);
+    SLANG_PERF_TRACE_PASS(perfTrace, irModule, "simplifyIR", simplifyIR(irModule, simplificationOptions));
 
     // For GLSL targets, we also want to specialize calls to functions that
     // takes array parameters if possible, to avoid performance issues on
     // those platforms.
     if (isKhronosTarget(targetRequest))
     {
-        specializeArrayParameters(codeGenContext, irModule);
-        simplifyIR(irModule);
+        SLANG_PERF_TRACE_PASS(perfTrace, irModule, "specializeArrayParameters", specializeArrayParameters(codeGenContext, irModule));
+        SLANG_PERF_TRACE_PASS(perfTrace, irModule, "simplifyIR", simplifyIR(irModule, simplificationOptions));
     }
 
     // Rewrite functions that return arrays to return them via `out` parameter,
     // since our target languages doesn't allow returning arrays.
-    legalizeArrayReturnType(irModule);
+    SLANG_PERF_TRACE_PASS(perfTrace, irModule, "legalizeArrayReturnType", legalizeArrayReturnType(irModule));
 
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "AFTER RESOURCE SPECIALIZATION");
@@ -573,7 +599,7 @@ Result linkAndOptimizeIR(
     {
     case CodeGenTarget::HLSL:
         {
-            wrapStructuredBuffersOfMatrices(irModule);
+            SLANG_PERF_TRACE_PASS(perfTrace, irModule, "wrapStructuredBuffersOfMatrices", wrapStructuredBuffersOfMatrices(irModule));
 #if 0
             dumpIRIfEnabled(codeGenContext, irModule, "STRUCTURED BUFFERS WRAPPED");
 #endif
@@ -670,7 +696,7 @@ Result linkAndOptimizeIR(
             break;
         }
 
-        legalizeByteAddressBufferOps(session, targetRequest, irModule, byteAddressBufferOptions);
+        SLANG_PERF_TRACE_PASS(perfTrace, irModule, "legalizeByteAddressBufferOps", legalizeByteAddressBufferOps(session, targetRequest, irModule, byteAddressBufferOptions));
     }
 
     // For CUDA targets only, we will need to turn operations
@@ -682,9 +708,9 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::CUDASource:
     case CodeGenTarget::PTX:
         {
-            synthesizeActiveMask(
+            SLANG_PERF_TRACE_PASS(perfTrace, irModule, "synthesizeActiveMask", synthesizeActiveMask(
                 irModule,
-                codeGenContext->getSink());
+                codeGenContext->getSink()));
 
 #if 0
             dumpIRIfEnabled(codeGenContext, irModule, "AFTER synthesizeActiveMask");
@@ -711,12 +737,12 @@ Result linkAndOptimizeIR(
     {
         auto glslExtensionTracker = as<GLSLExtensionTracker>(options.sourceEmitter->getExtensionTracker());
 
-        legalizeEntryPointsForGLSL(
+        SLANG_PERF_TRACE_PASS(perfTrace, irModule, "legalizeEntryPointsForGLSL", legalizeEntryPointsForGLSL(
             session,
             irModule,
             irEntryPoints,
             codeGenContext,
-            glslExtensionTracker);
+            glslExtensionTracker));
 
 #if 0
             dumpIRIfEnabled(codeGenContext, irModule, "GLSL LEGALIZED");
@@ -728,13 +754,13 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::CSource:
     case CodeGenTarget::CPPSource:
         {
-            legalizeEntryPointVaryingParamsForCPU(irModule, codeGenContext->getSink());
+            SLANG_PERF_TRACE_PASS(perfTrace, irModule, "legalizeEntryPointVaryingParamsForCPU", legalizeEntryPointVaryingParamsForCPU(irModule, codeGenContext->getSink()));
         }
         break;
 
     case CodeGenTarget::CUDASource:
         {
-            legalizeEntryPointVaryingParamsForCUDA(irModule, codeGenContext->getSink());
+            SLANG_PERF_TRACE_PASS(perfTrace, irModule, "legalizeEntryPointVaryingParamsForCUDA", legalizeEntryPointVaryingParamsForCUDA(irModule, codeGenContext->getSink()));
         }
         break;
 
@@ -747,7 +773,7 @@ Result linkAndOptimizeIR(
     {
     case CodeGenTarget::GLSL:
         {
-            legalizeImageSubscriptForGLSL(irModule);
+            SLANG_PERF_TRACE_PASS(perfTrace, irModule, "legalizeImageSubscriptForGLSL", legalizeImageSubscriptForGLSL(irModule));
         }
         break;
     default:
@@ -761,11 +787,11 @@ Result linkAndOptimizeIR(
 
     case CodeGenTarget::CPPSource:
     case CodeGenTarget::CUDASource:
-        moveGlobalVarInitializationToEntryPoints(irModule);
-        introduceExplicitGlobalContext(irModule, target);
+        SLANG_PERF_TRACE_PASS(perfTrace, irModule, "moveGlobalVarInitializationToEntryPoints", moveGlobalVarInitializationToEntryPoints(irModule));
+        SLANG_PERF_TRACE_PASS(perfTrace, irModule, "introduceExplicitGlobalContext", introduceExplicitGlobalContext(irModule, target));
         if(target == CodeGenTarget::CPPSource)
         {
-            convertEntryPointPtrParamsToRawPtrs(irModule);
+            SLANG_PERF_TRACE_PASS(perfTrace, irModule, "convertEntryPointPtrParamsToRawPtrs", convertEntryPointPtrParamsToRawPtrs(irModule));
         }
     #if 0
         dumpIRIfEnabled(codeGenContext, irModule, "EXPLICIT GLOBAL CONTEXT INTRODUCED");
@@ -774,12 +800,12 @@ Result linkAndOptimizeIR(
         break;
     }
 
-    stripCachedDictionaries(irModule);
+    SLANG_PERF_TRACE_PASS(perfTrace, irModule, "stripCachedDictionaries", stripCachedDictionaries(irModule));
 
     // TODO: our current dynamic dispatch pass will remove all uses of witness tables.
     // If we are going to support function-pointer based, "real" modular dynamic dispatch,
     // we will need to disable this pass.
-    stripWitnessTables(irModule);
+    SLANG_PERF_TRACE_PASS(perfTrace, irModule, "stripWitnessTables", stripWitnessTables(irModule));
 
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "AFTER STRIP WITNESS TABLES");
@@ -794,34 +820,34 @@ Result linkAndOptimizeIR(
     //
     // We run IR simplification passes again to clean things up.
     //
-    simplifyIR(irModule);
+    SLANG_PERF_TRACE_PASS(perfTrace, irModule, "simplifyIR", simplifyIR(irModule, simplificationOptions));
 
     if (isKhronosTarget(targetRequest))
     {
         // As a fallback, if the above specialization steps failed to remove resource type parameters, we will
         // inline the functions in question to make sure we can produce valid GLSL.
-        performGLSLResourceReturnFunctionInlining(irModule);
+        SLANG_PERF_TRACE_PASS(perfTrace, irModule, "performGLSLResourceReturnFunctionInlining", performGLSLResourceReturnFunctionInlining(irModule));
     }
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "AFTER DCE");
 #endif
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
-    cleanUpVoidType(irModule);
+    SLANG_PERF_TRACE_PASS(perfTrace, irModule, "cleanUpVoidType", cleanUpVoidType(irModule));
 
     // For some small improvement in type safety we represent these as opaque
     // structs instead of regular arrays.
     //
     // If any have survived this far, change them back to regular (decorated)
     // arrays that the emitters can deal with.
-    legalizeMeshOutputTypes(irModule);
+    SLANG_PERF_TRACE_PASS(perfTrace, irModule, "legalizeMeshOutputTypes", legalizeMeshOutputTypes(irModule));
 
     // Lower all bit_cast operations on complex types into leaf-level
     // bit_cast on basic types.
-    lowerBitCast(targetRequest, irModule);
-    simplifyIR(irModule);
+    SLANG_PERF_TRACE_PASS(perfTrace, irModule, "lowerBitCast", lowerBitCast(targetRequest, irModule));
+    SLANG_PERF_TRACE_PASS(perfTrace, irModule, "simplifyIR", simplifyIR(irModule, simplificationOptions));
 
-    eliminateMultiLevelBreak(irModule);
+    SLANG_PERF_TRACE_PASS(perfTrace, irModule, "eliminateMultiLevelBreak", eliminateMultiLevelBreak(irModule));
 
     // As a late step, we need to take the SSA-form IR and move things *out*
     // of SSA form, by eliminating all "phi nodes" (block parameters) and
@@ -848,7 +874,7 @@ Result linkAndOptimizeIR(
         }
 
         // We only want to accumulate locations if liveness tracking is enabled.
-        eliminatePhis(livenessMode, irModule);
+        SLANG_PERF_TRACE_PASS(perfTrace, irModule, "eliminatePhis", eliminatePhis(livenessMode, irModule));
 #if 0
         dumpIRIfEnabled(codeGenContext, irModule, "PHIS ELIMINATED");
 #endif
@@ -887,12 +913,12 @@ Result linkAndOptimizeIR(
     {
         if (isKhronosTarget(targetRequest))
         {
-            applyGLSLLiveness(irModule);
+            SLANG_PERF_TRACE_PASS(perfTrace, irModule, "applyGLSLLiveness", applyGLSLLiveness(irModule));
         }
     }
 
     // Run a final round of simplifications to clean up unused things after phi-elimination.
-    simplifyNonSSAIR(irModule);
+    SLANG_PERF_TRACE_PASS(perfTrace, irModule, "simplifyNonSSAIR", simplifyNonSSAIR(irModule));
 
     // We include one final step to (optionally) dump the IR and validate
     // it after all of the optimization passes are complete. This should
@@ -1020,7 +1046,10 @@ SlangResult CodeGenContext::emitEntryPointsSourceFromIR(ComPtr<IArtifact>& outAr
         auto irModule = linkedIR.module;
         
         // Perform final simplifications to help emit logic to generate more compact code.
-        simplifyForEmit(irModule, targetRequest);
+        {
+            PerfTraceScope simplifyScope(getPerfTrace(), "ir", "simplifyForEmit", irModule);
+            simplifyForEmit(irModule, targetRequest);
+        }
 
         metadata = linkedIR.metadata;
 
@@ -1028,6 +1057,7 @@ SlangResult CodeGenContext::emitEntryPointsSourceFromIR(ComPtr<IArtifact>& outAr
         // passes have been performed, we can emit target code from
         // the IR module.
         //
+        PerfTraceScope emitScope(getPerfTrace(), "emit", "emitModule");
         sourceEmitter->emitModule(irModule, sink);
     }
 
@@ -1122,7 +1152,10 @@ SlangResult emitSPIRVForEntryPointsDirectly(
     auto irEntryPoints = linkedIR.entryPoints;
 
     List<uint8_t> spirv;
-    emitSPIRVFromIR(codeGenContext, irModule, irEntryPoints, spirv);
+    {
+        PerfTraceScope emitScope(codeGenContext->getPerfTrace(), "emit", "emitSPIRVFromIR");
+        emitSPIRVFromIR(codeGenContext, irModule, irEntryPoints, spirv);
+    }
 
     auto artifact = ArtifactUtil::createArtifactForCompileTarget(asExternal(codeGenContext->getTargetFormat()));
     artifact->addRepresentationUnknown(ListBlob::moveCreate(spirv));
@@ -0,0 +1,142 @@
+// slang-ir-analysis-cache.cpp
+#include "slang-ir-analysis-cache.h"
+
+#include "slang-ir.h"
+#include "slang-ir-insts.h"
+
+namespace Slang
+{
+
+IRCFGAnalyses* IRAnalysisCache::getAnalyses(IRGlobalValueWithCode* code)
+{
+    if (auto analysesPtr = m_analyses.TryGetValue(code))
+    {
+        return *analysesPtr;
+    }
+    RefPtr<IRCFGAnalyses> analyses = new IRCFGAnalyses;
+    m_analyses.Add(code, analyses);
+    return analyses;
+}
+
+// Analyses are held by the module, so code that isn't in a module has none
+static IRCFGAnalyses* _getAnalyses(IRGlobalValueWithCode* code)
+{
+    auto module = code ? code->getModule() : nullptr;
+    return module ? module->getAnalysisCache().getAnalyses(code) : nullptr;
+}
+
+RefPtr<IRDominatorTree> getDominatorTree(IRGlobalValueWithCode* code)
+{
+    auto analyses = _getAnalyses(code);
+    if (!analyses)
+    {
+        return computeDominatorTree(code);
+    }
+    if (!analyses->dominatorTree)
+    {
+        analyses->dominatorTree = computeDominatorTree(code);
+    }
+    return analyses->dominatorTree;
+}
+
+static List<IRBlock*> _collectBlocksInLoop(IRDominatorTree* dom, IRLoop* loopInst)
+{
+    List<IRBlock*> loopBlocks;
+    HashSet<IRBlock*> loopBlocksSet;
+    auto addBlock = [&](IRBlock* block)
+    {
+        if (loopBlocksSet.Add(block))
+            loopBlocks.add(block);
+    };
+    auto firstBlock = as<IRBlock>(loopInst->block.get());
+    auto breakBlock = as<IRBlock>(loopInst->breakBlock.get());
+
+    addBlock(firstBlock);
+    for (Index i = 0; i < loopBlocks.getCount(); i++)
+    {
+        auto block = loopBlocks[i];
+        for (auto succ : block->getSuccessors())
+        {
+            if (succ == breakBlock)
+                continue;
+            if (dom->dominates(firstBlock, succ) && !dom->dominates(breakBlock, succ))
+                addBlock(succ);
+        }
+    }
+    return loopBlocks;
+}
+
+List<IRBlock*> getLoopBlocks(IRLoop* loop)
+{
+    auto block = as<IRBlock>(loop->getParent());
+    auto code = block ? as<IRGlobalValueWithCode>(block->getParent()) : nullptr;
+    auto analyses = _getAnalyses(code);
+    if (!analyses)
+    {
+        return _collectBlocksInLoop(computeDominatorTree(code), loop);
+    }
+
+    if (auto blocks = analyses->loopBlocks.TryGetValue(loop))
+    {
+        return *blocks;
+    }
+
+    auto blocks = _collectBlocksInLoop(getDominatorTree(code), loop);
+    analyses->loopBlocks.Add(loop, blocks);
+    return blocks;
+}
+
+bool areCFGAnalysesUpToDate(IRGlobalValueWithCode* code)
+{
+    auto module = code->getModule();
+    auto analyses = module ? module->getAnalysisCache().findAnalyses(code) : nullptr;
+    if (!analyses)
+    {
+        return true;
+    }
+
+    auto dominatorTree = computeDominatorTree(code);
+    if (auto cachedTree = analyses->dominatorTree)
+    {
+        for (auto block : code->getBlocks())
+        {
+            if (cachedTree->isUnreachable(block) != dominatorTree->isUnreachable(block) ||
+                cachedTree->getImmediateDominator(block) != dominatorTree->getImmediateDominator(block))
+            {
+                return false;
+            }
+        }
+    }
+
+    for (const auto& pair : analyses->loopBlocks)
+    {
+        auto loop = pair.Key;
+        auto block = as<IRBlock>(loop->getParent());
+        if (!block || block->getParent() != code ||
+            pair.Value != _collectBlocksInLoop(dominatorTree, loop))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void invalidateCFGAnalyses(IRInst* inst)
+{
+    // A block is held directly by its code, anything else by a block
+    auto parent = inst->getParent();
+    if (parent && !as<IRBlock>(inst))
+    {
+        parent = parent->getParent();
+    }
+
+    if (auto code = as<IRGlobalValueWithCode>(parent))
+    {
+        if (auto module = code->getModule())
+        {
+            module->getAnalysisCache().invalidate(code);
+        }
+    }
+}
+
+}
@@ -0,0 +1,71 @@
+// slang-ir-analysis-cache.h
+#pragma once
+
+#include "../core/slang-basic.h"
+
+#include "slang-ir-dominators.h"
+
+namespace Slang
+{
+    struct IRBlock;
+    struct IRGlobalValueWithCode;
+    struct IRInst;
+    struct IRLoop;
+
+    /// Analyses of the control flow graph (CFG) of a function (or other value with code).
+    ///
+    /// Each analysis is computed the first time it is asked for, and is then kept
+    /// until the CFG of the function changes.
+    struct IRCFGAnalyses : public RefObject
+    {
+            /// The dominator tree, or nullptr if not computed yet
+        RefPtr<IRDominatorTree> dominatorTree;
+
+            /// The blocks that make up the body of each (structured) loop that has been asked for
+        Dictionary<IRLoop*, List<IRBlock*>> loopBlocks;
+    };
+
+    /// Holds the CFG analyses of all of the functions in a module that have been asked for.
+    ///
+    /// The IR invalidates the analyses of a function whenever a change is made that can
+    /// alter its CFG: a block is inserted or removed, a terminator is inserted or removed,
+    /// or an operand that is a block is changed. Changes that leave the CFG unchanged
+    /// (like adding ordinary instructions to a block) keep the analyses.
+    class IRAnalysisCache
+    {
+    public:
+            /// Get the analyses for `code`, creating an empty set if there isn't one
+        IRCFGAnalyses* getAnalyses(IRGlobalValueWithCode* code);
+
+            /// Get the analyses for `code`, or nullptr if none have been asked for
+        IRCFGAnalyses* findAnalyses(IRGlobalValueWithCode* code)
+        {
+            auto analysesPtr = m_analyses.TryGetValue(code);
+            return analysesPtr ? analysesPtr->Ptr() : nullptr;
+        }
+
+            /// Discard the analyses for `code`
+        void invalidate(IRGlobalValueWithCode* code) { if (m_analyses.Count()) m_analyses.Remove(code); }
+            /// Discard all analyses
+        void clear() { m_analyses.Clear(); }
+
+    protected:
+        Dictionary<IRGlobalValueWithCode*, RefPtr<IRCFGAnalyses>> m_analyses;
+    };
+
+        /// Get the dominator tree for `code`. Computed if there isn't a tree for the current CFG.
+        ///
+        /// The returned tree is never changed. If the CFG changes a tree obtained before the
+        /// change describes the old CFG, and calling this again will return a new tree.
+    RefPtr<IRDominatorTree> getDominatorTree(IRGlobalValueWithCode* code);
+
+        /// Get the blocks that make up the body of `loop`, starting with its target block.
+    List<IRBlock*> getLoopBlocks(IRLoop* loop);
+
+        /// True if the analyses held for `code` are the same as analyses computed from its current CFG.
+        /// IR validation uses this to check that every change to the CFG invalidated them.
+    bool areCFGAnalysesUpToDate(IRGlobalValueWithCode* code);
+
+        /// Called when a change to `inst` (a block or a terminator) may have changed the CFG holding it
+    void invalidateCFGAnalyses(IRInst* inst);
+}
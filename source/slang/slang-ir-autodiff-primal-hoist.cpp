@@ -1,5 +1,6 @@
 #include "slang-ir-autodiff-primal-hoist.h"
 #include "slang-ir-autodiff-region.h"
+#include "slang-ir-analysis-cache.h"
 
 namespace Slang 
 {
@@ -17,7 +18,7 @@ RefPtr<HoistedPrimalsInfo> AutodiffCheckpointPolicyBase::processFunc(IRGlobalVal
 {
     RefPtr<CheckpointSetInfo> checkpointInfo = new CheckpointSetInfo();
 
-    RefPtr<IRDominatorTree> domTree = computeDominatorTree(func);
+    RefPtr<IRDominatorTree> domTree = getDominatorTree(func);
 
     List<IRUse*> workList;
     HashSet<IRUse*> processedUses;
@@ -503,7 +504,7 @@ RefPtr<HoistedPrimalsInfo> ensurePrimalAvailability(
     IRGlobalValueWithCode* func,
     Dictionary<IRBlock*, List<IndexTrackingInfo*>> indexedBlockInfo)
 {
-    RefPtr<IRDominatorTree> domTree = computeDominatorTree(func);
+    RefPtr<IRDominatorTree> domTree = getDominatorTree(func);
 
     IRBuilder builder(func->getModule());
     IRBlock* defaultVarBlock = func->getFirstBlock()->getNextBlock();
@@ -9,7 +9,7 @@
 #include "slang-ir-autodiff-fwd.h"
 #include "slang-ir-autodiff-cfg-norm.h"
 #include "slang-ir-autodiff-primal-hoist.h"
-#include "slang-ir-dominators.h"
+#include "slang-ir-analysis-cache.h"
 
 namespace Slang
 {
@@ -1423,7 +1423,7 @@ struct DiffTransposePass
         
         Dictionary<IRInst*, IRInst*> hoistedInstMap;
 
-        RefPtr<IRDominatorTree> domTree = computeDominatorTree(func);
+        RefPtr<IRDominatorTree> domTree = getDominatorTree(func);
 
         Dictionary<IRInst*, List<IRInst*>> invOperandMap = buildInvOperandMap();
 
@@ -52,7 +52,7 @@
 
 #include "slang-ir.h"
 #include "slang-ir-insts.h"
-#include "slang-ir-dominators.h"
+#include "slang-ir-analysis-cache.h"
 
 namespace Slang {
 
@@ -302,7 +302,7 @@ struct PhiEliminationContext
     {
         if (!m_dominatorTree)
         {
-            m_dominatorTree = computeDominatorTree(m_func);
+            m_dominatorTree = Slang::getDominatorTree(m_func);
         }
         return m_dominatorTree;
     }
@@ -212,6 +212,18 @@ struct IRSpecContext : IRSpecContextBase
     virtual IRInst* maybeCloneValue(IRInst* originalVal) override;
 };
 
+// We use an `IRExtractContext` for the case where we are cloning
+// the code for an entry point out of a module that has already
+// been linked for the target (see `linkIR`). Each global value
+// in such a module is already the best definition for the target,
+// so global values are cloned directly, without any lookup
+// by mangled name.
+//
+struct IRExtractContext : IRSpecContextBase
+{
+    virtual IRInst* maybeCloneValue(IRInst* originalVal) override;
+};
+
 
 IRInst* cloneGlobalValue(IRSpecContext* context, IRInst* originalVal);
 
@@ -223,9 +235,10 @@ IRType* cloneType(
     IRSpecContextBase*  context,
     IRType*             originalType);
 
-IRInst* IRSpecContext::maybeCloneValue(IRInst* originalValue)
+    /// Returns true if `inst` is a global value that is cloned by symbol, rather than as a hoistable instruction
+static bool _isClonedAsGlobalValue(IRInst* inst)
 {
-    switch (originalValue->getOp())
+    switch (inst->getOp())
     {
     case kIROp_StructType:
     case kIROp_ClassType:
@@ -240,8 +253,20 @@ IRInst* IRSpecContext::maybeCloneValue(IRInst* originalValue)
     case kIROp_WitnessTable:
     case kIROp_InterfaceType:
     case kIROp_TaggedUnionType:
-        return cloneGlobalValue(this, originalValue);
+        return true;
+
+    default:
+        return false;
+    }
+}
 
+    /// Clone a literal, or a hoistable instruction (such as a type), that isn't a global value
+static IRInst* _cloneLiteralOrHoistableValue(IRSpecContextBase* context, IRInst* originalValue)
+{
+    auto builder = context->builder;
+
+    switch (originalValue->getOp())
+    {
     case kIROp_BoolLit:
         {
             IRConstant* c = (IRConstant*)originalValue;
@@ -253,14 +278,14 @@ IRInst* IRSpecContext::maybeCloneValue(IRInst* originalValue)
     case kIROp_IntLit:
         {
             IRConstant* c = (IRConstant*)originalValue;
-            return builder->getIntValue(cloneType(this, c->getDataType()), c->value.intVal);
+            return builder->getIntValue(cloneType(context, c->getDataType()), c->value.intVal);
         }
         break;
 
     case kIROp_FloatLit:
         {
             IRConstant* c = (IRConstant*)originalValue;
-            return builder->getFloatValue(cloneType(this, c->getDataType()), c->value.floatVal);
+            return builder->getFloatValue(cloneType(context, c->getDataType()), c->value.floatVal);
         }
         break;
 
@@ -296,16 +321,16 @@ IRInst* IRSpecContext::maybeCloneValue(IRInst* originalValue)
             for (UInt aa = 0; aa < argCount; ++aa)
             {
                 IRInst* originalArg = originalValue->getOperand(aa);
-                IRInst* clonedArg = cloneValue(this, originalArg);
+                IRInst* clonedArg = cloneValue(context, originalArg);
                 newArgs[aa] = clonedArg;
             }
             IRInst* clonedValue = builder->createIntrinsicInst(
-                cloneType(this, originalValue->getFullType()),
+                cloneType(context, originalValue->getFullType()),
                 originalValue->getOp(),
                 argCount, newArgs.getArrayView().getBuffer());
-            registerClonedValue(this, clonedValue, originalValue);
+            registerClonedValue(context, clonedValue, originalValue);
             
-            cloneDecorationsAndChildren(this, clonedValue, originalValue);
+            cloneDecorationsAndChildren(context, clonedValue, originalValue);
             builder->addInst(clonedValue);
 
             return clonedValue;
@@ -314,6 +339,26 @@ IRInst* IRSpecContext::maybeCloneValue(IRInst* originalValue)
     }
 }
 
+IRInst* IRSpecContext::maybeCloneValue(IRInst* originalValue)
+{
+    if (_isClonedAsGlobalValue(originalValue))
+    {
+        return cloneGlobalValue(this, originalValue);
+    }
+    return _cloneLiteralOrHoistableValue(this, originalValue);
+}
+
+IRInst* IRExtractContext::maybeCloneValue(IRInst* originalValue)
+{
+    if (_isClonedAsGlobalValue(originalValue))
+    {
+        auto clonedValue = cloneInst(this, &shared->builderStorage, originalValue, IROriginalValuesForClone(originalValue));
+        clonedValue->moveToEnd();
+        return clonedValue;
+    }
+    return _cloneLiteralOrHoistableValue(this, originalValue);
+}
+
 IRInst* cloneValue(
     IRSpecContextBase*  context,
     IRInst*        originalValue);
@@ -1423,8 +1468,10 @@ static bool _isPublicOrHLSLExported(IRInst* inst)
     return false;
 }
 
-LinkedIR linkIR(
-    CodeGenContext* codeGenContext)
+    /// Link the IR for the entry points with `entryPointIndices` into a new module
+static LinkedIR _linkIR(
+    CodeGenContext*                             codeGenContext,
+    CodeGenContext::EntryPointIndices const&    entryPointIndices)
 {
     auto linkage = codeGenContext->getLinkage();
     auto program = codeGenContext->getProgram();
@@ -1527,7 +1574,7 @@ LinkedIR linkIR(
     //
 
     List<IRFunc*> irEntryPoints;
-    for (auto entryPointIndex : codeGenContext->getEntryPointIndices())
+    for (auto entryPointIndex : entryPointIndices)
     {
         auto entryPointMangledName = program->getEntryPointMangledName(entryPointIndex);
         auto nameOverride = program->getEntryPointNameOverride(entryPointIndex);
@@ -1653,6 +1700,157 @@ LinkedIR linkIR(
     return linkedIR;
 }
 
+    /// Link the IR for all of the entry points of the program into `outSharedIR`, so that the
+    /// IR for each entry point can be extracted from it.
+    ///
+    /// The link isn't done on behalf of any one entry point, so its diagnostics are held
+    /// in `outSharedIR`, and output to the sink of each entry point that is extracted.
+static void _linkSharedIR(
+    CodeGenContext*                 codeGenContext,
+    TargetProgram::SharedLinkedIR&  outSharedIR)
+{
+    CodeGenContext::EntryPointIndices entryPointIndices;
+    const Index entryPointCount = codeGenContext->getProgram()->getEntryPointCount();
+    for (Index i = 0; i < entryPointCount; ++i)
+    {
+        entryPointIndices.add(i);
+    }
+
+    outSharedIR.sink.initFrom(*codeGenContext->getSink());
+
+    CodeGenContext::Shared linkShared(
+        codeGenContext->getTargetProgram(),
+        entryPointIndices,
+        &outSharedIR.sink,
+        codeGenContext->isEndToEndCompile());
+    CodeGenContext linkBaseContext(&linkShared);
+    CodeGenContext linkContext(&linkBaseContext, codeGenContext->getTargetFormat(), codeGenContext->getExtensionTracker());
+
+    LinkedIR linkedIR = _linkIR(&linkContext, entryPointIndices);
+    outSharedIR.isLinked = true;
+
+    // If the same function is used for more than one entry point, linking changes it for each
+    // of them (for example to apply a name override), so they can't be extracted separately.
+    HashSet<IRFunc*> entryPoints;
+    for (auto entryPoint : linkedIR.entryPoints)
+    {
+        if (!entryPoints.Add(entryPoint))
+        {
+            return;
+        }
+    }
+
+    outSharedIR.module = linkedIR.module;
+    outSharedIR.globalScopeVarLayout = linkedIR.globalScopeVarLayout;
+    outSharedIR.entryPoints = linkedIR.entryPoints;
+}
+
+    /// Clone the IR for the entry point with `entryPointIndex` out of the shared linked IR, into a new module.
+    ///
+    /// The result is the same as linking the entry point on its own, because the shared
+    /// module holds the definitions that linking selected for the target, and the same roots
+    /// are cloned from it as `_linkIR` clones from the input modules.
+static LinkedIR _extractEntryPointIR(
+    CodeGenContext*                 codeGenContext,
+    TargetProgram::SharedLinkedIR&  sharedIR,
+    Index                           entryPointIndex)
+{
+    IRModule* sharedModule = sharedIR.module;
+
+    IRSharedSpecContext sharedContext;
+    initializeSharedSpecContext(
+        &sharedContext,
+        codeGenContext->getSession(),
+        nullptr,
+        codeGenContext->getTargetFormat(),
+        codeGenContext->getTargetReq());
+
+    RefPtr<IRModule> module = sharedContext.module;
+
+    {
+        StringSlicePool pool(StringSlicePool::Style::Empty);
+        findGlobalHashedStringLiterals(sharedModule, pool);
+        addGlobalHashedStringLiterals(pool, module);
+    }
+
+    IRExtractContext context;
+    context.shared = &sharedContext;
+    context.env = &sharedContext.globalEnv;
+    context.builder = &sharedContext.builderStorage;
+    context.builder->setInsertInto(module->getModuleInst());
+
+    List<IRFunc*> irEntryPoints;
+    irEntryPoints.add(cast<IRFunc>(cloneValue(&context, sharedIR.entryPoints[entryPointIndex])));
+
+    IRVarLayout* irGlobalScopeVarLayout = nullptr;
+    if (sharedIR.globalScopeVarLayout)
+    {
+        irGlobalScopeVarLayout = cast<IRVarLayout>(cloneValue(&context, sharedIR.globalScopeVarLayout));
+    }
+
+    // Global generic parameter bindings, and `public`/`export` values (which already have
+    // a `[KeepAlive]` decoration) are required even if they aren't referenced.
+    for (auto inst : sharedModule->getGlobalInsts())
+    {
+        if (as<IRBindGlobalGenericParam>(inst) || _isPublicOrHLSLExported(inst))
+        {
+            cloneValue(&context, inst);
+        }
+    }
+
+    for (auto decoration : sharedModule->getModuleInst()->getDecorations())
+    {
+        if (decoration->getOp() == kIROp_NVAPISlotDecoration)
+        {
+            auto cloned = cloneInst(&context, context.builder, decoration);
+            cloned->insertAtStart(module->getModuleInst());
+        }
+    }
+
+    LinkedIR linkedIR;
+    linkedIR.module = module;
+    linkedIR.globalScopeVarLayout = irGlobalScopeVarLayout;
+    linkedIR.entryPoints = irEntryPoints;
+    return linkedIR;
+}
+
+LinkedIR linkIR(
+    CodeGenContext* codeGenContext)
+{
+    auto program = codeGenContext->getProgram();
+    auto& entryPointIndices = codeGenContext->getEntryPointIndices();
+
+    // When the target links once, the first time the IR for an entry point of the program is
+    // linked, the IR for all of the entry points is linked into a module they share. The IR for
+    // each entry point is then extracted from that module, so that selecting and cloning
+    // definitions from the input modules is done once for the program, rather than once for each
+    // entry point.
+    //
+    if (codeGenContext->getTargetReq()->shouldLinkOnce() &&
+        entryPointIndices.getCount() == 1 &&
+        program->getEntryPointCount() > 1)
+    {
+        auto& sharedIR = codeGenContext->getTargetProgram()->getSharedLinkedIR();
+        {
+            std::lock_guard<std::mutex> lock(sharedIR.mutex);
+            if (!sharedIR.isLinked)
+            {
+                _linkSharedIR(codeGenContext, sharedIR);
+            }
+        }
+
+        // The shared IR isn't changed once it is linked, so it can be read
+        // without the lock, including from multiple threads at once.
+        if (sharedIR.module)
+        {
+            codeGenContext->getSink()->appendOutputFrom(sharedIR.sink);
+            return _extractEntryPointIR(codeGenContext, sharedIR, entryPointIndices[0]);
+        }
+    }
+
+    return _linkIR(codeGenContext, entryPointIndices);
+}
+
 struct ReplaceGlobalConstantsPass
 {
     void process(IRModule* module)
@@ -24,6 +24,11 @@ namespace Slang
     // that is best specialized for the appropriate compilation
     // target will be used.
     //
+    // If the target links once (see `TargetRequest::shouldLinkOnce`)
+    // the IR for a single entry point is extracted from a module with
+    // all the entry points of the program linked into it, which is
+    // linked the first time any of them is requested.
+    //
     LinkedIR linkIR(
         CodeGenContext* codeGenContext);
 
@@ -3,7 +3,7 @@
 #include "slang-ir-insts.h"
 #include "slang-ir.h"
 
-#include "slang-ir-dominators.h"
+#include "slang-ir-analysis-cache.h"
 
 namespace Slang
 {
@@ -1282,7 +1282,7 @@ void LivenessContext::_processFunction(IRFunc* func)
     SLANG_ASSERT(m_rangeStarts.getCount() > 0);
 
     // Create the dominator tree, for the function
-    m_dominatorTree = computeDominatorTree(func);
+    m_dominatorTree = getDominatorTree(func);
 
     // We are going to precalculate a variety of things for blocks. 
     // Most processing is performed via BlockIndex, so we need to set up a map from the block pointer to the index
@@ -2,7 +2,7 @@
 #include "slang-ir.h"
 #include "slang-ir-insts.h"
 #include "slang-ir-peephole.h"
-#include "slang-ir-dominators.h"
+#include "slang-ir-analysis-cache.h"
 #include "slang-ir-clone.h"
 #include "slang-ir-util.h"
 #include "slang-ir-simplify-cfg.h"
@@ -47,37 +47,9 @@ static bool _eliminateDeadBlocks(List<IRBlock*>& blocks, IRBlock* unreachableBlo
     return changed;
 }
 
-List<IRBlock*> _collectBlocksInLoop(IRDominatorTree* dom, IRLoop* loopInst)
+List<IRBlock*> collectBlocksInLoop(IRLoop* loopInst)
 {
-    List<IRBlock*> loopBlocks;
-    HashSet<IRBlock*> loopBlocksSet;
-    auto addBlock = [&](IRBlock* block)
-    {
-        if (loopBlocksSet.Add(block))
-            loopBlocks.add(block);
-    };
-    auto firstBlock = as<IRBlock>(loopInst->block.get());
-    auto breakBlock = as<IRBlock>(loopInst->breakBlock.get());
-
-    addBlock(firstBlock);
-    for (Index i = 0; i < loopBlocks.getCount(); i++)
-    {
-        auto block = loopBlocks[i];
-        for (auto succ : block->getSuccessors())
-        {
-            if (succ == breakBlock)
-                continue;
-            if (dom->dominates(firstBlock, succ) && !dom->dominates(breakBlock, succ))
-                addBlock(succ);
-        }
-    }
-    return loopBlocks;
-}
-
-List<IRBlock*> collectBlocksInLoop(IRGlobalValueWithCode* func,  IRLoop* loopInst)
-{
-    auto dom = computeDominatorTree(func);
-    return _collectBlocksInLoop(dom, loopInst);
+    return getLoopBlocks(loopInst);
 }
 
 static int _getLoopMaxIterationsToUnroll(IRLoop* loopInst)
@@ -483,7 +455,7 @@ bool unrollLoopsInFunc(
         // Remove any continue jumps from the loop.
         eliminateContinueBlocks(module, loop);
 
-        auto blocks = collectBlocksInLoop(func, loop);
+        auto blocks = collectBlocksInLoop(loop);
         auto loopLoc = loop->sourceLoc;
         if (!_unrollLoop(module, loop, blocks))
         {
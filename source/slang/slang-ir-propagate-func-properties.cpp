@@ -7,7 +7,7 @@
 
 namespace Slang
 {
-bool propagateFuncProperties(IRModule* module)
+bool propagateFuncProperties(IRModule* module, List<IRFunc*>* outChangedFuncs)
 {
     bool result = false;
     List<IRFunc*> workList;
@@ -173,6 +173,8 @@ bool propagateFuncProperties(IRModule* module)
             if (!hasSideEffectCall)
             {
                 builder.addDecoration(f, kIROp_ReadNoneDecoration);
+                if (outChangedFuncs)
+                    outChangedFuncs->add(f);
                 addCallersToWorkList(f);
                 changed = true;
             }
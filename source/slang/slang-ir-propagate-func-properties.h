@@ -1,7 +1,13 @@
 #pragma once
 
+#include "../core/slang-list.h"
+
 namespace Slang
 {
 struct IRModule;
-bool propagateFuncProperties(IRModule* module);
+struct IRFunc;
+
+    /// Propagate side-effect-free (`ReadNone`) properties through the call graph.
+    /// If `outChangedFuncs` is set, every function that gained a property is appended to it.
+bool propagateFuncProperties(IRModule* module, List<IRFunc*>* outChangedFuncs = nullptr);
 }
@@ -1,5 +1,5 @@
 #include "slang-ir-redundancy-removal.h"
-#include "slang-ir-dominators.h"
+#include "slang-ir-analysis-cache.h"
 #include "slang-ir-util.h"
 
 namespace Slang
@@ -195,7 +195,7 @@ bool removeRedundancyInFunc(IRGlobalValueWithCode* func)
         return false;
 
     RedundancyRemovalContext context;
-    context.dom = computeDominatorTree(func);
+    context.dom = getDominatorTree(func);
     DeduplicateContext deduplicateCtx;
     return context.removeRedundancyInBlock(deduplicateCtx, func, root);
 }
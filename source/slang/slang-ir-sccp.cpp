@@ -1689,6 +1689,17 @@ bool applySparseConditionalConstantPropagation(IRInst* func)
     return applySparseConditionalConstantPropagationRec(globalContext, func);
 }
 
+bool applySparseConditionalConstantPropagationForGlobalScope(IRModule* module)
+{
+    SharedSCCPContext shared;
+    shared.module = module;
+
+    SCCPContext globalContext;
+    globalContext.shared = &shared;
+    globalContext.code = nullptr;
+    return globalContext.applyOnGlobalScope(module);
+}
+
 IRInst* tryConstantFoldInst(IRModule* module, IRInst* inst)
 {
     SharedSCCPContext shared;
@@ -19,6 +19,11 @@ namespace Slang
 
     bool applySparseConditionalConstantPropagation(IRInst* func);
 
+        /// Apply SCCP to the instructions at global scope of `module` only,
+        /// without visiting any function bodies.
+        /// Returns true if IR is changed.
+    bool applySparseConditionalConstantPropagationForGlobalScope(IRModule* module);
+
     IRInst* tryConstantFoldInst(IRModule* module, IRInst* inst);
 }
 
@@ -2,7 +2,7 @@
 
 #include "slang-ir-insts.h"
 #include "slang-ir.h"
-#include "slang-ir-dominators.h"
+#include "slang-ir-analysis-cache.h"
 #include "slang-ir-restructure.h"
 #include "slang-ir-util.h"
 #include "slang-ir-loop-unroll.h"
@@ -55,7 +55,7 @@ static bool isTrivialSingleIterationLoop(
     // that skips out of this loop.
     CFGSimplificationContext context;
     if (!context.domTree)
-        context.domTree = computeDominatorTree(func);
+        context.domTree = getDominatorTree(func);
     if (!context.regionTree)
         context.regionTree = generateRegionTreeForFunc(func, nullptr);
 
@@ -99,7 +99,7 @@ static bool isTrivialSingleIterationLoop(
 
 static bool doesLoopHasSideEffect(IRGlobalValueWithCode* func, IRLoop* loopInst)
 {
-    auto blocks = collectBlocksInLoop(func, loopInst);
+    auto blocks = collectBlocksInLoop(loopInst);
     HashSet<IRBlock*> loopBlocks;
     for (auto b : blocks)
         loopBlocks.Add(b);
@@ -0,0 +1,527 @@
+// slang-ir-specialization-cache.cpp
+#include "slang-ir-specialization-cache.h"
+
+#include "slang-ir.h"
+#include "slang-ir-clone.h"
+#include "slang-ir-insts.h"
+
+namespace Slang
+{
+
+// Find the mangled name of a global value. A generic may only have a name on the value it returns.
+static IRLinkageDecoration* _findLinkageDecoration(IRInst* inst)
+{
+    if (auto linkage = inst->findDecoration<IRLinkageDecoration>())
+    {
+        return linkage;
+    }
+    if (as<IRGeneric>(inst))
+    {
+        return getResolvedInstForDecorations(inst)->findDecoration<IRLinkageDecoration>();
+    }
+    return nullptr;
+}
+
+static bool _isDescendantOf(IRInst* inst, IRInst* ancestor)
+{
+    for (; inst; inst = inst->getParent())
+    {
+        if (inst == ancestor)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Find all of the values used by `inst` (and its decorations and children) that are not defined inside of `root`
+static void _collectExternalOperands(IRInst* root, IRInst* inst, List<IRInst*>& outOperands)
+{
+    if (auto type = inst->getFullType())
+    {
+        if (!_isDescendantOf(type, root))
+        {
+            outOperands.add(type);
+        }
+    }
+
+    const UInt operandCount = inst->getOperandCount();
+    for (UInt i = 0; i < operandCount; ++i)
+    {
+        auto operand = inst->getOperand(i);
+        if (operand && !_isDescendantOf(operand, root))
+        {
+            outOperands.add(operand);
+        }
+    }
+
+    for (auto child : inst->getDecorationsAndChildren())
+    {
+        _collectExternalOperands(root, child, outOperands);
+    }
+}
+
+// Make a copy of the literal `inst` with `builder`. `type` is the type to use for the copy.
+static IRInst* _cloneLiteral(IRBuilder* builder, IRInst* inst, IRType* type)
+{
+    switch (inst->getOp())
+    {
+        case kIROp_BoolLit:     return builder->getBoolValue(as<IRBoolLit>(inst)->getValue());
+        case kIROp_IntLit:      return builder->getIntValue(type, as<IRIntLit>(inst)->getValue());
+        case kIROp_FloatLit:    return builder->getFloatValue(type, as<IRFloatLit>(inst)->getValue());
+        case kIROp_StringLit:   return builder->getStringValue(as<IRStringLit>(inst)->getStringSlice());
+        case kIROp_VoidLit:     return builder->getVoidValue();
+        case kIROp_PtrLit:
+        {
+            // Only null pointers can be cloned
+            return as<IRPtrLit>(inst)->getValue() ? nullptr : builder->getNullPtrValue(type);
+        }
+        default: return nullptr;
+    }
+}
+
+// True if `inst` is a hoistable instruction (such as a type) that can be recreated from its operands
+static bool _isClonableHoistable(IRInst* inst)
+{
+    return getIROpInfo(inst->getOp()).isHoistable() &&
+        inst->getFirstDecorationOrChild() == nullptr;
+}
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!! IRSpecializationCache !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+IRModule* IRSpecializationCache::getOrCreateModule()
+{
+    if (!m_module)
+    {
+        m_module = IRModule::create(m_session);
+    }
+    return m_module;
+}
+
+IRInst* IRSpecializationCache::findValue(const String& key)
+{
+    auto value = m_valueForKey.TryGetValue(key);
+    return value ? *value : nullptr;
+}
+
+void IRSpecializationCache::addValue(const String& key, IRInst* value)
+{
+    SLANG_ASSERT(value->getModule() == m_module);
+    m_valueForKey.Add(key, value);
+    m_keyForValue.Add(value, key);
+}
+
+IRInst* IRSpecializationCache::getOrCreateGlobal(const UnownedStringSlice& mangledName)
+{
+    const String name(mangledName);
+    if (auto global = m_globalForName.TryGetValue(name))
+    {
+        return *global;
+    }
+
+    // All that matters is that the instruction is unique, and that it isn't hoistable
+    // (so that it doesn't get deduplicated), so a struct key will do.
+    IRBuilder builder(getOrCreateModule());
+    builder.setInsertInto(m_module->getModuleInst());
+    IRInst* global = builder.createStructKey();
+
+    m_globalForName.Add(name, global);
+    m_nameForGlobal.Add(global, name);
+    return global;
+}
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!! IRSpecializationCacheContext !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+void IRSpecializationCacheContext::initGlobals(const HashSet<IRInst*>& specializedValues)
+{
+    m_nameForGlobal.Clear();
+    m_globalForName.Clear();
+    m_structuralKeys.Clear();
+
+    // The results of specialization have the same mangled name as the generic they came from,
+    // so they are skipped. If any other globals share a name, it can't be known which one
+    // a reference is to, so the name isn't used.
+    Dictionary<String, IRInst*> globalForName;
+    for (auto inst : m_module->getGlobalInsts())
+    {
+        if (specializedValues.Contains(inst))
+        {
+            continue;
+        }
+
+        if (auto linkage = _findLinkageDecoration(inst))
+        {
+            const String name(linkage->getMangledName());
+            if (auto existing = globalForName.TryGetValue(name))
+            {
+                *existing = nullptr;
+            }
+            else
+            {
+                globalForName.Add(name, inst);
+            }
+        }
+    }
+
+    for (const auto& pair : globalForName)
+    {
+        if (pair.Value)
+        {
+            m_globalForName.Add(pair.Key, pair.Value);
+            m_nameForGlobal.Add(pair.Value, pair.Key);
+        }
+    }
+}
+
+const String* IRSpecializationCacheContext::_findGlobalName(IRInst* inst)
+{
+    const String* name = m_nameForGlobal.TryGetValue(inst);
+    if (!name || inst->getParent() != m_module->getModuleInst())
+    {
+        return nullptr;
+    }
+
+    // Check the instruction is still the one the name was found for
+    auto linkage = _findLinkageDecoration(inst);
+    return (linkage && linkage->getMangledName() == name->getUnownedSlice()) ? name : nullptr;
+}
+
+bool IRSpecializationCacheContext::_appendKey(IRInst* inst, StringBuilder& out)
+{
+    // Each part of the key starts with a character that identifies the kind of part,
+    // and names (which may contain any characters) are prefixed with their length,
+    // so that different keys can't produce the same string.
+    if (!inst)
+    {
+        out << "0";
+        return true;
+    }
+
+    if (auto key = m_keyForValue.TryGetValue(inst))
+    {
+        out << "S" << key->getLength() << ":" << *key;
+        return true;
+    }
+
+    if (auto key = m_structuralKeys.TryGetValue(inst))
+    {
+        out << *key;
+        return true;
+    }
+
+    // Anything else must be a global
+    if (inst->getParent() != m_module->getModuleInst())
+    {
+        return false;
+    }
+
+    if (auto name = _findGlobalName(inst))
+    {
+        out << "N" << name->getLength() << ":" << *name;
+        return true;
+    }
+
+    StringBuilder buf;
+    if (auto constant = as<IRConstant>(inst))
+    {
+        buf << "L" << Index(inst->getOp()) << ":";
+        if (!_appendKey(inst->getFullType(), buf))
+        {
+            return false;
+        }
+
+        switch (inst->getOp())
+        {
+            case kIROp_BoolLit:
+            case kIROp_IntLit:
+            case kIROp_PtrLit:
+            {
+                buf << ":" << int64_t(constant->value.intVal);
+                break;
+            }
+            case kIROp_FloatLit:
+            {
+                // Use the bits, so the key is exact
+                uint64_t bits;
+                ::memcpy(&bits, &constant->value.floatVal, sizeof(bits));
+                buf << ":" << bits;
+                break;
+            }
+            case kIROp_StringLit:
+            {
+                const auto slice = constant->getStringSlice();
+                buf << ":" << slice.getLength() << ":" << slice;
+                break;
+            }
+            default: break;
+        }
+    }
+    else if (_isClonableHoistable(inst))
+    {
+        buf << "(" << Index(inst->getOp()) << " ";
+        if (!_appendKey(inst->getFullType(), buf))
+        {
+            return false;
+        }
+        const UInt operandCount = inst->getOperandCount();
+        for (UInt i = 0; i < operandCount; ++i)
+        {
+            buf << " ";
+            if (!_appendKey(inst->getOperand(i), buf))
+            {
+                return false;
+            }
+        }
+        buf << ")";
+    }
+    else
+    {
+        return false;
+    }
+
+    String key = buf.ProduceString();
+    out << key;
+    m_structuralKeys.Add(inst, key);
+    return true;
+}
+
+bool IRSpecializationCacheContext::calcKey(IRInst* generic, IRInst* const* args, Index argCount, String& outKey)
+{
+    StringBuilder buf;
+    buf << "G";
+    if (!_appendKey(generic, buf))
+    {
+        return false;
+    }
+
+    buf << "<";
+    for (Index i = 0; i < argCount; ++i)
+    {
+        buf << (i ? "," : "");
+        if (!_appendKey(args[i], buf))
+        {
+            return false;
+        }
+    }
+    buf << ">";
+
+    outKey = buf.ProduceString();
+    return true;
+}
+
+void IRSpecializationCacheContext::addSpecialization(const String& key, IRInst* value)
+{
+    m_keyForValue[value] = key;
+    m_valueForKey[key] = value;
+}
+
+IRInst* IRSpecializationCacheContext::findSpecialization(const String& key)
+{
+    auto value = m_valueForKey.TryGetValue(key);
+    // The value may have been removed from the module since it was added
+    return (value && (*value)->getParent()) ? *value : nullptr;
+}
+
+IRInst* IRSpecializationCacheContext::_mapToCache(IRInst* inst, IRBuilder* builder, IRCloneEnv* env)
+{
+    if (auto mapped = env->mapOldValToNew.TryGetValue(inst))
+    {
+        return *mapped;
+    }
+
+    IRInst* cacheInst = nullptr;
+    if (auto key = m_keyForValue.TryGetValue(inst))
+    {
+        // Specializations are stored when they are made, so one that isn't in the cache
+        // couldn't be stored (and the module's version may have been changed by other passes since)
+        cacheInst = m_cache->findValue(*key);
+        if (!cacheInst)
+        {
+            return nullptr;
+        }
+    }
+    else if (inst->getParent() != m_module->getModuleInst())
+    {
+        return nullptr;
+    }
+    else if (auto name = _findGlobalName(inst))
+    {
+        cacheInst = m_cache->getOrCreateGlobal(name->getUnownedSlice());
+    }
+    else if (as<IRConstant>(inst) || _isClonableHoistable(inst))
+    {
+        IRInst* type = nullptr;
+        if (auto oldType = inst->getFullType())
+        {
+            type = _mapToCache(oldType, builder, env);
+            if (!type)
+            {
+                return nullptr;
+            }
+        }
+
+        builder->setInsertInto(builder->getModule()->getModuleInst());
+        if (as<IRConstant>(inst))
+        {
+            cacheInst = _cloneLiteral(builder, inst, (IRType*)type);
+        }
+        else
+        {
+            const UInt operandCount = inst->getOperandCount();
+            ShortList<IRInst*> operands;
+            operands.setCount(operandCount);
+            for (UInt i = 0; i < operandCount; ++i)
+            {
+                auto operand = inst->getOperand(i);
+                operands[i] = operand ? _mapToCache(operand, builder, env) : nullptr;
+                if (operand && !operands[i])
+                {
+                    return nullptr;
+                }
+            }
+            cacheInst = builder->emitIntrinsicInst((IRType*)type, inst->getOp(), operandCount, operands.getArrayView().getBuffer());
+        }
+    }
+
+    if (cacheInst)
+    {
+        env->mapOldValToNew[inst] = cacheInst;
+    }
+    return cacheInst;
+}
+
+void IRSpecializationCacheContext::storeSpecialization(const String& key, IRInst* value)
+{
+    std::lock_guard<std::mutex> lock(m_cache->getMutex());
+
+    // Another module may have stored the same specialization
+    if (m_cache->findValue(key))
+    {
+        return;
+    }
+
+    IRBuilder builder(m_cache->getOrCreateModule());
+    IRCloneEnv env;
+
+    // Everything the value references from outside of itself must first be mapped to
+    // an equivalent in the cache.
+    List<IRInst*> operands;
+    _collectExternalOperands(value, value, operands);
+
+    for (auto operand : operands)
+    {
+        if (!_mapToCache(operand, &builder, &env))
+        {
+            return;
+        }
+    }
+
+    builder.setInsertInto(builder.getModule()->getModuleInst());
+    IRInst* cachedValue = cloneInst(&env, &builder, value);
+    m_cache->addValue(key, cachedValue);
+}
+
+IRInst* IRSpecializationCacheContext::_mapFromCache(IRInst* inst, IRInst* insertBefore, IRCloneEnv* env, List<IRInst*>& outClonedValues)
+{
+    if (auto mapped = env->mapOldValToNew.TryGetValue(inst))
+    {
+        return *mapped;
+    }
+
+    IRInst* moduleInst = nullptr;
+    if (auto key = m_cache->findKey(inst))
+    {
+        moduleInst = findSpecialization(*key);
+        if (!moduleInst)
+        {
+            moduleInst = _cloneFromCache(inst, *key, insertBefore, env, outClonedValues);
+        }
+    }
+    else if (auto name = m_cache->findGlobalName(inst))
+    {
+        if (auto global = m_globalForName.TryGetValue(*name))
+        {
+            // Check the global is still in the module
+            moduleInst = _findGlobalName(*global) ? *global : nullptr;
+        }
+    }
+    else if (as<IRConstant>(inst) || _isClonableHoistable(inst))
+    {
+        IRInst* type = nullptr;
+        if (auto oldType = inst->getFullType())
+        {
+            type = _mapFromCache(oldType, insertBefore, env, outClonedValues);
+            if (!type)
+            {
+                return nullptr;
+            }
+        }
+
+        IRBuilder builder(m_module);
+        builder.setInsertInto(m_module->getModuleInst());
+        if (as<IRConstant>(inst))
+        {
+            moduleInst = _cloneLiteral(&builder, inst, (IRType*)type);
+        }
+        else
+        {
+            const UInt operandCount = inst->getOperandCount();
+            ShortList<IRInst*> operands;
+            operands.setCount(operandCount);
+            for (UInt i = 0; i < operandCount; ++i)
+            {
+                auto operand = inst->getOperand(i);
+                operands[i] = operand ? _mapFromCache(operand, insertBefore, env, outClonedValues) : nullptr;
+                if (operand && !operands[i])
+                {
+                    return nullptr;
+                }
+            }
+            moduleInst = builder.emitIntrinsicInst((IRType*)type, inst->getOp(), operandCount, operands.getArrayView().getBuffer());
+        }
+    }
+
+    if (moduleInst)
+    {
+        env->mapOldValToNew[inst] = moduleInst;
+    }
+    return moduleInst;
+}
+
+IRInst* IRSpecializationCacheContext::_cloneFromCache(IRInst* cachedValue, const String& key, IRInst* insertBefore, IRCloneEnv* env, List<IRInst*>& outClonedValues)
+{
+    List<IRInst*> operands;
+    _collectExternalOperands(cachedValue, cachedValue, operands);
+
+    for (auto operand : operands)
+    {
+        if (!_mapFromCache(operand, insertBefore, env, outClonedValues))
+        {
+            return nullptr;
+        }
+    }
+
+    IRBuilder builder(m_module);
+    builder.setInsertBefore(insertBefore);
+    IRInst* value = cloneInst(env, &builder, cachedValue);
+
+    addSpecialization(key, value);
+    outClonedValues.add(value);
+    return value;
+}
+
+IRInst* IRSpecializationCacheContext::findCachedSpecialization(const String& key, IRInst* insertBefore, List<IRInst*>& outClonedValues)
+{
+    std::lock_guard<std::mutex> lock(m_cache->getMutex());
+
+    IRInst* cachedValue = m_cache->findValue(key);
+    if (!cachedValue)
+    {
+        return nullptr;
+    }
+
+    IRCloneEnv env;
+    return _cloneFromCache(cachedValue, key, insertBefore, &env, outClonedValues);
+}
+
+} // namespace Slang
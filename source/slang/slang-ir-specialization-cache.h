@@ -0,0 +1,142 @@
+// slang-ir-specialization-cache.h
+#pragma once
+
+#include "../core/slang-basic.h"
+
+#include <mutex>
+
+namespace Slang
+{
+struct IRBuilder;
+struct IRCloneEnv;
+struct IRInst;
+struct IRModule;
+class Session;
+
+    /// Holds generic specializations made in one IR module, so that they can be reused by
+    /// other IR modules linked from the same program for the same target.
+    ///
+    /// Each entry point of a program is linked into its own IR module, so without the cache
+    /// the same `specialize(g, a, b)` is evaluated once per entry point.
+    ///
+    /// A value is stored as soon as the specialization is made, before the specialization pass
+    /// or any later pass (such as inlining, loop unrolling or auto-diff) has changed it. So a module
+    /// that clones a cached value gets the same value as it would have made itself, and processes
+    /// it in the same way.
+    ///
+    /// A specialization is identified by a key string built from the mangled name of the
+    /// generic, and a structural description of its arguments (see `IRSpecializationCacheContext`).
+    /// The cached values are held in an IR module owned by the cache. References a cached value
+    /// makes to global values are held by mangled name, or by key for other specializations,
+    /// and are resolved against the module the value is cloned into. Values that reference
+    /// anything that can't be identified that way are not cached.
+    ///
+    /// The cache can be used by modules being specialized on different threads. All access
+    /// must be made with the mutex locked.
+class IRSpecializationCache : public RefObject
+{
+public:
+        /// Get the mutex that must be held to access the cache
+    std::mutex& getMutex() { return m_mutex; }
+
+        /// Get the module that holds the cached values
+    IRModule* getOrCreateModule();
+
+        /// Find the cached value for the key. Returns nullptr if there isn't one.
+    IRInst* findValue(const String& key);
+        /// Find the key of a cached value. Returns nullptr if `value` isn't a cached value.
+    const String* findKey(IRInst* value) { return m_keyForValue.TryGetValue(value); }
+        /// Add `value` (which must be in the cache's module) as the value for `key`
+    void addValue(const String& key, IRInst* value);
+
+        /// Get the instruction that stands for the global value with `mangledName` in cached values
+    IRInst* getOrCreateGlobal(const UnownedStringSlice& mangledName);
+        /// Find the mangled name `global` stands for. Returns nullptr if it doesn't stand for a global value.
+    const String* findGlobalName(IRInst* global) { return m_nameForGlobal.TryGetValue(global); }
+
+        /// Get the number of cached values
+    Count getCount() const { return m_valueForKey.Count(); }
+
+        /// Ctor
+    explicit IRSpecializationCache(Session* session):
+        m_session(session)
+    {
+    }
+
+protected:
+    Session* m_session;
+    std::mutex m_mutex;
+
+    RefPtr<IRModule> m_module;
+
+    Dictionary<String, IRInst*> m_valueForKey;
+    Dictionary<IRInst*, String> m_keyForValue;
+
+    Dictionary<String, IRInst*> m_globalForName;
+    Dictionary<IRInst*, String> m_nameForGlobal;
+};
+
+    /// Uses an `IRSpecializationCache` for the specializations made in a single module.
+    ///
+    /// The key for `specialize(g, a, b)` is made from the mangled name of `g`, and keys for each
+    /// argument. The key for an argument is
+    ///
+    /// * the key of the specialization, if it is the result of a specialization
+    /// * the mangled name of a global value, as long as it is the only global in the module with that name
+    /// * the type and value of a literal
+    /// * the opcode, type and keys of the operands of a hoistable instruction (such as a type)
+    ///
+    /// Specializations that have an argument for which a key can't be made are not cached.
+struct IRSpecializationCacheContext
+{
+        /// Must be called before the module is changed by specialization.
+        /// `specializedValues` holds all of the results of specialization that are already in the module.
+    void initGlobals(const HashSet<IRInst*>& specializedValues);
+
+        /// Calculate the key for specializing `generic` with `args`. Returns false if there isn't one.
+    bool calcKey(IRInst* generic, IRInst* const* args, Index argCount, String& outKey);
+
+        /// Record that `value` is the result of the specialization with `key`
+    void addSpecialization(const String& key, IRInst* value);
+        /// Find the value in the module for the specialization with `key`
+    IRInst* findSpecialization(const String& key);
+
+        /// Find a cached value for `key`, and clone it into the module before `insertBefore`.
+        /// Any specializations it depends on that are not in the module are cloned too, and all of
+        /// the values added are appended to `outClonedValues`.
+        /// Returns nullptr if there isn't a cached value, or it can't be used in this module.
+    IRInst* findCachedSpecialization(const String& key, IRInst* insertBefore, List<IRInst*>& outClonedValues);
+
+        /// Add `value`, which has just been made by specializing with `key` (so it hasn't been changed
+        /// by any other pass), to the cache, if everything it references can be identified in other modules
+    void storeSpecialization(const String& key, IRInst* value);
+
+        /// Ctor
+    IRSpecializationCacheContext(IRSpecializationCache* cache, IRModule* module):
+        m_cache(cache),
+        m_module(module)
+    {
+    }
+
+protected:
+    bool _appendKey(IRInst* inst, StringBuilder& out);
+    const String* _findGlobalName(IRInst* inst);
+
+    IRInst* _mapToCache(IRInst* inst, IRBuilder* builder, IRCloneEnv* env);
+
+    IRInst* _cloneFromCache(IRInst* cachedValue, const String& key, IRInst* insertBefore, IRCloneEnv* env, List<IRInst*>& outClonedValues);
+    IRInst* _mapFromCache(IRInst* inst, IRInst* insertBefore, IRCloneEnv* env, List<IRInst*>& outClonedValues);
+
+    IRSpecializationCache* m_cache;
+    IRModule* m_module;
+
+    Dictionary<IRInst*, String> m_keyForValue;              ///< The key of each specialization in the module
+    Dictionary<String, IRInst*> m_valueForKey;
+
+    Dictionary<IRInst*, String> m_nameForGlobal;            ///< Globals in the module with a unique mangled name
+    Dictionary<String, IRInst*> m_globalForName;
+
+    Dictionary<IRInst*, String> m_structuralKeys;           ///< Keys of hoistable insts and literals, that have been calculated
+};
+
+}
@@ -4,6 +4,7 @@
 #include "slang-ir.h"
 #include "slang-ir-clone.h"
 #include "slang-ir-insts.h"
+#include "slang-ir-specialization-cache.h"
 #include "slang-ir-ssa-simplification.h"
 
 namespace Slang
@@ -204,6 +205,13 @@ struct SpecializationContext
     typedef IRSimpleSpecializationKey Key;
     Dictionary<Key, IRInst*> genericSpecializations;
 
+    // Other modules linked from the same program for the same target
+    // will often need the same specializations, so if there is a cache
+    // we look for a specialization there before making it ourselves,
+    // and add the specializations we make to it.
+    //
+    IRSpecializationCacheContext* cacheContext = nullptr;
+
 
     // Now let's look at the task of finding or generation a
     // specialization of some generic `g`, given a specialization
@@ -245,6 +253,35 @@ struct SpecializationContext
                 return specializedVal;
         }
 
+        // Next we look for a specialization made by another module.
+        //
+        String cacheKey;
+        const bool hasCacheKey = cacheContext &&
+            cacheContext->calcKey(key.vals[0], key.vals.getBuffer() + 1, key.vals.getCount() - 1, cacheKey);
+        if (hasCacheKey)
+        {
+            IRInst* specializedVal = cacheContext->findSpecialization(cacheKey);
+            if (!specializedVal)
+            {
+                List<IRInst*> clonedVals;
+                specializedVal = cacheContext->findCachedSpecialization(cacheKey, genericVal, clonedVals);
+
+                // Like a specialization we make ourselves, the cloned values may
+                // expose more specialization opportunities.
+                for (auto clonedVal : clonedVals)
+                {
+                    for (auto child : clonedVal->getDecorationsAndChildren())
+                        addToWorkList(child);
+                }
+            }
+
+            if (specializedVal)
+            {
+                genericSpecializations.Add(key, specializedVal);
+                return specializedVal;
+            }
+        }
+
         // If no existing specialization is found, we need
         // to create the specialization instead.
         // This mostly amounts to evaluating the generic as
@@ -269,6 +306,13 @@ struct SpecializationContext
         // this generic again for the same arguments.
         //
         genericSpecializations.Add(key, specializedVal);
+        if (hasCacheKey)
+        {
+            // Other modules can use the value as it is now, before it is changed
+            // by the rest of this pass or by later passes
+            cacheContext->addSpecialization(cacheKey, specializedVal);
+            cacheContext->storeSpecialization(cacheKey, specializedVal);
+        }
 
         return specializedVal;
     }
@@ -807,6 +851,54 @@ struct SpecializationContext
         _writeSpecializationDictionaryImpl(existentialSpecializedStructs, kIROp_ExistentialTypeSpecializationDictionary, moduleInst);
     }
 
+    // The specializations made by previous runs of the pass are read from
+    // the module, so the cache context needs to be told about them, so it
+    // can make keys for specializations that use them as arguments. They
+    // have been changed by other passes since they were made, so they
+    // aren't stored in the cache (they were stored when they were made).
+    //
+    void initSpecializationCache()
+    {
+        HashSet<IRInst*> specializedVals;
+        for (const auto& kv : genericSpecializations)
+            specializedVals.Add(kv.Value);
+        for (const auto& kv : existentialSpecializedFuncs)
+            specializedVals.Add(kv.Value);
+        for (const auto& kv : existentialSpecializedStructs)
+            specializedVals.Add(kv.Value);
+
+        cacheContext->initGlobals(specializedVals);
+
+        // The key for a specialization can depend on the keys of the
+        // specializations used as its arguments, so we keep finding keys
+        // until no more can be found.
+        //
+        List<KeyValuePair<Key, IRInst*>> remaining;
+        for (const auto& kv : genericSpecializations)
+            remaining.add(KeyValuePair<Key, IRInst*>(kv.Key, kv.Value));
+
+        for (bool foundKey = true; foundKey; )
+        {
+            foundKey = false;
+            for (Index i = 0; i < remaining.getCount(); )
+            {
+                const auto& vals = remaining[i].Key.vals;
+
+                String cacheKey;
+                if (cacheContext->calcKey(vals[0], vals.getBuffer() + 1, vals.getCount() - 1, cacheKey))
+                {
+                    cacheContext->addSpecialization(cacheKey, remaining[i].Value);
+                    remaining.fastRemoveAt(i);
+                    foundKey = true;
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+        }
+    }
+
     // All of the machinery for generic specialization
     // has been defined above, so we will now walk
     // through the flow of the overall specialization pass.
@@ -818,6 +910,9 @@ struct SpecializationContext
         // when this pass is invoked iteratively.
         readSpecializationDictionaries();
 
+        if (cacheContext)
+            initSpecializationCache();
+
         // The unspecialized IR we receive as input will have
         // `IRBindGlobalGenericParam` instructions that associate
         // each global-scope generic parameter (a type, witness
@@ -2318,10 +2413,16 @@ struct SpecializationContext
 };
 
 bool specializeModule(
-    IRModule*   module)
+    IRModule*               module,
+    IRSpecializationCache*  cache)
 {
     SpecializationContext context;
     context.module = module;
+
+    IRSpecializationCacheContext cacheContext(cache, module);
+    if (cache)
+        context.cacheContext = &cacheContext;
+
     context.processModule();
     return context.changed;
 }
@@ -4,10 +4,15 @@
 namespace Slang
 {
 struct IRModule;
+class IRSpecializationCache;
 
     /// Specialize generic and interface-based code to use concrete types.
+    ///
+    /// If `cache` is set, specializations are looked for in it before they are made,
+    /// and the specializations made are added to it.
 bool specializeModule(
-    IRModule*   module);
+    IRModule*               module,
+    IRSpecializationCache*  cache = nullptr);
 
 void finalizeSpecialization(IRModule* module);
 
@@ -3,7 +3,7 @@
 
 #include "slang-ir.h"
 #include "slang-ir-insts.h"
-#include "slang-ir-dominators.h"
+#include "slang-ir-analysis-cache.h"
 
 
 namespace Slang {
@@ -182,7 +182,7 @@ struct RegisterAllocateContext
         ReachabilityContext reachabilityContext;
         mapTypeToRegisterList.Clear();
 
-        auto dom = computeDominatorTree(func);
+        auto dom = getDominatorTree(func);
         inOutDom = dom;
 
         // Note that if inst A does not dominate inst B, then A can't be alive at B.
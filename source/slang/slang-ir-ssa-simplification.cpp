@@ -14,33 +14,217 @@
 
 namespace Slang
 {
-    // Run a combination of SSA, SCCP, SimplifyCFG, and DeadCodeElimination pass
-    // until no more changes are possible.
-    void simplifyIR(IRModule* module)
+    // Drives `simplifyIR` incrementally.
+    //
+    // The passes that work on function bodies (SCCP, peephole, redundancy removal,
+    // CFG simplification, DCE and SSA construction) are run per "unit" - a function,
+    // global variable or generic at module scope. Only units that changed in the
+    // previous iteration (or are affected by a change elsewhere) are revisited, so
+    // a large module where only a few functions keep changing does not re-scan every
+    // function body on each iteration.
+    //
+    // A unit is considered dirty if
+    // * it has not been seen before (all units are dirty on the first iteration)
+    // * one of the function body passes changed it in the previous iteration
+    // * it calls a function that `propagateFuncProperties` gave new properties to
+    // * anything at global scope changed, as that can affect any function body
+    struct SimplifyIRContext
     {
-        bool changed = true;
-        const int kMaxIterations = 8;
-        int iterationCounter = 0;
-        while (changed && iterationCounter < kMaxIterations)
+        IRModule* module = nullptr;
+        IRSimplificationOptions options;
+
+        HashSet<IRInst*> seenUnits;
+        HashSet<IRInst*> dirtyUnits;
+
+        static bool isUnit(IRInst* inst)
         {
-            changed = false;
+            return as<IRGlobalValueWithCode>(inst) || as<IRGeneric>(inst);
+        }
+
+        // Get the unit at module scope that contains inst, or nullptr if there isn't one.
+        IRInst* findParentUnit(IRInst* inst)
+        {
+            auto moduleInst = module->getModuleInst();
+            while (inst && inst->getParent() != moduleInst)
+            {
+                inst = inst->getParent();
+            }
+            return (inst && isUnit(inst)) ? inst : nullptr;
+        }
+
+        void markAllDirty()
+        {
+            for (auto inst : module->getGlobalInsts())
+            {
+                if (isUnit(inst))
+                    dirtyUnits.Add(inst);
+            }
+        }
+
+        // Mark every unit that uses `value` as dirty. Uses by global scope insts
+        // (such as a `specialize` of a generic) are followed to their users.
+        void markUsersDirty(IRInst* value, HashSet<IRInst*>& visited)
+        {
+            if (!visited.Add(value))
+                return;
+
+            for (auto use = value->firstUse; use; use = use->nextUse)
+            {
+                auto user = use->getUser();
+                if (auto unit = findParentUnit(user))
+                {
+                    dirtyUnits.Add(unit);
+                }
+                else if (user->getParent() == module->getModuleInst())
+                {
+                    markUsersDirty(user, visited);
+                }
+            }
+        }
+
+        // Returns the units to process this iteration, in module order, and clears the dirty set.
+        void takeDirtyUnits(List<IRInst*>& outUnits)
+        {
+            outUnits.clear();
+            for (auto inst : module->getGlobalInsts())
+            {
+                if (!isUnit(inst))
+                    continue;
+                if (seenUnits.Add(inst) || dirtyUnits.Contains(inst))
+                    outUnits.add(inst);
+            }
+            dirtyUnits.Clear();
+        }
+
+        // Simplifications of insts at global scope that are not inside a unit.
+        bool simplifyGlobalScope()
+        {
+            bool changed = false;
             changed |= hoistConstants(module);
             changed |= deduplicateGenericChildren(module);
-            changed |= applySparseConditionalConstantPropagation(module);
-            changed |= peepholeOptimize(module);
-            changed |= removeRedundancy(module);
-            changed |= simplifyCFG(module);
-            changed |= propagateFuncProperties(module);
+            changed |= applySparseConditionalConstantPropagationForGlobalScope(module);
+
+            List<IRInst*> globalInsts;
+            for (auto inst : module->getGlobalInsts())
+            {
+                if (!isUnit(inst))
+                    globalInsts.add(inst);
+            }
+            for (auto inst : globalInsts)
+            {
+                // The inst may have been removed by a peephole on an earlier inst
+                if (inst->getParent() == module->getModuleInst())
+                    changed |= peepholeOptimize(inst);
+            }
+            return changed;
+        }
+
+        bool simplifyUnit(IRInst* unit)
+        {
+            bool changed = false;
+            changed |= applySparseConditionalConstantPropagation(unit);
+            changed |= peepholeOptimize(unit);
+
+            IRInst* inner = unit;
+            if (auto genericInst = as<IRGeneric>(unit))
+            {
+                removeRedundancyInFunc(genericInst);
+                inner = findGenericReturnVal(genericInst);
+            }
+            if (auto func = as<IRFunc>(inner))
+            {
+                changed |= removeRedundancyInFunc(func);
+                changed |= eliminateRedundantLoadStore(func);
+                changed |= simplifyCFG(func);
+            }
 
             // Note: we disregard the `changed` state from dead code elimination pass since
             // SCCP pass could be generating temporarily evaluated constant values and never actually use them.
             // DCE will always remove those nearly generated consts and always returns true here.
-            eliminateDeadCode(module);
+            eliminateDeadCode(unit);
 
-            changed |= constructSSA(module);
-            changed |= removeUnusedGenericParam(module);
-            iterationCounter++;
+            changed |= constructSSA(module, unit);
+            return changed;
+        }
+
+        void simplify()
+        {
+            const int kMaxIterations = 8;
+
+            List<IRInst*> units;
+            List<IRInst*> changedUnits;
+            List<IRFunc*> changedFuncs;
+
+            bool changed = true;
+            int iterationCounter = 0;
+            while (changed && iterationCounter < kMaxIterations)
+            {
+                changed = false;
+
+                const bool globalChanged = simplifyGlobalScope();
+                if (globalChanged)
+                {
+                    changed = true;
+                    markAllDirty();
+                }
+                else if (options.fullRescan)
+                {
+                    markAllDirty();
+                }
+
+                takeDirtyUnits(units);
+                changedUnits.clear();
+                for (auto unit : units)
+                {
+                    if (simplifyUnit(unit))
+                        changedUnits.add(unit);
+                }
+                changed |= (changedUnits.getCount() != 0);
+
+                changedFuncs.clear();
+                if (propagateFuncProperties(module, &changedFuncs))
+                {
+                    changed = true;
+                    HashSet<IRInst*> visited;
+                    for (auto func : changedFuncs)
+                    {
+                        auto outerGeneric = findOuterGeneric(func);
+                        markUsersDirty(outerGeneric ? outerGeneric : func, visited);
+                    }
+                }
+
+                // Removing unreferenced globals requires a walk of the whole module, so only do so
+                // when the module as a whole has changed. Insts left behind by the per-unit passes
+                // are removed once we are done.
+                if (iterationCounter == 0 || globalChanged)
+                {
+                    eliminateDeadCode(module);
+                }
+
+                if (removeUnusedGenericParam(module))
+                {
+                    changed = true;
+                    markAllDirty();
+                }
+
+                for (auto unit : changedUnits)
+                    dirtyUnits.Add(unit);
+
+                iterationCounter++;
+            }
+
+            eliminateDeadCode(module);
         }
+    };
+
+    // Run a combination of SSA, SCCP, SimplifyCFG, and DeadCodeElimination pass
+    // until no more changes are possible.
+    void simplifyIR(IRModule* module, IRSimplificationOptions const& options)
+    {
+        SimplifyIRContext context;
+        context.module = module;
+        context.options = options;
+        context.simplify();
     }
 
     void simplifyNonSSAIR(IRModule* module)
@@ -6,9 +6,17 @@ namespace Slang
     struct IRModule;
     struct IRGlobalValueWithCode;
 
+    struct IRSimplificationOptions
+    {
+        // Revisit every function on each iteration, rather than only the ones that changed
+        // (or were affected by a change) in the previous iteration. The result is the same,
+        // so this is only useful to test the incremental driver against.
+        bool fullRescan = false;
+    };
+
     // Run a combination of SSA, SCCP, SimplifyCFG, and DeadCodeElimination pass
     // until no more changes are possible.
-    void simplifyIR(IRModule* module);
+    void simplifyIR(IRModule* module, IRSimplificationOptions const& options = IRSimplificationOptions());
 
     // Run simplifications on IR that is out of SSA form.
     void simplifyNonSSAIR(IRModule* module);
@@ -8,6 +8,8 @@ namespace Slang
     struct IRInst;
 
     bool constructSSA(IRModule* module, IRGlobalValueWithCode* globalVal);
+        /// Construct SSA for a global value, including the value produced by an `IRGeneric`.
+    bool constructSSA(IRModule* module, IRInst* globalVal);
     bool constructSSA(IRModule* module);
     bool constructSSA(IRInst* globalVal);
 }
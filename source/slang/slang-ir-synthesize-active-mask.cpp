@@ -1,7 +1,7 @@
 // slang-ir-synthesize-active-mask.cpp
 #include "slang-ir-synthesize-active-mask.h"
 
-#include "slang-ir-dominators.h"
+#include "slang-ir-analysis-cache.h"
 #include "slang-ir-insts.h"
 
 namespace Slang
@@ -958,7 +958,7 @@ struct SynthesizeActiveMaskForFunctionContext
         // the function, since that will help us
         // identify the regions.
         //
-        m_dominatorTree = computeDominatorTree(m_func);
+        m_dominatorTree = getDominatorTree(m_func);
 
         // Next we look up th active mask for the function's
         // entry region, which had better be set before
@@ -67,7 +67,7 @@ namespace Slang
             // We need to check the integrity of the parent/next/prev links of
             // all of our instructions
             validate(context, child->parent == parent,  child, "parent link");
-            validate(context, child->prev == prevChild, child, "next/prev link");
+            validate(context, child->getPrevInst() == prevChild, child, "next/prev link");
 
             // Recursively validate the instruction itself.
             validateIRInst(context, child);
@@ -328,6 +328,14 @@ namespace Slang
         if (auto code = as<IRGlobalValueWithCode>(inst))
         {
             validateCodeBody(context, code);
+
+            // Analyses of the CFG are kept until the IR invalidates them, so a change to the
+            // CFG that didn't invalidate them leaves them describing the old CFG.
+            validate(
+                context,
+                areCFGAnalysesUpToDate(code),
+                code,
+                "CFG analyses must be invalidated when the CFG changes.");
         }
     }
 
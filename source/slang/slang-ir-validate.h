@@ -26,6 +26,8 @@ namespace Slang
     //   elsewhere in a block.
     //
     // * Confirm that all the parameters of a block come before any "ordinary" instructions.
+    //
+    // * Confirm that the CFG analyses the module holds for a function describe its current CFG.
     void validateIRModule(IRModule* module, DiagnosticSink* sink);
 
     // A wrapper that calls `validateIRModule` only when IR validation is enabled
@@ -155,6 +155,12 @@ namespace Slang
         usedValue = v;
         if(v)
         {
+            // A block operand is a control flow edge
+            if (u && as<IRBlock>(v))
+            {
+                invalidateCFGAnalyses(u);
+            }
+
             nextUse = v->firstUse;
             prevLink = &v->firstUse;
 
@@ -191,6 +197,11 @@ namespace Slang
 #ifdef SLANG_ENABLE_FULL_IR_VALIDATION
             auto uv = usedValue;
 #endif
+            if (user && as<IRBlock>(usedValue))
+            {
+                invalidateCFGAnalyses(user);
+            }
+
             *prevLink = nextUse;
             if(nextUse)
             {
@@ -1443,6 +1454,35 @@ namespace Slang
         return inst;
     }
 
+    void IRModule::calcMemoryStats(IRModuleMemoryStats& outStats)
+    {
+        outStats = IRModuleMemoryStats();
+
+        // Walk the whole module including decorations. We use an explicit
+        // stack as function bodies can be nested fairly deeply.
+        List<IRInst*> stack;
+        stack.add(getModuleInst());
+        while (stack.getCount())
+        {
+            IRInst* inst = stack.getLast();
+            stack.removeLast();
+
+            const UInt operandCount = inst->getOperandCount();
+
+            outStats.instCount++;
+            outStats.operandCount += Count(operandCount);
+            outStats.instBytes += sizeof(IRInst) + operandCount * sizeof(IRUse);
+
+            for (auto child : inst->getDecorationsAndChildren())
+            {
+                stack.add(child);
+            }
+        }
+
+        outStats.arenaUsedBytes = m_memoryArena.calcTotalMemoryUsed();
+        outStats.arenaTotalBytes = m_memoryArena.calcTotalMemoryAllocated();
+    }
+
         /// Return whichever of `left` or `right` represents the later point in a common parent
     static IRInst* pickLaterInstInSameParent(
         IRInst* left,
@@ -6663,6 +6703,10 @@ namespace Slang
 
             //ff->debugValidate();
 
+            // Blocks are used as branch targets, so replacing one changes the
+            // control flow of the users.
+            const bool changesControlFlow = as<IRBlock>(thisInst) || as<IRBlock>(other);
+
             IRUse* uu = ff;
             for (;;)
             {
@@ -6671,6 +6715,10 @@ namespace Slang
                 SLANG_ASSERT(uu->get() == thisInst);
 
                 auto user = uu->getUser();
+                if (changesControlFlow)
+                {
+                    invalidateCFGAnalyses(user);
+                }
                 bool userIsHoistable = getIROpInfo(user->getOp()).isHoistable();
                 if (userIsHoistable)
                 {
@@ -6770,6 +6818,12 @@ namespace Slang
         insertAtStart(p);
     }
 
+    // True if adding or removing `inst` can change the control flow graph that holds it
+    static bool _isControlFlowInst(IRInst* inst)
+    {
+        return as<IRBlock>(inst) || as<IRTerminatorInst>(inst);
+    }
+
     void IRInst::_insertAt(IRInst* inPrev, IRInst* inNext, IRInst* inParent)
     {
         // Make sure this instruction has been removed from any previous parent
@@ -6779,27 +6833,34 @@ namespace Slang
         SLANG_ASSERT(!inPrev || (inPrev->getNextInst() == inNext) && (inPrev->getParent() == inParent));
         SLANG_ASSERT(!inNext || (inNext->getPrevInst() == inPrev) && (inNext->getParent() == inParent));
 
+        // The parent doesn't store the last decoration or child, the first's `prev` links to it.
+        // If inserting at the end, this becomes the last.
+        IRInst* last = inNext ? inParent->getLastDecorationOrChild() : this;
+
         if( inPrev )
         {
             inPrev->next = this;
         }
         else
         {
-            inParent->m_decorationsAndChildren.first = this;
+            inParent->m_firstDecorationOrChild = this;
         }
 
         if (inNext)
         {
             inNext->prev = this;
         }
-        else
-        {
-            inParent->m_decorationsAndChildren.last = this;
-        }
 
         this->prev = inPrev;
         this->next = inNext;
         this->parent = inParent;
+
+        inParent->m_firstDecorationOrChild->prev = last;
+
+        if (_isControlFlowInst(this))
+        {
+            invalidateCFGAnalyses(this);
+        }
         
 #if _DEBUG
         validateIRInstOperands(this);
@@ -6861,9 +6922,17 @@ namespace Slang
         if(!oldParent)
             return;
 
+        if (_isControlFlowInst(this))
+        {
+            invalidateCFGAnalyses(this);
+        }
+
         auto pp = getPrevInst();
         auto nn = getNextInst();
 
+        // If this is the last, the previous becomes the last
+        IRInst* last = nn ? oldParent->getLastDecorationOrChild() : pp;
+
         if(pp)
         {
             SLANG_ASSERT(pp->getParent() == oldParent);
@@ -6871,7 +6940,7 @@ namespace Slang
         }
         else
         {
-            oldParent->m_decorationsAndChildren.first = nn;
+            oldParent->m_firstDecorationOrChild = nn;
         }
 
         if(nn)
@@ -6879,9 +6948,11 @@ namespace Slang
             SLANG_ASSERT(nn->getParent() == oldParent);
             nn->prev = pp;
         }
-        else
+
+        // Keep the first's `prev` linking to the last
+        if (auto first = oldParent->m_firstDecorationOrChild)
         {
-            oldParent->m_decorationsAndChildren.last = pp;
+            first->prev = last;
         }
 
         prev = nullptr;
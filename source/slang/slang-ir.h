@@ -15,6 +15,7 @@
 #include "../compiler-core/slang-source-loc.h"
 
 #include "slang-type-system-shared.h"
+#include "slang-ir-analysis-cache.h"
 
 namespace Slang {
 
@@ -552,6 +553,14 @@ struct IRInst
     // Source location information for this value, if any
     SourceLoc sourceLoc;
 
+#ifdef SLANG_ENABLE_IR_BREAK_ALLOC
+    // Unique allocation ID for this instruction since start of current process.
+    // Used to aid debugging only.
+    //
+    // Placed here as it fits in the padding after `sourceLoc` on 64 bit targets.
+    uint32_t _debugUID;
+#endif
+
     // Each instruction can have zero or more "decorations"
     // attached to it. A decoration is a specialized kind
     // of instruction that either attaches metadata to,
@@ -609,12 +618,16 @@ struct IRInst
 
     IRInst* getParent() { return parent; }
 
-    // The next and previous instructions with the same parent
+    // The next and previous instructions with the same parent.
+    //
+    // The `prev` link of the first decoration or child of a parent links
+    // to the *last* decoration or child, so that the parent only needs to
+    // store a single pointer. Use `getPrevInst` which handles that case.
     IRInst*         next;
     IRInst*         prev;
 
     IRInst* getNextInst() { return next; }
-    IRInst* getPrevInst() { return prev; }
+    IRInst* getPrevInst() { return (parent && parent->m_firstDecorationOrChild == this) ? nullptr : prev; }
 
     // An instruction can have zero or more children, although
     // only certain instruction opcodes are allowed to have
@@ -641,37 +654,33 @@ struct IRInst
             getLastChild());
     }
 
-        /// A doubly-linked list containing any decorations and then any children of this instruction.
+        /// The first of a doubly-linked list containing any decorations and then any children of this instruction.
         ///
         /// We store both the decorations and children of an instruction
         /// in the same list, to conserve space in the instruction itself
         /// (rather than storing distinct lists for decorations and children).
         ///
+        /// To save more space the last entry isn't stored, it is the `prev` of the first entry.
+        ///
         // Note: This field is *not* being declared `private` because doing so could
         // mess with our required memory layout, where `typeUse` below is assumed
         // to be the last field in `IRInst` and to come right before any additional
         // `IRUse` values that represent operands.
         //
-    IRInstListBase m_decorationsAndChildren;
+    IRInst* m_firstDecorationOrChild = nullptr;
 
-    IRInst* getFirstDecorationOrChild() { return m_decorationsAndChildren.first; }
-    IRInst* getLastDecorationOrChild()  { return m_decorationsAndChildren.last;  }
-    IRInstListBase getDecorationsAndChildren() { return m_decorationsAndChildren; }
+    IRInst* getFirstDecorationOrChild() { return m_firstDecorationOrChild; }
+    IRInst* getLastDecorationOrChild()  { return m_firstDecorationOrChild ? m_firstDecorationOrChild->prev : nullptr; }
+    IRInstListBase getDecorationsAndChildren() { return IRInstListBase(getFirstDecorationOrChild(), getLastDecorationOrChild()); }
     IRModifiableInstList<IRInst> getModifiableDecorationsAndChildren()
     {
         return IRModifiableInstList<IRInst>(
             this,
-            m_decorationsAndChildren.first,
-            m_decorationsAndChildren.last);
+            getFirstDecorationOrChild(),
+            getLastDecorationOrChild());
     }
     void removeAndDeallocateAllDecorationsAndChildren();
 
-#ifdef SLANG_ENABLE_IR_BREAK_ALLOC
-    // Unique allocation ID for this instruction since start of current process.
-    // Used to aid debugging only.
-    uint32_t _debugUID;
-#endif
-
     // The type of the result value of this instruction,
     // or `null` to indicate that the instruction has
     // no value.
@@ -882,7 +891,7 @@ IRFilteredInstList<T>::IRFilteredInstList(IRInst* fst, IRInst* lst)
     while (first != lastIter && !as<T>(first))
         first = first->next;
     while (last && last != first && !as<T>(last))
-        last = last->prev;
+        last = last->getPrevInst();
 }
 
 template<typename T>
@@ -1994,6 +2003,19 @@ private:
     ConstantMap m_constantMap;
 };
 
+    /// Statistics about the memory used by an IRModule
+struct IRModuleMemoryStats
+{
+    Count instCount = 0;            ///< The number of instructions (including decorations and the module inst)
+    Count operandCount = 0;         ///< The total number of operands of the instructions
+    size_t instBytes = 0;           ///< Bytes used by the instructions and their operands. Doesn't include extra payloads (such as string literal contents)
+    size_t arenaUsedBytes = 0;      ///< Bytes allocated from the module's arena. Includes instructions that have been removed and extra payloads
+    size_t arenaTotalBytes = 0;     ///< Bytes held by the arena, including space not yet allocated from
+
+        /// The average amount of bytes used by an instruction
+    double calcBytesPerInst() const { return instCount ? double(instBytes) / double(instCount) : 0.0; }
+};
+
 struct IRModule : RefObject
 {
 public:
@@ -2010,8 +2032,14 @@ public:
 
     IRDeduplicationContext* getDeduplicationContext() const { return &m_deduplicationContext; }
 
+        /// Get the cached control flow analyses of the functions in the module
+    IRAnalysisCache& getAnalysisCache() { return m_analysisCache; }
+
     IRInstListBase getGlobalInsts() const { return getModuleInst()->getChildren(); }
 
+        /// Calculate statistics about the memory used by the module. Requires traversing all the instructions.
+    void calcMemoryStats(IRModuleMemoryStats& outStats);
+
         /// Create an empty instruction with the `op` opcode and space for
         /// a number of operands given by `operandCount`.
         ///
@@ -2074,6 +2102,9 @@ private:
 
         /// Shared contexts for constructing and deduplicating the IR.
     mutable IRDeduplicationContext m_deduplicationContext;
+
+        /// Control flow analyses of functions, kept until the function's control flow changes.
+    IRAnalysisCache m_analysisCache;
 };
 
 struct IRSpecializationDictionaryItem : public IRInst
@@ -47,6 +47,10 @@ SlangResult LanguageServer::init(const InitializeParams& args)
     SLANG_RETURN_ON_FAIL(m_connection->initWithStdStreams(JSONRPCConnection::CallStyle::Object));
     m_workspaceFolders = args.workspaceFolders;
     m_workspace = new Workspace();
+    m_tracedWorkspaceVersionCount = 0;
+    setTraceOptions(args.trace);
+    m_cancellationToken = new LanguageServerCancellationToken(this);
+    m_workspace->cancellationToken = m_cancellationToken;
     List<URI> rootUris;
     for (auto& wd : m_workspaceFolders)
     {
@@ -434,7 +438,7 @@ SlangResult LanguageServer::hover(
     Index line, col;
     doc->zeroBasedUTF16LocToOneBasedUTF8Loc(args.position.line, args.position.character, line, col);
 
-    auto version = m_workspace->getCurrentVersion();
+    auto version = getCurrentWorkspaceVersion();
     Module* parsedModule = version->getOrLoadModule(canonicalPath);
     if (!parsedModule)
     {
@@ -613,7 +617,7 @@ SlangResult LanguageServer::gotoDefinition(
     Index line, col;
     doc->zeroBasedUTF16LocToOneBasedUTF8Loc(args.position.line, args.position.character, line, col);
 
-    auto version = m_workspace->getCurrentVersion();
+    auto version = getCurrentWorkspaceVersion();
     Module* parsedModule = version->getOrLoadModule(canonicalPath);
     if (!parsedModule)
     {
@@ -901,7 +905,7 @@ SlangResult LanguageServer::semanticTokens(
         return SLANG_OK;
     }
 
-    auto version = m_workspace->getCurrentVersion();
+    auto version = getCurrentWorkspaceVersion();
     Module* parsedModule = version->getOrLoadModule(canonicalPath);
     if (!parsedModule)
     {
@@ -945,7 +949,7 @@ String LanguageServer::getExprDeclSignature(Expr* expr, String* outDocumentation
     if (!funcType)
         return String();
 
-    auto version = m_workspace->getCurrentVersion();
+    auto version = getCurrentWorkspaceVersion();
 
     SignatureInformation sigInfo;
 
@@ -1006,7 +1010,7 @@ String LanguageServer::getExprDeclSignature(Expr* expr, String* outDocumentation
 
 String LanguageServer::getDeclRefSignature(DeclRef<Decl> declRef, String* outDocumentation, List<Slang::Range<Index>>* outParamRanges)
 {
-    auto version = m_workspace->getCurrentVersion();
+    auto version = getCurrentWorkspaceVersion();
     ASTPrinter printer(
         version->linkage->getASTBuilder(),
         ASTPrinter::OptionFlag::ParamNames | ASTPrinter::OptionFlag::NoInternalKeywords |
@@ -1041,7 +1045,7 @@ SlangResult LanguageServer::signatureHelp(
     Index line, col;
     doc->zeroBasedUTF16LocToOneBasedUTF8Loc(args.position.line, args.position.character, line, col);
 
-    auto version = m_workspace->getCurrentVersion();
+    auto version = getCurrentWorkspaceVersion();
     Module* parsedModule = version->getOrLoadModule(canonicalPath);
     if (!parsedModule)
     {
@@ -1251,7 +1255,7 @@ SlangResult LanguageServer::documentSymbol(
         m_connection->sendResult(NullResponse::get(), responseId);
         return SLANG_OK;
     }
-    auto version = m_workspace->getCurrentVersion();
+    auto version = getCurrentWorkspaceVersion();
     Module* parsedModule = version->getOrLoadModule(canonicalPath);
     if (!parsedModule)
     {
@@ -1272,7 +1276,7 @@ SlangResult LanguageServer::inlayHint(const LanguageServerProtocol::InlayHintPar
         m_connection->sendResult(NullResponse::get(), responseId);
         return SLANG_OK;
     }
-    auto version = m_workspace->getCurrentVersion();
+    auto version = getCurrentWorkspaceVersion();
     Module* parsedModule = version->getOrLoadModule(canonicalPath);
     if (!parsedModule)
     {
@@ -1390,7 +1394,7 @@ void LanguageServer::publishDiagnostics()
     }
     m_lastDiagnosticUpdateTime = std::chrono::system_clock::now();
 
-    auto version = m_workspace->getCurrentVersion();
+    auto version = getCurrentWorkspaceVersion();
     // Send updates to clear diagnostics for files that no longer have any messages.
     List<String> filesToRemove;
     for (auto& file : m_lastPublishedDiagnostics)
@@ -1546,16 +1550,21 @@ void LanguageServer::updateTraceOptions(const JSONValue& value)
         String str;
         if (SLANG_SUCCEEDED(converter.convert(value, &str)))
         {
-            if (str == "messages")
-                m_traceOptions = TraceOptions::Messages;
-            else if (str == "verbose")
-                m_traceOptions = TraceOptions::Verbose;
-            else
-                m_traceOptions = TraceOptions::Off;
+            setTraceOptions(str);
         }
     }
 }
 
+void LanguageServer::setTraceOptions(const String& value)
+{
+    if (value == "messages")
+        m_traceOptions = TraceOptions::Messages;
+    else if (value == "verbose")
+        m_traceOptions = TraceOptions::Verbose;
+    else
+        m_traceOptions = TraceOptions::Off;
+}
+
 void LanguageServer::sendConfigRequest()
 {
     ConfigurationParams args;
@@ -1609,6 +1618,18 @@ void LanguageServer::logMessage(int type, String message)
     m_connection->sendCall(LanguageServerProtocol::LogMessageParams::methodName, &args);
 }
 
+WorkspaceVersion* LanguageServer::getCurrentWorkspaceVersion()
+{
+    auto version = m_workspace->getCurrentVersion();
+    if (m_workspace->createdVersionCount != m_tracedWorkspaceVersionCount)
+    {
+        m_tracedWorkspaceVersionCount = m_workspace->createdVersionCount;
+        if (m_traceOptions == TraceOptions::Verbose)
+            logMessage(3, m_workspace->lastVersionDescription);
+    }
+    return version;
+}
+
 SlangResult LanguageServer::tryGetMacroHoverInfo(
     WorkspaceVersion* version, DocumentVersion* doc, Index line, Index col, JSONValue responseId)
 {
@@ -1815,10 +1836,148 @@ SlangResult LanguageServer::queueJSONCall(JSONRPCCall call)
         SLANG_RETURN_ON_FAIL(m_connection->toNativeArgsOrSendError(call.params, &args, call.id));
         cmd.cancelArgs = args;
     }
-    commands.add(_Move(cmd));
+    if (m_isRunningCommand)
+        m_commandsQueuedWhileRunning.add(_Move(cmd));
+    else
+        commands.add(_Move(cmd));
     return SLANG_OK;
 }
 
+// Reading messages is comparatively slow, so the connection is only polled this often during checking
+static const std::chrono::milliseconds kCancellationPollInterval(20);
+
+bool LanguageServerCancellationToken::isCancelled()
+{
+    if (CancellationToken::isCancelled())
+        return true;
+    if (!m_isPolling)
+        return false;
+
+    const auto now = std::chrono::steady_clock::now();
+    if (now - m_lastPollTime < kCancellationPollInterval)
+        return false;
+    m_lastPollTime = now;
+
+    if (m_server->pollMessages())
+        cancel();
+    return CancellationToken::isCancelled();
+}
+
+void LanguageServerCancellationToken::reset()
+{
+    CancellationToken::reset();
+    m_isPolling = false;
+    m_lastPollTime = std::chrono::steady_clock::now();
+}
+
+// Returns the document a command reads, or nullptr if it doesn't read a document.
+static const String* _getRequestDocumentURI(Command& cmd)
+{
+    if (cmd.hoverArgs.isValid())
+        return &cmd.hoverArgs.get().textDocument.uri;
+    if (cmd.definitionArgs.isValid())
+        return &cmd.definitionArgs.get().textDocument.uri;
+    if (cmd.completionArgs.isValid())
+        return &cmd.completionArgs.get().textDocument.uri;
+    if (cmd.semanticTokenArgs.isValid())
+        return &cmd.semanticTokenArgs.get().textDocument.uri;
+    if (cmd.signatureHelpArgs.isValid())
+        return &cmd.signatureHelpArgs.get().textDocument.uri;
+    if (cmd.documentSymbolArgs.isValid())
+        return &cmd.documentSymbolArgs.get().textDocument.uri;
+    if (cmd.inlayHintArgs.isValid())
+        return &cmd.inlayHintArgs.get().textDocument.uri;
+    if (cmd.formattingArgs.isValid())
+        return &cmd.formattingArgs.get().textDocument.uri;
+    if (cmd.rangeFormattingArgs.isValid())
+        return &cmd.rangeFormattingArgs.get().textDocument.uri;
+    if (cmd.onTypeFormattingArgs.isValid())
+        return &cmd.onTypeFormattingArgs.get().textDocument.uri;
+    return nullptr;
+}
+
+// Returns the document a command modifies, or nullptr if it doesn't modify a document.
+static const String* _getModifiedDocumentURI(Command& cmd)
+{
+    if (cmd.openDocArgs.isValid())
+        return &cmd.openDocArgs.get().textDocument.uri;
+    if (cmd.changeDocArgs.isValid())
+        return &cmd.changeDocArgs.get().textDocument.uri;
+    if (cmd.closeDocArgs.isValid())
+        return &cmd.closeDocArgs.get().textDocument.uri;
+    return nullptr;
+}
+
+bool LanguageServer::isCommandCancelled(Index commandIndex)
+{
+    auto& cmd = commands[commandIndex];
+    if (cmd.id.getKind() != JSONValue::Kind::Integer)
+        return false;
+    const auto id = cmd.id.asInteger();
+    for (auto& other : commands)
+    {
+        if (other.cancelArgs.isValid() && other.cancelArgs.get().id == id)
+            return true;
+    }
+    return false;
+}
+
+bool LanguageServer::isCommandStale(Index commandIndex)
+{
+    // A request on a document is stale if the document has been modified since it was made,
+    // as the client will no longer use the result.
+    auto uri = _getRequestDocumentURI(commands[commandIndex]);
+    if (!uri)
+        return false;
+    for (Index i = commandIndex + 1; i < commands.getCount(); i++)
+    {
+        auto modifiedUri = _getModifiedDocumentURI(commands[i]);
+        if (modifiedUri && *modifiedUri == *uri)
+            return true;
+    }
+    return false;
+}
+
+bool LanguageServer::pollMessages()
+{
+    bool isRunningCommandStale = false;
+    while (!m_hasHeldMessage)
+    {
+        m_connection->tryReadMessage();
+        if (!m_connection->hasMessage())
+            break;
+
+        // Messages that are handled as soon as they are parsed (rather than queued) can change
+        // the state the running command uses, so are held until the command completes.
+        JSONRPCCall call;
+        if (m_connection->getMessageType() != JSONRPCMessageType::Call ||
+            SLANG_FAILED(m_connection->getRPC(&call)) ||
+            call.method == ExitParams::methodName ||
+            call.method == ShutdownParams::methodName ||
+            call.method == InitializeParams::methodName ||
+            call.method == "initialized")
+        {
+            m_hasHeldMessage = true;
+            break;
+        }
+
+        auto& queuedCommands = m_commandsQueuedWhileRunning;
+        const Index commandCount = queuedCommands.getCount();
+        queueJSONCall(call);
+        if (queuedCommands.getCount() == commandCount)
+            continue;
+
+        // Any change to the workspace makes the version the running command uses stale
+        auto& cmd = queuedCommands.getLast();
+        if (_getModifiedDocumentURI(cmd) ||
+            (cmd.cancelArgs.isValid() && cmd.cancelArgs.get().id == m_runningRequestId))
+        {
+            isRunningCommandStale = true;
+        }
+    }
+    return isRunningCommandStale;
+}
+
 SlangResult LanguageServer::runCommand(Command& call)
 {
     // Do different things
@@ -1895,28 +2054,42 @@ SlangResult LanguageServer::runCommand(Command& call)
 
 void LanguageServer::processCommands()
 {
-    HashSet<int64_t> canceledIDs;
-    for (auto& cmd : commands)
+    const int kErrorRequestCanceled = -32800;
+    const int kErrorContentModified = -32801;
+    // Note: Commands queued while a command runs are added to the end of `commands`, so are
+    // processed in this loop.
+    for (Index i = 0; i < commands.getCount(); i++)
     {
-        if (cmd.method == "$/cancelRequest")
+        if (isCommandCancelled(i))
         {
-            auto id = cmd.cancelArgs.get().id;
-            if (id > 0)
-            {
-                canceledIDs.Add(id);
-            }
+            m_connection->sendError((JSONRPC::ErrorCode)kErrorRequestCanceled, commands[i].id);
         }
-    }
-    const int kErrorRequestCanceled = -32800;
-    for (auto& cmd : commands)
-    {
-        if (cmd.id.getKind() == JSONValue::Kind::Integer && canceledIDs.Contains(cmd.id.asInteger()))
+        else if (isCommandStale(i))
         {
-            m_connection->sendError((JSONRPC::ErrorCode)kErrorRequestCanceled, cmd.id);
+            m_connection->sendError((JSONRPC::ErrorCode)kErrorContentModified, commands[i].id);
         }
         else
         {
+            auto& cmd = commands[i];
+            m_isRunningCommand = true;
+            m_runningRequestId = cmd.id.getKind() == JSONValue::Kind::Integer ? cmd.id.asInteger() : -1;
+            m_cancellationToken->reset();
+            m_cancellationToken->m_isPolling = m_initialized;
+
             runCommand(cmd);
+
+            m_cancellationToken->m_isPolling = false;
+            if (m_cancellationToken->isCancelled() && m_traceOptions != TraceOptions::Off)
+            {
+                logMessage(3, "Checking for '" + cmd.method + "' was cancelled by a newer request");
+            }
+            m_cancellationToken->reset();
+            m_runningRequestId = -1;
+            m_isRunningCommand = false;
+
+            for (auto& queuedCmd : m_commandsQueuedWhileRunning)
+                commands.add(_Move(queuedCmd));
+            m_commandsQueuedWhileRunning.clear();
         }
     }
 }
@@ -1964,7 +2137,10 @@ SlangResult LanguageServer::execute()
         auto start = platform::PerformanceCounter::now();
         while (true)
         {
-            m_connection->tryReadMessage();
+            // A message may have been read (but not handled) while the last command ran
+            if (!m_hasHeldMessage)
+                m_connection->tryReadMessage();
+            m_hasHeldMessage = false;
             if (!m_connection->hasMessage())
                 break;
             parseNextMessage();
@@ -1985,7 +2161,8 @@ SlangResult LanguageServer::execute()
             logMessage(3, msgBuilder.ProduceString());
         }
 
-        m_connection->getUnderlyingConnection()->waitForResult(1000);
+        if (!m_hasHeldMessage)
+            m_connection->getUnderlyingConnection()->waitForResult(1000);
     }
 
     return SLANG_OK;
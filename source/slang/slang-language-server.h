@@ -76,10 +76,13 @@ struct Command
     Optional<LanguageServerProtocol::CancelParams> cancelArgs;
 };
 
+class LanguageServerCancellationToken;
+
 class LanguageServer
 {
 private:
     static const int kConfigResponseId = 0x1213;
+    friend class LanguageServerCancellationToken;
     
 public:
     enum class TraceOptions
@@ -146,10 +149,14 @@ private:
     void updateFormattingOptions(const JSONValue& clangFormatLoc, const JSONValue& clangFormatStyle, const JSONValue& clangFormatFallbackStyle, const JSONValue& allowLineBreakOnType, const JSONValue& allowLineBreakInRange);
     void updateInlayHintOptions(const JSONValue& deducedTypes, const JSONValue& parameterNames);
     void updateTraceOptions(const JSONValue& value);
+    void setTraceOptions(const String& value);
 
     void sendConfigRequest();
     void registerCapability(const char* methodName);
     void logMessage(int type, String message);
+    // Get the current version of the workspace, tracing how it was created if it is new
+    WorkspaceVersion* getCurrentWorkspaceVersion();
+    Index m_tracedWorkspaceVersionCount = 0;
 
     SlangResult tryGetMacroHoverInfo(
         WorkspaceVersion* version,
@@ -169,11 +176,42 @@ private:
         Index line,
         JSONValue responseId);
     List<Command> commands;
+    // Set on the linkages of the workspace, such that checking for a command stops if the command becomes stale
+    RefPtr<LanguageServerCancellationToken> m_cancellationToken;
+    // True while a command runs
+    bool m_isRunningCommand = false;
+    // The id of the request being run, or -1 if there isn't one
+    int64_t m_runningRequestId = -1;
+    // Commands queued while a command runs. They are added to `commands` once it completes.
+    List<Command> m_commandsQueuedWhileRunning;
+    // True if the current message of the connection was read while a command was running, and hasn't been handled
+    bool m_hasHeldMessage = false;
     SlangResult queueJSONCall(JSONRPCCall call);
     SlangResult runCommand(Command& cmd);
+    bool isCommandCancelled(Index commandIndex);
+    bool isCommandStale(Index commandIndex);
+    bool pollMessages();
     void processCommands();
 };
 
+/* Checked by the front end while a command runs. It polls the connection for new messages, and
+requests cancellation if a message arrives that makes the result of the running command stale. */
+class LanguageServerCancellationToken : public CancellationToken
+{
+public:
+    virtual bool isCancelled() override;
+    virtual void reset() override;
+
+    LanguageServerCancellationToken(LanguageServer* server) : m_server(server) {}
+
+    // Only polls for messages when set
+    bool m_isPolling = false;
+
+protected:
+    LanguageServer* m_server;
+    std::chrono::time_point<std::chrono::steady_clock> m_lastPollTime;
+};
+
 inline bool _isIdentifierChar(char ch)
 {
     return ch >= '0' && ch <= '9' || ch >= 'a' && ch <= 'z' || ch >= 'A' && ch <= 'Z' || ch == '_';
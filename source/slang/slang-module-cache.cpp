@@ -0,0 +1,378 @@
+// slang-module-cache.cpp
+#include "slang-module-cache.h"
+
+#include "../core/slang-blob.h"
+#include "../core/slang-io.h"
+#include "../core/slang-shared-library.h"
+#include "../core/slang-stream.h"
+
+#include "slang-serialize-container.h"
+
+namespace Slang
+{
+
+// Bump if the layout of a cache entry or the contents of the key changes
+static const char kModuleCacheVersion[] = "module-cache-4";
+
+namespace { // anonymous
+
+struct DependencyWriter
+{
+    void writeUInt32(uint32_t value) { m_data.addRange((const uint8_t*)&value, sizeof(value)); }
+    void writeString(const String& str)
+    {
+        writeUInt32(uint32_t(str.getLength()));
+        m_data.addRange((const uint8_t*)str.getBuffer(), str.getLength());
+    }
+    void writeDigest(const ContentHash::Digest& digest) { m_data.addRange((const uint8_t*)digest.data, sizeof(digest.data)); }
+
+    List<uint8_t> m_data;
+};
+
+struct DependencyReader
+{
+    SlangResult readUInt32(uint32_t& outValue) { return _read(&outValue, sizeof(outValue)); }
+    SlangResult readString(String& outString)
+    {
+        uint32_t length;
+        SLANG_RETURN_ON_FAIL(readUInt32(length));
+        if (size_t(m_end - m_cur) < length)
+        {
+            return SLANG_FAIL;
+        }
+        outString = UnownedStringSlice((const char*)m_cur, length);
+        m_cur += length;
+        return SLANG_OK;
+    }
+    SlangResult readDigest(ContentHash::Digest& outDigest) { return _read(outDigest.data, sizeof(outDigest.data)); }
+
+    DependencyReader(const void* data, size_t size):
+        m_cur((const uint8_t*)data),
+        m_end((const uint8_t*)data + size)
+    {
+    }
+
+protected:
+    SlangResult _read(void* dst, size_t size)
+    {
+        if (size_t(m_end - m_cur) < size)
+        {
+            return SLANG_FAIL;
+        }
+        ::memcpy(dst, m_cur, size);
+        m_cur += size;
+        return SLANG_OK;
+    }
+
+    const uint8_t* m_cur;
+    const uint8_t* m_end;
+};
+
+} // anonymous
+
+static void _appendString(DigestBuilder<SHA1>& builder, const String& str)
+{
+    // Append the length so adjacent strings can't alias
+    builder.append(str.getLength());
+    builder.append(str);
+}
+
+static ContentHash::Digest _calcContentDigest(ISlangBlob* blob)
+{
+    return ContentHash::compute(blob->getBufferPointer(), SlangInt(blob->getBufferSize()));
+}
+
+// Calculate a digest of the binary holding the compiler (the slang shared library, or the
+// executable it is linked into). The digest is zero if the binary can't be read.
+static ContentHash::Digest _calcCompilerBinaryDigest()
+{
+    ContentHash::Digest digest;
+    const String fileName = SharedLibraryUtils::getSharedLibraryFileName((void*)&_calcCompilerBinaryDigest);
+    ScopedAllocation contents;
+    if (fileName.getLength() && SLANG_SUCCEEDED(File::readAllBytes(fileName, contents)))
+    {
+        digest = ContentHash::compute(contents.getData(), SlangInt(contents.getSizeInBytes()));
+    }
+    return digest;
+}
+
+// The binary can't change while it is loaded, so it is only read (on first use of a module cache) once
+static const ContentHash::Digest& _getCompilerBinaryDigest()
+{
+    static const ContentHash::Digest digest = _calcCompilerBinaryDigest();
+    return digest;
+}
+
+/* static */PersistentCache::Key ModuleCacheUtil::calcKey(Linkage* linkage, Name* name, const PathInfo& pathInfo, ISlangBlob* sourceBlob, DiagnosticSink* sink)
+{
+    DigestBuilder<SHA1> builder;
+
+    _appendString(builder, String(kModuleCacheVersion));
+    _appendString(builder, String(getBuildTagString()));
+    // The build tag is the same for all development builds, but the way the AST and IR are
+    // serialized can differ between any two builds, so an entry is only used by the same binary
+    builder.append(_getCompilerBinaryDigest());
+
+    // The module itself
+    _appendString(builder, getText(name));
+    _appendString(builder, pathInfo.getMostUniqueIdentity());
+    builder.append(_calcContentDigest(sourceBlob));
+
+    // The options that can change how the module is checked and lowered
+    for (const auto& searchDir : linkage->getSearchDirectories().searchDirectories)
+    {
+        _appendString(builder, searchDir.path);
+    }
+    for (const auto& pair : linkage->preprocessorDefinitions)
+    {
+        _appendString(builder, pair.Key);
+        _appendString(builder, pair.Value);
+    }
+
+    builder.append(linkage->m_flag);
+    builder.append(linkage->getDefaultMatrixLayoutMode());
+    builder.append(linkage->m_obfuscateCode);
+    builder.append(linkage->m_useFalcorCustomSharedKeywordSemantics);
+    builder.append(linkage->debugInfoLevel);
+    builder.append(linkage->optimizationLevel);
+
+    // How diagnostics are formatted, and which are warnings or errors
+    builder.append(sink->getFlags());
+    for (const auto& pair : sink->getSeverityOverrides())
+    {
+        builder.append(pair.Key);
+        builder.append(pair.Value);
+    }
+
+    return builder.finalize();
+}
+
+/* static */SlangResult ModuleCacheUtil::writeModule(Linkage* linkage, const PersistentCache::Key& key, const PathInfo& pathInfo, Module* module, const String& diagnostics)
+{
+    PersistentCache* cache = linkage->getModuleCache();
+    SLANG_ASSERT(cache);
+
+    const String moduleIdentity = pathInfo.getMostUniqueIdentity();
+
+    // Record the files the module depends on other than its own source (which is part of the key)
+    List<SourceFile*> dependencies;
+    for (SourceFile* sourceFile : module->getFileDependencyList())
+    {
+        const PathInfo& dependencyPathInfo = sourceFile->getPathInfo();
+        if (dependencyPathInfo.getMostUniqueIdentity() == moduleIdentity)
+        {
+            continue;
+        }
+
+        // We can only check a dependency is unchanged if it can be loaded from the file system
+        if (!dependencyPathInfo.hasUniqueIdentity() ||
+            !dependencyPathInfo.hasFileFoundPath() ||
+            !sourceFile->getContentBlob())
+        {
+            return SLANG_E_NOT_AVAILABLE;
+        }
+        dependencies.add(sourceFile);
+    }
+
+    DependencyWriter dependencyWriter;
+    dependencyWriter.writeUInt32(uint32_t(dependencies.getCount()));
+    for (SourceFile* sourceFile : dependencies)
+    {
+        const PathInfo& dependencyPathInfo = sourceFile->getPathInfo();
+        dependencyWriter.writeDigest(sourceFile->getContentDigest());
+        dependencyWriter.writeString(dependencyPathInfo.foundPath);
+        dependencyWriter.writeString(dependencyPathInfo.uniqueIdentity);
+    }
+
+    RiffContainer container;
+    {
+        RiffContainer::ScopeChunk scopeEntry(&container, RiffContainer::Chunk::Kind::List, kModuleCacheFourCc);
+
+        {
+            RiffContainer::ScopeChunk scopeDependencies(&container, RiffContainer::Chunk::Kind::Data, kDependencyFourCc);
+            container.write(dependencyWriter.m_data.getBuffer(), dependencyWriter.m_data.getCount());
+        }
+        if (diagnostics.getLength())
+        {
+            RiffContainer::ScopeChunk scopeDiagnostics(&container, RiffContainer::Chunk::Kind::Data, kDiagnosticsFourCc);
+            container.write(diagnostics.getBuffer(), diagnostics.getLength());
+        }
+
+        SerialContainerUtil::WriteOptions options;
+        // No compression so the IR can be read in place from the cached blob
+        options.compressionType = SerialCompressionType::None;
+        options.optionFlags |= SerialOptionFlag::SourceLocation;
+        options.sourceManager = linkage->getSourceManager();
+
+        SerialContainerData data;
+        SLANG_RETURN_ON_FAIL(SerialContainerUtil::addModuleToData(module, options, data));
+        SLANG_RETURN_ON_FAIL(SerialContainerUtil::write(data, options, &container));
+    }
+
+    OwnedMemoryStream stream(FileAccess::Write);
+    SLANG_RETURN_ON_FAIL(RiffUtil::write(container.getRoot(), true, &stream));
+
+    List<uint8_t> contents;
+    stream.swapContents(contents);
+
+    auto blob = ListBlob::moveCreate(contents);
+    return cache->writeEntry(key, blob);
+}
+
+static SlangResult _loadDependencies(Linkage* linkage, RiffContainer::Data* dependencyData, List<SourceFile*>& outSourceFiles)
+{
+    DependencyReader reader(dependencyData->getPayload(), dependencyData->getSize());
+
+    uint32_t count;
+    SLANG_RETURN_ON_FAIL(reader.readUInt32(count));
+
+    SourceManager* sourceManager = linkage->getSourceManager();
+    IncludeSystem includeSystem(nullptr, linkage->getFileSystemExt(), sourceManager);
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        ContentHash::Digest digest;
+        String foundPath;
+        String uniqueIdentity;
+
+        SLANG_RETURN_ON_FAIL(reader.readDigest(digest));
+        SLANG_RETURN_ON_FAIL(reader.readString(foundPath));
+        SLANG_RETURN_ON_FAIL(reader.readString(uniqueIdentity));
+
+        // Loading through the include system makes the file known to the source manager
+        // (or uses the contents already loaded in this session)
+        const PathInfo pathInfo = PathInfo::makeNormal(foundPath, uniqueIdentity);
+        ComPtr<ISlangBlob> blob;
+        if (SLANG_FAILED(includeSystem.loadFile(pathInfo, blob)))
+        {
+            return SLANG_E_NOT_FOUND;
+        }
+
+        // The digest is held by the source file, so each file is only hashed once per session
+        SourceFile* sourceFile = sourceManager->findSourceFileRecursively(uniqueIdentity);
+        if (!sourceFile || sourceFile->getContentDigest() != digest)
+        {
+            return SLANG_E_NOT_FOUND;
+        }
+        outSourceFiles.add(sourceFile);
+    }
+    return SLANG_OK;
+}
+
+/* static */SlangResult ModuleCacheUtil::readModule(Linkage* linkage, const PersistentCache::Key& key, const PathInfo& pathInfo, ISlangBlob* sourceBlob, DiagnosticSink* sink, RefPtr<Module>& outModule)
+{
+    PersistentCache* cache = linkage->getModuleCache();
+    SLANG_ASSERT(cache);
+
+    ComPtr<ISlangBlob> blob;
+    SLANG_RETURN_ON_FAIL(cache->readEntry(key, blob.writeRef()));
+
+    // A damaged entry is treated as a miss, so the module is compiled and the entry rewritten
+    RiffContainer container;
+    if (SLANG_FAILED(RiffUtil::readInPlace(blob->getBufferPointer(), blob->getBufferSize(), container)))
+    {
+        return SLANG_E_NOT_FOUND;
+    }
+
+    RiffContainer::ListChunk* entryChunk = container.getRoot()->findListRec(kModuleCacheFourCc);
+    RiffContainer::Data* dependencyData = entryChunk ? entryChunk->findContainedData(kDependencyFourCc) : nullptr;
+    if (!dependencyData)
+    {
+        return SLANG_E_NOT_FOUND;
+    }
+
+    // The entry can only be used if none of the files the module depends on have changed
+    List<SourceFile*> dependencies;
+    {
+        const SlangResult res = _loadDependencies(linkage, dependencyData, dependencies);
+        if (SLANG_FAILED(res))
+        {
+            return SLANG_E_NOT_FOUND;
+        }
+    }
+
+    SerialContainerUtil::ReadOptions options;
+    options.namePool = linkage->getNamePool();
+    options.session = linkage->getSessionImpl();
+    options.sharedASTBuilder = linkage->getASTBuilder()->getSharedASTBuilder();
+    options.sourceManager = linkage->getSourceManager();
+    options.linkage = linkage;
+    options.sink = sink;
+    // The IR is only needed if the module is used for code generation
+    options.readIRLazily = true;
+    options.inPlaceBlob = blob;
+
+    SerialContainerData containerData;
+    SLANG_RETURN_ON_FAIL(SerialContainerUtil::read(&container, options, containerData));
+
+    if (containerData.modules.getCount() != 1)
+    {
+        return SLANG_FAIL;
+    }
+    auto& srcModule = containerData.modules[0];
+
+    ModuleDecl* moduleDecl = as<ModuleDecl>(srcModule.astRootNode);
+    if (!moduleDecl || !(srcModule.irModuleFactory || srcModule.irModule))
+    {
+        return SLANG_FAIL;
+    }
+
+    RefPtr<Module> module(new Module(linkage, srcModule.astBuilder));
+
+    moduleDecl->module = module;
+    module->setModuleDecl(moduleDecl);
+
+    if (srcModule.irModuleFactory)
+    {
+        module->setIRModuleFactory(srcModule.irModuleFactory);
+    }
+    else
+    {
+        module->setIRModule(srcModule.irModule);
+    }
+
+    // Restore the dependencies that checking would have recorded. The imported
+    // modules were loaded when the import symbols were resolved during the read.
+    for (auto importDecl : moduleDecl->getMembersOfType<ImportDecl>())
+    {
+        auto importedModuleDecl = importDecl->importedModuleDecl;
+        if (!importedModuleDecl || !importedModuleDecl->module)
+        {
+            return SLANG_FAIL;
+        }
+        module->addModuleDependency(importedModuleDecl->module);
+    }
+
+    // The module's own source file is a dependency too (as it would be if the module was compiled)
+    {
+        SourceManager* sourceManager = linkage->getSourceManager();
+        SourceFile* sourceFile = sourceManager->findSourceFileRecursively(pathInfo.uniqueIdentity);
+        if (!sourceFile)
+        {
+            sourceFile = sourceManager->createSourceFileWithBlob(pathInfo, sourceBlob);
+            sourceManager->addSourceFile(pathInfo.uniqueIdentity, sourceFile);
+        }
+        module->addFileDependency(sourceFile);
+    }
+    for (SourceFile* sourceFile : dependencies)
+    {
+        module->addFileDependency(sourceFile);
+    }
+
+    module->_collectShaderParams();
+
+    // Output the diagnostics (warnings) that compiling the module produced, as they would be if it was compiled.
+    // The diagnostics of imported modules were output when they were loaded.
+    if (RiffContainer::Data* diagnosticsData = entryChunk->findContainedData(kDiagnosticsFourCc))
+    {
+        sink->diagnoseRaw(Severity::Warning, UnownedStringSlice((const char*)diagnosticsData->getPayload(), diagnosticsData->getSize()));
+    }
+
+    // Entry points aren't held in the entry, so are found as they are when a module is checked
+    module->_discoverEntryPoints(sink);
+
+    outModule = module;
+    return SLANG_OK;
+}
+
+} // namespace Slang
@@ -0,0 +1,48 @@
+// slang-module-cache.h
+#ifndef SLANG_MODULE_CACHE_H
+#define SLANG_MODULE_CACHE_H
+
+#include "../core/slang-persistent-cache.h"
+#include "../core/slang-riff.h"
+
+#include "slang-compiler.h"
+
+namespace Slang
+{
+
+/* Stores checked modules (their AST and IR) in a PersistentCache, so that a module that is
+`import`ed in a later session with the same source, dependencies and options can be read back
+instead of being parsed, checked and lowered again.
+
+The key of an entry covers the compiler version and binary, the module name and path, the module's source
+and the linkage options that influence checking and lowering. The files the module depends on
+(`#include`d files, and the files of `import`ed modules) are only known after the module has been
+checked, so they are held in the entry along with a digest of their contents, and an entry is
+only used if all of the files are unchanged. */
+struct ModuleCacheUtil
+{
+        /// The list that holds a cache entry
+    static const FourCC kModuleCacheFourCc = SLANG_FOUR_CC('S', 'm', 'c', 'e');
+        /// Data chunk holding the files the module depends on
+    static const FourCC kDependencyFourCc = SLANG_FOUR_CC('S', 'm', 'c', 'd');
+        /// Data chunk holding the (formatted) diagnostics produced when the module was compiled
+    static const FourCC kDiagnosticsFourCc = SLANG_FOUR_CC('S', 'm', 'c', 'g');
+
+        /// Calculate the key for a module called name with the source held in sourceBlob, loaded from pathInfo.
+        /// The key includes how sink formats diagnostics, as the module's diagnostics are held formatted in the entry.
+    static PersistentCache::Key calcKey(Linkage* linkage, Name* name, const PathInfo& pathInfo, ISlangBlob* sourceBlob, DiagnosticSink* sink);
+
+        /// Write the checked module into the cache, along with the diagnostics (such as warnings) produced when it was compiled.
+        /// pathInfo must have a unique identity.
+        /// Returns SLANG_E_NOT_AVAILABLE if the module cannot be cached (for example because it depends on a file that is not on the file system)
+    static SlangResult writeModule(Linkage* linkage, const PersistentCache::Key& key, const PathInfo& pathInfo, Module* module, const String& diagnostics);
+
+        /// Read a module from the cache. pathInfo and sourceBlob are the module's source, as passed to calcKey.
+        /// The diagnostics produced when the module was compiled are output to sink.
+        /// Returns SLANG_E_NOT_FOUND if there is no entry, or a file the module depends on has changed.
+    static SlangResult readModule(Linkage* linkage, const PersistentCache::Key& key, const PathInfo& pathInfo, ISlangBlob* sourceBlob, DiagnosticSink* sink, RefPtr<Module>& outModule);
+};
+
+} // namespace Slang
+
+#endif
@@ -3,6 +3,7 @@
 #include <assert.h>
 
 #include "../core/slang-blob.h"
+#include "../core/slang-io.h"
 #include "../core/slang-riff.h"
 
 #include "../core/slang-type-text-util.h"
@@ -44,11 +45,9 @@ SlangResult loadModuleLibrary(const Byte* inBytes, size_t bytesCount, EndToEndCo
     auto library = new ModuleLibrary;
     ComPtr<IModuleLibrary> scopeLibrary(library);
 
-    // Load up the module
-    MemoryStreamBase memoryStream(FileAccess::Read, inBytes, bytesCount);
-
+    // Load up the module. The IR is read before returning, so the container can reference the bytes in place
     RiffContainer riffContainer;
-    SLANG_RETURN_ON_FAIL(RiffUtil::read(&memoryStream, riffContainer));
+    SLANG_RETURN_ON_FAIL(RiffUtil::readInPlace(inBytes, bytesCount, riffContainer));
 
     auto linkage = req->getLinkage();
 
@@ -101,9 +100,24 @@ SlangResult loadModuleLibrary(ArtifactKeep keep, IArtifact* artifact, EndToEndCo
         return SLANG_OK;
     }
 
-    // Load the blob
     ComPtr<ISlangBlob> blob;
-    SLANG_RETURN_ON_FAIL(artifact->loadBlob(getIntermediateKeep(keep), blob.writeRef()));
+
+    // If the library is a file that hasn't been loaded, map it instead of reading it. Only the parts that are 
+    // touched are paged in, and uncompressed IR arrays are used without copying.
+    if (!findRepresentation<ISlangBlob>(artifact))
+    {
+        auto fileRep = findRepresentation<IOSFileArtifactRepresentation>(artifact);
+        if (fileRep && fileRep->getKind() != IOSFileArtifactRepresentation::Kind::NameOnly)
+        {
+            File::mapReadOnly(fileRep->getPath(), blob);
+        }
+    }
+
+    // Load the blob
+    if (!blob)
+    {
+        SLANG_RETURN_ON_FAIL(artifact->loadBlob(getIntermediateKeep(keep), blob.writeRef()));
+    }
 
     // Load the module
     ComPtr<IModuleLibrary> library;
@@ -149,6 +149,7 @@ struct OptionsParser
         SlangTargetFlags    targetFlags = 0;
         int                 targetID = -1;
         FloatingPointMode   floatingPointMode = FloatingPointMode::Default;
+        Int                 cpuSIMDLaneCount = -1;  ///< -1 if not set
 
         List<CapabilityAtom> capabilityAtoms;
 
@@ -515,6 +516,8 @@ struct OptionsParser
             "\n"
             "  -D<name>[=<value>], -D <name>[=<value>]: Insert a preprocessor macro.\n"
             "  -depfile <path>: Save the source file dependency list in a file.\n"
+            "  -downstream-cache-path <dir>: Cache the products of downstream compilers in\n"
+            "    <dir>, and reuse them when the source, compiler and options are unchanged.\n"
             "  -entry <name>: Specify the name of an entry-point function.\n"
             "    Multiple -entry options may be used in a single invocation.\n"
             "    If no -entry options are given, compiler will use [shader(...)]\n"
@@ -527,6 +530,8 @@ struct OptionsParser
             "      c, cpp, c++, cxx, slang, glsl, hlsl, cu, cuda\n"
             "  -matrix-layout-column-major: Set the default matrix layout to column-major.\n"
             "  -matrix-layout-row-major: Set the default matrix layout to row-major.\n"
+            "  -module-cache-path <dir>: Cache checked imported modules in <dir>, and reuse\n"
+            "    them when their source, dependencies and options are unchanged.\n"
             "  -module-name <name>: Set the module name to use when compiling multiple\n"
             "    .slang source files into a single module.\n"
             "  -o <path>: Specify a path where generated output should be written.\n"
@@ -572,10 +577,20 @@ struct OptionsParser
             "\n"
             "  -capability <capability>[+<capability>...]: Add optional capabilities\n"
             "    to a code generation target. See Capabilities below.\n"
+            "  -codegen-threads <N>: Generate code for up to N entry points concurrently.\n"
+            "    0 uses all hardware threads, default is 1. Only used if Slang is built\n"
+            "    with --enable-concurrent-compile=true.\n"
+            "  -cpu-simd-lanes <N>: For CPU targets run the threads of a compute thread group\n"
+            "    with a single loop that is marked for the downstream compiler to vectorize\n"
+            "    N threads at a time. Vectorization is up to the downstream compiler.\n"
+            "    N is 0 (scalar loops, the default) or a power of 2 up to 64.\n"
             "  -default-image-format-unknown: Set the format of R/W images with unspecified\n"
             "    format to 'unknown'. Otherwise try to guess the format.\n"
             "  -disable-dynamic-dispatch: Disables generating dynamic dispatch code.\n"
+            "  -disable-incremental-simplification: Revisit every function on each iteration of IR\n"
+            "    simplification, rather than only the functions that changed.\n"
             "  -disable-specialization: Disables generics and specialization pass.\n"
+            "  -disable-specialization-cache: Disables reusing specializations across entry points.\n"
             "  -fp-mode <mode>, -floating-point-mode <mode>: Set the floating point mode.\n"
             "    Accepted modes are:\n"
             "      precise : Disable optimization that could change the output of floating-\n"
@@ -593,9 +608,13 @@ struct OptionsParser
             "      If not specified, default behavior is to use C-style `#line` directives\n"
             "      for HLSL and C/C++ output, and traditional GLSL-style `#line` directives\n"
             "      for GLSL output.\n"
+            "  -link-once: Link the IR for all entry points of a program once per target,\n"
+            "    and derive the IR for each entry point from it. Can reduce the time taken\n"
+            "    by programs with many entry points that share most of their code.\n"
             "  -O<N>: Set the optimization level.\n"
             "    N is the amount of optimization, 0..3, default is 1\n"
             "  -obfuscate: Remove all source file information from outputs.\n"
+            "  -validate-spirv: Check generated SPIR-V with the SPIR-V validator.\n"
             "\n"
             "Downstream compiler options:\n"
             "\n"
@@ -635,17 +654,27 @@ struct OptionsParser
             "  -pass-through <name>: Pass the input through mostly unmodified to the \n"
             "      existing compiler <name>. Accepted compilers are:\n"
             "      fxc, glslang, dxc\n"
+            "  -report-perf: Print a summary of the time spent in each compilation phase\n"
+            "      and IR pass after compilation.\n"
             "  -repro-file-system <name>\n"
             "  -serial-ir: Serialize the IR between front-end and back-end.\n"
             "  -skip-codegen: Skip the code generation phase.\n"
+            "  -trace-file <path>: Write a trace of the time spent in each compilation phase\n"
+            "      and IR pass to <path>, in Chrome trace JSON format.\n"
             "  -validate-ir: Validate the IR between the phases.\n"
             "  -verbose-paths: Display more detailed paths in diagnostic output.\n"
             "  -verify-debug-serial-ir: Verify IR in the front-end.\n"
             "\n"
             "Experimental options (use at your own risk):\n"
             "\n"
+            "  -check-threads <N>: Check the bodies of functions in a module on up to N threads.\n"
+            "    0 uses all hardware threads, default is 1. Only used if Slang is built\n"
+            "    with --enable-concurrent-compile=true.\n"
             "  -emit-spirv-directly: Generate SPIR-V output directly (otherwise through \n"
             "      GLSL and using the glslang compiler)\n"
+            "  -optimize-direct-spirv: Run the SPIR-V optimizer on SPIR-V generated directly,\n"
+            "      with the passes for the optimization level, or the spirv-opt style passes\n"
+            "      given with -Xglslang\n"
             "  -file-system <fs>: Set the filesystem hook to use for a compile request.\n"
             "    Accepted file systems:\n"
             "      default, load-file, os\n"
@@ -660,7 +689,7 @@ struct OptionsParser
             "  -compile-stdlib: Compile the StdLib from embedded sources.\n"
             "      Will return a failure if there is already a StdLib available.\n"
             "  -doc: Write documentation for -compile-stdlib\n"
-            "  -ir-compression <type>: Set compression for IR and AST outputs.\n"
+            "  -ir-compression <type>: Set compression for IR and AST outputs. Default is none.\n"
             "      Accepted compression types:\n"
             "      none, lite\n"
             "  -load-stdlib <filename>: Load the StdLib from file.\n"
@@ -991,6 +1020,18 @@ struct OptionsParser
                 {
                     requestImpl->m_dumpReproOnError = true;
                 }
+                else if (argValue == "-report-perf")
+                {
+                    requestImpl->m_reportPerf = true;
+                    compileRequest->setPerfTraceEnabled(true);
+                }
+                else if (argValue == "-trace-file")
+                {
+                    CommandLineArg traceFile;
+                    SLANG_RETURN_ON_FAIL(reader.expectArg(traceFile));
+                    requestImpl->m_perfTraceFilePath = traceFile.value;
+                    compileRequest->setPerfTraceEnabled(true);
+                }
                 else if (argValue == "-extract-repro")
                 {
                     CommandLineArg reproName;
@@ -1005,6 +1046,20 @@ struct OptionsParser
                         }
                     }
                 }
+                else if (argValue == "-module-cache-path")
+                {
+                    CommandLineArg cachePath;
+                    SLANG_RETURN_ON_FAIL(reader.expectArg(cachePath));
+
+                    compileRequest->setModuleCachePath(cachePath.value.getBuffer());
+                }
+                else if (argValue == "-downstream-cache-path")
+                {
+                    CommandLineArg cachePath;
+                    SLANG_RETURN_ON_FAIL(reader.expectArg(cachePath));
+
+                    compileRequest->setDownstreamCachePath(cachePath.value.getBuffer());
+                }
                 else if (argValue == "-module-name")
                 {
                     CommandLineArg moduleName;
@@ -1105,6 +1160,14 @@ struct OptionsParser
                 {
                     requestImpl->disableSpecialization = true;
                 }
+                else if (argValue == "-disable-specialization-cache")
+                {
+                    requestImpl->disableSpecializationCache = true;
+                }
+                else if (argValue == "-disable-incremental-simplification")
+                {
+                    requestImpl->disableIncrementalSimplification = true;
+                }
                 else if (argValue == "-disable-dynamic-dispatch")
                 {
                     requestImpl->disableDynamicDispatch = true;
@@ -1475,6 +1538,20 @@ struct OptionsParser
 
                     setFloatingPointMode(getCurrentTarget(), mode);
                 }
+                else if( argValue == "-cpu-simd-lanes" )
+                {
+                    CommandLineArg countArg;
+                    SLANG_RETURN_ON_FAIL(reader.expectArg(countArg));
+
+                    Int laneCount = 0;
+                    if (SLANG_FAILED(StringUtil::parseInt(countArg.value.getUnownedSlice(), laneCount)) ||
+                        laneCount < 0 || laneCount > 64 || (laneCount & (laneCount - 1)) != 0)
+                    {
+                        sink->diagnose(countArg.loc, Diagnostics::invalidSIMDLaneCount, countArg.value);
+                        return SLANG_FAIL;
+                    }
+                    getCurrentTarget()->cpuSIMDLaneCount = laneCount;
+                }
                 else if( argValue.getLength() >= 2 && argValue[1] == 'O' )
                 {
                     UnownedStringSlice levelSlice = argValue.getUnownedSlice().tail(2);
@@ -1569,6 +1646,32 @@ struct OptionsParser
                 {
                     requestImpl->getLinkage()->m_obfuscateCode = true;
                 }
+                else if (argValue == "-codegen-threads")
+                {
+                    CommandLineArg countArg;
+                    SLANG_RETURN_ON_FAIL(reader.expectArg(countArg));
+
+                    Int threadCount = 0;
+                    if (SLANG_FAILED(StringUtil::parseInt(countArg.value.getUnownedSlice(), threadCount)) || threadCount < 0)
+                    {
+                        sink->diagnose(countArg.loc, Diagnostics::expectingNonNegativeInteger, argValue, countArg.value);
+                        return SLANG_FAIL;
+                    }
+                    compileRequest->setCodeGenThreadCount(int(threadCount));
+                }
+                else if (argValue == "-check-threads")
+                {
+                    CommandLineArg countArg;
+                    SLANG_RETURN_ON_FAIL(reader.expectArg(countArg));
+
+                    Int threadCount = 0;
+                    if (SLANG_FAILED(StringUtil::parseInt(countArg.value.getUnownedSlice(), threadCount)) || threadCount < 0)
+                    {
+                        sink->diagnose(countArg.loc, Diagnostics::expectingNonNegativeInteger, argValue, countArg.value);
+                        return SLANG_FAIL;
+                    }
+                    requestImpl->getLinkage()->m_checkThreadCount = Count(threadCount);
+                }
                 else if (argValue == "-file-system")
                 {
                     CommandLineArg name;
@@ -1663,6 +1766,18 @@ struct OptionsParser
                 {
                     getCurrentTarget()->targetFlags |= SLANG_TARGET_FLAG_GENERATE_SPIRV_DIRECTLY;
                 }
+                else if (argValue == "-link-once")
+                {
+                    getCurrentTarget()->targetFlags |= SLANG_TARGET_FLAG_LINK_ONCE;
+                }
+                else if (argValue == "-optimize-direct-spirv")
+                {
+                    getCurrentTarget()->targetFlags |= SLANG_TARGET_FLAG_OPTIMIZE_DIRECT_SPIRV;
+                }
+                else if (argValue == "-validate-spirv")
+                {
+                    getCurrentTarget()->targetFlags |= SLANG_TARGET_FLAG_VALIDATE_SPIRV;
+                }
                 else if (argValue == "-default-downstream-compiler")
                 {
                     CommandLineArg sourceLanguageArg, compilerArg;
@@ -2059,6 +2174,11 @@ struct OptionsParser
             {
                 setFloatingPointMode(getCurrentTarget(), defaultTarget.floatingPointMode);
             }
+
+            if( defaultTarget.cpuSIMDLaneCount >= 0 )
+            {
+                getCurrentTarget()->cpuSIMDLaneCount = defaultTarget.cpuSIMDLaneCount;
+            }
         }
         else
         {
@@ -2094,7 +2214,8 @@ struct OptionsParser
                 }
             }
 
-            if( defaultTarget.floatingPointMode != FloatingPointMode::Default )
+            if( defaultTarget.floatingPointMode != FloatingPointMode::Default ||
+                defaultTarget.cpuSIMDLaneCount >= 0 )
             {
                 if( rawTargets.getCount() == 0 )
                 {
@@ -2149,6 +2270,11 @@ struct OptionsParser
             {
                 compileRequest->setTargetFloatingPointMode(targetID, SlangFloatingPointMode(rawTarget.floatingPointMode));
             }
+
+            if( rawTarget.cpuSIMDLaneCount >= 0 )
+            {
+                compileRequest->setTargetCPUSIMDLaneCount(targetID, int(rawTarget.cpuSIMDLaneCount));
+            }
         }
 
         if(defaultMatrixLayoutMode != SLANG_MATRIX_LAYOUT_MODE_UNKNOWN)
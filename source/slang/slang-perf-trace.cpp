@@ -0,0 +1,234 @@
+// slang-perf-trace.cpp
+#include "slang-perf-trace.h"
+
+#include "../core/slang-process.h"
+#include "../core/slang-string-escape-util.h"
+
+#include "slang-ir.h"
+
+namespace Slang
+{
+
+PerfTrace::PerfTrace()
+{
+    m_clockFrequency = Process::getClockFrequency();
+    if (m_clockFrequency == 0)
+    {
+        m_clockFrequency = 1;
+    }
+    m_startTick = Process::getClockTick();
+    m_threadId = std::this_thread::get_id();
+}
+
+/* static */Count PerfTrace::calcInstCount(IRModule* module)
+{
+    if (!module)
+    {
+        return 0;
+    }
+
+    IRModuleMemoryStats stats;
+    module->calcMemoryStats(stats);
+    return stats.instCount;
+}
+
+void PerfTrace::_setIRStats(IRModule* module, Count& outInstCount, Count& outArenaBytes)
+{
+    IRModuleMemoryStats stats;
+    module->calcMemoryStats(stats);
+
+    outInstCount = stats.instCount;
+    outArenaBytes = Count(stats.arenaUsedBytes);
+}
+
+Index PerfTrace::beginEvent(const char* category, const UnownedStringSlice& name, IRModule* module)
+{
+    if (std::this_thread::get_id() != m_threadId)
+    {
+        return -1;
+    }
+
+    const Index eventIndex = m_events.getCount();
+
+    Event event;
+    event.name = name;
+    event.category = category;
+    event.depth = m_depth++;
+
+    if (module)
+    {
+        _setIRStats(module, event.instCountBefore, event.arenaBytesBefore);
+    }
+
+    // Take the tick last, so the IR statistics are not part of the timing
+    event.startTick = Process::getClockTick();
+    m_events.add(event);
+
+    return eventIndex;
+}
+
+void PerfTrace::endEvent(Index eventIndex, IRModule* module)
+{
+    if (eventIndex < 0)
+    {
+        return;
+    }
+
+    const uint64_t endTick = Process::getClockTick();
+
+    auto& event = m_events[eventIndex];
+    event.endTick = endTick;
+
+    if (module)
+    {
+        _setIRStats(module, event.instCountAfter, event.arenaBytesAfter);
+    }
+
+    SLANG_ASSERT(m_depth > 0);
+    m_depth--;
+}
+
+void PerfTrace::clear()
+{
+    m_events.clear();
+    m_depth = 0;
+    m_startTick = Process::getClockTick();
+}
+
+static void _appendArg(const char* name, Count value, bool& isFirst, StringBuilder& out)
+{
+    if (value < 0)
+    {
+        return;
+    }
+    if (!isFirst)
+    {
+        out << ", ";
+    }
+    isFirst = false;
+    out << "\"" << name << "\": " << value;
+}
+
+void PerfTrace::writeChromeTrace(StringBuilder& out) const
+{
+    auto handler = StringEscapeUtil::getHandler(StringEscapeUtil::Style::JSON);
+
+    out << "{\n\"displayTimeUnit\": \"ms\",\n\"traceEvents\": [\n";
+
+    const Count eventCount = m_events.getCount();
+    for (Index i = 0; i < eventCount; ++i)
+    {
+        const auto& event = m_events[i];
+
+        // Events that never ended (say because of an exception) are written with the start time
+        const uint64_t endTick = event.endTick ? event.endTick : event.startTick;
+
+        out << "{\"name\": ";
+        StringEscapeUtil::appendQuoted(handler, event.name.getUnownedSlice(), out);
+        out << ", \"cat\": \"" << (event.category ? event.category : "") << "\"";
+        out << ", \"ph\": \"X\", \"pid\": 1, \"tid\": 1";
+        out << ", \"ts\": ";
+        out.append(ticksToMicroseconds(event.startTick - m_startTick), "%.3f");
+        out << ", \"dur\": ";
+        out.append(ticksToMicroseconds(endTick - event.startTick), "%.3f");
+
+        if (event.instCountBefore >= 0 || event.instCountAfter >= 0)
+        {
+            out << ", \"args\": {";
+            bool isFirst = true;
+            _appendArg("instCountBefore", event.instCountBefore, isFirst, out);
+            _appendArg("instCountAfter", event.instCountAfter, isFirst, out);
+            _appendArg("arenaBytesBefore", event.arenaBytesBefore, isFirst, out);
+            _appendArg("arenaBytesAfter", event.arenaBytesAfter, isFirst, out);
+            out << "}";
+        }
+
+        out << "}";
+        if (i + 1 < eventCount)
+        {
+            out << ",";
+        }
+        out << "\n";
+    }
+
+    out << "]\n}\n";
+}
+
+namespace { // anonymous
+
+struct SummaryEntry
+{
+    String name;
+    const char* category = nullptr;
+    Count count = 0;
+    uint64_t totalTicks = 0;
+    uint64_t maxTicks = 0;
+    Count instDelta = 0;
+};
+
+} // anonymous
+
+void PerfTrace::writeSummary(StringBuilder& out) const
+{
+    List<SummaryEntry> entries;
+    Dictionary<String, Index> entryMap;
+
+    uint64_t totalTopLevelTicks = 0;
+
+    for (const auto& event : m_events)
+    {
+        const uint64_t duration = event.endTick >= event.startTick ? event.endTick - event.startTick : 0;
+        if (event.depth == 0)
+        {
+            totalTopLevelTicks += duration;
+        }
+
+        StringBuilder keyBuf;
+        keyBuf << (event.category ? event.category : "") << ":" << event.name;
+        const String key = keyBuf.ProduceString();
+
+        Index entryIndex;
+        if (auto entryIndexPtr = entryMap.TryGetValue(key))
+        {
+            entryIndex = *entryIndexPtr;
+        }
+        else
+        {
+            entryIndex = entries.getCount();
+            SummaryEntry entry;
+            entry.name = event.name;
+            entry.category = event.category;
+            entries.add(entry);
+            entryMap.Add(key, entryIndex);
+        }
+
+        auto& entry = entries[entryIndex];
+        entry.count++;
+        entry.totalTicks += duration;
+        entry.maxTicks = (duration > entry.maxTicks) ? duration : entry.maxTicks;
+        if (event.instCountBefore >= 0 && event.instCountAfter >= 0)
+        {
+            entry.instDelta += event.instCountAfter - event.instCountBefore;
+        }
+    }
+
+    entries.sort([](const SummaryEntry& a, const SummaryEntry& b) { return a.totalTicks > b.totalTicks; });
+
+    out << "Performance summary (total ";
+    out.append(ticksToMicroseconds(totalTopLevelTicks) / 1000.0, "%.3f");
+    out << "ms)\n";
+    out << "    total(ms)      max(ms)  count   inst-delta  category:name\n";
+
+    for (const auto& entry : entries)
+    {
+        char buf[128];
+        sprintf_s(buf, SLANG_COUNT_OF(buf), "%13.3f %12.3f %6d %12d  ",
+            ticksToMicroseconds(entry.totalTicks) / 1000.0,
+            ticksToMicroseconds(entry.maxTicks) / 1000.0,
+            int(entry.count),
+            int(entry.instDelta));
+        out << buf << (entry.category ? entry.category : "") << ":" << entry.name << "\n";
+    }
+}
+
+} // namespace Slang
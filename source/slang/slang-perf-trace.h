@@ -0,0 +1,129 @@
+// slang-perf-trace.h
+#ifndef SLANG_PERF_TRACE_H
+#define SLANG_PERF_TRACE_H
+
+#include "../core/slang-basic.h"
+
+#include <thread>
+
+namespace Slang
+{
+
+struct IRModule;
+
+/* Records wall-clock time (and optionally IR statistics) for the phases of a compilation -
+parsing, semantic checking, lowering to IR and each of the IR passes run during linking and
+optimization.
+
+The trace can be written out in the Chrome "Trace Event Format" (viewable in chrome://tracing
+or https://ui.perfetto.dev), or as a textual summary where events are aggregated by name.
+
+Events nest - an event that is begun while another is open is treated as a child of the open
+event. Tracing is opt-in, so when a `Linkage` has no `PerfTrace` set all of the scopes below
+are no-ops.
+
+Only events on the thread that created the trace are recorded. Events begun on other threads
+(for example when generating code for entry points concurrently) are ignored. */
+class PerfTrace : public RefObject
+{
+public:
+    typedef PerfTrace ThisType;
+
+    struct Event
+    {
+        String name;
+        const char* category = nullptr;     ///< Must be a string with static lifetime
+        uint64_t startTick = 0;
+        uint64_t endTick = 0;
+        Index depth = 0;                    ///< Nesting depth, 0 is top level
+
+            /// IR statistics. Only set if the event is associated with an IR module, otherwise -1
+        Count instCountBefore = -1;
+        Count instCountAfter = -1;
+        Count arenaBytesBefore = -1;
+        Count arenaBytesAfter = -1;
+    };
+
+        /// Begin an event. Returns the index of the event which must be passed to `endEvent`.
+        /// If module is set, the instruction count and memory used by the module is recorded.
+        /// Returns -1 if the event is not recorded because it is begun on a different thread.
+    Index beginEvent(const char* category, const UnownedStringSlice& name, IRModule* module = nullptr);
+        /// End the event at `eventIndex`. If module is set records the IR statistics after the event.
+    void endEvent(Index eventIndex, IRModule* module = nullptr);
+
+        /// Get all of the recorded events, in the order they were begun
+    const List<Event>& getEvents() const { return m_events; }
+
+        /// Clear all recorded events
+    void clear();
+
+        /// Write the events in the Chrome trace JSON format
+    void writeChromeTrace(StringBuilder& out) const;
+        /// Write a summary of the events, aggregated by category and name, ordered by total time
+    void writeSummary(StringBuilder& out) const;
+
+        /// Convert a tick duration to microseconds
+    double ticksToMicroseconds(uint64_t ticks) const { return double(ticks) * 1000000.0 / double(m_clockFrequency); }
+
+        /// Count all of the instructions in the module
+    static Count calcInstCount(IRModule* module);
+
+    PerfTrace();
+
+protected:
+    void _setIRStats(IRModule* module, Count& outInstCount, Count& outArenaBytes);
+
+    List<Event> m_events;
+    Index m_depth = 0;
+    uint64_t m_clockFrequency = 1;
+    uint64_t m_startTick = 0;
+    std::thread::id m_threadId;             ///< The thread events are recorded on
+};
+
+/* RAII type to time a scope. Does nothing if the trace is nullptr. */
+struct PerfTraceScope
+{
+    PerfTraceScope(PerfTrace* trace, const char* category, const char* name, IRModule* module = nullptr):
+        m_trace(trace),
+        m_module(module)
+    {
+        if (trace)
+        {
+            m_eventIndex = trace->beginEvent(category, UnownedStringSlice(name), module);
+        }
+    }
+    PerfTraceScope(PerfTrace* trace, const char* category, const UnownedStringSlice& name, IRModule* module = nullptr) :
+        m_trace(trace),
+        m_module(module)
+    {
+        if (trace)
+        {
+            m_eventIndex = trace->beginEvent(category, name, module);
+        }
+    }
+
+        /// The module may change during the scope (for example linking produces a new module)
+    void setModule(IRModule* module) { m_module = module; }
+
+    ~PerfTraceScope()
+    {
+        if (m_trace)
+        {
+            m_trace->endEvent(m_eventIndex, m_module);
+        }
+    }
+
+private:
+    PerfTrace* m_trace;
+    IRModule* m_module;
+    Index m_eventIndex = -1;
+};
+
+} // namespace Slang
+
+// Runs `pass` as an event called `name` in the "ir" category of `trace` (which may be nullptr if
+// tracing isn't enabled), recording the IR statistics of `module` before and after the pass.
+#define SLANG_PERF_TRACE_PASS(trace, module, name, pass) \
+    do { ::Slang::PerfTraceScope perfPassScope_(trace, "ir", name, module); pass; } while (0)
+
+#endif
@@ -495,13 +495,17 @@ private:
 // take responsibility for actually emitting those diagnostics.
 
     /// An input stream that reads tokens directly using the Slang `Lexer`
+    ///
+    /// If the tokens of the file have been lexed before (and lexing produced no diagnostics)
+    /// the tokens are read from the cache entry instead of lexing again.
 struct LexerInputStream : InputStream
 {
     typedef InputStream Super;
 
     LexerInputStream(
-        Preprocessor*   preprocessor,
-        SourceView*     sourceView);
+        Preprocessor*               preprocessor,
+        SourceView*                 sourceView,
+        IncludeTokenCache::Entry*   cachedTokens);
 
     Lexer* getLexer() { return &m_lexer; }
 
@@ -525,6 +529,18 @@ private:
         /// Read a token from the lexer, bypassing lookahead
     Token _readTokenImpl()
     {
+        if (m_cachedTokens)
+        {
+            // The end of file token is last, and is returned for any read after the end
+            Token token = m_cachedTokens->tokens[m_cachedTokenIndex];
+            if (token.type != TokenType::EndOfFile)
+            {
+                m_cachedTokenIndex++;
+            }
+            token.loc = m_lexer.m_startLoc + Int(token.loc.getRaw());
+            return token;
+        }
+
         for(;;)
         {
             Token token = m_lexer.lexToken();
@@ -544,6 +560,10 @@ private:
         /// The lexer state that will provide input
     Lexer m_lexer;
 
+        /// If set, tokens are read from here instead of using m_lexer
+    RefPtr<IncludeTokenCache::Entry> m_cachedTokens;
+    Index m_cachedTokenIndex = 0;
+
         /// One token of lookahead
     Token m_lookaheadToken;
 };
@@ -910,8 +930,9 @@ private:
 struct InputFile
 {
     InputFile(
-        Preprocessor*   preprocessor,
-        SourceView*     sourceView);
+        Preprocessor*               preprocessor,
+        SourceView*                 sourceView,
+        IncludeTokenCache::Entry*   cachedTokens = nullptr);
 
     ~InputFile();
 
@@ -1003,6 +1024,13 @@ struct Preprocessor
         /// stop them from being included again.
     HashSet<String>                         pragmaOnceUniqueIdentities;
 
+        /// Maps the unique identity of an included file whose contents are all inside of an include
+        /// guard to the guard macro. The file doesn't need to be included again while the macro is defined.
+    Dictionary<String, Name*>               includeGuards;
+
+        /// Tokens of included files
+    RefPtr<IncludeTokenCache>               includeTokenCache;
+
         /// Name pool to use when creating `Name`s from strings
     NamePool*                               namePool = nullptr;
 
@@ -1092,22 +1120,27 @@ DiagnosticSink* InputStream::getSink()
 //
 
 LexerInputStream::LexerInputStream(
-    Preprocessor*   preprocessor,
-    SourceView*     sourceView)
+    Preprocessor*               preprocessor,
+    SourceView*                 sourceView,
+    IncludeTokenCache::Entry*   cachedTokens)
     : Super(preprocessor)
+    , m_cachedTokens(cachedTokens)
 {
+    SLANG_ASSERT(!cachedTokens || !cachedTokens->hasDiagnostics);
+
     MemoryArena* memoryArena = sourceView->getSourceManager()->getMemoryArena();
     m_lexer.initialize(sourceView, GetSink(preprocessor), preprocessor->getNamePool(), memoryArena);
     m_lookaheadToken = _readTokenImpl();
 }
 
 InputFile::InputFile(
-    Preprocessor*   preprocessor,
-    SourceView*     sourceView)
+    Preprocessor*               preprocessor,
+    SourceView*                 sourceView,
+    IncludeTokenCache::Entry*   cachedTokens)
 {
     m_preprocessor = preprocessor;
 
-    m_lexerStream = new LexerInputStream(preprocessor, sourceView);
+    m_lexerStream = new LexerInputStream(preprocessor, sourceView, cachedTokens);
     m_expansionStream = new ExpansionInputStream(preprocessor, m_lexerStream);
 }
 
@@ -3027,6 +3060,16 @@ static void HandleIncludeDirective(PreprocessorDirectiveContext* context)
         return;
     }
 
+    // Check whether we've previously included this file and found all of it is inside of an include
+    // guard. If the guard macro is defined, including the file again would produce nothing.
+    if (auto includeGuard = context->m_preprocessor->includeGuards.TryGetValue(filePathInfo.uniqueIdentity))
+    {
+        if (LookupMacro(&context->m_preprocessor->globalEnv, *includeGuard))
+        {
+            return;
+        }
+    }
+
     // Simplify the path
     filePathInfo.foundPath = includeSystem->simplifyPath(filePathInfo.foundPath);
 
@@ -3062,7 +3105,14 @@ static void HandleIncludeDirective(PreprocessorDirectiveContext* context)
     // This is a new parse (even if it's a pre-existing source file), so create a new SourceView
     SourceView* sourceView = sourceManager->createSourceView(sourceFile, &filePathInfo, directiveLoc);
 
-    InputFile* inputFile = new InputFile(context->m_preprocessor, sourceView);
+    // Use the tokens from the last time the file was lexed if we can
+    auto cacheEntry = context->m_preprocessor->includeTokenCache->getEntry(filePathInfo.uniqueIdentity, sourceView, context->m_preprocessor->getNamePool());
+    if (cacheEntry && cacheEntry->includeGuard)
+    {
+        context->m_preprocessor->includeGuards[filePathInfo.uniqueIdentity] = cacheEntry->includeGuard;
+    }
+
+    InputFile* inputFile = new InputFile(context->m_preprocessor, sourceView, (cacheEntry && !cacheEntry->hasDiagnostics) ? cacheEntry : nullptr);
 
     context->m_preprocessor->pushInputFile(inputFile);
 }
@@ -3941,6 +3991,197 @@ static TokenList ReadAllTokens(
 
 } // namespace preprocessor
 
+//
+// IncludeTokenCache
+//
+
+static bool _isIdentifier(const Token& token, const char* text)
+{
+    return token.type == TokenType::Identifier && token.getContent() == UnownedStringSlice(text);
+}
+
+    /// If all of tokens (the tokens of a file, ending with an end of file token) are inside of an
+    /// include guard, returns the name of the guard macro, else nullptr.
+    ///
+    /// The first directive must be `#ifndef X`, `#if !defined(X)` or `#if !defined X`. The `#endif`
+    /// that matches it must be the last directive, and there can't be an `#else` or `#elif` for it.
+    /// There can't be any tokens outside of the guard, other than newlines.
+static Name* _findIncludeGuard(const List<Token>& tokens)
+{
+    // Note that we never step past the end of file token, as it doesn't match any of the checks
+    Index index = 0;
+    auto skipNewLines = [&]()
+    {
+        while (tokens[index].type == TokenType::NewLine)
+        {
+            index++;
+        }
+    };
+    auto isDirectiveStart = [&](Index i)
+    {
+        return tokens[i].type == TokenType::Pound && (tokens[i].flags & TokenFlag::AtStartOfLine);
+    };
+
+    skipNewLines();
+    if (!isDirectiveStart(index))
+    {
+        return nullptr;
+    }
+    index++;
+
+    Name* guardName = nullptr;
+    if (_isIdentifier(tokens[index], "ifndef"))
+    {
+        index++;
+        if (tokens[index].type != TokenType::Identifier)
+        {
+            return nullptr;
+        }
+        guardName = tokens[index++].getName();
+    }
+    else if (_isIdentifier(tokens[index], "if"))
+    {
+        index++;
+        if (tokens[index].type != TokenType::OpNot || !_isIdentifier(tokens[index + 1], "defined"))
+        {
+            return nullptr;
+        }
+        index += 2;
+
+        const bool hasParens = tokens[index].type == TokenType::LParent;
+        if (hasParens)
+        {
+            index++;
+        }
+        if (tokens[index].type != TokenType::Identifier)
+        {
+            return nullptr;
+        }
+        guardName = tokens[index++].getName();
+        if (hasParens)
+        {
+            if (tokens[index].type != TokenType::RParent)
+            {
+                return nullptr;
+            }
+            index++;
+        }
+    }
+    else
+    {
+        return nullptr;
+    }
+
+    // The condition must be all of the directive
+    if (tokens[index].type != TokenType::NewLine || !guardName)
+    {
+        return nullptr;
+    }
+
+    // Find the matching `#endif`
+    const Index count = tokens.getCount();
+    Index depth = 1;
+    for (; index < count && depth > 0; ++index)
+    {
+        if (!isDirectiveStart(index))
+        {
+            continue;
+        }
+        const Token& directive = tokens[index + 1];
+        if (_isIdentifier(directive, "if") || _isIdentifier(directive, "ifdef") || _isIdentifier(directive, "ifndef"))
+        {
+            depth++;
+        }
+        else if (_isIdentifier(directive, "else") || _isIdentifier(directive, "elif"))
+        {
+            if (depth == 1)
+            {
+                return nullptr;
+            }
+        }
+        else if (_isIdentifier(directive, "endif"))
+        {
+            depth--;
+        }
+    }
+    if (depth > 0)
+    {
+        return nullptr;
+    }
+
+    // Skip the rest of the `#endif` line, after which there can only be newlines
+    while (tokens[index].type != TokenType::NewLine && tokens[index].type != TokenType::EndOfFile)
+    {
+        index++;
+    }
+    skipNewLines();
+    return tokens[index].type == TokenType::EndOfFile ? guardName : nullptr;
+}
+
+IncludeTokenCache::Entry* IncludeTokenCache::getEntry(const String& uniqueIdentity, SourceView* sourceView, NamePool* namePool)
+{
+    SourceFile* sourceFile = sourceView->getSourceFile();
+    ISlangBlob* contentBlob = sourceFile->getContentBlob();
+    if (!contentBlob)
+    {
+        return nullptr;
+    }
+
+    if (auto entryPtr = m_entries.TryGetValue(uniqueIdentity))
+    {
+        Entry* entry = *entryPtr;
+        // Blobs are immutable, so the same blob means the same contents
+        if (entry->contentBlob == contentBlob)
+        {
+            return entry;
+        }
+        if (sourceFile->getContentDigest() == entry->contentDigest)
+        {
+            return entry;
+        }
+    }
+
+    RefPtr<Entry> entry = new Entry;
+    entry->contentBlob = contentBlob;
+    entry->contentDigest = sourceFile->getContentDigest();
+
+    // Diagnostics are only needed to know if there are any, as the file will be lexed again by
+    // the preprocessor if there are.
+    DiagnosticSink sink(sourceView->getSourceManager(), Lexer::sourceLocationLexer);
+
+    Lexer lexer;
+    lexer.initialize(sourceView, &sink, namePool, &m_memoryArena);
+
+    const SourceLoc startLoc = sourceView->getRange().begin;
+    for (;;)
+    {
+        Token token = lexer.lexToken();
+        switch (token.type)
+        {
+            case TokenType::WhiteSpace:
+            case TokenType::BlockComment:
+            case TokenType::LineComment:
+                continue;
+            default:
+                break;
+        }
+
+        token.loc = SourceLoc::fromRaw(token.loc.getRaw() - startLoc.getRaw());
+        entry->tokens.add(token);
+
+        if (token.type == TokenType::EndOfFile)
+        {
+            break;
+        }
+    }
+
+    entry->hasDiagnostics = sink.outputBuffer.getLength() > 0 || sink.getErrorCount() > 0;
+    entry->includeGuard = _findIncludeGuard(entry->tokens);
+
+    m_entries[uniqueIdentity] = entry;
+    return entry;
+}
+
     /// Try to look up a macro with the given `macroName` and produce its value as a string
 Result findMacroValue(
     Preprocessor*   preprocessor,
@@ -4002,6 +4243,7 @@ TokenList preprocessSource(
     desc.fileSystem     = linkage->getFileSystemExt();
     desc.namePool       = linkage->getNamePool();
     desc.sourceManager  = linkage->getSourceManager();
+    desc.includeTokenCache = linkage->getIncludeTokenCache();
 
     if (linkage->isInLanguageServer())
     {
@@ -4023,6 +4265,8 @@ TokenList preprocessSource(
     preprocessor.fileSystem = desc.fileSystem;
     preprocessor.namePool = desc.namePool;
 
+    preprocessor.includeTokenCache = desc.includeTokenCache ? desc.includeTokenCache : new IncludeTokenCache;
+
     preprocessor.endOfFileToken.type = TokenType::EndOfFile;
     preprocessor.endOfFileToken.flags = TokenFlag::AtStartOfLine;
     preprocessor.contentAssistInfo = desc.contentAssistInfo;
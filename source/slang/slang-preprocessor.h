@@ -3,6 +3,8 @@
 #define SLANG_PREPROCESSOR_H_INCLUDED
 
 #include "../core/slang-basic.h"
+#include "../core/slang-crypto.h"
+#include "../core/slang-memory-arena.h"
 
 #include "../compiler-core/slang-lexer.h"
 #include "../compiler-core/slang-include-system.h"
@@ -31,6 +33,53 @@ struct PreprocessorHandler
     virtual void handleFileDependency(SourceFile* sourceFile);
 };
 
+    /// Caches the tokens lexed from files included with `#include`, such that including a file
+    /// again (from the same or another translation unit) doesn't need to lex it again.
+    ///
+    /// Entries are found by the unique identity of a file, and are only used if the contents of
+    /// the file are unchanged. An entry also records if all of the file is inside of an include
+    /// guard (`#ifndef X` ... `#endif`), so the preprocessor can skip including the file again
+    /// while `X` is defined, without loading it.
+    ///
+    /// Cached tokens hold `Name`s, so a cache must only be used with a single `NamePool`.
+class IncludeTokenCache : public RefObject
+{
+public:
+    struct Entry : RefObject
+    {
+            /// The contents the tokens were lexed from. Held because token content can reference it.
+        ComPtr<ISlangBlob> contentBlob;
+        ContentHash::Digest contentDigest;
+
+            /// The tokens of the file (without whitespace or comments), ending with an end of file token.
+            /// The location of each token is its offset from the start of the file.
+        List<Token> tokens;
+
+            /// Set if lexing the file produced diagnostics. The tokens can't be used in place of lexing,
+            /// because which diagnostics are reported depends on the parts of the file that are skipped.
+        bool hasDiagnostics = false;
+
+            /// If all of the file is inside of an include guard, the name of the guard macro
+        Name* includeGuard = nullptr;
+    };
+
+        /// Get the entry for the file viewed by sourceView, lexing the file to create the entry if there
+        /// isn't one for the file, or the file contents have changed.
+        /// Returns nullptr if the file can't be cached.
+    Entry* getEntry(const String& uniqueIdentity, SourceView* sourceView, NamePool* namePool);
+
+        /// Remove all entries
+    void clear() { m_entries.Clear(); }
+
+    IncludeTokenCache() : m_memoryArena(4096) {}
+
+protected:
+    Dictionary<String, RefPtr<Entry>> m_entries;
+
+        /// Holds the content of tokens that had escaped newlines removed
+    MemoryArena m_memoryArena;
+};
+
     /// Description of a preprocessor options/dependencies
 struct PreprocessorDesc
 {
@@ -57,6 +106,10 @@ struct PreprocessorDesc
 
         /// Optional: additional information for code assist.
     PreprocessorContentAssistInfo* contentAssistInfo = nullptr;
+
+        /// Optional: cache of the tokens of included files, shared between invocations of the
+        /// preprocessor. If not set, a cache is only kept for this invocation.
+    IncludeTokenCache* includeTokenCache = nullptr;
 };
 
     /// Take a source `file` and preprocess it into a list of tokens.
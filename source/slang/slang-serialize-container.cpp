@@ -18,6 +18,60 @@
 
 namespace Slang {
 
+namespace { // anonymous
+
+/* Holds the serialized IR of a module, and creates the IRModule from it when first needed.
+The serialized data is only decoded from the container format, no instructions are
+created until createIRModule is called. If the container was read in place, uncompressed
+arrays are not copied at all, and the blob holding them is kept alive until then. */
+class SerialIRModuleFactory : public IRModuleFactory
+{
+public:
+    virtual RefPtr<IRModule> createIRModule() SLANG_OVERRIDE
+    {
+        RefPtr<IRModule> irModule;
+        IRSerialReader reader;
+        if (SLANG_FAILED(reader.read(m_serialDataView, m_session, m_sourceLocReader, irModule)))
+        {
+            return nullptr;
+        }
+        // The serialized data is no longer needed
+        m_serialDataView = IRSerialDataView();
+        m_serialData.clear();
+        m_blob.setNull();
+        return irModule;
+    }
+
+    SlangResult readContainer(RiffContainer::ListChunk* irChunk, SerialCompressionType containerCompressionType, ISlangBlob* inPlaceBlob)
+    {
+        if (inPlaceBlob)
+        {
+            m_blob = inPlaceBlob;
+            return IRSerialReader::readContainerInPlace(irChunk, containerCompressionType, &m_serialData, &m_serialDataView);
+        }
+
+        SLANG_RETURN_ON_FAIL(IRSerialReader::readContainer(irChunk, containerCompressionType, &m_serialData));
+        m_serialDataView.set(m_serialData);
+        return SLANG_OK;
+    }
+
+    SerialIRModuleFactory(Session* session, SerialSourceLocReader* sourceLocReader):
+        m_session(session),
+        m_sourceLocReader(sourceLocReader)
+    {
+    }
+
+protected:
+    IRSerialData m_serialData;                  ///< Holds arrays that could not be referenced in place
+    IRSerialDataView m_serialDataView;
+    ComPtr<ISlangBlob> m_blob;                  ///< Holds the memory in place arrays reference
+
+    Session* m_session;
+    RefPtr<SerialSourceLocReader> m_sourceLocReader;
+};
+
+} // anonymous
+
 /* static */SlangResult SerialContainerUtil::write(Module* module, const WriteOptions& options, Stream* stream)
 {
     RiffContainer container;
@@ -354,15 +408,28 @@ static List<ExtensionDecl*>& _getCandidateExtensionList(
             NodeBase* astRootNode = nullptr;
             RefPtr<IRModule> irModule;
 
+            RefPtr<IRModuleFactory> irModuleFactory;
+
             if (auto irChunk = as<RiffContainer::ListChunk>(chunk, IRSerialBinary::kIRModuleFourCc))
             {
-                IRSerialData serialData;
+                if (options.readIRLazily)
+                {
+                    RefPtr<SerialIRModuleFactory> factory = new SerialIRModuleFactory(options.session, sourceLocReader);
+                    SLANG_RETURN_ON_FAIL(factory->readContainer(irChunk, containerCompressionType, options.inPlaceBlob));
+                    irModuleFactory = factory;
+                }
+                else
+                {
+                    // The container is in scope for the whole read, so arrays can always be used in place
+                    IRSerialData serialData;
+                    IRSerialDataView serialDataView;
 
-                SLANG_RETURN_ON_FAIL(IRSerialReader::readContainer(irChunk, containerCompressionType, &serialData));
+                    SLANG_RETURN_ON_FAIL(IRSerialReader::readContainerInPlace(irChunk, containerCompressionType, &serialData, &serialDataView));
 
-                // Read IR back from serialData
-                IRSerialReader reader;
-                SLANG_RETURN_ON_FAIL(reader.read(serialData, options.session, sourceLocReader, irModule));
+                    // Read IR back from serialData
+                    IRSerialReader reader;
+                    SLANG_RETURN_ON_FAIL(reader.read(serialDataView, options.session, sourceLocReader, irModule));
+                }
 
                 // Onto next chunk
                 chunk = chunk->m_next;
@@ -576,13 +643,14 @@ static List<ExtensionDecl*>& _getCandidateExtensionList(
                 chunk = chunk->m_next;
             }
 
-            if (astBuilder || irModule)
+            if (astBuilder || irModule || irModuleFactory)
             {
                 SerialContainerData::Module module;
 
                 module.astBuilder = astBuilder;
                 module.astRootNode = astRootNode;
                 module.irModule = irModule;
+                module.irModuleFactory = irModuleFactory;
 
                 out.modules.add(module);
             }
@@ -51,6 +51,7 @@ struct SerialContainerData
     struct Module
     {
         RefPtr<IRModule> irModule;              ///< The IR for the module
+        RefPtr<IRModuleFactory> irModuleFactory; ///< If IR is read lazily, creates the IR for the module (irModule is not set)
         RefPtr<ASTBuilder> astBuilder;          ///< The astBuilder that owns the astRootNode
         NodeBase* astRootNode = nullptr;        ///< The module decl
     };
@@ -92,6 +93,8 @@ struct SerialContainerUtil
         ASTBuilder* astBuilder = nullptr; // Optional. If not provided will create one in SerialContainerData.
         Linkage* linkage = nullptr;
         DiagnosticSink* sink = nullptr;
+        bool readIRLazily = false;        ///< If set IR modules are not created on reading, but an IRModuleFactory is returned which creates them on demand
+        ISlangBlob* inPlaceBlob = nullptr;    ///< If set the container was read in place (with RiffUtil::readInPlace) from this blob. Lazily read IR references the blob directly, and keeps it alive.
     };
 
         /// Add module to outData
@@ -72,6 +72,16 @@ IRSerialData::IRSerialData()
     clear();
 }
 
+void IRSerialDataView::set(const IRSerialData& data)
+{
+    m_insts = data.m_insts.getArrayView();
+    m_rawSourceLocs = data.m_rawSourceLocs.getArrayView();
+    m_childRuns = data.m_childRuns.getArrayView();
+    m_externalOperands = data.m_externalOperands.getArrayView();
+    m_stringTable = data.m_stringTable.getArrayView();
+    m_debugSourceLocRuns = data.m_debugSourceLocRuns.getArrayView();
+}
+
 void IRSerialData::clear()
 {
     // First Instruction is null
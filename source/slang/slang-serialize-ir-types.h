@@ -193,6 +193,32 @@ struct IRSerialData
     static const PayloadInfo s_payloadInfos[int(Inst::PayloadType::CountOf)];
 };
 
+/* A read only view of the arrays of IRSerialData. The arrays can reference the contents of an IRSerialData,
+or the serialized data directly - say when a container is read in place from a memory mapped file. In that
+case the memory backing the view must stay in scope for as long as the view is used. */
+struct IRSerialDataView
+{
+    typedef IRSerialDataView ThisType;
+    typedef IRSerialData::Inst Inst;
+    typedef IRSerialData::InstIndex InstIndex;
+
+        /// Get the operands of an instruction
+    SLANG_FORCE_INLINE int getOperands(const Inst& inst, const InstIndex** operandsOut) const;
+
+        /// Set to reference the contents of data
+    void set(const IRSerialData& data);
+
+    IRSerialDataView() {}
+    explicit IRSerialDataView(const IRSerialData& data) { set(data); }
+
+    ConstArrayView<Inst> m_insts;
+    ConstArrayView<IRSerialData::RawSourceLoc> m_rawSourceLocs;
+    ConstArrayView<IRSerialData::InstRun> m_childRuns;
+    ConstArrayView<InstIndex> m_externalOperands;
+    ConstArrayView<char> m_stringTable;
+    ConstArrayView<IRSerialData::SourceLocRun> m_debugSourceLocRuns;
+};
+
 // --------------------------------------------------------------------------
 SLANG_FORCE_INLINE int IRSerialData::Inst::getNumOperands() const
 {
@@ -252,6 +278,20 @@ SLANG_FORCE_INLINE int IRSerialData::getOperands(const Inst& inst, const InstInd
     }
 }
 
+// --------------------------------------------------------------------------
+SLANG_FORCE_INLINE int IRSerialDataView::getOperands(const Inst& inst, const InstIndex** operandsOut) const
+{
+    if (inst.m_payloadType == Inst::PayloadType::OperandExternal)
+    {
+        *operandsOut = m_externalOperands.begin() + int(inst.m_payload.m_externalOperand.m_arrayIndex);
+        return int(inst.m_payload.m_externalOperand.m_size);
+    }
+    else
+    {
+        *operandsOut = inst.m_payload.m_operands;
+        return IRSerialData::s_payloadInfos[int(inst.m_payloadType)].m_numOperands;
+    }
+}
 
 } // namespace Slang
 
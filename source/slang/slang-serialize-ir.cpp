@@ -616,11 +616,34 @@ static Result _readInstArrayChunk(SerialCompressionType containerCompressionType
     return SLANG_OK;
 }
 
-/* static */Result IRSerialReader::readContainer(RiffContainer::ListChunk* module, SerialCompressionType containerCompressionType, IRSerialData* outData)
+/* If outView is set, tries to reference the array held in chunk in place. Returns true if it does. */
+template <typename T>
+static bool _readArrayChunkInPlace(RiffContainer::DataChunk* chunk, ConstArrayView<T>* outView)
+{
+    return outView && SLANG_SUCCEEDED(SerialRiffUtil::readArrayChunkInPlace(chunk, *outView));
+}
+
+/* If the view doesn't reference an array in place, make it reference the array read into storage */
+template <typename T>
+static void _setViewIfNotInPlace(const List<T>& storage, ConstArrayView<T>& ioView)
+{
+    if (ioView.getBuffer() == nullptr)
+    {
+        ioView = storage.getArrayView();
+    }
+}
+
+/* Reads the module container into outData. If outView is set, arrays are referenced in place when possible 
+and are only read into outData when not. */
+static Result _readContainer(RiffContainer::ListChunk* module, SerialCompressionType containerCompressionType, IRSerialData* outData, IRSerialDataView* outView)
 {
     typedef IRSerialBinary Bin;
 
     outData->clear();
+    if (outView)
+    {
+        *outView = IRSerialDataView();
+    }
 
     for (RiffContainer::Chunk* chunk = module->m_containedChunks; chunk; chunk = chunk->m_next)
     {
@@ -635,35 +658,53 @@ static Result _readInstArrayChunk(SerialCompressionType containerCompressionType
             case SLANG_MAKE_COMPRESSED_FOUR_CC(Bin::kInstFourCc):
             case Bin::kInstFourCc:
             {
-                SLANG_RETURN_ON_FAIL(_readInstArrayChunk(containerCompressionType, dataChunk, outData->m_insts));
+                if (!_readArrayChunkInPlace(dataChunk, outView ? &outView->m_insts : nullptr))
+                {
+                    SLANG_RETURN_ON_FAIL(_readInstArrayChunk(containerCompressionType, dataChunk, outData->m_insts));
+                }
                 break;
             }
             case SLANG_MAKE_COMPRESSED_FOUR_CC(Bin::kChildRunFourCc):
             case Bin::kChildRunFourCc:
             {
-                SLANG_RETURN_ON_FAIL(SerialRiffUtil::readArrayChunk(containerCompressionType, dataChunk, outData->m_childRuns));
+                if (!_readArrayChunkInPlace(dataChunk, outView ? &outView->m_childRuns : nullptr))
+                {
+                    SLANG_RETURN_ON_FAIL(SerialRiffUtil::readArrayChunk(containerCompressionType, dataChunk, outData->m_childRuns));
+                }
                 break;
             }
             case SLANG_MAKE_COMPRESSED_FOUR_CC(Bin::kExternalOperandsFourCc):
             case Bin::kExternalOperandsFourCc:
             {
-                SLANG_RETURN_ON_FAIL(SerialRiffUtil::readArrayChunk(containerCompressionType, dataChunk, outData->m_externalOperands));
+                if (!_readArrayChunkInPlace(dataChunk, outView ? &outView->m_externalOperands : nullptr))
+                {
+                    SLANG_RETURN_ON_FAIL(SerialRiffUtil::readArrayChunk(containerCompressionType, dataChunk, outData->m_externalOperands));
+                }
                 break;
             }
             case SerialBinary::kStringTableFourCc:
             {
-                SLANG_RETURN_ON_FAIL(SerialRiffUtil::readArrayUncompressedChunk(dataChunk, outData->m_stringTable));
+                if (!_readArrayChunkInPlace(dataChunk, outView ? &outView->m_stringTable : nullptr))
+                {
+                    SLANG_RETURN_ON_FAIL(SerialRiffUtil::readArrayUncompressedChunk(dataChunk, outData->m_stringTable));
+                }
                 break;
             }
             case Bin::kUInt32RawSourceLocFourCc:
             {
-                SLANG_RETURN_ON_FAIL(SerialRiffUtil::readArrayUncompressedChunk(dataChunk, outData->m_rawSourceLocs));
+                if (!_readArrayChunkInPlace(dataChunk, outView ? &outView->m_rawSourceLocs : nullptr))
+                {
+                    SLANG_RETURN_ON_FAIL(SerialRiffUtil::readArrayUncompressedChunk(dataChunk, outData->m_rawSourceLocs));
+                }
                 break;
             }
             case SLANG_MAKE_COMPRESSED_FOUR_CC(Bin::kDebugSourceLocRunFourCc):
             case Bin::kDebugSourceLocRunFourCc:
             {
-                SLANG_RETURN_ON_FAIL(SerialRiffUtil::readArrayChunk(containerCompressionType, dataChunk, outData->m_debugSourceLocRuns));
+                if (!_readArrayChunkInPlace(dataChunk, outView ? &outView->m_debugSourceLocRuns : nullptr))
+                {
+                    SLANG_RETURN_ON_FAIL(SerialRiffUtil::readArrayChunk(containerCompressionType, dataChunk, outData->m_debugSourceLocRuns));
+                }
                 break;
             }
             default:
@@ -673,10 +714,36 @@ static Result _readInstArrayChunk(SerialCompressionType containerCompressionType
         }
     }
 
+    if (outView)
+    {
+        _setViewIfNotInPlace(outData->m_insts, outView->m_insts);
+        _setViewIfNotInPlace(outData->m_rawSourceLocs, outView->m_rawSourceLocs);
+        _setViewIfNotInPlace(outData->m_childRuns, outView->m_childRuns);
+        _setViewIfNotInPlace(outData->m_externalOperands, outView->m_externalOperands);
+        _setViewIfNotInPlace(outData->m_stringTable, outView->m_stringTable);
+        _setViewIfNotInPlace(outData->m_debugSourceLocRuns, outView->m_debugSourceLocRuns);
+    }
+
     return SLANG_OK;
 }
 
+/* static */Result IRSerialReader::readContainer(RiffContainer::ListChunk* module, SerialCompressionType containerCompressionType, IRSerialData* outData)
+{
+    return _readContainer(module, containerCompressionType, outData, nullptr);
+}
+
+/* static */Result IRSerialReader::readContainerInPlace(RiffContainer::ListChunk* module, SerialCompressionType containerCompressionType, IRSerialData* outStorage, IRSerialDataView* outView)
+{
+    return _readContainer(module, containerCompressionType, outStorage, outView);
+}
+
 Result IRSerialReader::read(const IRSerialData& data, Session* session, SerialSourceLocReader* sourceLocReader, RefPtr<IRModule>& outModule)
+{
+    const IRSerialDataView view(data);
+    return read(view, session, sourceLocReader, outModule);
+}
+
+Result IRSerialReader::read(const IRSerialDataView& data, Session* session, SerialSourceLocReader* sourceLocReader, RefPtr<IRModule>& outModule)
 {
     typedef Ser::Inst::PayloadType PayloadType;
 
@@ -926,7 +993,8 @@ Result IRSerialReader::read(const IRSerialData& data, Session* session, SerialSo
     // We now need to apply the runs
     if (sourceLocReader && m_serialData->m_debugSourceLocRuns.getCount())
     {
-        List<IRSerialData::SourceLocRun> sourceRuns(m_serialData->m_debugSourceLocRuns);
+        List<IRSerialData::SourceLocRun> sourceRuns;
+        sourceRuns.addRange(m_serialData->m_debugSourceLocRuns.getBuffer(), m_serialData->m_debugSourceLocRuns.getCount());
         // They are now in source location order
         sourceRuns.sort();
 
@@ -70,9 +70,13 @@ struct IRSerialReader
     
         /// Read a stream to fill in dataOut IRSerialData
     static Result readContainer(RiffContainer::ListChunk* module, SerialCompressionType containerCompressionType, IRSerialData* outData);
+        /// Read the container into outView. Arrays that are uncompressed and suitably aligned are referenced in place, 
+        /// the others are read into outStorage. The container payloads and outStorage must stay in scope while the view is used.
+    static Result readContainerInPlace(RiffContainer::ListChunk* module, SerialCompressionType containerCompressionType, IRSerialData* outStorage, IRSerialDataView* outView);
 
         /// Read a module from serial data
     Result read(const IRSerialData& data, Session* session, SerialSourceLocReader* sourceLocReader, RefPtr<IRModule>& outModule);
+    Result read(const IRSerialDataView& data, Session* session, SerialSourceLocReader* sourceLocReader, RefPtr<IRModule>& outModule);
 
     IRSerialReader():
         m_serialData(nullptr),
@@ -85,7 +89,7 @@ struct IRSerialReader
 
     StringSlicePool m_stringTable;
 
-    const IRSerialData* m_serialData;
+    const IRSerialDataView* m_serialData;
     IRModule* m_module;
 };
 
@@ -120,6 +120,34 @@ struct ByteReader
 
 // !!!!!!!!!!!!!!!!!!!!!!!!!!!! SerialRiffUtil !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
 
+/* static */void SerialRiffUtil::writeAlignmentPadChunk(size_t headerSize, RiffContainer* container)
+{
+    typedef RiffContainer::Chunk Chunk;
+    typedef RiffContainer::ScopeChunk ScopeChunk;
+
+    const size_t alignMask = SerialBinary::kArrayAlignment - 1;
+
+    // Where the data would be if there is no padding
+    const size_t offset = container->calcNextChunkOffset() + sizeof(RiffHeader) + headerSize;
+    if ((offset & alignMask) == 0)
+    {
+        return;
+    }
+
+    // The pad chunk moves the data by its header and payload. As riff chunks are 2 byte aligned, the payload
+    // size is always even.
+    const size_t padSize = (SerialBinary::kArrayAlignment - ((offset + sizeof(RiffHeader)) & alignMask)) & alignMask;
+    SLANG_ASSERT((padSize & kRiffPadMask) == 0);
+
+    static const uint8_t zeros[SerialBinary::kArrayAlignment] = { 0 };
+
+    ScopeChunk scope(container, Chunk::Kind::Data, SerialBinary::kPadFourCc);
+    if (padSize)
+    {
+        container->write(zeros, padSize);
+    }
+}
+
 /* static */ Result SerialRiffUtil::writeArrayChunk(SerialCompressionType compressionType, FourCC chunkId, const void* data, size_t numEntries, size_t typeSize, RiffContainer* container)
 {
     typedef RiffContainer::Chunk Chunk;
@@ -133,6 +161,12 @@ struct ByteReader
     // Make compressed fourCC
     chunkId = (compressionType != SerialCompressionType::None) ? SLANG_MAKE_COMPRESSED_FOUR_CC(chunkId) : chunkId;
 
+    if (compressionType == SerialCompressionType::None)
+    {
+        // Align the entries, so they can be used in place when read
+        writeAlignmentPadChunk(sizeof(SerialBinary::ArrayHeader), container);
+    }
+
     ScopeChunk scope(container, Chunk::Kind::Data, chunkId);
 
     switch (compressionType)
@@ -205,6 +239,36 @@ struct ByteReader
     return SLANG_OK;
 }
 
+/* static */Result SerialRiffUtil::readArrayChunkInPlace(RiffContainer::DataChunk* dataChunk, size_t typeSize, size_t typeAlignment, const void** outEntries, size_t* outNumEntries)
+{
+    // Compressed chunks have to be decoded
+    if (dataChunk->m_fourCC == SLANG_MAKE_COMPRESSED_FOUR_CC(dataChunk->m_fourCC))
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    RiffReadHelper read = dataChunk->asReadHelper();
+
+    SerialBinary::ArrayHeader header;
+    SLANG_RETURN_ON_FAIL(read.read(header));
+
+    const size_t payloadSize = header.numEntries * typeSize;
+    if (payloadSize != read.getRemainingSize())
+    {
+        return SLANG_FAIL;
+    }
+
+    const uint8_t* entries = read.getData();
+    if (size_t(entries) & (typeAlignment - 1))
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    *outEntries = entries;
+    *outNumEntries = header.numEntries;
+    return SLANG_OK;
+}
+
 // !!!!!!!!!!!!!!!!!!!!!!!!!!!! SerialParseUtil !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
 
 #define SLANG_SERIAL_BINARY_COMPRESSION_TYPE(x) \
@@ -143,6 +143,13 @@ struct SerialBinary
         /// Container
     static const FourCC kContainerHeaderFourCc = SLANG_FOUR_CC('S', 'c', 'h', 'd');
 
+        /// Padding, such that the payload of the chunk that follows is aligned. The contents should be ignored. 
+    static const FourCC kPadFourCc = SLANG_FOUR_CC('p', 'a', 'd', ' ');
+
+        /// The alignment of the entries of uncompressed arrays, relative to the start of the riff. 
+        /// Makes it possible to use the entries directly when the riff is read in place.
+    static const size_t kArrayAlignment = 8;
+
     struct ContainerHeader
     {
         uint32_t compressionType;         ///< Holds the compression type used (if used at all)
@@ -196,6 +203,10 @@ struct SerialRiffUtil
         List<T>& m_list;
     };
 
+        /// Writes a pad chunk (if needed) such that data held in the next chunk after `headerSize` bytes
+        /// is aligned to SerialBinary::kArrayAlignment.
+    static void writeAlignmentPadChunk(size_t headerSize, RiffContainer* container);
+
     static Result writeArrayChunk(SerialCompressionType compressionType, FourCC chunkId, const void* data, size_t numEntries, size_t typeSize, RiffContainer* container);
     
     template <typename T>
@@ -232,6 +243,20 @@ struct SerialRiffUtil
         return readArrayChunk(SerialCompressionType::None, chunk, resizer);
     }
 
+        /// Get the entries of an uncompressed array chunk without copying them. Returns SLANG_E_NOT_AVAILABLE if the 
+        /// entries can't be used in place, because the chunk is compressed or the entries are not suitably aligned.
+    static Result readArrayChunkInPlace(RiffContainer::DataChunk* dataChunk, size_t typeSize, size_t typeAlignment, const void** outEntries, size_t* outNumEntries);
+
+    template <typename T>
+    static Result readArrayChunkInPlace(RiffContainer::DataChunk* dataChunk, ConstArrayView<T>& outView)
+    {
+        const void* entries = nullptr;
+        size_t numEntries = 0;
+        SLANG_RETURN_ON_FAIL(readArrayChunkInPlace(dataChunk, sizeof(T), SLANG_ALIGN_OF(T), &entries, &numEntries));
+        outView = ConstArrayView<T>((const T*)entries, Count(numEntries));
+        return SLANG_OK;
+    }
+
 
 };
 
@@ -478,6 +478,10 @@ Index getFilterCountImpl(const ReflectClassInfo& clsInfo, MemberFilterStyle filt
         ASTBuilder*     astBuilder,
         DeclRef<Decl>   declRef)
     {
+        // Types that are cached by the AST builder are completed after they are found, so
+        // must be locked throughout
+        SharedStateLock lock;
+
         declRef = createDefaultSubstitutionsIfNeeded(astBuilder, nullptr, declRef);
 
         if (auto builtinMod = declRef.getDecl()->findModifier<BuiltinTypeModifier>())
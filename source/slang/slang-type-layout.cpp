@@ -3407,7 +3407,8 @@ static TypeLayoutResult createArrayLikeTypeLayout(
 }
 
 
-static TypeLayoutResult _createTypeLayout(
+    /// Create layout information for `type`, without looking it up in the target's `TypeLayoutCache`.
+static TypeLayoutResult _createTypeLayoutUncached(
     TypeLayoutContext const&    context,
     Type*                       type)
 {
@@ -3744,6 +3745,14 @@ static TypeLayoutResult _createTypeLayout(
         }
         else if (auto globalGenericParamDecl = declRef.as<GlobalGenericParamDecl>())
         {
+            // The layout depends on the program being laid out, so
+            // can't be shared through the cache.
+            //
+            if (context.targetReq)
+            {
+                context.targetReq->getTypeLayoutCache()->markUncacheable();
+            }
+
             if( auto concreteType = findGlobalGenericSpecializationArg(
                 context,
                 globalGenericParamDecl) )
@@ -4329,6 +4338,50 @@ RefPtr<TypeLayout> getSimpleVaryingParameterTypeLayout(
         rules).layout;
 }
 
+static TypeLayoutResult _createTypeLayout(
+    TypeLayoutContext const&    context,
+    Type*                       type)
+{
+    // Layouts made with specialization arguments depend on more than
+    // the type and rules, so are always made from scratch.
+    //
+    if (context.specializationArgCount || !context.targetReq)
+    {
+        return _createTypeLayoutUncached(context, type);
+    }
+
+    // The cache may be shared by code laying out types on several threads.
+    // The lock is held while the layout is made, so that uncacheable
+    // layouts found by other threads aren't mistaken for ours.
+    //
+    SharedStateLock lock;
+
+    TypeLayoutCache* cache = context.targetReq->getTypeLayoutCache();
+
+    TypeLayoutCache::Key key;
+    key.type = type;
+    key.rules = context.rules;
+    key.matrixLayoutMode = context.matrixLayoutMode;
+
+    if (auto result = cache->find(key))
+    {
+        return *result;
+    }
+
+    // If making the layout (or the layout of anything it contains) marks
+    // it uncacheable, the count will change.
+    //
+    const Count uncacheableCount = cache->getUncacheableCount();
+
+    TypeLayoutResult result = _createTypeLayoutUncached(context, type);
+
+    if (cache->getUncacheableCount() == uncacheableCount)
+    {
+        cache->add(key, result);
+    }
+    return result;
+}
+
 RefPtr<TypeLayout> createTypeLayout(
     TypeLayoutContext const&    context,
     Type*                       type)
@@ -1112,6 +1112,51 @@ struct TypeLayoutResult
     {}
 };
 
+    /// Holds the type layouts made for a target, so that the layout of a type is only made once
+    /// for each set of layout rules and matrix layout mode, however many times parameter binding
+    /// (for each program and entry point) and reflection ask for it.
+    ///
+    /// A layout is only cached if it doesn't depend on anything but the key. Layouts made
+    /// with specialization arguments, or that involve a global generic type parameter (whose
+    /// layout depends on the program) are not cached.
+    ///
+    /// Cached layouts are shared, and so must not be modified once made.
+class TypeLayoutCache : public RefObject
+{
+public:
+    struct Key
+    {
+        typedef Key ThisType;
+        SLANG_FORCE_INLINE bool operator==(const ThisType& rhs) const { return type == rhs.type && rules == rhs.rules && matrixLayoutMode == rhs.matrixLayoutMode; }
+        SLANG_FORCE_INLINE bool operator!=(const ThisType& rhs) const { return !(*this == rhs); }
+
+        HashCode getHashCode() const { return combineHash(combineHash(Slang::getHashCode(type), Slang::getHashCode(rules)), HashCode(matrixLayoutMode)); }
+
+        Type* type;
+            /// The rules identify the family as well as the kind of rules (constant buffer, varying input etc)
+        LayoutRulesImpl* rules;
+        MatrixLayoutMode matrixLayoutMode;
+    };
+
+        /// Find the cached layout for `key`. Returns nullptr if there isn't one.
+    TypeLayoutResult* find(const Key& key) { return m_results.TryGetValue(key); }
+        /// Add the layout `result` for `key`
+    void add(const Key& key, const TypeLayoutResult& result) { m_results[key] = result; }
+
+        /// Record that the layout being made can't be cached.
+        /// Layouts made for all the keys being looked up at the time aren't cached either.
+    void markUncacheable() { m_uncacheableCount++; }
+        /// Get the number of times `markUncacheable` has been called
+    Count getUncacheableCount() const { return m_uncacheableCount; }
+
+        /// Get the number of cached layouts
+    Count getCount() const { return m_results.Count(); }
+
+protected:
+    Dictionary<Key, TypeLayoutResult> m_results;
+    Count m_uncacheableCount = 0;
+};
+
     /// Helper type for building `struct` type layouts
 struct StructTypeLayoutBuilder
 {
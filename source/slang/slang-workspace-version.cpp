@@ -34,8 +34,11 @@ DocumentVersion* Workspace::openDoc(String path, String text)
     doc->setText(text.getUnownedSlice());
     doc->setPath(path);
     openedDocuments[path] = doc;
-    workspaceSearchPaths.Add(Path::getParentDirectory(path));
-    invalidate();
+    // Changing the search paths changes how every module is found
+    if (workspaceSearchPaths.Add(Path::getParentDirectory(path)) || !searchInWorkspace)
+        invalidate();
+    else
+        invalidateDocument(path);
     return doc.Ptr();
 }
 
@@ -63,13 +66,16 @@ void Workspace::changeDoc(const String& path, LanguageServerProtocol::Range rang
 void Workspace::changeDoc(DocumentVersion* doc, const String& newText)
 {
     doc->setText(newText);
-    invalidate();
+    invalidateDocument(doc->getPath());
 }
 
 void Workspace::closeDoc(const String& path)
 {
     openedDocuments.Remove(path);
-    invalidate();
+    if (searchInWorkspace)
+        invalidateDocument(path);
+    else
+        invalidate();
 }
 
 bool Workspace::updatePredefinedMacros(List<String> macros)
@@ -188,7 +194,22 @@ void Workspace::init(List<URI> rootDirURI, slang::IGlobalSession* globalSession)
     slangGlobalSession = globalSession;
 }
 
-void Workspace::invalidate() { currentVersion = nullptr; }
+void Workspace::invalidate()
+{
+    currentVersion = nullptr;
+    previousVersion = nullptr;
+    changedDocumentPaths.Clear();
+}
+
+void Workspace::invalidateDocument(const String& path)
+{
+    if (currentVersion)
+    {
+        previousVersion = currentVersion;
+        currentVersion = nullptr;
+    }
+    changedDocumentPaths.Add(path);
+}
 
 void WorkspaceVersion::parseDiagnostics(String compilerOutput)
 {
@@ -324,6 +345,7 @@ RefPtr<WorkspaceVersion> Workspace::createWorkspaceVersion()
     slangGlobalSession->createSession(desc, session.writeRef());
     version->linkage = static_cast<Linkage*>(session.get());
     version->linkage->contentAssistInfo.checkingMode = ContentAssistCheckingMode::General;
+    version->linkage->m_cancellationToken = cancellationToken;
     return version;
 }
 
@@ -339,10 +361,70 @@ SlangResult Workspace::loadFile(const char* path, ISlangBlob** outBlob)
     }
     return Slang::OSFileSystem::getExtSingleton()->loadFile(path, outBlob);
 }
+// The number of modules that can be unloaded from a linkage before starting over with a new
+// linkage. The unloaded modules are kept in memory until the linkage is destroyed.
+static const Count kMaxUnloadedModuleCount = 256;
+
+// Get the file names (without extensions) of the modules loaded by `linkage`, sorted
+static List<String> _getLoadedModuleFileNames(Linkage* linkage)
+{
+    List<String> names;
+    for (auto module : linkage->loadedModulesList)
+    {
+        // The first file dependency of a module is its own source file
+        auto& files = module->getFileDependencyList();
+        if (files.getCount())
+            names.add(Path::getFileNameWithoutExt(files[0]->getPathInfo().foundPath));
+    }
+    names.sort();
+    return names;
+}
+
+RefPtr<WorkspaceVersion> Workspace::createIncrementalWorkspaceVersion()
+{
+    RefPtr<Linkage> linkage = previousVersion->linkage;
+    if (linkage->getUnloadedModuleCount() >= kMaxUnloadedModuleCount)
+        return nullptr;
+
+    // Only the changed documents and the modules that depend on them need to be checked again.
+    List<String> previousModuleNames = _getLoadedModuleFileNames(linkage);
+    linkage->unloadModulesDependingOnFiles(changedDocumentPaths);
+    List<String> keptModuleNames = _getLoadedModuleFileNames(linkage);
+
+    StringBuilder description;
+    description << "Created a workspace version from the previous linkage, unloaded:";
+    for (auto& name : previousModuleNames)
+    {
+        if (keptModuleNames.indexOf(name) < 0)
+            description << " " << name;
+    }
+    description << "; kept:";
+    for (auto& name : keptModuleNames)
+        description << " " << name;
+    lastVersionDescription = description.ProduceString();
+
+    RefPtr<WorkspaceVersion> version = new WorkspaceVersion();
+    version->workspace = this;
+    version->linkage = linkage;
+    version->moduleDiagnosticOutputs = previousVersion->moduleDiagnosticOutputs;
+    return version;
+}
+
 WorkspaceVersion* Workspace::getCurrentVersion()
 {
     if (!currentVersion)
-        currentVersion = createWorkspaceVersion();
+    {
+        if (previousVersion)
+            currentVersion = createIncrementalWorkspaceVersion();
+        if (!currentVersion)
+        {
+            currentVersion = createWorkspaceVersion();
+            lastVersionDescription = "Created a workspace version with a new linkage";
+        }
+        previousVersion = nullptr;
+        changedDocumentPaths.Clear();
+        createdVersionCount++;
+    }
     return currentVersion.Ptr();
 }
 WorkspaceVersion* Workspace::createVersionForCompletion()
@@ -508,8 +590,22 @@ Module* WorkspaceVersion::getOrLoadModule(String path)
     auto sourceBlob = StringBlob::create((*doc)->getText());
 
     auto moduleName = getMangledNameFromNameString(path.getUnownedSlice());
-    linkage->contentAssistInfo.primaryModuleName = linkage->getNamePool()->getName(moduleName);
+    auto moduleNamePtr = linkage->getNamePool()->getName(moduleName);
+    linkage->contentAssistInfo.primaryModuleName = moduleNamePtr;
     linkage->contentAssistInfo.primaryModulePath = path;
+
+    // If a previous version loaded the module as the primary module, and none of the documents
+    // it depends on have changed since, it is still loaded in the linkage and fully checked.
+    RefPtr<Module> previousModule;
+    if (linkage->mapNameToLoadedModules.TryGetValue(moduleNamePtr, previousModule) && previousModule)
+    {
+        modules[path] = previousModule.Ptr();
+        String diagnosticString;
+        if (moduleDiagnosticOutputs.TryGetValue(path, diagnosticString))
+            reportDiagnostics(path, diagnosticString);
+        return previousModule.Ptr();
+    }
+
     // Note: 
     // The module at `path` may have already been loaded into the linkage previously
     // due to an `import`. However that module won't get fully checked in when the checker
@@ -523,21 +619,32 @@ Module* WorkspaceVersion::getOrLoadModule(String path)
         path.getBuffer(),
         sourceBlob,
         diagnosticBlob.writeRef());
+    // If checking was cancelled, the load was abandoned (the module isn't kept as loaded by
+    // the linkage) and its diagnostics are incomplete, so nothing is recorded for it.
+    if (!parsedModule && linkage->isCancellationRequested())
+        return nullptr;
     if (parsedModule)
     {
         modules[path] = static_cast<Module*>(parsedModule);
     }
+    moduleDiagnosticOutputs.Remove(path);
     if (diagnosticBlob)
     {
         auto diagnosticString = String((const char*)diagnosticBlob->getBufferPointer());
-        parseDiagnostics(diagnosticString);
-        auto docDiagnostic = diagnostics.TryGetValue(path);
-        if (docDiagnostic)
-            docDiagnostic->originalOutput = diagnosticString;
+        moduleDiagnosticOutputs[path] = diagnosticString;
+        reportDiagnostics(path, diagnosticString);
     }
     return static_cast<Module*>(parsedModule);
 }
 
+void WorkspaceVersion::reportDiagnostics(const String& path, const String& diagnosticString)
+{
+    parseDiagnostics(diagnosticString);
+    auto docDiagnostic = diagnostics.TryGetValue(path);
+    if (docDiagnostic)
+        docDiagnostic->originalOutput = diagnosticString;
+}
+
 MacroDefinitionContentAssistInfo* WorkspaceVersion::tryGetMacroDefinition(UnownedStringSlice name)
 {
     if (macroDefinitions.Count() == 0)
@@ -115,10 +115,14 @@ namespace Slang
         Dictionary<ModuleDecl*, RefPtr<ASTMarkup>> markupASTs;
         Dictionary<Name*, MacroDefinitionContentAssistInfo*> macroDefinitions;
         void parseDiagnostics(String compilerOutput);
+        void reportDiagnostics(const String& path, const String& diagnosticString);
     public:
         Workspace* workspace;
         RefPtr<Linkage> linkage;
         Dictionary<String, DocumentDiagnostics> diagnostics;
+        // The compiler output from loading each primary module, such that the diagnostics of a module
+        // that is reused by a later version can be reported again.
+        Dictionary<String, String> moduleDiagnosticOutputs;
         ASTMarkup* getOrCreateMarkupAST(ModuleDecl* module);
         Module* getOrLoadModule(String path);
         MacroDefinitionContentAssistInfo* tryGetMacroDefinition(UnownedStringSlice name);
@@ -136,13 +140,20 @@ namespace Slang
     private:
         RefPtr<WorkspaceVersion> currentVersion;
         RefPtr<WorkspaceVersion> currentCompletionVersion;
+        // The version the next version can be derived from, as only the contents of the documents in
+        // `changedDocumentPaths` have changed since it was created.
+        RefPtr<WorkspaceVersion> previousVersion;
+        HashSet<String> changedDocumentPaths;
         RefPtr<WorkspaceVersion> createWorkspaceVersion();
+        RefPtr<WorkspaceVersion> createIncrementalWorkspaceVersion();
     public:
         List<String> rootDirectories;
         List<String> additionalSearchPaths;
         OrderedHashSet<String> workspaceSearchPaths;
         List<OwnedPreprocessorMacroDefinition> predefinedMacros;
         bool searchInWorkspace = true;
+        // Set on the linkage of each version, such that checking can be cancelled
+        RefPtr<CancellationToken> cancellationToken;
 
         slang::IGlobalSession* slangGlobalSession;
         Dictionary<String, RefPtr<DocumentVersion>> openedDocuments;
@@ -158,8 +169,16 @@ namespace Slang
         bool updateSearchInWorkspace(bool value);
 
         void init(List<URI> rootDirURI, slang::IGlobalSession* globalSession);
+        // Invalidate the current version, such that the next version is created from scratch.
         void invalidate();
+        // Invalidate the current version because the contents of the document at `path` changed.
+        // The next version reuses the modules that don't depend on the document.
+        void invalidateDocument(const String& path);
         WorkspaceVersion* getCurrentVersion();
+        // The number of versions created by `getCurrentVersion`, and a description of how the last
+        // one was created (which modules were reused), for tracing.
+        Index createdVersionCount = 0;
+        String lastVersionDescription;
         WorkspaceVersion* getCurrentCompletionVersion() { return currentCompletionVersion.Ptr(); }
         WorkspaceVersion* createVersionForCompletion();
     public:
@@ -14,6 +14,7 @@
 #include "../compiler-core/slang-artifact-associated-impl.h"
 
 #include "slang-module-library.h"
+#include "slang-module-cache.h"
 
 #include "slang-check.h"
 #include "slang-parameter-binding.h"
@@ -391,6 +392,9 @@ SlangResult Session::saveStdLib(SlangArchiveType archiveType, ISlangBlob** outBl
         // Save with SourceLocation information
         options.optionFlags |= SerialOptionFlag::SourceLocation;
 
+        // Uncompressed IR arrays can be used in place when the stdlib is loaded
+        options.compressionType = SerialCompressionType::None;
+
         // TODO(JS): Should this be the Session::getBuiltinSourceManager()?
         options.sourceManager = m_builtinLinkage->getSourceManager();
 
@@ -418,18 +422,13 @@ SlangResult Session::_readBuiltinModule(ISlangFileSystem* fileSystem, Scope* sco
     StringBuilder moduleFilename;
     moduleFilename << moduleName << ".slang-module";
 
-    RiffContainer riffContainer;
-    {
-        // Load it
-        ComPtr<ISlangBlob> blob;
-        SLANG_RETURN_ON_FAIL(fileSystem->loadFile(moduleFilename.getBuffer(), blob.writeRef()));
-
-        // Set up a stream
-        MemoryStreamBase stream(FileAccess::Read, blob->getBufferPointer(), blob->getBufferSize());
+    // Load it
+    ComPtr<ISlangBlob> blob;
+    SLANG_RETURN_ON_FAIL(fileSystem->loadFile(moduleFilename.getBuffer(), blob.writeRef()));
 
-        // Load the riff container
-        SLANG_RETURN_ON_FAIL(RiffUtil::read(&stream, riffContainer));
-    }
+    // Load the riff container. The payloads reference the blob, rather than being copied.
+    RiffContainer riffContainer;
+    SLANG_RETURN_ON_FAIL(RiffUtil::readInPlace(blob->getBufferPointer(), blob->getBufferSize(), riffContainer));
 
     // Load up the module
 
@@ -452,6 +451,11 @@ SlangResult Session::_readBuiltinModule(ISlangFileSystem* fileSystem, Scope* sco
     // Hmm - don't have a suitable sink yet, so attempt to just not have one
     options.sink = nullptr;
 
+    // The IR of the stdlib is only needed when generating code, so create it on first use
+    options.readIRLazily = true;
+    // The lazily read IR can reference the blob directly
+    options.inPlaceBlob = blob;
+
     SLANG_RETURN_ON_FAIL(SerialContainerUtil::read(&riffContainer, options, containerData));
 
     for (auto& srcModule : containerData.modules)
@@ -472,7 +476,14 @@ SlangResult Session::_readBuiltinModule(ISlangFileSystem* fileSystem, Scope* sco
             module->setModuleDecl(moduleDecl);
         }
 
-        module->setIRModule(srcModule.irModule);
+        if (srcModule.irModuleFactory)
+        {
+            module->setIRModuleFactory(srcModule.irModuleFactory);
+        }
+        else
+        {
+            module->setIRModule(srcModule.irModule);
+        }
 
         // Put in the loaded module map
         linkage->mapNameToLoadedModules.Add(sessionNamePool->getName(moduleName), module);
@@ -581,6 +592,11 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Session::createSession(
         linkage->m_useFalcorCustomSharedKeywordSemantics = true;
     }
 
+    if (desc.flags & slang::kSessionFlag_EnablePerfTrace)
+    {
+        linkage->setPerfTraceEnabled(true);
+    }
+
     linkage->setMatrixLayoutMode(desc.defaultMatrixLayoutMode);
 
     Int searchPathCount = desc.searchPathCount;
@@ -600,6 +616,13 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Session::createSession(
     {
         linkage->setFileSystem(desc.fileSystem);
     }
+
+    // The module cache path was added to the end of the desc, so is only read if it's there
+    if (desc.structureSize >= SLANG_OFFSET_OF(slang::SessionDesc, moduleCachePath) + sizeof(desc.moduleCachePath) &&
+        desc.moduleCachePath)
+    {
+        linkage->setModuleCachePath(desc.moduleCachePath);
+    }
     *outSession = asExternal(linkage.detach());
     return SLANG_OK;
 }
@@ -677,6 +700,7 @@ SLANG_NO_THROW void SLANG_MCALL Session::setLanguagePrelude(
     if (sourceLanguage != SourceLanguage::Unknown)
     {
         m_languagePreludes[int(sourceLanguage)] = prelude;
+        m_hashGeneration++;
     }
 }
 
@@ -706,6 +730,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Session::setDefaultDownstreamCompiler(Sla
     if (DownstreamCompilerInfo::canCompile(defaultCompiler, sourceLanguage))
     {
         m_defaultDownstreamCompilers[int(sourceLanguage)] = PassThroughMode(defaultCompiler);
+        m_hashGeneration++;
         return SLANG_OK;
     }
     return SLANG_FAIL;
@@ -729,6 +754,7 @@ void Session::setDownstreamCompilerForTransition(SlangCompileTarget source, Slan
     {
         m_codeGenTransitionMap.addTransition(CodeGenTarget(source), CodeGenTarget(target), PassThroughMode(compiler));
     }
+    m_hashGeneration++;
 }
 
 SlangPassThrough Session::getDownstreamCompilerForTransition(SlangCompileTarget inSource, SlangCompileTarget inTarget)
@@ -901,6 +927,8 @@ Linkage::Linkage(Session* session, ASTBuilder* astBuilder, Linkage* builtinLinka
 
     m_defaultSourceManager.initialize(session->getBuiltinSourceManager(), nullptr);
 
+    m_includeTokenCache = new IncludeTokenCache;
+
     setFileSystem(nullptr);
 
     // Copy of the built in linkages modules
@@ -946,6 +974,7 @@ Linkage::~Linkage()
 
 TypeCheckingCache* Linkage::getTypeCheckingCache()
 {
+    SharedStateLock lock;
     if (!m_typeCheckingCache)
     {
         m_typeCheckingCache = new TypeCheckingCache();
@@ -1320,6 +1349,72 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Linkage::createCompileRequest(
     return SLANG_OK;
 }
 
+SLANG_NO_THROW SlangResult SLANG_MCALL Linkage::getPerfTrace(
+    SlangPerfTraceFormat    format,
+    ISlangBlob**            outBlob)
+{
+    return writePerfTrace(format, outBlob);
+}
+
+void Linkage::setPerfTraceEnabled(bool enable)
+{
+    if (!enable)
+    {
+        m_perfTrace.setNull();
+    }
+    else if (!m_perfTrace)
+    {
+        m_perfTrace = new PerfTrace;
+    }
+}
+
+void Linkage::setModuleCachePath(const String& path)
+{
+    if (path.getLength() == 0)
+    {
+        m_moduleCache.setNull();
+    }
+    else
+    {
+        PersistentCache::Desc desc;
+        desc.directory = path.getBuffer();
+        m_moduleCache = new PersistentCache(desc);
+    }
+}
+
+void Linkage::setDownstreamCachePath(const String& path)
+{
+    if (path.getLength() == 0)
+    {
+        m_downstreamCache.setNull();
+    }
+    else
+    {
+        PersistentCache::Desc desc;
+        desc.directory = path.getBuffer();
+        m_downstreamCache = new PersistentCache(desc);
+    }
+}
+
+SlangResult Linkage::writePerfTrace(SlangPerfTraceFormat format, ISlangBlob** outBlob)
+{
+    if (!m_perfTrace)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    StringBuilder buf;
+    switch (format)
+    {
+        case SLANG_PERF_TRACE_FORMAT_CHROME_JSON:   m_perfTrace->writeChromeTrace(buf); break;
+        case SLANG_PERF_TRACE_FORMAT_SUMMARY:       m_perfTrace->writeSummary(buf); break;
+        default: return SLANG_E_INVALID_ARG;
+    }
+
+    *outBlob = StringBlob::moveCreate(buf).detach();
+    return SLANG_OK;
+}
+
 void Linkage::buildHash(DigestBuilder<SHA1>& builder, SlangInt targetIndex)
 {
     // Add the Slang compiler version to the hash
@@ -1349,6 +1444,7 @@ void Linkage::buildHash(DigestBuilder<SHA1>& builder, SlangInt targetIndex)
     builder.append(targetReq->getFloatingPointMode());
     builder.append(targetReq->getLineDirectiveMode());
     builder.append(targetReq->getForceGLSLScalarBufferLayout());
+    builder.append(targetReq->getCPUSIMDLaneCount());
     builder.append(targetReq->getDefaultMatrixLayoutMode());
     builder.append(targetReq->shouldDumpIntermediates());
     builder.append(targetReq->shouldTrackLiveness());
@@ -1388,10 +1484,37 @@ void Linkage::buildHash(DigestBuilder<SHA1>& builder, SlangInt targetIndex)
     }
 }
 
+const SHA1::Digest& Linkage::getHash(SlangInt targetIndex)
+{
+    // The digest also covers options held by the target and the global session, which can be
+    // changed without the linkage knowing, so it is only used if none of them have changed since
+    TargetRequest* targetReq = targets[targetIndex];
+    const Count sessionGeneration = getSessionImpl()->getHashGeneration();
+
+    if (auto entry = m_hashForTarget.TryGetValue(targetIndex))
+    {
+        if (entry->targetGeneration == targetReq->getHashGeneration() &&
+            entry->sessionGeneration == sessionGeneration)
+        {
+            return entry->digest;
+        }
+    }
+
+    DigestBuilder<SHA1> builder;
+    buildHash(builder, targetIndex);
+
+    HashEntry& entry = m_hashForTarget[targetIndex];
+    entry.digest = builder.finalize();
+    entry.targetGeneration = targetReq->getHashGeneration();
+    entry.sessionGeneration = sessionGeneration;
+    return entry.digest;
+}
+
 SlangResult Linkage::addSearchPath(
     char const* path)
 {
     searchDirectories.searchDirectories.add(Slang::SearchDirectory(path));
+    invalidateHashes();
     return SLANG_OK;
 }
 
@@ -1400,6 +1523,7 @@ SlangResult Linkage::addPreprocessorDefine(
     char const* value)
 {
     preprocessorDefinitions[name] = value;
+    invalidateHashes();
     return SLANG_OK;
 }
 
@@ -1407,6 +1531,13 @@ SlangResult Linkage::setMatrixLayoutMode(
     SlangMatrixLayoutMode mode)
 {
     defaultMatrixLayoutMode = MatrixLayoutMode(mode);
+    invalidateHashes();
+
+    // The layout of the contents of parameter groups depends on the default mode
+    for (auto& target : targets)
+    {
+        target->invalidateTypeLayoutCache();
+    }
     return SLANG_OK;
 }
 
@@ -1434,6 +1565,7 @@ void TargetRequest::addCapability(CapabilityAtom capability)
 {
     rawCapabilities.add(capability);
     cookedCapabilities = CapabilitySet::makeEmpty();
+    hashGeneration++;
 }
 
 CapabilitySet TargetRequest::getTargetCaps()
@@ -1516,6 +1648,40 @@ CapabilitySet TargetRequest::getTargetCaps()
 }
 
 
+void TargetRequest::setTargetProfile(Slang::Profile profile)
+{
+    targetProfile = profile;
+    hashGeneration++;
+
+    // The layout of some types depends on the profile
+    invalidateTypeLayoutCache();
+}
+
+void TargetRequest::setForceGLSLScalarBufferLayout(bool value)
+{
+    forceGLSLScalarBufferLayout = value;
+    hashGeneration++;
+
+    // The rules used to lay out the contents of buffers depend on it
+    invalidateTypeLayoutCache();
+}
+
+void TargetRequest::invalidateTypeLayoutCache()
+{
+    SharedStateLock lock;
+    typeLayoutCache.setNull();
+}
+
+TypeLayoutCache* TargetRequest::getTypeLayoutCache()
+{
+    SharedStateLock lock;
+    if (!typeLayoutCache)
+    {
+        typeLayoutCache = new TypeLayoutCache;
+    }
+    return typeLayoutCache;
+}
+
 TypeLayout* TargetRequest::getTypeLayout(Type* type)
 {
     // TODO: We are not passing in a `ProgramLayout` here, although one
@@ -2325,7 +2491,10 @@ void FrontEndCompileRequest::checkAllTranslationUnits()
     // apply the semantic checking logic.
     for( auto& translationUnit : translationUnits )
     {
-        checkTranslationUnit(translationUnit.Ptr(), loadedModules);
+        {
+            PerfTraceScope perfScope(getLinkage()->getPerfTrace(), "frontend", "check");
+            checkTranslationUnit(translationUnit.Ptr(), loadedModules);
+        }
 
         // Add the checked module to list of loadedModules so that they can be
         // discovered by `findOrImportModule` when processing future `import` decls.
@@ -2358,7 +2527,12 @@ void FrontEndCompileRequest::generateIR()
         /// Generate IR for translation unit.
         /// TODO(JS): Use the linkage ASTBuilder, because it seems possible that cross module constructs are possible in
         /// ir lowering.
-        RefPtr<IRModule> irModule(generateIRForTranslationUnit(getLinkage()->getASTBuilder(), translationUnit));
+        RefPtr<IRModule> irModule;
+        {
+            PerfTraceScope perfScope(getLinkage()->getPerfTrace(), "frontend", "lowerToIR");
+            irModule = generateIRForTranslationUnit(getLinkage()->getASTBuilder(), translationUnit);
+            perfScope.setModule(irModule);
+        }
 
         if (verifyDebugSerialization)
         {
@@ -2452,6 +2626,7 @@ SlangResult FrontEndCompileRequest::executeActionsInner()
     // Parse everything from the input files requested
     for (TranslationUnitRequest* translationUnit : translationUnits)
     {
+        PerfTraceScope perfScope(getLinkage()->getPerfTrace(), "frontend", "parse");
         parseTranslationUnit(translationUnit);
     }
 
@@ -2525,6 +2700,7 @@ SlangResult FrontEndCompileRequest::executeActionsInner()
     //
     for(auto targetReq : getLinkage()->targets)
     {
+        PerfTraceScope perfScope(getLinkage()->getPerfTrace(), "frontend", "parameterBinding");
         auto targetProgram = m_globalAndEntryPointsComponentType->getTargetProgram(targetReq);
         targetProgram->getOrCreateLayout(getSink());
         targetProgram->getOrCreateIRModuleForLayout(getSink());
@@ -2712,7 +2888,14 @@ SlangResult EndToEndCompileRequest::executeActionsInner()
 // Act as expected of the API-based compiler
 SlangResult EndToEndCompileRequest::executeActions()
 {
-    SlangResult res = executeActionsInner();
+    // Options may have been changed directly on the linkage since the last compile
+    getLinkage()->invalidateHashes();
+
+    SlangResult res;
+    {
+        PerfTraceScope perfScope(getLinkage()->getPerfTrace(), "compile", "compile");
+        res = executeActionsInner();
+    }
 
     m_diagnosticOutput = getSink()->outputBuffer.ProduceString();
     return res;
@@ -2870,6 +3053,7 @@ UInt Linkage::addTarget(
 
     Index result = targets.getCount();
     targets.add(targetReq);
+    invalidateHashes();
     return (int) result;
 }
 
@@ -2895,7 +3079,21 @@ void Linkage::loadParsedModule(
     auto sink = translationUnit->compileRequest->getSink();
 
     int errorCountBefore = sink->getErrorCount();
-    compileRequest->checkAllTranslationUnits();
+    try
+    {
+        compileRequest->checkAllTranslationUnits();
+    }
+    catch (const AbortCompilationException&)
+    {
+        // The module is only partially checked (for example because checking was cancelled),
+        // so it must not be found by later imports. It is kept alive, as types cached on the
+        // linkage may reference it.
+        mapPathToLoadedModule.Remove(mostUniqueIdentity);
+        mapNameToLoadedModules.Remove(name);
+        m_unloadedModules.add(loadedModule);
+        destroyTypeCheckingCache();
+        throw;
+    }
     int errorCountAfter = sink->getErrorCount();
     if (isInLanguageServer())
     {
@@ -2916,8 +3114,10 @@ void Linkage::loadParsedModule(
             // IR code for the imported module.
             if (errorCountAfter == 0)
             {
+                PerfTraceScope perfScope(getPerfTrace(), "frontend", "lowerToIR");
                 loadedModule->setIRModule(
                     generateIRForTranslationUnit(getASTBuilder(), translationUnit));
+                perfScope.setModule(loadedModule->getIRModule());
             }
         }
     }
@@ -2958,7 +3158,80 @@ RefPtr<Module> Linkage::loadModule(
     DiagnosticSink*     sink,
     const LoadedModuleDictionary* additionalLoadedModules)
 {
-    RefPtr<FrontEndCompileRequest> frontEndReq = new FrontEndCompileRequest(this, nullptr, sink);
+    PerfTraceScope perfScope(getPerfTrace(), "frontend", "import");
+
+    // If this module is imported by a module whose diagnostics are being recorded for the module cache,
+    // drop whatever loading this module adds to the recording
+    struct ImportedDiagnosticsRAII
+    {
+        ImportedDiagnosticsRAII(DiagnosticSink* recorder, DiagnosticSink* sink):
+            m_recorder(recorder == sink ? recorder : nullptr),
+            m_length(m_recorder ? m_recorder->outputBuffer.getLength() : 0)
+        {
+        }
+        ~ImportedDiagnosticsRAII()
+        {
+            if (m_recorder)
+            {
+                m_recorder->outputBuffer.reduceLength(m_length);
+            }
+        }
+        DiagnosticSink* m_recorder;
+        Index m_length;
+    };
+    ImportedDiagnosticsRAII importedDiagnostics(m_moduleDiagnosticsRecorder, sink);
+
+    // If there is a module cache, see if the module has already been checked (and lowered to IR)
+    // with the same source, dependencies and options. Modules loaded for the language server
+    // or with additional loaded modules are always compiled.
+    const bool useModuleCache = m_moduleCache &&
+        sourceBlob &&
+        filePathInfo.hasUniqueIdentity() &&
+        !isInLanguageServer() &&
+        !(additionalLoadedModules && additionalLoadedModules->Count());
+
+    PersistentCache::Key moduleCacheKey;
+    if (useModuleCache)
+    {
+        PerfTraceScope cacheScope(getPerfTrace(), "frontend", "readModuleCache");
+
+        moduleCacheKey = ModuleCacheUtil::calcKey(this, name, filePathInfo, sourceBlob, sink);
+
+        const int errorCountBefore = sink->getErrorCount();
+        RefPtr<Module> cachedModule;
+        if (SLANG_SUCCEEDED(ModuleCacheUtil::readModule(this, moduleCacheKey, filePathInfo, sourceBlob, sink, cachedModule)))
+        {
+            mapPathToLoadedModule.Add(filePathInfo.getMostUniqueIdentity(), cachedModule);
+            mapNameToLoadedModules.Add(name, cachedModule);
+            loadedModulesList.add(cachedModule);
+            return cachedModule;
+        }
+        if (sink->getErrorCount() != errorCountBefore)
+        {
+            // Loading a module the cached module imports failed
+            _diagnoseErrorInImportedModule(sink);
+            return nullptr;
+        }
+    }
+
+    // When the module will be cached, its diagnostics are recorded (as well as output to sink),
+    // so they can be output when the module is read from the cache
+    DiagnosticSink recorder;
+    DiagnosticSink* const prevRecorder = m_moduleDiagnosticsRecorder;
+    if (useModuleCache)
+    {
+        recorder.initFrom(*sink);
+        recorder.setParentSink(sink);
+        m_moduleDiagnosticsRecorder = &recorder;
+    }
+    struct RestoreRecorderRAII
+    {
+        ~RestoreRecorderRAII() { *m_dst = m_value; }
+        DiagnosticSink** m_dst;
+        DiagnosticSink* m_value;
+    } restoreRecorder = { &m_moduleDiagnosticsRecorder, prevRecorder };
+
+    RefPtr<FrontEndCompileRequest> frontEndReq = new FrontEndCompileRequest(this, nullptr, useModuleCache ? &recorder : sink);
 
     frontEndReq->additionalLoadedModules = additionalLoadedModules;
 
@@ -3007,7 +3280,10 @@ RefPtr<Module> Linkage::loadModule(
     }
 
     int errorCountBefore = sink->getErrorCount();
-    frontEndReq->parseTranslationUnit(translationUnit);
+    {
+        PerfTraceScope parseScope(getPerfTrace(), "frontend", "parse");
+        frontEndReq->parseTranslationUnit(translationUnit);
+    }
     int errorCountAfter = sink->getErrorCount();
 
     if (errorCountAfter != errorCountBefore && !isInLanguageServer())
@@ -3035,6 +3311,14 @@ RefPtr<Module> Linkage::loadModule(
         return nullptr;
     }
 
+    if (useModuleCache && module->getIRModule())
+    {
+        PerfTraceScope cacheScope(getPerfTrace(), "frontend", "writeModuleCache");
+
+        // Failing to cache the module isn't an error, it just means it will be compiled next time
+        ModuleCacheUtil::writeModule(this, moduleCacheKey, filePathInfo, module, recorder.outputBuffer.ProduceString());
+    }
+
     return module;
 }
 
@@ -3156,6 +3440,131 @@ RefPtr<Module> Linkage::findOrImportModule(
         loadedModules);
 }
 
+template <typename T>
+static void _removeContentAssistInfoInFiles(SourceManager* sourceManager, const HashSet<SourceFile*>& files, List<T>& ioInfos)
+{
+    Index count = 0;
+    for (Index i = 0; i < ioInfos.getCount(); ++i)
+    {
+        SourceView* sourceView = sourceManager->findSourceViewRecursively(ioInfos[i].loc);
+        if (sourceView && files.Contains(sourceView->getSourceFile()))
+        {
+            continue;
+        }
+        if (count != i)
+        {
+            ioInfos[count] = _Move(ioInfos[i]);
+        }
+        count++;
+    }
+    ioInfos.setCount(count);
+}
+
+void Linkage::unloadModulesDependingOnFiles(const HashSet<String>& paths)
+{
+    // The file dependency list of a module includes the files of all the modules it imports,
+    // so a module that (directly or indirectly) imports a changed module is unloaded too.
+    HashSet<LoadedModule*> unloadModules;
+    HashSet<SourceFile*> unloadFiles;
+    for (LoadedModule* module : loadedModulesList)
+    {
+        bool isAffected = false;
+        for (SourceFile* sourceFile : module->getFileDependencyList())
+        {
+            const PathInfo& pathInfo = sourceFile->getPathInfo();
+            if (paths.Contains(pathInfo.uniqueIdentity) || paths.Contains(pathInfo.foundPath))
+            {
+                isAffected = true;
+                break;
+            }
+        }
+        if (!isAffected)
+        {
+            continue;
+        }
+
+        unloadModules.Add(module);
+        for (SourceFile* sourceFile : module->getFileDependencyList())
+        {
+            unloadFiles.Add(sourceFile);
+        }
+    }
+
+    // Remove the unloaded modules, and prior failed loads
+    {
+        List<Name*> names;
+        for (const auto& pair : mapNameToLoadedModules)
+        {
+            if (!pair.Value || unloadModules.Contains(pair.Value))
+            {
+                names.add(pair.Key);
+            }
+        }
+        for (Name* name : names)
+        {
+            mapNameToLoadedModules.Remove(name);
+        }
+
+        List<String> identities;
+        for (const auto& pair : mapPathToLoadedModule)
+        {
+            if (!pair.Value || unloadModules.Contains(pair.Value))
+            {
+                identities.add(pair.Key);
+            }
+        }
+        for (const auto& identity : identities)
+        {
+            mapPathToLoadedModule.Remove(identity);
+        }
+
+        Index count = 0;
+        for (Index i = 0; i < loadedModulesList.getCount(); ++i)
+        {
+            RefPtr<LoadedModule>& module = loadedModulesList[i];
+            if (unloadModules.Contains(module))
+            {
+                m_unloadedModules.add(module);
+            }
+            else
+            {
+                loadedModulesList[count++] = module;
+            }
+        }
+        loadedModulesList.setCount(count);
+    }
+
+    // Make sure the changed files are read again
+    for (SourceFile* sourceFile : unloadFiles)
+    {
+        const PathInfo& pathInfo = sourceFile->getPathInfo();
+        if (paths.Contains(pathInfo.uniqueIdentity) || paths.Contains(pathInfo.foundPath))
+        {
+            m_sourceManager->unmapSourceFile(pathInfo.uniqueIdentity);
+        }
+    }
+    for (const auto& path : paths)
+    {
+        m_sourceManager->unmapSourceFile(path);
+    }
+    if (m_fileSystemExt)
+    {
+        m_fileSystemExt->clearCache();
+    }
+
+    // The files of the unloaded modules will be preprocessed again when the modules are
+    // loaded, so remove what was found when they were last preprocessed
+    {
+        auto& preprocessorInfo = contentAssistInfo.preprocessorInfo;
+        _removeContentAssistInfoInFiles(m_sourceManager, unloadFiles, preprocessorInfo.macroDefinitions);
+        _removeContentAssistInfoInFiles(m_sourceManager, unloadFiles, preprocessorInfo.macroInvocations);
+        _removeContentAssistInfoInFiles(m_sourceManager, unloadFiles, preprocessorInfo.fileIncludes);
+    }
+
+    // Cached checking results may refer to declarations in the unloaded modules
+    destroyTypeCheckingCache();
+}
+
 //
 // ModuleDependencyList
 //
@@ -3235,6 +3644,22 @@ Module::Module(Linkage* linkage, ASTBuilder* astBuilder)
     addModuleDependency(this);
 }
 
+IRModule* Module::getIRModule()
+{
+    // Once the call has completed on any thread, m_irModule is visible to all threads that pass
+    // through call_once, so only creation needs the (internal) lock
+    std::call_once(m_irModuleOnceFlag, [this]()
+    {
+        if (!m_irModule && m_irModuleFactory)
+        {
+            m_irModule = m_irModuleFactory->createIRModule();
+        }
+        // Only attempt creation once
+        m_irModuleFactory.setNull();
+    });
+    return m_irModule;
+}
+
 ISlangUnknown* Module::getInterface(const Guid& guid)
 {
     if(guid == IModule::getTypeGuid())
@@ -3458,14 +3883,12 @@ SLANG_NO_THROW void SLANG_MCALL ComponentType::getEntryPointHash(
     // the compiler, part of hashing the linkage is hashing in the compiler version.
     // Consequently, any encoding differences as a result of different compiler versions
     // will already be reflected in the resulting hash.
-    getLinkage()->buildHash(builder, targetIndex);
+    builder.append(getLinkage()->getHash(targetIndex));
 
     // Enumerate all file dependencies and add them to the hash.
     for (SourceFile* sourceFile : getFileDependencies())
     {
-        // TODO: We want to lazily evaluate & cache the source file digest
-        SHA1::Digest digest = SHA1::compute(sourceFile->getContent().begin(), sourceFile->getContent().getLength());
-        builder.append(digest);
+        builder.append(sourceFile->getContentDigest());
     }
 
     buildHash(builder);
@@ -4406,6 +4829,7 @@ TargetProgram::TargetProgram(
     , m_targetReq(targetReq)
 {
     m_entryPointResults.setCount(componentType->getEntryPointCount());
+    m_specializationCache = new IRSpecializationCache(componentType->getLinkage()->getSessionImpl());
 }
 
 //
@@ -4661,6 +5085,11 @@ void EndToEndCompileRequest::setTargetForceGLSLScalarBufferLayout(int targetInde
     getLinkage()->targets[targetIndex]->setForceGLSLScalarBufferLayout(value);
 }
 
+void EndToEndCompileRequest::setTargetCPUSIMDLaneCount(int targetIndex, int laneCount)
+{
+    getLinkage()->targets[targetIndex]->setCPUSIMDLaneCount((laneCount < 0) ? 0 : Count(laneCount));
+}
+
 void EndToEndCompileRequest::setTargetFloatingPointMode(int targetIndex, SlangFloatingPointMode  mode)
 {
     getLinkage()->targets[targetIndex]->setFloatingPointMode(FloatingPointMode(mode));
@@ -4742,6 +5171,31 @@ void EndToEndCompileRequest::setDebugInfoFormat(SlangDebugInfoFormat format)
     getLinkage()->debugInfoFormat = DebugInfoFormat(format);
 }
 
+void EndToEndCompileRequest::setPerfTraceEnabled(bool enable)
+{
+    getLinkage()->setPerfTraceEnabled(enable);
+}
+
+SlangResult EndToEndCompileRequest::getPerfTrace(SlangPerfTraceFormat format, ISlangBlob** outBlob)
+{
+    return getLinkage()->writePerfTrace(format, outBlob);
+}
+
+void EndToEndCompileRequest::setCodeGenThreadCount(int threadCount)
+{
+    getLinkage()->m_codeGenThreadCount = (threadCount < 0) ? 1 : Count(threadCount);
+}
+
+void EndToEndCompileRequest::setModuleCachePath(const char* path)
+{
+    getLinkage()->setModuleCachePath(path ? String(path) : String());
+}
+
+void EndToEndCompileRequest::setDownstreamCachePath(const char* path)
+{
+    getLinkage()->setDownstreamCachePath(path ? String(path) : String());
+}
+
 void EndToEndCompileRequest::setOptimizationLevel(SlangOptimizationLevel level)
 {
     getLinkage()->optimizationLevel = OptimizationLevel(level);
@@ -5055,6 +5509,27 @@ SlangResult EndToEndCompileRequest::EndToEndCompileRequest::compile()
         }
     }
 
+    // Performance trace output
+    if (auto perfTrace = getLinkage()->getPerfTrace())
+    {
+        if (m_reportPerf)
+        {
+            StringBuilder buf;
+            perfTrace->writeSummary(buf);
+            getWriter(WriterChannel::StdError)->write(buf.getBuffer(), buf.getLength());
+        }
+
+        if (m_perfTraceFilePath.getLength())
+        {
+            StringBuilder buf;
+            perfTrace->writeChromeTrace(buf);
+            if (SLANG_FAILED(File::writeAllText(m_perfTraceFilePath, buf)))
+            {
+                getSink()->diagnose(SourceLoc(), Diagnostics::unableToWriteFile, m_perfTraceFilePath);
+            }
+        }
+    }
+
     return res;
 }
 
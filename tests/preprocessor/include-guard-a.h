@@ -0,0 +1,11 @@
+// include-guard-a.h
+
+// A header with a classic include guard, which defines a function
+// that would be an error to define twice.
+
+#ifndef INCLUDE_GUARD_A_H
+#define INCLUDE_GUARD_A_H
+
+float guardedA(float x) { return x; }
+
+#endif // INCLUDE_GUARD_A_H
@@ -0,0 +1,10 @@
+// include-guard-b.h
+
+// A header with an include guard using `#if !defined`, which defines a macro
+
+#if !defined(INCLUDE_GUARD_B_H)
+#define INCLUDE_GUARD_B_H
+
+#define GUARDED_B(x) (x * 2.0)
+
+#endif
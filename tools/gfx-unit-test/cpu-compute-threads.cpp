@@ -0,0 +1,131 @@
+#include "tools/unit-test/slang-unit-test.h"
+
+#include "slang-gfx.h"
+#include "gfx-test-util.h"
+#include "tools/gfx-util/shader-cursor.h"
+#include "source/core/slang-basic.h"
+
+using namespace gfx;
+
+namespace gfx_test
+{
+    // The dispatch is 8x4 groups of 8x1 threads, writing one value per thread
+    static const uint32_t kGroupCountX = 8;
+    static const uint32_t kGroupCountY = 4;
+    static const uint32_t kThreadCountX = 8;
+    static const uint32_t kValueCount = kGroupCountX * kThreadCountX * kGroupCountY;
+
+    // Run the dispatch on `device`, and read back the values it wrote
+    static ComPtr<ISlangBlob> _runCPUComputeThreads(IDevice* device)
+    {
+        Slang::ComPtr<ITransientResourceHeap> transientHeap;
+        ITransientResourceHeap::Desc transientHeapDesc = {};
+        transientHeapDesc.constantBufferSize = 4096;
+        GFX_CHECK_CALL_ABORT(
+            device->createTransientResourceHeap(transientHeapDesc, transientHeap.writeRef()));
+
+        ComPtr<IShaderProgram> shaderProgram;
+        slang::ProgramLayout* slangReflection;
+        GFX_CHECK_CALL_ABORT(loadComputeProgram(device, shaderProgram, "cpu-compute-threads", "computeMain", slangReflection));
+
+        ComputePipelineStateDesc pipelineDesc = {};
+        pipelineDesc.program = shaderProgram.get();
+        ComPtr<gfx::IPipelineState> pipelineState;
+        GFX_CHECK_CALL_ABORT(
+            device->createComputePipelineState(pipelineDesc, pipelineState.writeRef()));
+
+        uint32_t initialData[kValueCount] = {};
+        IBufferResource::Desc bufferDesc = {};
+        bufferDesc.sizeInBytes = sizeof(initialData);
+        bufferDesc.format = gfx::Format::Unknown;
+        bufferDesc.elementSize = sizeof(uint32_t);
+        bufferDesc.allowedStates = ResourceStateSet(
+            ResourceState::ShaderResource,
+            ResourceState::UnorderedAccess,
+            ResourceState::CopyDestination,
+            ResourceState::CopySource);
+        bufferDesc.defaultState = ResourceState::UnorderedAccess;
+        bufferDesc.memoryType = MemoryType::DeviceLocal;
+
+        ComPtr<IBufferResource> valuesBuffer;
+        GFX_CHECK_CALL_ABORT(device->createBufferResource(
+            bufferDesc,
+            (void*)initialData,
+            valuesBuffer.writeRef()));
+
+        ComPtr<IResourceView> bufferView;
+        IResourceView::Desc viewDesc = {};
+        viewDesc.type = IResourceView::Type::UnorderedAccess;
+        viewDesc.format = Format::Unknown;
+        GFX_CHECK_CALL_ABORT(
+            device->createBufferView(valuesBuffer, nullptr, viewDesc, bufferView.writeRef()));
+
+        {
+            ICommandQueue::Desc queueDesc = { ICommandQueue::QueueType::Graphics };
+            auto queue = device->createCommandQueue(queueDesc);
+
+            auto commandBuffer = transientHeap->createCommandBuffer();
+            auto encoder = commandBuffer->encodeComputeCommands();
+
+            auto rootObject = encoder->bindPipeline(pipelineState);
+
+            ShaderCursor entryPointCursor(rootObject->getEntryPoint(0));
+            entryPointCursor.getPath("buffer").setResource(bufferView);
+
+            encoder->dispatchCompute(kGroupCountX, kGroupCountY, 1);
+            encoder->endEncoding();
+            commandBuffer->close();
+            queue->executeCommandBuffer(commandBuffer);
+            queue->waitOnHost();
+        }
+
+        ComPtr<ISlangBlob> resultBlob;
+        GFX_CHECK_CALL_ABORT(device->readBufferResource(
+            valuesBuffer, 0, sizeof(initialData), resultBlob.writeRef()));
+        SLANG_CHECK_ABORT(resultBlob->getBufferSize() == sizeof(initialData));
+        return resultBlob;
+    }
+
+    // Check that a dispatch whose groups are run on several threads writes the same values as
+    // one run on a single thread.
+    SLANG_UNIT_TEST(cpuComputeThreads)
+    {
+        if ((Slang::RenderApiFlag::CPU & unitTestContext->enabledApis) == 0)
+        {
+            SLANG_IGNORE_TEST
+        }
+
+        // A single threaded device, which is the default
+        auto singleThreadDevice = createTestingDevice(unitTestContext, Slang::RenderApiFlag::CPU);
+        if (!singleThreadDevice)
+        {
+            SLANG_IGNORE_TEST
+        }
+        auto expectedBlob = _runCPUComputeThreads(singleThreadDevice);
+
+        // Every value is written with the IDs of the thread that wrote it
+        const uint32_t* expectedValues = (const uint32_t*)expectedBlob->getBufferPointer();
+        for (uint32_t y = 0; y < kGroupCountY; ++y)
+        {
+            for (uint32_t x = 0; x < kGroupCountX * kThreadCountX; ++x)
+            {
+                const uint32_t expected = x * 7 + y * 1000 + (x / kThreadCountX) * 100000;
+                SLANG_CHECK(expectedValues[y * kGroupCountX * kThreadCountX + x] == expected);
+            }
+        }
+
+        // With a fixed number of threads, and with as many threads as there are hardware threads
+        const GfxCount computeThreadCounts[] = { 4, 0 };
+        for (auto computeThreadCount : computeThreadCounts)
+        {
+            CPUDeviceExtendedDesc cpuDesc;
+            cpuDesc.computeThreadCount = computeThreadCount;
+            auto device = createTestingDevice(unitTestContext, Slang::RenderApiFlag::CPU, {}, {}, { &cpuDesc });
+            SLANG_CHECK_ABORT(device);
+
+            auto resultBlob = _runCPUComputeThreads(device);
+            SLANG_CHECK(::memcmp(resultBlob->getBufferPointer(), expectedBlob->getBufferPointer(), expectedBlob->getBufferSize()) == 0);
+        }
+    }
+
+}
@@ -195,7 +195,8 @@ namespace gfx_test
         UnitTestContext* context,
         Slang::RenderApiFlag::Enum api,
         Slang::List<const char*> additionalSearchPaths,
-        gfx::IDevice::ShaderCacheDesc shaderCache)
+        gfx::IDevice::ShaderCacheDesc shaderCache,
+        Slang::List<void*> additionalExtendedDescs)
     {
         Slang::ComPtr<gfx::IDevice> device;
         gfx::IDevice::Desc deviceDesc = {};
@@ -235,9 +236,11 @@ namespace gfx_test
         gfx::D3D12DeviceExtendedDesc extDesc = {};
         extDesc.rootParameterShaderAttributeName = "root";
 
-        deviceDesc.extendedDescCount = 1;
-        void* extDescPtr = &extDesc;
-        deviceDesc.extendedDescs = &extDescPtr;
+        Slang::List<void*> extDescPtrs;
+        extDescPtrs.add(&extDesc);
+        extDescPtrs.addRange(additionalExtendedDescs);
+        deviceDesc.extendedDescCount = (gfx::GfxCount)extDescPtrs.getCount();
+        deviceDesc.extendedDescs = extDescPtrs.getBuffer();
 
         auto createDeviceResult = gfxCreateDevice(&deviceDesc, device.writeRef());
         if (SLANG_FAILED(createDeviceResult))
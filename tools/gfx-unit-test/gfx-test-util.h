@@ -78,7 +78,8 @@ namespace gfx_test
         UnitTestContext* context,
         Slang::RenderApiFlag::Enum api,
         Slang::List<const char*> additionalSearchPaths = {},
-        gfx::IDevice::ShaderCacheDesc shaderCache = {});
+        gfx::IDevice::ShaderCacheDesc shaderCache = {},
+        Slang::List<void*> additionalExtendedDescs = {});
 
     void initializeRenderDoc();
     void renderDocBeginFrame();
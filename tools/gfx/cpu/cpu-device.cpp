@@ -21,6 +21,14 @@ namespace cpu
     {
         m_currentPipeline = nullptr;
         m_currentRootObject = nullptr;
+        m_threadPool = nullptr;
+    }
+
+    // Split extent into at most maxChunkCount chunks. Returns the size of a chunk.
+    static uint32_t _calcChunkSize(uint32_t extent, uint32_t maxChunkCount)
+    {
+        const uint32_t chunkCount = (extent < maxChunkCount) ? extent : maxChunkCount;
+        return (extent + chunkCount - 1) / chunkCount;
     }
 
     SLANG_NO_THROW Result SLANG_MCALL DeviceImpl::initialize(const Desc& desc)
@@ -33,6 +41,31 @@ namespace cpu
 
         SLANG_RETURN_ON_FAIL(RendererBase::initialize(desc));
 
+        // Dispatches run on a single thread, unless a thread count is set via the extended desc
+        m_extendedDesc.computeThreadCount = 1;
+        for (GfxIndex i = 0; i < desc.extendedDescCount; i++)
+        {
+            StructType stype;
+            memcpy(&stype, desc.extendedDescs[i], sizeof(stype));
+            switch (stype)
+            {
+            case StructType::CPUDeviceExtendedDesc:
+                memcpy(&m_extendedDesc, desc.extendedDescs[i], sizeof(m_extendedDesc));
+                break;
+            default:
+                break;
+            }
+        }
+
+        if (m_extendedDesc.computeThreadCount != 1)
+        {
+            m_threadPool = new ThreadPool(m_extendedDesc.computeThreadCount);
+            if (m_threadPool->getThreadCount() <= 1)
+            {
+                m_threadPool.setNull();
+            }
+        }
+
         // Initialize DeviceInfo
         {
             m_info.deviceType = DeviceType::CPU;
@@ -263,17 +296,69 @@ namespace cpu
 
         auto func = (slang_prelude::ComputeFunc)sharedLibrary->findSymbolAddressByName(entryPointName);
 
-        slang_prelude::ComputeVaryingInput varyingInput;
-        varyingInput.startGroupID.x = 0;
-        varyingInput.startGroupID.y = 0;
-        varyingInput.startGroupID.z = 0;
-        varyingInput.endGroupID.x = x;
-        varyingInput.endGroupID.y = y;
-        varyingInput.endGroupID.z = z;
-
         auto globalParamsData = m_currentRootObject->getDataBuffer();
         auto entryPointParamsData = entryPointObject->getDataBuffer();
-        func(&varyingInput, entryPointParamsData, globalParamsData);
+
+        if (!m_threadPool || Int(x) * Int(y) * Int(z) <= 1)
+        {
+            slang_prelude::ComputeVaryingInput varyingInput;
+            varyingInput.startGroupID.x = 0;
+            varyingInput.startGroupID.y = 0;
+            varyingInput.startGroupID.z = 0;
+            varyingInput.endGroupID.x = x;
+            varyingInput.endGroupID.y = y;
+            varyingInput.endGroupID.z = z;
+
+            func(&varyingInput, entryPointParamsData, globalParamsData);
+            return;
+        }
+
+        // The generated function runs the groups in a box [startGroupID, endGroupID), so the
+        // grid is split into boxes. Split z, then y, then x, so each chunk runs whole rows
+        // where possible. Using several chunks per thread balances groups that take different
+        // amounts of time.
+        const uint32_t extent[3] = { uint32_t(x), uint32_t(y), uint32_t(z) };
+        uint32_t chunkSize[3];
+        uint32_t chunkCount[3];
+
+        uint32_t remainingChunkCount = uint32_t(m_threadPool->getThreadCount() * 4);
+        for (Index i = 2; i >= 0; --i)
+        {
+            chunkSize[i] = _calcChunkSize(extent[i], remainingChunkCount);
+            chunkCount[i] = (extent[i] + chunkSize[i] - 1) / chunkSize[i];
+            remainingChunkCount = (remainingChunkCount + chunkCount[i] - 1) / chunkCount[i];
+        }
+
+        const Count taskCount = Count(chunkCount[0]) * chunkCount[1] * chunkCount[2];
+
+        m_threadPool->run(taskCount, [&](Index taskIndex)
+            {
+                const uint32_t chunkIndex[3] =
+                {
+                    uint32_t(taskIndex % chunkCount[0]),
+                    uint32_t((taskIndex / chunkCount[0]) % chunkCount[1]),
+                    uint32_t(taskIndex / (Index(chunkCount[0]) * chunkCount[1])),
+                };
+
+                uint32_t start[3];
+                uint32_t end[3];
+                for (Index i = 0; i < 3; ++i)
+                {
+                    start[i] = chunkIndex[i] * chunkSize[i];
+                    end[i] = start[i] + chunkSize[i];
+                    end[i] = (end[i] > extent[i]) ? extent[i] : end[i];
+                }
+
+                slang_prelude::ComputeVaryingInput varyingInput;
+                varyingInput.startGroupID.x = start[0];
+                varyingInput.startGroupID.y = start[1];
+                varyingInput.startGroupID.z = start[2];
+                varyingInput.endGroupID.x = end[0];
+                varyingInput.endGroupID.y = end[1];
+                varyingInput.endGroupID.z = end[2];
+
+                func(&varyingInput, entryPointParamsData, globalParamsData);
+            });
     }
 
     void DeviceImpl::copyBuffer(
@@ -4,6 +4,7 @@
 
 #include "cpu-pipeline-state.h"
 #include "cpu-shader-object.h"
+#include "cpu-thread-pool.h"
 
 namespace gfx
 {
@@ -80,6 +81,10 @@ private:
     RefPtr<RootShaderObjectImpl> m_currentRootObject = nullptr;
     DeviceInfo m_info;
 
+    CPUDeviceExtendedDesc m_extendedDesc;
+        /// Runs the groups of a dispatch. Only created if more than one thread is used.
+    RefPtr<ThreadPool> m_threadPool;
+
     virtual void setPipelineState(IPipelineState* state) override;
 
     virtual void bindRootShaderObject(IShaderObject* object) override;
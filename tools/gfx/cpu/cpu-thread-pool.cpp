@@ -0,0 +1,115 @@
+// cpu-thread-pool.cpp
+#include "cpu-thread-pool.h"
+
+namespace gfx
+{
+using namespace Slang;
+
+namespace cpu
+{
+
+ThreadPool::ThreadPool(Count threadCount) :
+    m_nextTaskIndex(0)
+{
+    if (threadCount <= 0)
+    {
+        threadCount = Count(std::thread::hardware_concurrency());
+    }
+
+    // The calling thread runs tasks too, so one less thread is needed
+    for (Index i = 1; i < threadCount; ++i)
+    {
+        m_threads.add(std::thread([this]() { _workerThread(); }));
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isQuitting = true;
+    }
+    m_startCondition.notify_all();
+
+    for (auto& thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+void ThreadPool::_runTasks(const TaskFunc& func, Count taskCount)
+{
+    for (;;)
+    {
+        const Index taskIndex = m_nextTaskIndex++;
+        if (taskIndex >= taskCount)
+        {
+            break;
+        }
+        func(taskIndex);
+    }
+}
+
+void ThreadPool::_workerThread()
+{
+    uint64_t runIndex = 0;
+    for (;;)
+    {
+        const TaskFunc* func;
+        Count taskCount;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_startCondition.wait(lock, [&]() { return m_isQuitting || m_runIndex != runIndex; });
+            if (m_isQuitting)
+            {
+                return;
+            }
+            runIndex = m_runIndex;
+            func = m_func;
+            taskCount = m_taskCount;
+        }
+
+        _runTasks(*func, taskCount);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (--m_busyWorkerCount == 0)
+            {
+                m_finishedCondition.notify_one();
+            }
+        }
+    }
+}
+
+void ThreadPool::run(Count taskCount, const TaskFunc& func)
+{
+    // Not worth waking the workers
+    if (m_threads.getCount() == 0 || taskCount <= 1)
+    {
+        for (Index i = 0; i < taskCount; ++i)
+        {
+            func(i);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_func = &func;
+        m_taskCount = taskCount;
+        m_busyWorkerCount = m_threads.getCount();
+        m_nextTaskIndex = 0;
+        m_runIndex++;
+    }
+    m_startCondition.notify_all();
+
+    _runTasks(func, taskCount);
+
+    // Wait for the workers, as they may still be running tasks
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_finishedCondition.wait(lock, [this]() { return m_busyWorkerCount == 0; });
+    m_func = nullptr;
+}
+
+} // namespace cpu
+} // namespace gfx
@@ -0,0 +1,60 @@
+// cpu-thread-pool.h
+#pragma once
+#include "cpu-base.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace gfx
+{
+using namespace Slang;
+
+namespace cpu
+{
+
+/* A set of worker threads used to run the groups of a compute dispatch concurrently.
+
+The threads are created once and wait between dispatches. The tasks of a run are taken in order
+from a shared counter by whichever thread is free, so threads that finish early take on the
+remaining work. The calling thread also runs tasks, so a pool of N threads creates N - 1
+additional threads. */
+class ThreadPool : public RefObject
+{
+public:
+    typedef std::function<void(Index taskIndex)> TaskFunc;
+
+        /// Run func for each task index in [0, taskCount). Returns once all tasks are complete.
+        /// Must not be called concurrently or from within a task.
+    void run(Count taskCount, const TaskFunc& func);
+
+        /// The number of threads that run tasks, including the calling thread
+    Count getThreadCount() const { return m_threads.getCount() + 1; }
+
+        /// threadCount of 0 uses as many threads as there are hardware threads
+    ThreadPool(Count threadCount);
+    ~ThreadPool();
+
+protected:
+    void _runTasks(const TaskFunc& func, Count taskCount);
+    void _workerThread();
+
+    std::mutex m_mutex;
+    std::condition_variable m_startCondition;       ///< Signalled when a run starts, or the pool is destroyed
+    std::condition_variable m_finishedCondition;    ///< Signalled when the last worker finishes a run
+
+    uint64_t m_runIndex = 0;                        ///< Incremented for each run, so workers can detect a new run
+    const TaskFunc* m_func = nullptr;
+    Count m_taskCount = 0;
+    Count m_busyWorkerCount = 0;
+    bool m_isQuitting = false;
+
+    std::atomic<Index> m_nextTaskIndex;
+
+    List<std::thread> m_threads;
+};
+
+} // namespace cpu
+} // namespace gfx
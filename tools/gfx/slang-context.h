@@ -44,6 +44,8 @@ namespace gfx
             slangSessionDesc.targets = &targetDesc;
             slangSessionDesc.targetCount = 1;
 
+            slangSessionDesc.moduleCachePath = desc.moduleCachePath;
+
             SLANG_RETURN_ON_FAIL(globalSession->createSession(slangSessionDesc, session.writeRef()));
             return SLANG_OK;
         }
@@ -145,6 +145,14 @@ static gfx::DeviceType _toRenderType(Slang::RenderApiType apiType)
         {
             outOptions.generateSPIRVDirectly = true;
         }
+        else if (argValue == "-optimize-direct-spirv")
+        {
+            outOptions.optimizeDirectSPIRV = true;
+        }
+        else if (argValue == "-validate-spirv")
+        {
+            outOptions.validateSPIRV = true;
+        }
         else if (argValue == "-only-startup")
         {
             outOptions.onlyStartup = true;
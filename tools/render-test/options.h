@@ -72,6 +72,18 @@ struct Options
     Slang::DownstreamArgs downstreamArgs;                    ///< Args to downstream tools. Here it's just slang
 
     bool generateSPIRVDirectly = false;
+    bool optimizeDirectSPIRV = false;           ///< Run the SPIR-V optimizer on SPIR-V generated directly
+    bool validateSPIRV = false;                 ///< Check generated SPIR-V with the SPIR-V validator
+
+        /// Get the target flags for the SPIR-V options
+    SlangTargetFlags getSPIRVTargetFlags() const
+    {
+        SlangTargetFlags flags = 0;
+        flags |= generateSPIRVDirectly ? SLANG_TARGET_FLAG_GENERATE_SPIRV_DIRECTLY : 0;
+        flags |= optimizeDirectSPIRV ? SLANG_TARGET_FLAG_OPTIMIZE_DIRECT_SPIRV : 0;
+        flags |= validateSPIRV ? SLANG_TARGET_FLAG_VALIDATE_SPIRV : 0;
+        return flags;
+    }
 
     Options() { downstreamArgs.addName("slang"); }
 
@@ -1325,8 +1325,7 @@ static SlangResult _innerMain(Slang::StdWriters* stdWriters, SlangSession* sessi
         desc.deviceType = options.deviceType;
 
         desc.slang.lineDirectiveMode = SLANG_LINE_DIRECTIVE_MODE_NONE;
-        if (options.generateSPIRVDirectly)
-            desc.slang.targetFlags = SLANG_TARGET_FLAG_GENERATE_SPIRV_DIRECTLY;
+        desc.slang.targetFlags = options.getSPIRVTargetFlags();
 
         List<const char*> requiredFeatureList;
         for (auto& name : options.renderFeatures)
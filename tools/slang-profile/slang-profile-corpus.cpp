@@ -0,0 +1,228 @@
+// slang-profile-corpus.cpp
+
+#include "slang-profile-corpus.h"
+
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-string-util.h"
+
+#include "../../source/slang/slang-profile.h"
+
+using namespace Slang;
+
+static const char kSyntheticPrefix[] = "synthetic:";
+
+// Split a line into whitespace separated fields
+static void _splitFields(const UnownedStringSlice& line, List<UnownedStringSlice>& outFields)
+{
+    outFields.clear();
+
+    const char* cur = line.begin();
+    const char* end = line.end();
+    while (cur < end)
+    {
+        while (cur < end && (*cur == ' ' || *cur == '\t'))
+        {
+            cur++;
+        }
+        const char* start = cur;
+        while (cur < end && !(*cur == ' ' || *cur == '\t'))
+        {
+            cur++;
+        }
+        if (cur > start)
+        {
+            outFields.add(UnownedStringSlice(start, cur));
+        }
+    }
+}
+
+static SlangResult _generateSyntheticSource(const UnownedStringSlice& desc, String& outSource)
+{
+    // The desc is <kind>:<count>
+    List<UnownedStringSlice> parts;
+    StringUtil::split(desc, ':', parts);
+
+    Int count = 0;
+    if (parts.getCount() != 2 || SLANG_FAILED(StringUtil::parseInt(parts[1], count)) || count <= 0)
+    {
+        return SLANG_FAIL;
+    }
+
+    if (parts[0] == toSlice("generics"))
+    {
+        outSource = BenchmarkCorpus::generateGenericsSource(count);
+    }
+    else if (parts[0] == toSlice("autodiff"))
+    {
+        outSource = BenchmarkCorpus::generateAutodiffSource(count);
+    }
+    else
+    {
+        return SLANG_FAIL;
+    }
+    return SLANG_OK;
+}
+
+SlangResult BenchmarkCorpus::load(const String& path, WriterHelper stdError)
+{
+    String manifest;
+    if (SLANG_FAILED(File::readAllText(path, manifest)))
+    {
+        stdError.print("error: unable to read corpus manifest '%s'\n", path.getBuffer());
+        return SLANG_FAIL;
+    }
+
+    List<UnownedStringSlice> fields;
+    Index lineIndex = 0;
+    for (auto line : LineParser(manifest.getUnownedSlice()))
+    {
+        lineIndex++;
+
+        line = line.trim();
+        if (line.getLength() == 0 || line[0] == '#')
+        {
+            continue;
+        }
+
+        _splitFields(line, fields);
+        if (fields.getCount() < 2 || fields.getCount() > 4)
+        {
+            stdError.print("error: %s(%d): expected <name> <source> [<entry point> [<stage>]]\n", path.getBuffer(), int(lineIndex));
+            return SLANG_FAIL;
+        }
+
+        BenchmarkCase benchmarkCase;
+        benchmarkCase.name = fields[0];
+        benchmarkCase.entryPointName = (fields.getCount() > 2) ? String(fields[2]) : String("computeMain");
+
+        if (fields.getCount() > 3)
+        {
+            const Stage stage = findStageByName(fields[3]);
+            if (stage == Stage::Unknown)
+            {
+                stdError.print("error: %s(%d): unknown stage '%s'\n", path.getBuffer(), int(lineIndex), String(fields[3]).getBuffer());
+                return SLANG_FAIL;
+            }
+            benchmarkCase.stage = SlangStage(stage);
+        }
+
+        const UnownedStringSlice source = fields[1];
+        if (source.startsWith(toSlice(kSyntheticPrefix)))
+        {
+            const UnownedStringSlice desc(source.begin() + SLANG_COUNT_OF(kSyntheticPrefix) - 1, source.end());
+            if (SLANG_FAILED(_generateSyntheticSource(desc, benchmarkCase.source)))
+            {
+                stdError.print("error: %s(%d): invalid synthetic source '%s'\n", path.getBuffer(), int(lineIndex), String(source).getBuffer());
+                return SLANG_FAIL;
+            }
+            benchmarkCase.path = benchmarkCase.name + ".slang";
+        }
+        else
+        {
+            benchmarkCase.path = source;
+            if (SLANG_FAILED(File::readAllText(benchmarkCase.path, benchmarkCase.source)))
+            {
+                stdError.print("error: %s(%d): unable to read '%s'\n", path.getBuffer(), int(lineIndex), benchmarkCase.path.getBuffer());
+                return SLANG_FAIL;
+            }
+        }
+
+        cases.add(benchmarkCase);
+    }
+
+    return SLANG_OK;
+}
+
+void BenchmarkCorpus::filter(const List<String>& filters)
+{
+    if (filters.getCount() == 0)
+    {
+        return;
+    }
+
+    List<BenchmarkCase> filteredCases;
+    for (const auto& benchmarkCase : cases)
+    {
+        for (const auto& filter : filters)
+        {
+            if (benchmarkCase.name.indexOf(filter) >= 0)
+            {
+                filteredCases.add(benchmarkCase);
+                break;
+            }
+        }
+    }
+    cases.swapWith(filteredCases);
+}
+
+/* static */String BenchmarkCorpus::generateGenericsSource(Index count)
+{
+    StringBuilder buf;
+
+    buf << "// Generated generics benchmark (" << count << " operations)\n\n";
+    buf << "RWStructuredBuffer<float> outputBuffer;\n\n";
+
+    buf << "interface IOp\n{\n    float apply(float x);\n}\n\n";
+
+    for (Index i = 0; i < count; ++i)
+    {
+        buf << "struct Op" << i << " : IOp\n{\n";
+        buf << "    float apply(float x) { return x * " << (i % 7) + 1 << ".0 * 0.25 + " << i << ".0; }\n";
+        buf << "}\n\n";
+    }
+
+    buf << "struct Compose<A : IOp, B : IOp> : IOp\n{\n";
+    buf << "    A a;\n    B b;\n";
+    buf << "    float apply(float x) { return b.apply(a.apply(x)); }\n";
+    buf << "}\n\n";
+
+    buf << "float run<T : IOp>(T op, float x) { return op.apply(x); }\n\n";
+
+    buf << "[numthreads(64, 1, 1)]\n";
+    buf << "void computeMain(uint3 dispatchThreadID : SV_DispatchThreadID)\n{\n";
+    buf << "    float value = float(dispatchThreadID.x);\n";
+    for (Index i = 0; i < count; ++i)
+    {
+        // Nest the compositions, so each is a distinct specialization
+        buf << "    Compose<Compose<Op" << i << ", Op" << (i + 1) % count << ">, Op" << (i + 2) % count << "> c" << i << ";\n";
+        buf << "    value = run(c" << i << ", value);\n";
+    }
+    buf << "    outputBuffer[dispatchThreadID.x] = value;\n";
+    buf << "}\n";
+
+    return buf.ProduceString();
+}
+
+/* static */String BenchmarkCorpus::generateAutodiffSource(Index count)
+{
+    StringBuilder buf;
+
+    buf << "// Generated autodiff benchmark (" << count << " functions)\n\n";
+    buf << "RWStructuredBuffer<float> outputBuffer;\n\n";
+
+    buf << "[BackwardDifferentiable]\n";
+    buf << "float f0(float x)\n{\n";
+    buf << "    if (x > 0.5)\n        return x * x + 0.5;\n";
+    buf << "    return x * 3.0;\n";
+    buf << "}\n\n";
+
+    for (Index i = 1; i < count; ++i)
+    {
+        // Each function calls the previous one, and has control flow to differentiate through
+        buf << "[BackwardDifferentiable]\n";
+        buf << "float f" << i << "(float x)\n{\n";
+        buf << "    float y = f" << i - 1 << "(x) * 0.5 + x;\n";
+        buf << "    if (y > " << i << ".0)\n        y = y * y;\n";
+        buf << "    return y;\n";
+        buf << "}\n\n";
+    }
+
+    buf << "[numthreads(64, 1, 1)]\n";
+    buf << "void computeMain(uint3 dispatchThreadID : SV_DispatchThreadID)\n{\n";
+    buf << "    DifferentialPair<float> dpx = DifferentialPair<float>(float(dispatchThreadID.x), 0.0);\n";
+    buf << "    __bwd_diff(f" << count - 1 << ")(dpx, 1.0);\n";
+    buf << "    outputBuffer[dispatchThreadID.x] = dpx.d;\n";
+    buf << "}\n";
+
+    return buf.ProduceString();
+}
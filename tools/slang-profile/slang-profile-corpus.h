@@ -0,0 +1,51 @@
+// slang-profile-corpus.h
+
+#ifndef SLANG_PROFILE_CORPUS_H_INCLUDED
+#define SLANG_PROFILE_CORPUS_H_INCLUDED
+
+#include "../../source/core/slang-basic.h"
+#include "../../source/core/slang-writer.h"
+
+#include "../../slang.h"
+
+// A shader that is compiled as part of the benchmark
+struct BenchmarkCase
+{
+    Slang::String name;                 ///< Name the results are reported under
+    Slang::String path;                 ///< The path of the source. For generated source this is just a name.
+    Slang::String source;               ///< The source text
+    Slang::String entryPointName;
+    SlangStage stage = SLANG_STAGE_COMPUTE;
+};
+
+/* The set of shaders to benchmark.
+
+A corpus is described by a manifest file, where each (non empty, non '#' comment) line is
+
+    <name> <source> [<entry point> [<stage>]]
+
+<source> is either a path to a file (relative to the working directory), or one of
+
+    synthetic:generics:<count>
+    synthetic:autodiff:<count>
+
+which generate a shader of a size controlled by <count>, that makes heavy use of generics
+and interfaces, or of backward differentiation respectively. The entry point defaults to
+`computeMain` and the stage to `compute`. */
+struct BenchmarkCorpus
+{
+        /// Read the manifest at path, and the sources it references
+    SlangResult load(const Slang::String& path, Slang::WriterHelper stdError);
+
+        /// Remove all cases whose names don't contain any of the filters. Does nothing if there are no filters.
+    void filter(const Slang::List<Slang::String>& filters);
+
+        /// Generate source that specializes `count` generic compositions of interface implementations
+    static Slang::String generateGenericsSource(Slang::Index count);
+        /// Generate source that backward differentiates a chain of `count` functions with control flow
+    static Slang::String generateAutodiffSource(Slang::Index count);
+
+    Slang::List<BenchmarkCase> cases;
+};
+
+#endif
@@ -4,34 +4,529 @@
 #include "../../source/core/slang-std-writers.h"
 
 #include "../../source/core/slang-process-util.h"
+#include "../../source/core/slang-test-tool-util.h"
+#include "../../source/core/slang-type-text-util.h"
 
 #include "../../slang-com-helper.h"
+#include "../../slang-com-ptr.h"
 
 #include "../../source/core/slang-string-util.h"
 
+#include "../../source/compiler-core/slang-json-rpc.h"
+#include "../../source/compiler-core/slang-json-value.h"
+
+#include "slang-profile-corpus.h"
+#include "slang-profile-micro.h"
+#include "slang-profile-results.h"
+
 using namespace Slang;
 
+namespace { // anonymous
+
+struct Options
+{
+    String corpusPath = "tools/slang-profile/corpus.txt";
+    List<String> caseFilters;               ///< Only cases whose names contain one of these are run
+    List<String> targets;                   ///< The targets to generate code for
+    Index warmupCount = 1;                  ///< Runs before measurement starts
+    Index repeatCount = 5;                  ///< Measured runs
+    String jsonPath;                        ///< If set, results are written here
+    String comparePath;                     ///< If set, results are compared against the results here
+    BenchmarkCompareOptions compareOptions;
+};
+
+// The time in ms taken by each phase in a single run
+typedef BenchmarkPhaseTimes PhaseTimes;
+
+// An event read from a Chrome trace
+struct TraceEvent
+{
+    String name;
+    String category;
+    double start = 0.0;                     ///< In microseconds
+    double duration = 0.0;                  ///< In microseconds
+};
+
+} // anonymous
+
+static void _printUsage(WriterHelper out)
+{
+    out.print(
+        "usage: slang-profile [options]\n"
+        "\n"
+        "Compiles each shader of a corpus a number of times, and reports the time taken by each phase\n"
+        "of compilation and the peak memory used. Micro benchmarks of parts of the compiler (named\n"
+        "micro-*) are then run in the same way.\n"
+        "\n"
+        "  -corpus <path>       The corpus manifest (default tools/slang-profile/corpus.txt)\n"
+        "  -case <text>         Only run cases whose name contains text. Can be used multiple times.\n"
+        "  -target <name>       Generate code for the target (e.g. hlsl, glsl, spirv). Can be used multiple times.\n"
+        "                       Default is hlsl and glsl.\n"
+        "  -warmup <count>      Runs of each case before measuring (default 1)\n"
+        "  -repeat <count>      Measured runs of each case (default 5)\n"
+        "  -json <path>         Write the results as JSON to path\n"
+        "  -compare <path>      Compare against results written previously with -json. Fails if there are regressions.\n"
+        "  -threshold <percent> Percentage a median time or peak memory must grow by to be a regression (default 10)\n"
+        "  -min-delta <ms>      Time a median must grow by to be a regression (default 1)\n");
+}
+
+static SlangResult _parseCount(const char* text, Index minValue, Index& outCount)
+{
+    Int value;
+    SLANG_RETURN_ON_FAIL(StringUtil::parseInt(UnownedStringSlice(text), value));
+    if (value < minValue)
+    {
+        return SLANG_FAIL;
+    }
+    outCount = Index(value);
+    return SLANG_OK;
+}
+
+static SlangResult _parseOptions(int argc, char** argv, WriterHelper stdError, Options& outOptions)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const UnownedStringSlice arg(argv[i]);
+        if (arg == toSlice("-h") || arg == toSlice("-help") || arg == toSlice("--help"))
+        {
+            _printUsage(stdError);
+            return SLANG_FAIL;
+        }
+
+        if (i + 1 >= argc)
+        {
+            stdError.print("error: expected a value after '%s'\n", argv[i]);
+            return SLANG_FAIL;
+        }
+        const char* value = argv[++i];
+
+        SlangResult res = SLANG_OK;
+        if (arg == toSlice("-corpus"))
+        {
+            outOptions.corpusPath = value;
+        }
+        else if (arg == toSlice("-case"))
+        {
+            outOptions.caseFilters.add(value);
+        }
+        else if (arg == toSlice("-target"))
+        {
+            outOptions.targets.add(value);
+        }
+        else if (arg == toSlice("-warmup"))
+        {
+            res = _parseCount(value, 0, outOptions.warmupCount);
+        }
+        else if (arg == toSlice("-repeat"))
+        {
+            res = _parseCount(value, 1, outOptions.repeatCount);
+        }
+        else if (arg == toSlice("-json"))
+        {
+            outOptions.jsonPath = value;
+        }
+        else if (arg == toSlice("-compare"))
+        {
+            outOptions.comparePath = value;
+        }
+        else if (arg == toSlice("-threshold"))
+        {
+            res = StringUtil::parseDouble(UnownedStringSlice(value), outOptions.compareOptions.thresholdPercent);
+        }
+        else if (arg == toSlice("-min-delta"))
+        {
+            res = StringUtil::parseDouble(UnownedStringSlice(value), outOptions.compareOptions.minDeltaMs);
+        }
+        else
+        {
+            stdError.print("error: unknown option '%s'\n", argv[i - 1]);
+            _printUsage(stdError);
+            return SLANG_FAIL;
+        }
+
+        if (SLANG_FAILED(res))
+        {
+            stdError.print("error: invalid value '%s' for '%s'\n", value, argv[i - 1]);
+            return res;
+        }
+    }
+
+    if (outOptions.targets.getCount() == 0)
+    {
+        outOptions.targets.add("hlsl");
+        outOptions.targets.add("glsl");
+    }
+    return SLANG_OK;
+}
+
+static double _getElapsedMs(uint64_t startTick, uint64_t endTick)
+{
+    return double(endTick - startTick) * 1000.0 / double(Process::getClockFrequency());
+}
+
+static void _addTime(PhaseTimes& ioTimes, const String& phase, double ms)
+{
+    if (auto time = ioTimes.TryGetValue(phase))
+    {
+        *time += ms;
+    }
+    else
+    {
+        ioTimes.Add(phase, ms);
+    }
+}
+
+static SlangResult _readTraceEvents(ISlangBlob* trace, List<TraceEvent>& outEvents)
+{
+    SourceManager sourceManager;
+    sourceManager.initialize(nullptr, nullptr);
+    DiagnosticSink sink(&sourceManager, nullptr);
+
+    JSONContainer container(&sourceManager);
+    JSONValue root;
+    const UnownedStringSlice text((const char*)trace->getBufferPointer(), trace->getBufferSize());
+    SLANG_RETURN_ON_FAIL(JSONRPCUtil::parseJSON(text, &container, &sink, root));
+
+    const JSONValue eventsValue = container.findObjectValue(root, container.findKey(toSlice("traceEvents")));
+    if (eventsValue.getKind() != JSONValue::Kind::Array)
+    {
+        return SLANG_FAIL;
+    }
+
+    const JSONKey nameKey = container.findKey(toSlice("name"));
+    const JSONKey categoryKey = container.findKey(toSlice("cat"));
+    const JSONKey startKey = container.findKey(toSlice("ts"));
+    const JSONKey durationKey = container.findKey(toSlice("dur"));
+
+    for (const auto& eventValue : container.getArray(eventsValue))
+    {
+        TraceEvent event;
+        event.name = container.getString(container.findObjectValue(eventValue, nameKey));
+        event.category = container.getString(container.findObjectValue(eventValue, categoryKey));
+        event.start = container.asFloat(container.findObjectValue(eventValue, startKey));
+        event.duration = container.asFloat(container.findObjectValue(eventValue, durationKey));
+        outEvents.add(event);
+    }
+    return SLANG_OK;
+}
+
+/* Attribute the time of the events in a trace to phases.
+
+Events nest, and most phases (such as "parse" or "check") are the time spent in events of that
+name excluding any nested events, so a "check" that imports a module doesn't include the time
+to parse the imported module. "codegen" events (one per target) instead include all of the
+events they contain, so all of the work to produce the code for a target is in one phase. */
+static void _addTracePhases(const List<TraceEvent>& events, PhaseTimes& ioTimes)
+{
+    const Index eventCount = events.getCount();
+
+    List<double> selfTimes;
+    List<bool> inCodegen;
+    selfTimes.setCount(eventCount);
+    inCodegen.setCount(eventCount);
+
+    // Events are in the order they began, so the stack holds the events that contain the current one
+    List<Index> stack;
+    for (Index i = 0; i < eventCount; ++i)
+    {
+        const auto& event = events[i];
+        while (stack.getCount() && events[stack.getLast()].start + events[stack.getLast()].duration <= event.start)
+        {
+            stack.removeLast();
+        }
+
+        selfTimes[i] = event.duration;
+        inCodegen[i] = false;
+        if (stack.getCount())
+        {
+            const Index parent = stack.getLast();
+            selfTimes[parent] -= event.duration;
+            inCodegen[i] = inCodegen[parent] || events[parent].category == "codegen";
+        }
+        stack.add(i);
+    }
+
+    for (Index i = 0; i < eventCount; ++i)
+    {
+        const auto& event = events[i];
+        if (inCodegen[i])
+        {
+            continue;
+        }
+
+        if (event.category == "codegen")
+        {
+            _addTime(ioTimes, "codegen:" + event.name, event.duration / 1000.0);
+        }
+        else if (event.category == "frontend")
+        {
+            _addTime(ioTimes, event.name, selfTimes[i] / 1000.0);
+        }
+        else if (event.category == "compile")
+        {
+            // Whatever isn't in any other phase
+            _addTime(ioTimes, "other", selfTimes[i] / 1000.0);
+        }
+        else
+        {
+            _addTime(ioTimes, event.category + ":" + event.name, selfTimes[i] / 1000.0);
+        }
+    }
+}
+
+static SlangResult _createGlobalSession(const char* exePath, ComPtr<slang::IGlobalSession>& outSession, PhaseTimes& outTimes)
+{
+    const uint64_t startTick = Process::getClockTick();
+    SLANG_RETURN_ON_FAIL(slang_createGlobalSessionWithoutStdLib(SLANG_API_VERSION, outSession.writeRef()));
+    const uint64_t sessionTick = Process::getClockTick();
+
+    // Use the embedded stdlib if there is one, as that is what a typical application will do
+    if (ISlangBlob* stdLib = slang_getEmbeddedStdLib())
+    {
+        SLANG_RETURN_ON_FAIL(outSession->loadStdLib(stdLib->getBufferPointer(), stdLib->getBufferSize()));
+    }
+    else
+    {
+        SLANG_RETURN_ON_FAIL(outSession->compileStdLib(0));
+    }
+    const uint64_t endTick = Process::getClockTick();
+
+    TestToolUtil::setSessionDefaultPreludeFromExePath(exePath, outSession);
+
+    outTimes.Add("createSession", _getElapsedMs(startTick, sessionTick));
+    outTimes.Add("loadStdLib", _getElapsedMs(sessionTick, endTick));
+    return SLANG_OK;
+}
+
+static SlangResult _compileCase(slang::IGlobalSession* session, const BenchmarkCase& benchmarkCase, const List<SlangCompileTarget>& targets, WriterHelper stdError, PhaseTimes& outTimes)
+{
+    SlangCompileRequest* request = spCreateCompileRequest(session);
+
+    spSetPerfTraceEnabled(request, true);
+    for (auto target : targets)
+    {
+        spAddCodeGenTarget(request, target);
+    }
+
+    const String directory = Path::getParentDirectory(benchmarkCase.path);
+    if (directory.getLength())
+    {
+        spAddSearchPath(request, directory.getBuffer());
+    }
+
+    const int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    spAddTranslationUnitSourceString(request, translationUnitIndex, benchmarkCase.path.getBuffer(), benchmarkCase.source.getBuffer());
+    spAddEntryPoint(request, translationUnitIndex, benchmarkCase.entryPointName.getBuffer(), benchmarkCase.stage);
+
+    const uint64_t startTick = Process::getClockTick();
+    SlangResult res = spCompile(request);
+    const uint64_t endTick = Process::getClockTick();
+
+    if (SLANG_FAILED(res))
+    {
+        stdError.print("error: '%s' failed to compile\n%s", benchmarkCase.name.getBuffer(), spGetDiagnosticOutput(request));
+    }
+    else
+    {
+        ComPtr<ISlangBlob> trace;
+        List<TraceEvent> events;
+        res = spGetPerfTrace(request, SLANG_PERF_TRACE_FORMAT_CHROME_JSON, trace.writeRef());
+        if (SLANG_SUCCEEDED(res))
+        {
+            res = _readTraceEvents(trace, events);
+        }
+
+        if (SLANG_SUCCEEDED(res))
+        {
+            _addTracePhases(events, outTimes);
+            outTimes.Add("total", _getElapsedMs(startTick, endTick));
+        }
+        else
+        {
+            stdError.print("error: unable to read the performance trace of '%s'\n", benchmarkCase.name.getBuffer());
+        }
+    }
+
+    spDestroyCompileRequest(request);
+    return res;
+}
+
+static size_t _getPeakMemoryUsage()
+{
+    size_t bytes = 0;
+    Process::getPeakMemoryUsage(bytes);
+    return bytes;
+}
+
+static bool _matchesFilters(const String& name, const List<String>& filters)
+{
+    if (filters.getCount() == 0)
+    {
+        return true;
+    }
+    for (const auto& filter : filters)
+    {
+        if (name.indexOf(filter) >= 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Run a case for the warm up and measured runs, and add its result to ioResults.
+runOnce times a single run. A case that fails isn't reported, so a comparison will note it is missing. */
+template <typename Func>
+static SlangResult _runCase(const Options& options, const String& name, const Func& runOnce, BenchmarkResults& ioResults)
+{
+    PhaseSamples samples;
+    const Index runCount = options.warmupCount + options.repeatCount;
+    for (Index i = 0; i < runCount; ++i)
+    {
+        PhaseTimes times;
+        SLANG_RETURN_ON_FAIL(runOnce(times));
+        if (i >= options.warmupCount)
+        {
+            for (const auto& pair : times)
+            {
+                samples.add(pair.Key, pair.Value);
+            }
+        }
+    }
+
+    BenchmarkResult result;
+    result.name = name;
+    result.setPhases(samples);
+    // The peak is for the process, so it is the largest of this and all of the cases before it
+    result.peakMemoryBytes = _getPeakMemoryUsage();
+    ioResults.results.add(result);
+    return SLANG_OK;
+}
+
 SlangResult innerMain(int argc, char** argv)
 {
     auto stdWriters = StdWriters::initDefaultSingleton();
+    WriterHelper stdOut = stdWriters->getOut();
+    WriterHelper stdError = stdWriters->getError();
+
+    Options options;
+    SLANG_RETURN_ON_FAIL(_parseOptions(argc, argv, stdError, options));
 
-    // Time the creation of the session
+    List<SlangCompileTarget> targets;
+    for (const auto& targetName : options.targets)
     {
-        const auto startTick = ProcessUtil::getClockTick();
+        const SlangCompileTarget target = TypeTextUtil::findCompileTargetFromName(targetName.getUnownedSlice());
+        if (target == SLANG_TARGET_UNKNOWN)
+        {
+            stdError.print("error: unknown target '%s'\n", targetName.getBuffer());
+            return SLANG_FAIL;
+        }
+        targets.add(target);
+    }
 
-        for (Int i = 0; i < 32; ++i)
+    BenchmarkCorpus corpus;
+    SLANG_RETURN_ON_FAIL(corpus.load(options.corpusPath, stdError));
+    corpus.filter(options.caseFilters);
+
+    BenchmarkResults results;
+    results.warmupCount = options.warmupCount;
+    results.repeatCount = options.repeatCount;
+    results.targets = options.targets;
+
+    const Index runCount = options.warmupCount + options.repeatCount;
+
+    // Time the creation of the global session. The last one created is used to compile the corpus.
+    ComPtr<slang::IGlobalSession> session;
+    {
+        PhaseSamples samples;
+        for (Index i = 0; i < runCount; ++i)
         {
-            ComPtr<slang::IGlobalSession> slangSession;
-            slangSession.attach(spCreateSession(nullptr));
+            session.setNull();
+
+            PhaseTimes times;
+            SLANG_RETURN_ON_FAIL(_createGlobalSession(argv[0], session, times));
+            if (i >= options.warmupCount)
+            {
+                for (const auto& pair : times)
+                {
+                    samples.add(pair.Key, pair.Value);
+                }
+            }
         }
 
-        const auto endTick = ProcessUtil::getClockTick();
+        BenchmarkResult result;
+        result.name = "session";
+        result.setPhases(samples);
+        result.peakMemoryBytes = _getPeakMemoryUsage();
+        results.results.add(result);
+    }
+
+    SlangResult res = SLANG_OK;
+    for (const auto& benchmarkCase : corpus.cases)
+    {
+        const SlangResult caseRes = _runCase(options, benchmarkCase.name, [&](PhaseTimes& outTimes)
+        {
+            return _compileCase(session, benchmarkCase, targets, stdError, outTimes);
+        }, results);
 
-        printf("Ticks %f\n", double(endTick - startTick) / ProcessUtil::getClockFrequency());
-        return SLANG_OK;
+        if (SLANG_FAILED(caseRes))
+        {
+            res = caseRes;
+        }
     }
 
-    return SLANG_OK;
+    for (const auto& microBenchmark : getMicroBenchmarks())
+    {
+        if (!_matchesFilters(microBenchmark.name, options.caseFilters))
+        {
+            continue;
+        }
+
+        const SlangResult caseRes = _runCase(options, microBenchmark.name, [&](PhaseTimes& outTimes)
+        {
+            return microBenchmark.func(stdError, outTimes);
+        }, results);
+
+        if (SLANG_FAILED(caseRes))
+        {
+            res = caseRes;
+        }
+    }
+
+    {
+        StringBuilder buf;
+        results.writeSummary(buf);
+        stdOut.put(buf.getUnownedSlice());
+    }
+
+    if (options.jsonPath.getLength())
+    {
+        StringBuilder buf;
+        results.writeJSON(buf);
+        if (SLANG_FAILED(File::writeAllText(options.jsonPath, buf)))
+        {
+            stdError.print("error: unable to write '%s'\n", options.jsonPath.getBuffer());
+            return SLANG_FAIL;
+        }
+    }
+
+    if (options.comparePath.getLength())
+    {
+        BenchmarkResults baseline;
+        SLANG_RETURN_ON_FAIL(baseline.readJSON(options.comparePath, stdError));
+
+        StringBuilder buf;
+        const Index regressionCount = BenchmarkResults::compare(baseline, results, options.compareOptions, buf);
+        buf << regressionCount << " regression(s) against '" << options.comparePath << "'\n";
+        stdOut.put(buf.getUnownedSlice());
+
+        if (regressionCount)
+        {
+            res = SLANG_FAIL;
+        }
+    }
+
+    return res;
 }
 
 int main(int argc, char** argv)
@@ -0,0 +1,175 @@
+// slang-profile-micro.cpp
+
+#include "slang-profile-micro.h"
+
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-process.h"
+
+#include "../../source/compiler-core/slang-diagnostic-sink.h"
+#include "../../source/compiler-core/slang-lexer.h"
+#include "../../source/compiler-core/slang-name.h"
+#include "../../source/compiler-core/slang-source-loc.h"
+
+using namespace Slang;
+
+template <typename Func>
+static double _timeMs(const Func& func)
+{
+    const uint64_t startTick = Process::getClockTick();
+    func();
+    const uint64_t endTick = Process::getClockTick();
+    return double(endTick - startTick) * 1000.0 / double(Process::getClockFrequency());
+}
+
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! Dictionary !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+
+static const Index kDictionaryKeyCount = 100000;
+
+template <typename KeyType>
+static SlangResult _benchmarkDictionary(const char* name, const List<KeyType>& keys, const List<KeyType>& missingKeys, WriterHelper stdError, BenchmarkPhaseTimes& outTimes)
+{
+    const Index count = keys.getCount();
+    Dictionary<KeyType, Index> dict;
+
+    outTimes.Add("insert", _timeMs([&]() {
+        for (Index i = 0; i < count; ++i)
+            dict.Add(keys[i], i);
+    }));
+
+    Index hitCount = 0;
+    outTimes.Add("lookupHit", _timeMs([&]() {
+        for (const auto& key : keys)
+            hitCount += dict.TryGetValue(key) ? 1 : 0;
+    }));
+
+    Index missHitCount = 0;
+    outTimes.Add("lookupMiss", _timeMs([&]() {
+        for (const auto& key : missingKeys)
+            missHitCount += dict.TryGetValue(key) ? 1 : 0;
+    }));
+
+    outTimes.Add("remove", _timeMs([&]() {
+        for (const auto& key : keys)
+            dict.Remove(key);
+    }));
+
+    // Check the lookups did what they should, so the work can't be optimized away
+    if (hitCount != count || missHitCount != 0 || dict.Count() != 0)
+    {
+        stdError.print("error: dictionary of %s gave the wrong results\n", name);
+        return SLANG_FAIL;
+    }
+    return SLANG_OK;
+}
+
+static SlangResult _benchmarkIntDictionary(WriterHelper stdError, BenchmarkPhaseTimes& outTimes)
+{
+    List<int> keys, missingKeys;
+    for (Index i = 0; i < kDictionaryKeyCount; ++i)
+    {
+        keys.add(int(i * 7919));
+        missingKeys.add(int((i + kDictionaryKeyCount) * 7919));
+    }
+    return _benchmarkDictionary("int", keys, missingKeys, stdError, outTimes);
+}
+
+static SlangResult _benchmarkPointerDictionary(WriterHelper stdError, BenchmarkPhaseTimes& outTimes)
+{
+    // Like the pointer keys used for IR instructions and AST nodes
+    List<void*> keys, missingKeys;
+    for (Index i = 0; i < kDictionaryKeyCount; ++i)
+    {
+        keys.add((void*)(size_t(i + 1) * 64));
+        missingKeys.add((void*)(size_t(i + 1 + kDictionaryKeyCount) * 64));
+    }
+    return _benchmarkDictionary("pointer", keys, missingKeys, stdError, outTimes);
+}
+
+static SlangResult _benchmarkStringDictionary(WriterHelper stdError, BenchmarkPhaseTimes& outTimes)
+{
+    // Like the names used in member dictionaries
+    List<String> keys, missingKeys;
+    for (Index i = 0; i < kDictionaryKeyCount; ++i)
+    {
+        StringBuilder buf;
+        buf << "identifier" << i;
+        keys.add(buf.ProduceString());
+        buf << "_";
+        missingKeys.add(buf.ProduceString());
+    }
+    return _benchmarkDictionary("String", keys, missingKeys, stdError, outTimes);
+}
+
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! Lexer !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+
+static SlangResult _benchmarkLexer(WriterHelper stdError, BenchmarkPhaseTimes& outTimes)
+{
+    // The stdlib meta sources are a reasonable amount of real world source
+    const char* const paths[] =
+    {
+        "source/slang/core.meta.slang",
+        "source/slang/hlsl.meta.slang",
+        "source/slang/diff.meta.slang",
+    };
+
+    StringBuilder buf;
+    for (const char* path : paths)
+    {
+        String contents;
+        if (SLANG_FAILED(File::readAllText(path, contents)))
+        {
+            stdError.print("error: unable to read '%s'\n", path);
+            return SLANG_FAIL;
+        }
+        buf << contents << "\n";
+    }
+    const String text = buf.ProduceString();
+
+    SourceManager sourceManager;
+    sourceManager.initialize(nullptr, nullptr);
+    DiagnosticSink sink;
+    RootNamePool rootNamePool;
+    NamePool namePool;
+    namePool.setRootNamePool(&rootNamePool);
+
+    Index tokenCount = 0;
+    outTimes.Add("lex", _timeMs([&]() {
+        SourceFile* sourceFile = sourceManager.createSourceFileWithString(PathInfo::makeFromString("lexer"), text);
+        SourceView* sourceView = sourceManager.createSourceView(sourceFile, nullptr, SourceLoc::fromRaw(0));
+
+        Lexer lexer;
+        lexer.initialize(sourceView, &sink, &namePool, sourceManager.getMemoryArena());
+        while (lexer.lexToken().type != TokenType::EndOfFile)
+        {
+            tokenCount++;
+        }
+    }));
+
+    Index lineCount = 0;
+    outTimes.Add("lineBreaks", _timeMs([&]() {
+        SourceFile* sourceFile = sourceManager.createSourceFileWithString(PathInfo::makeFromString("lines"), text);
+        lineCount = sourceFile->getLineBreakOffsets().getCount();
+    }));
+
+    if (tokenCount == 0 || lineCount == 0)
+    {
+        stdError.print("error: lexing gave no tokens or lines\n");
+        return SLANG_FAIL;
+    }
+    return SLANG_OK;
+}
+
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! All !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+
+static const MicroBenchmark s_microBenchmarks[] =
+{
+    { "micro-dictionary-int", _benchmarkIntDictionary },
+    { "micro-dictionary-pointer", _benchmarkPointerDictionary },
+    { "micro-dictionary-string", _benchmarkStringDictionary },
+    { "micro-lexer", _benchmarkLexer },
+};
+
+ConstArrayView<MicroBenchmark> getMicroBenchmarks()
+{
+    return makeConstArrayView(s_microBenchmarks, SLANG_COUNT_OF(s_microBenchmarks));
+}
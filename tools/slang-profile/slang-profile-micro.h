@@ -0,0 +1,29 @@
+// slang-profile-micro.h
+
+#ifndef SLANG_PROFILE_MICRO_H_INCLUDED
+#define SLANG_PROFILE_MICRO_H_INCLUDED
+
+#include "../../source/core/slang-basic.h"
+#include "../../source/core/slang-array-view.h"
+#include "../../source/core/slang-writer.h"
+
+// The time in ms taken by each phase in a single run
+typedef Slang::OrderedDictionary<Slang::String, double> BenchmarkPhaseTimes;
+
+/* A benchmark of one part of the compiler (such as a container or the lexer), timed on its own
+rather than as part of compiling a shader. Like a corpus case, a run produces the time taken by
+each of a number of phases, and the results are reported and compared in the same way.
+
+Micro benchmarks are named with a "micro-" prefix, so they can be selected with `-case micro`. */
+struct MicroBenchmark
+{
+    typedef SlangResult (*Func)(Slang::WriterHelper stdError, BenchmarkPhaseTimes& outTimes);
+
+    const char* name;
+    Func func;
+};
+
+    /// Get all of the micro benchmarks
+Slang::ConstArrayView<MicroBenchmark> getMicroBenchmarks();
+
+#endif
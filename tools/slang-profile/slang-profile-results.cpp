@@ -0,0 +1,343 @@
+// slang-profile-results.cpp
+
+#include "slang-profile-results.h"
+
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-string-escape-util.h"
+
+#include "../../source/compiler-core/slang-json-rpc.h"
+#include "../../source/compiler-core/slang-json-value.h"
+
+using namespace Slang;
+
+// Bump if the layout of the JSON changes
+static const int kResultsVersion = 1;
+
+/* static */PhaseStats PhaseStats::calc(const List<double>& inSamples)
+{
+    PhaseStats stats;
+    const Index count = inSamples.getCount();
+    if (count == 0)
+    {
+        return stats;
+    }
+
+    List<double> samples(inSamples);
+    samples.sort();
+
+    double total = 0.0;
+    for (auto sample : samples)
+    {
+        total += sample;
+    }
+
+    stats.min = samples[0];
+    stats.max = samples[count - 1];
+    stats.mean = total / double(count);
+    stats.median = (count & 1) ? samples[count / 2] : (samples[count / 2 - 1] + samples[count / 2]) * 0.5;
+    return stats;
+}
+
+void PhaseSamples::add(const String& phase, double ms)
+{
+    if (auto list = samples.TryGetValue(phase))
+    {
+        list->add(ms);
+    }
+    else
+    {
+        List<double> phaseSamples;
+        phaseSamples.add(ms);
+        samples.Add(phase, phaseSamples);
+    }
+}
+
+void BenchmarkResult::setPhases(const PhaseSamples& phaseSamples)
+{
+    phases.Clear();
+    for (const auto& pair : phaseSamples.samples)
+    {
+        phases.Add(pair.Key, PhaseStats::calc(pair.Value));
+    }
+}
+
+static void _appendQuoted(const String& text, StringBuilder& out)
+{
+    auto handler = StringEscapeUtil::getHandler(StringEscapeUtil::Style::JSON);
+    StringEscapeUtil::appendQuoted(handler, text.getUnownedSlice(), out);
+}
+
+void BenchmarkResults::writeJSON(StringBuilder& out) const
+{
+    out << "{\n";
+    out << "    \"version\": " << kResultsVersion << ",\n";
+    out << "    \"warmup\": " << warmupCount << ",\n";
+    out << "    \"repeat\": " << repeatCount << ",\n";
+
+    out << "    \"targets\": [";
+    for (Index i = 0; i < targets.getCount(); ++i)
+    {
+        out << (i ? ", " : "");
+        _appendQuoted(targets[i], out);
+    }
+    out << "],\n";
+
+    out << "    \"results\": [\n";
+    for (Index i = 0; i < results.getCount(); ++i)
+    {
+        const auto& result = results[i];
+        out << "        {\n";
+        out << "            \"name\": ";
+        _appendQuoted(result.name, out);
+        out << ",\n";
+        out << "            \"peakMemoryBytes\": " << uint64_t(result.peakMemoryBytes) << ",\n";
+        out << "            \"phases\": {\n";
+
+        Index phaseIndex = 0;
+        for (const auto& pair : result.phases)
+        {
+            const auto& stats = pair.Value;
+            out << "                ";
+            _appendQuoted(pair.Key, out);
+            out << ": { \"min\": ";
+            out.append(stats.min, "%.4f");
+            out << ", \"median\": ";
+            out.append(stats.median, "%.4f");
+            out << ", \"mean\": ";
+            out.append(stats.mean, "%.4f");
+            out << ", \"max\": ";
+            out.append(stats.max, "%.4f");
+            out << " }" << ((++phaseIndex < result.phases.Count()) ? "," : "") << "\n";
+        }
+
+        out << "            }\n";
+        out << "        }" << ((i + 1 < results.getCount()) ? "," : "") << "\n";
+    }
+    out << "    ]\n";
+    out << "}\n";
+}
+
+void BenchmarkResults::writeSummary(StringBuilder& out) const
+{
+    out << "Median times in ms (" << repeatCount << " runs after " << warmupCount << " warm up)\n";
+    for (const auto& result : results)
+    {
+        out << result.name << " (peak memory ";
+        out.append(double(result.peakMemoryBytes) / (1024.0 * 1024.0), "%.1f");
+        out << "MB)\n";
+
+        for (const auto& pair : result.phases)
+        {
+            char buf[64];
+            sprintf_s(buf, SLANG_COUNT_OF(buf), "%12.3f  ", pair.Value.median);
+            out << buf << pair.Key << "\n";
+        }
+    }
+}
+
+namespace { // anonymous
+
+struct JSONReader
+{
+    JSONValue find(const JSONValue& obj, const char* name) const
+    {
+        const JSONKey key = container->findKey(UnownedStringSlice(name));
+        return key ? container->findObjectValue(obj, key) : JSONValue::makeInvalid();
+    }
+    double findFloat(const JSONValue& obj, const char* name) const
+    {
+        const JSONValue value = find(obj, name);
+        return value.isValid() ? container->asFloat(value) : 0.0;
+    }
+
+    JSONContainer* container;
+};
+
+} // anonymous
+
+SlangResult BenchmarkResults::readJSON(const String& path, WriterHelper stdError)
+{
+    String contents;
+    if (SLANG_FAILED(File::readAllText(path, contents)))
+    {
+        stdError.print("error: unable to read results '%s'\n", path.getBuffer());
+        return SLANG_FAIL;
+    }
+
+    SourceManager sourceManager;
+    sourceManager.initialize(nullptr, nullptr);
+    DiagnosticSink sink(&sourceManager, nullptr);
+
+    JSONContainer container(&sourceManager);
+    JSONValue root;
+    if (SLANG_FAILED(JSONRPCUtil::parseJSON(contents.getUnownedSlice(), &container, &sink, root)))
+    {
+        stdError.print("error: unable to parse results '%s'\n%s", path.getBuffer(), sink.outputBuffer.getBuffer());
+        return SLANG_FAIL;
+    }
+
+    JSONReader reader{ &container };
+
+    if (root.getKind() != JSONValue::Kind::Object || reader.findFloat(root, "version") != double(kResultsVersion))
+    {
+        stdError.print("error: '%s' is not a results file of a supported version\n", path.getBuffer());
+        return SLANG_FAIL;
+    }
+
+    warmupCount = Index(reader.findFloat(root, "warmup"));
+    repeatCount = Index(reader.findFloat(root, "repeat"));
+
+    targets.clear();
+    const JSONValue targetsValue = reader.find(root, "targets");
+    if (targetsValue.getKind() == JSONValue::Kind::Array)
+    {
+        for (const auto& target : container.getArray(targetsValue))
+        {
+            targets.add(container.getString(target));
+        }
+    }
+
+    results.clear();
+    const JSONValue resultsValue = reader.find(root, "results");
+    if (resultsValue.getKind() == JSONValue::Kind::Array)
+    {
+        for (const auto& resultValue : container.getArray(resultsValue))
+        {
+            BenchmarkResult result;
+            result.name = container.getString(reader.find(resultValue, "name"));
+            result.peakMemoryBytes = size_t(reader.findFloat(resultValue, "peakMemoryBytes"));
+
+            const JSONValue phasesValue = reader.find(resultValue, "phases");
+            if (phasesValue.getKind() == JSONValue::Kind::Object)
+            {
+                for (const auto& phase : container.getObject(phasesValue))
+                {
+                    PhaseStats stats;
+                    stats.min = reader.findFloat(phase.value, "min");
+                    stats.median = reader.findFloat(phase.value, "median");
+                    stats.mean = reader.findFloat(phase.value, "mean");
+                    stats.max = reader.findFloat(phase.value, "max");
+                    result.phases.Add(container.getStringFromKey(phase.key), stats);
+                }
+            }
+            results.add(result);
+        }
+    }
+
+    return SLANG_OK;
+}
+
+const BenchmarkResult* BenchmarkResults::findResult(const String& name) const
+{
+    for (const auto& result : results)
+    {
+        if (result.name == name)
+        {
+            return &result;
+        }
+    }
+    return nullptr;
+}
+
+namespace { // anonymous
+
+enum class Change
+{
+    None,
+    Improvement,
+    Regression,
+};
+
+} // anonymous
+
+static Change _calcChange(double baseline, double current, double thresholdPercent, double minDelta)
+{
+    const double delta = current - baseline;
+    const double threshold = baseline * thresholdPercent / 100.0;
+    if (delta > minDelta && delta > threshold)
+    {
+        return Change::Regression;
+    }
+    if (-delta > minDelta && -delta > threshold)
+    {
+        return Change::Improvement;
+    }
+    return Change::None;
+}
+
+static void _writeChange(Change change, const String& name, const char* what, double baseline, double current, const char* units, StringBuilder& out)
+{
+    out << ((change == Change::Regression) ? "REGRESSION  " : "improvement ") << name << " " << what << ": ";
+    out.append(baseline, "%.3f");
+    out << units << " -> ";
+    out.append(current, "%.3f");
+    out << units << " (";
+    if (baseline > 0.0)
+    {
+        const double percent = (current - baseline) * 100.0 / baseline;
+        out << (percent >= 0.0 ? "+" : "");
+        out.append(percent, "%.1f");
+        out << "%";
+    }
+    else
+    {
+        out << "new";
+    }
+    out << ")\n";
+}
+
+/* static */Index BenchmarkResults::compare(const BenchmarkResults& baseline, const BenchmarkResults& current, const BenchmarkCompareOptions& options, StringBuilder& out)
+{
+    Index regressionCount = 0;
+
+    for (const auto& result : current.results)
+    {
+        const BenchmarkResult* baselineResult = baseline.findResult(result.name);
+        if (!baselineResult)
+        {
+            out << "note: '" << result.name << "' is not in the baseline\n";
+            continue;
+        }
+
+        for (const auto& pair : result.phases)
+        {
+            const PhaseStats* baselineStats = baselineResult->phases.TryGetValue(pair.Key);
+            if (!baselineStats)
+            {
+                continue;
+            }
+
+            const double baselineMs = baselineStats->median;
+            const double currentMs = pair.Value.median;
+            const Change change = _calcChange(baselineMs, currentMs, options.thresholdPercent, options.minDeltaMs);
+            if (change != Change::None)
+            {
+                regressionCount += Index(change == Change::Regression);
+                _writeChange(change, result.name, pair.Key.getBuffer(), baselineMs, currentMs, "ms", out);
+            }
+        }
+
+        if (baselineResult->peakMemoryBytes && result.peakMemoryBytes)
+        {
+            const double megabyte = 1024.0 * 1024.0;
+            const double baselineMB = double(baselineResult->peakMemoryBytes) / megabyte;
+            const double currentMB = double(result.peakMemoryBytes) / megabyte;
+            const Change change = _calcChange(baselineMB, currentMB, options.thresholdPercent, options.minDeltaBytes / megabyte);
+            if (change != Change::None)
+            {
+                regressionCount += Index(change == Change::Regression);
+                _writeChange(change, result.name, "peak memory", baselineMB, currentMB, "MB", out);
+            }
+        }
+    }
+
+    for (const auto& baselineResult : baseline.results)
+    {
+        if (!current.findResult(baselineResult.name))
+        {
+            out << "note: '" << baselineResult.name << "' was not run\n";
+        }
+    }
+
+    return regressionCount;
+}
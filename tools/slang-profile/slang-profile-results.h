@@ -0,0 +1,70 @@
+// slang-profile-results.h
+
+#ifndef SLANG_PROFILE_RESULTS_H_INCLUDED
+#define SLANG_PROFILE_RESULTS_H_INCLUDED
+
+#include "../../source/core/slang-basic.h"
+#include "../../source/core/slang-writer.h"
+
+// Statistics for the times (in milliseconds) taken by a phase over the measured runs
+struct PhaseStats
+{
+    static PhaseStats calc(const Slang::List<double>& samples);
+
+    double min = 0.0;
+    double median = 0.0;
+    double mean = 0.0;
+    double max = 0.0;
+};
+
+// The times taken by each phase, for each measured run
+struct PhaseSamples
+{
+        /// Add the time taken by a phase in a run. Multiple times for the same phase in one run should be summed before adding.
+    void add(const Slang::String& phase, double ms);
+
+    Slang::OrderedDictionary<Slang::String, Slang::List<double>> samples;
+};
+
+// The result of benchmarking one case (or the session setup)
+struct BenchmarkResult
+{
+        /// Set the phases from the samples
+    void setPhases(const PhaseSamples& phaseSamples);
+
+    Slang::String name;
+    Slang::OrderedDictionary<Slang::String, PhaseStats> phases;
+    size_t peakMemoryBytes = 0;         ///< The peak resident memory of the process after the case has run
+};
+
+// Controls what is considered a change when comparing results
+struct BenchmarkCompareOptions
+{
+    double thresholdPercent = 10.0;     ///< A median time or peak memory must change by more than this percentage
+    double minDeltaMs = 1.0;            ///< and a time must change by at least this many milliseconds
+    double minDeltaBytes = 4.0 * 1024 * 1024;   ///< or memory by this many bytes
+};
+
+struct BenchmarkResults
+{
+        /// Write the results as JSON
+    void writeJSON(Slang::StringBuilder& out) const;
+        /// Write the median times of the results as a human readable table
+    void writeSummary(Slang::StringBuilder& out) const;
+
+        /// Read results previously written with `writeJSON`
+    SlangResult readJSON(const Slang::String& path, Slang::WriterHelper stdError);
+
+        /// Find the result with the name, or nullptr if not found
+    const BenchmarkResult* findResult(const Slang::String& name) const;
+
+        /// Compare `current` against `baseline`, writing the changes to out. Returns the number of regressions.
+    static Slang::Index compare(const BenchmarkResults& baseline, const BenchmarkResults& current, const BenchmarkCompareOptions& options, Slang::StringBuilder& out);
+
+    Slang::Index warmupCount = 0;
+    Slang::Index repeatCount = 0;
+    Slang::List<Slang::String> targets;
+    Slang::List<BenchmarkResult> results;
+};
+
+#endif
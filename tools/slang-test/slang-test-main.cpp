@@ -1532,6 +1532,19 @@ TestResult runLanguageServerTest(TestContext* context, TestInput& input)
     Path::getCanonical(input.filePath, fullPath);
     wsFolder.uri = URI::fromLocalFilePath(Path::getParentDirectory(fullPath).getUnownedSlice()).uri;
     initParams.workspaceFolders.add(wsFolder);
+
+    String testFileContent;
+    if (SLANG_FAILED(File::readAllText(input.filePath, testFileContent)))
+    {
+        return TestResult::Fail;
+    }
+
+    // The server traces how it creates workspace versions, for //VERSION
+    if (testFileContent.indexOf(UnownedStringSlice("//VERSION")) >= 0)
+    {
+        initParams.trace = "verbose";
+    }
+
     if (SLANG_FAILED(connection->sendCall(
             LanguageServerProtocol::InitializeParams::methodName, &initParams, JSONValue::makeInt(0))))
     {
@@ -1549,13 +1562,6 @@ TestResult runLanguageServerTest(TestContext* context, TestInput& input)
     }
 
     // Send open document call.
-    String testFileContent;
-
-    if (SLANG_FAILED(File::readAllText(input.filePath, testFileContent)))
-    {
-        return TestResult::Fail;
-    }
-
     LanguageServerProtocol::DidOpenTextDocumentParams openDocParams;
     openDocParams.textDocument.version = 0;
     openDocParams.textDocument.uri = URI::fromLocalFilePath(fullPath.getUnownedSlice()).uri;
@@ -1566,6 +1572,7 @@ TestResult runLanguageServerTest(TestContext* context, TestInput& input)
         JSONValue::makeInt(1));
     List<LanguageServerProtocol::PublishDiagnosticsParams> diagnostics;
     bool diagnosticsReceived = false;
+    List<String> logMessages;
     auto waitForNonDiagnosticResponse = [&]() -> SlangResult
     {
         repeat:
@@ -1584,6 +1591,14 @@ TestResult runLanguageServerTest(TestContext* context, TestInput& input)
                 diagnostics.add(arg);
                 goto repeat;
             }
+            if (call.method == LanguageServerProtocol::LogMessageParams::methodName)
+            {
+                LanguageServerProtocol::LogMessageParams arg;
+                if (SLANG_FAILED(connection->getMessage(&arg)))
+                    return SLANG_FAIL;
+                logMessages.add(arg.message);
+                goto repeat;
+            }
         }
         return SLANG_OK;
     };
@@ -1600,6 +1615,14 @@ TestResult runLanguageServerTest(TestContext* context, TestInput& input)
         return startPos;
     };
     int callId = 2;
+    int docVersion = 0;
+    // The URIs of the documents opened by //OPEN, other than the test file
+    List<String> openedDocUris;
+    auto getSiblingDocUri = [&](UnownedStringSlice fileName)
+    {
+        String path = Path::combine(Path::getParentDirectory(fullPath), fileName);
+        return URI::fromLocalFilePath(path.getUnownedSlice()).uri;
+    };
     for (auto line : lines)
     {
         if (line.startsWith("//COMPLETE:"))
@@ -1715,6 +1738,122 @@ TestResult runLanguageServerTest(TestContext* context, TestInput& input)
                 actualOutputSB << "\ncontent:\n" << hover.contents.value << "\n";
             }
         }
+        else if (line.startsWith("//CANCEL:"))
+        {
+            // Send a hover request, and before it is answered, a change to the document (that
+            // leaves its text as it was) which makes the result of the hover stale. The server
+            // either cancels the check the hover runs, or doesn't run it, or (if the check
+            // finished first) answers it, depending on timing. So only that it was answered is
+            // output, and requests that follow test the server after the cancellation.
+            auto arg = line.tail(UnownedStringSlice("//CANCEL:").getLength());
+            Int linePos, colPos;
+            parseLocation(arg, 0, linePos, colPos);
+
+            LanguageServerProtocol::HoverParams params;
+            params.position.line = int(linePos - 1);
+            params.position.character = int(colPos - 1);
+            params.textDocument.uri = openDocParams.textDocument.uri;
+            if (SLANG_FAILED(connection->sendCall(
+                    LanguageServerProtocol::HoverParams::methodName,
+                    &params,
+                    JSONValue::makeInt(callId++))))
+            {
+                return TestResult::Fail;
+            }
+
+            LanguageServerProtocol::DidChangeTextDocumentParams changeDocParams;
+            changeDocParams.textDocument.uri = openDocParams.textDocument.uri;
+            changeDocParams.textDocument.version = ++docVersion;
+            LanguageServerProtocol::TextDocumentContentChangeEvent change;
+            change.range.start.line = 0;
+            change.range.start.character = 0;
+            change.range.end = change.range.start;
+            changeDocParams.contentChanges.add(change);
+            connection->sendCall(
+                LanguageServerProtocol::DidChangeTextDocumentParams::methodName,
+                &changeDocParams,
+                JSONValue::makeInt(1));
+
+            if (SLANG_FAILED(waitForNonDiagnosticResponse()))
+                return TestResult::Fail;
+            actualOutputSB << "--------\n";
+            actualOutputSB << "answered\n";
+        }
+        else if (line.startsWith("//OPEN:"))
+        {
+            // Open a file in the directory of the test file as a document, such that it can be
+            // changed with //EDIT
+            auto fileName = line.tail(UnownedStringSlice("//OPEN:").getLength()).trim();
+            String content;
+            if (SLANG_FAILED(File::readAllText(Path::combine(Path::getParentDirectory(fullPath), fileName), content)))
+            {
+                return TestResult::Fail;
+            }
+            LanguageServerProtocol::DidOpenTextDocumentParams params;
+            params.textDocument.version = 0;
+            params.textDocument.uri = getSiblingDocUri(fileName);
+            params.textDocument.text = content;
+            connection->sendCall(
+                LanguageServerProtocol::DidOpenTextDocumentParams::methodName,
+                &params,
+                JSONValue::makeInt(1));
+            openedDocUris.add(params.textDocument.uri);
+        }
+        else if (line.startsWith("//EDIT:"))
+        {
+            // //EDIT:<file>,<count>:<text>
+            // Replace the contents of a document opened by //OPEN with `text`, `count` times. After
+            // each change a hover request on the test file makes the server create a new version
+            // of the workspace. The hover result isn't output.
+            auto arg = line.tail(UnownedStringSlice("//EDIT:").getLength());
+            const Index commaIndex = arg.indexOf(',');
+            const Index colonIndex = arg.indexOf(':');
+            if (commaIndex < 0 || colonIndex < commaIndex)
+            {
+                return TestResult::Fail;
+            }
+            auto fileName = arg.head(commaIndex).trim();
+            Index pos = commaIndex + 1;
+            const Int count = StringUtil::parseIntAndAdvancePos(arg, pos);
+            const String text = arg.tail(colonIndex + 1);
+
+            for (Int i = 0; i < count; ++i)
+            {
+                LanguageServerProtocol::DidChangeTextDocumentParams changeDocParams;
+                changeDocParams.textDocument.uri = getSiblingDocUri(fileName);
+                changeDocParams.textDocument.version = ++docVersion;
+                // Without a range, the change replaces the whole document
+                LanguageServerProtocol::TextDocumentContentChangeEvent change;
+                change.text = text;
+                changeDocParams.contentChanges.add(change);
+                connection->sendCall(
+                    LanguageServerProtocol::DidChangeTextDocumentParams::methodName,
+                    &changeDocParams,
+                    JSONValue::makeInt(1));
+
+                LanguageServerProtocol::HoverParams params;
+                params.position.line = 0;
+                params.position.character = 0;
+                params.textDocument.uri = openDocParams.textDocument.uri;
+                if (SLANG_FAILED(connection->sendCall(
+                        LanguageServerProtocol::HoverParams::methodName,
+                        &params,
+                        JSONValue::makeInt(callId++))))
+                {
+                    return TestResult::Fail;
+                }
+                if (SLANG_FAILED(waitForNonDiagnosticResponse()))
+                    return TestResult::Fail;
+            }
+        }
+        else if (line.startsWith("//VERSION"))
+        {
+            // Output how the server created the last version of the workspace, which it reports
+            // with a log message when tracing
+            actualOutputSB << "--------\n";
+            actualOutputSB << (logMessages.getCount() ? logMessages.getLast() : String("none")) << "\n";
+            logMessages.clear();
+        }
         else if (line.startsWith("//DIAGNOSTICS"))
         {
             if (!diagnosticsReceived)
@@ -1734,12 +1873,16 @@ TestResult runLanguageServerTest(TestContext* context, TestInput& input)
             }
         }
     }
-    LanguageServerProtocol::DidCloseTextDocumentParams closeDocParams;
-    closeDocParams.textDocument.uri = URI::fromLocalFilePath(fullPath.getUnownedSlice()).uri;
-    connection->sendCall(
-        LanguageServerProtocol::DidCloseTextDocumentParams::methodName,
-        &closeDocParams,
-        JSONValue::makeInt(1));
+    openedDocUris.add(URI::fromLocalFilePath(fullPath.getUnownedSlice()).uri);
+    for (auto& uri : openedDocUris)
+    {
+        LanguageServerProtocol::DidCloseTextDocumentParams closeDocParams;
+        closeDocParams.textDocument.uri = uri;
+        connection->sendCall(
+            LanguageServerProtocol::DidCloseTextDocumentParams::methodName,
+            &closeDocParams,
+            JSONValue::makeInt(1));
+    }
 
     auto outputStem = input.outputStem;
     String expectedOutputPath = outputStem + ".expected.txt";
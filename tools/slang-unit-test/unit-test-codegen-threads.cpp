@@ -0,0 +1,220 @@
+// unit-test-codegen-threads.cpp
+
+#include "../../slang.h"
+#include "../../slang-com-ptr.h"
+
+#include "../../source/core/slang-basic.h"
+
+#include "tools/unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+static const char kCodeGenThreadsFileName[] = "codegen-threads.slang";
+
+// Entry points that generate code, and entry points whose code generation fails with a
+// diagnostic (a loop that can't be unrolled, as its bound isn't known at compile time)
+static const char kCodeGenThreadsSource[] = R"(
+    RWStructuredBuffer<int> gBuffer;
+
+    int scaleBy<let N : int>(int value)
+    {
+        return value * N;
+    }
+
+    [shader("compute")]
+    [numthreads(4, 1, 1)]
+    void scaleMain(uint3 tid : SV_DispatchThreadID)
+    {
+        gBuffer[tid.x] = scaleBy<3>(int(tid.x));
+    }
+
+    [shader("compute")]
+    [numthreads(4, 1, 1)]
+    void sumMain(uint3 tid : SV_DispatchThreadID)
+    {
+        int sum = 0;
+        for (int i = 0; i < int(tid.y); i++)
+            sum += gBuffer[i];
+        gBuffer[tid.x] = sum;
+    }
+
+    [shader("compute")]
+    [numthreads(4, 1, 1)]
+    void genericMain(uint3 tid : SV_DispatchThreadID)
+    {
+        gBuffer[tid.x] = scaleBy<2>(int(tid.x)) + scaleBy<3>(int(tid.y));
+    }
+
+    [shader("compute")]
+    [numthreads(4, 1, 1)]
+    void unrollMainA(uint3 tid : SV_DispatchThreadID)
+    {
+        [ForceUnroll]
+        for (int a = 0; a < int(tid.y); a++)
+            gBuffer[a] = a;
+    }
+
+    [shader("compute")]
+    [numthreads(4, 1, 1)]
+    void unrollMainB(uint3 tid : SV_DispatchThreadID)
+    {
+        [ForceUnroll]
+        for (int b = 0; b < int(tid.z); b++)
+            gBuffer[b] = b;
+    }
+)";
+
+static const SlangCompileTarget kCodeGenThreadsTargets[] = { SLANG_HLSL, SLANG_GLSL };
+
+namespace { // anonymous
+
+struct CodeGenThreadsResult
+{
+    SlangResult result = SLANG_OK;
+    List<String> codes;         ///< The code for each entry point and target, if compilation succeeded
+    String diagnostics;
+};
+
+} // anonymous
+
+    /// Compile the entry points for all of the targets, generating the code of entry points with
+    /// `codeGenThreadCount` threads
+static CodeGenThreadsResult _compileWithCodeGenThreads(SlangSession* session, const List<const char*>& entryPointNames, int codeGenThreadCount)
+{
+    CodeGenThreadsResult out;
+
+    auto request = spCreateCompileRequest(session);
+
+    for (auto target : kCodeGenThreadsTargets)
+    {
+        spAddCodeGenTarget(request, target);
+    }
+
+    spSetCodeGenThreadCount(request, codeGenThreadCount);
+
+    const int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "codeGenThreads");
+    spAddTranslationUnitSourceString(request, translationUnitIndex, kCodeGenThreadsFileName, kCodeGenThreadsSource);
+
+    for (auto entryPointName : entryPointNames)
+    {
+        spAddEntryPoint(request, translationUnitIndex, entryPointName, SLANG_STAGE_COMPUTE);
+    }
+
+    out.result = spCompile(request);
+    out.diagnostics = spGetDiagnosticOutput(request);
+
+    for (Index i = 0; SLANG_SUCCEEDED(out.result) && i < entryPointNames.getCount(); ++i)
+    {
+        for (Index j = 0; SLANG_SUCCEEDED(out.result) && j < SLANG_COUNT_OF(kCodeGenThreadsTargets); ++j)
+        {
+            ComPtr<ISlangBlob> codeBlob;
+            out.result = spGetEntryPointCodeBlob(request, int(i), int(j), codeBlob.writeRef());
+            if (SLANG_SUCCEEDED(out.result))
+            {
+                const char* code = (const char*)codeBlob->getBufferPointer();
+                out.codes.add(String(code, code + codeBlob->getBufferSize()));
+            }
+        }
+    }
+
+    spDestroyCompileRequest(request);
+    return out;
+}
+
+    /// Get the index in `diagnostics` of the diagnostic for the line of the source containing `text`,
+    /// or -1 if there isn't one
+static Index _findDiagnosticForLine(const String& diagnostics, const char* text)
+{
+    const UnownedStringSlice source(kCodeGenThreadsSource);
+    const Index textIndex = source.indexOf(UnownedStringSlice(text));
+    if (textIndex < 0)
+    {
+        return -1;
+    }
+
+    Index line = 1;
+    for (Index i = 0; i < textIndex; ++i)
+    {
+        line += (source[i] == '\n') ? 1 : 0;
+    }
+
+    StringBuilder buf;
+    buf << kCodeGenThreadsFileName << "(" << line << "): error";
+    return diagnostics.indexOf(buf.ProduceString());
+}
+
+// Test that code generated for entry points with several threads is the same as the code
+// generated serially, and that the diagnostics of the entry points are output in entry point
+// order, whichever thread finishes first.
+SLANG_UNIT_TEST(codeGenThreads)
+{
+    auto session = spCreateSession();
+
+    // With several threads, and with as many threads as the hardware has (0)
+    const int codeGenThreadCounts[] = { 2, 4, 0 };
+
+    {
+        const List<const char*> entryPointNames = { "scaleMain", "unrollMainA", "sumMain", "genericMain" };
+        const List<const char*> succeedingEntryPointNames = { "scaleMain", "sumMain", "genericMain" };
+
+        // Code generation succeeds, and the code is the same for any number of threads
+        const CodeGenThreadsResult expected = _compileWithCodeGenThreads(session, succeedingEntryPointNames, 1);
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(expected.result));
+        SLANG_CHECK_ABORT(expected.codes.getCount() == succeedingEntryPointNames.getCount() * SLANG_COUNT_OF(kCodeGenThreadsTargets));
+
+        for (auto& code : expected.codes)
+        {
+            SLANG_CHECK(code.getLength() > 0);
+        }
+
+        for (auto codeGenThreadCount : codeGenThreadCounts)
+        {
+            const CodeGenThreadsResult result = _compileWithCodeGenThreads(session, succeedingEntryPointNames, codeGenThreadCount);
+            SLANG_CHECK(SLANG_SUCCEEDED(result.result));
+            SLANG_CHECK(result.codes == expected.codes);
+        }
+
+        // Code generation for one of the entry points fails, with the same diagnostics for any number of threads
+        const CodeGenThreadsResult expectedFailure = _compileWithCodeGenThreads(session, entryPointNames, 1);
+        SLANG_CHECK(SLANG_FAILED(expectedFailure.result));
+        SLANG_CHECK(_findDiagnosticForLine(expectedFailure.diagnostics, "int a = 0") >= 0);
+
+        for (auto codeGenThreadCount : codeGenThreadCounts)
+        {
+            const CodeGenThreadsResult result = _compileWithCodeGenThreads(session, entryPointNames, codeGenThreadCount);
+            SLANG_CHECK(SLANG_FAILED(result.result));
+            SLANG_CHECK(result.diagnostics == expectedFailure.diagnostics);
+        }
+    }
+
+    {
+        // Code generation for two of the entry points fails. Serially, the first failure stops the
+        // diagnostics of later entry points (as they share a sink which then has errors), so the
+        // diagnostics are the same as with several threads up to the end of the first failure's.
+        const List<const char*> entryPointNames = { "scaleMain", "unrollMainA", "sumMain", "unrollMainB" };
+
+        const CodeGenThreadsResult serialResult = _compileWithCodeGenThreads(session, entryPointNames, 1);
+        SLANG_CHECK(SLANG_FAILED(serialResult.result));
+        SLANG_CHECK(_findDiagnosticForLine(serialResult.diagnostics, "int a = 0") >= 0);
+
+        String expectedDiagnostics;
+        for (auto codeGenThreadCount : codeGenThreadCounts)
+        {
+            const CodeGenThreadsResult result = _compileWithCodeGenThreads(session, entryPointNames, codeGenThreadCount);
+            SLANG_CHECK(SLANG_FAILED(result.result));
+            SLANG_CHECK(result.diagnostics.startsWith(serialResult.diagnostics));
+
+            const Index indexA = _findDiagnosticForLine(result.diagnostics, "int a = 0");
+            const Index indexB = _findDiagnosticForLine(result.diagnostics, "int b = 0");
+            SLANG_CHECK(indexA >= 0 && indexB > indexA);
+
+            if (expectedDiagnostics.getLength() == 0)
+            {
+                expectedDiagnostics = result.diagnostics;
+            }
+            SLANG_CHECK(result.diagnostics == expectedDiagnostics);
+        }
+    }
+
+    spDestroySession(session);
+}
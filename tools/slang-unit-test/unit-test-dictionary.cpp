@@ -0,0 +1,181 @@
+// unit-test-dictionary.cpp
+
+#include "source/core/slang-basic.h"
+#include "source/core/slang-random-generator.h"
+#include "tools/unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+namespace { // anonymous
+
+// A 'bad' hash, so that many keys have the same start position and long probe sequences,
+// wrap around and tombstones are exercised.
+struct CollidingKey
+{
+    int value;
+
+    HashCode getHashCode() const { return HashCode(value & 3); }
+    bool operator==(const CollidingKey& rhs) const { return value == rhs.value; }
+};
+
+} // anonymous
+
+template <typename DictType>
+static bool _checkMatchesReference(DictType& dict, const List<int>& reference)
+{
+    Index count = 0;
+    for (Index i = 0; i < reference.getCount(); ++i)
+    {
+        auto valuePtr = dict.TryGetValue(int(i));
+        if (reference[i] < 0)
+        {
+            if (valuePtr)
+                return false;
+        }
+        else
+        {
+            if (!valuePtr || *valuePtr != reference[i])
+                return false;
+            count++;
+        }
+    }
+    if (dict.Count() != count)
+        return false;
+
+    // Iteration must visit each entry once
+    Index iteratedCount = 0;
+    for (const auto& pair : dict)
+    {
+        if (pair.Key < 0 || pair.Key >= reference.getCount() || reference[pair.Key] != pair.Value)
+            return false;
+        iteratedCount++;
+    }
+    return iteratedCount == count;
+}
+
+template <typename DictType>
+static void _randomOperations(RandomGenerator* rand, Index keyRange, Index opCount)
+{
+    DictType dict;
+    List<int> reference;
+    reference.setCount(keyRange);
+    for (auto& v : reference)
+        v = -1;
+
+    for (Index i = 0; i < opCount; ++i)
+    {
+        const int key = rand->nextInt32InRange(0, int32_t(keyRange));
+        const int value = int(i);
+        switch (rand->nextInt32InRange(0, 4))
+        {
+            case 0:
+            {
+                dict.Remove(key);
+                reference[key] = -1;
+                break;
+            }
+            case 1:
+            {
+                const bool added = dict.AddIfNotExists(key, value);
+                SLANG_CHECK(added == (reference[key] < 0));
+                if (added)
+                    reference[key] = value;
+                break;
+            }
+            case 2:
+            {
+                dict[key] = value;
+                reference[key] = value;
+                break;
+            }
+            default:
+            {
+                SLANG_CHECK(dict.ContainsKey(key) == (reference[key] >= 0));
+                break;
+            }
+        }
+    }
+
+    SLANG_CHECK(_checkMatchesReference(dict, reference));
+
+    // Copies and moves must hold the same entries
+    DictType copy(dict);
+    SLANG_CHECK(_checkMatchesReference(copy, reference));
+    DictType moved(_Move(copy));
+    SLANG_CHECK(_checkMatchesReference(moved, reference));
+    SLANG_CHECK(copy.Count() == 0);
+
+    dict.Clear();
+    SLANG_CHECK(dict.Count() == 0 && dict.begin() == dict.end());
+    dict.Add(1, 2);
+    SLANG_CHECK(dict.Count() == 1 && dict.TryGetValue(1) && *dict.TryGetValue(1) == 2);
+}
+
+SLANG_UNIT_TEST(dictionary)
+{
+    RefPtr<RandomGenerator> rand = RandomGenerator::create(0x1234);
+
+    // Small key ranges mean lots of removes and re-adds in a small table, large ones grow the table
+    _randomOperations<Dictionary<int, int>>(rand, 10, 1000);
+    _randomOperations<Dictionary<int, int>>(rand, 100, 10000);
+    _randomOperations<Dictionary<int, int>>(rand, 5000, 50000);
+
+    _randomOperations<OrderedDictionary<int, int>>(rand, 10, 1000);
+    _randomOperations<OrderedDictionary<int, int>>(rand, 5000, 50000);
+
+    // Keys that all collide
+    {
+        Dictionary<CollidingKey, int> dict;
+        const int count = 200;
+        for (int i = 0; i < count; ++i)
+        {
+            dict.Add(CollidingKey{i}, i);
+        }
+        for (int i = 0; i < count; i += 2)
+        {
+            dict.Remove(CollidingKey{i});
+        }
+        for (int i = 0; i < count; ++i)
+        {
+            auto valuePtr = dict.TryGetValue(CollidingKey{i});
+            SLANG_CHECK((i & 1) ? (valuePtr && *valuePtr == i) : (valuePtr == nullptr));
+        }
+        // Re-adding should reuse the removed slots
+        for (int i = 0; i < count; i += 2)
+        {
+            SLANG_CHECK(dict.AddIfNotExists(CollidingKey{i}, i));
+        }
+        SLANG_CHECK(dict.Count() == count);
+    }
+
+    // OrderedDictionary iterates in insertion order, regardless of removes
+    {
+        OrderedDictionary<String, int> dict;
+        for (int i = 0; i < 100; ++i)
+        {
+            dict.Add(String(i), i);
+        }
+        for (int i = 0; i < 100; i += 3)
+        {
+            dict.Remove(String(i));
+        }
+        int prev = -1;
+        bool inOrder = true;
+        for (const auto& pair : dict)
+        {
+            inOrder = inOrder && (pair.Value > prev) && (pair.Value % 3 != 0);
+            prev = pair.Value;
+        }
+        SLANG_CHECK(inOrder);
+    }
+
+    // HashSet
+    {
+        HashSet<String> set;
+        SLANG_CHECK(set.Add("a"));
+        SLANG_CHECK(set.Add("b"));
+        SLANG_CHECK(!set.Add("a"));
+        set.Remove("a");
+        SLANG_CHECK(!set.Contains("a") && set.Contains("b") && set.Count() == 1);
+    }
+}
@@ -0,0 +1,233 @@
+// unit-test-downstream-compile-cache.cpp
+
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-file-system.h"
+#include "../../source/core/slang-blob.h"
+
+#include "../../source/compiler-core/slang-downstream-compile-cache.h"
+#include "../../source/compiler-core/slang-artifact-associated-impl.h"
+#include "../../source/compiler-core/slang-artifact-desc-util.h"
+#include "../../source/compiler-core/slang-artifact-util.h"
+
+#include "tools/unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+namespace { // anonymous
+
+// A compiler that produces a product holding the number of times it has been invoked,
+// so it's possible to tell if a product came from the cache
+class CountingDownstreamCompiler : public DownstreamCompilerBase
+{
+public:
+    typedef DownstreamCompilerBase Super;
+
+    // IDownstreamCompiler
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL compile(const CompileOptions& options, IArtifact** outArtifact) SLANG_OVERRIDE
+    {
+        m_compileCount++;
+        if (m_failCompile)
+        {
+            return SLANG_FAIL;
+        }
+
+        auto diagnostics = ArtifactDiagnostics::create();
+        if (m_produceError)
+        {
+            ArtifactDiagnostic diagnostic;
+            diagnostic.severity = ArtifactDiagnostic::Severity::Error;
+            diagnostic.text = TerminatedCharSlice("counting compiler error");
+            diagnostics->add(diagnostic);
+            diagnostics->setResult(SLANG_FAIL);
+        }
+
+        StringBuilder buf;
+        buf << "product " << m_compileCount;
+
+        auto artifact = ArtifactUtil::createArtifact(ArtifactDescUtil::makeDescForCompileTarget(options.targetType));
+        artifact->addRepresentationUnknown(StringBlob::create(buf));
+        artifact->addAssociated(diagnostics);
+
+        *outArtifact = artifact.detach();
+        return SLANG_OK;
+    }
+    virtual SLANG_NO_THROW bool SLANG_MCALL isFileBased() SLANG_OVERRIDE { return false; }
+
+    CountingDownstreamCompiler(const Desc& desc) : Super(desc) {}
+
+    Count m_compileCount = 0;
+    bool m_failCompile = false;         ///< If set compile returns a failure
+    bool m_produceError = false;        ///< If set compile produces a product with an error diagnostic
+};
+
+struct DownstreamCompileCacheTest
+{
+    DownstreamCompileCacheTest()
+    {
+        osFileSystem = OSFileSystem::getMutableSingleton();
+        directory = Path::simplify(Path::getParentDirectory(Path::getExecutablePath()) + "/downstream-compile-cache-test");
+        cacheDirectory = Path::combine(directory, "cache");
+
+        removeFiles();
+        Path::createDirectory(directory);
+
+        PersistentCache::Desc desc;
+        desc.directory = cacheDirectory.getBuffer();
+        cache = new PersistentCache(desc);
+
+        includePath = TerminatedCharSlice(directory.getBuffer(), directory.getLength());
+        options.targetType = SLANG_SHADER_SHARED_LIBRARY;
+        options.includePaths = makeSlice(&includePath, 1);
+    }
+    ~DownstreamCompileCacheTest()
+    {
+        cache.setNull();
+        removeFiles();
+    }
+
+    void setSource(const char* text)
+    {
+        auto artifact = ArtifactUtil::createArtifact(ArtifactDesc::make(ArtifactKind::Source, ArtifactPayload::C, ArtifactStyle::Unknown));
+        artifact->addRepresentationUnknown(StringBlob::create(text));
+        sourceArtifact = artifact;
+        options.sourceArtifacts = makeSlice(sourceArtifact.readRef(), 1);
+    }
+
+        /// Compile with the cache, returning the product as a string
+    String compile(IDownstreamCompiler* compiler)
+    {
+        ComPtr<IArtifact> artifact;
+        if (SLANG_FAILED(DownstreamCompileCacheUtil::compile(cache, compiler, options, artifact.writeRef())))
+        {
+            return String();
+        }
+        ComPtr<ISlangBlob> blob;
+        if (SLANG_FAILED(artifact->loadBlob(ArtifactKeep::No, blob.writeRef())))
+        {
+            return String();
+        }
+        return String((const char*)blob->getBufferPointer(), (const char*)blob->getBufferPointer() + blob->getBufferSize());
+    }
+
+    void removeFiles()
+    {
+        _removeDirectory(cacheDirectory);
+        _removeDirectory(directory);
+    }
+
+    ISlangMutableFileSystem* osFileSystem;
+    String directory;
+    String cacheDirectory;
+    RefPtr<PersistentCache> cache;
+
+    TerminatedCharSlice includePath;
+    ComPtr<IArtifact> sourceArtifact;
+    DownstreamCompileOptions options;
+
+protected:
+    void _removeDirectory(const String& path)
+    {
+        struct Context
+        {
+            ISlangMutableFileSystem* fileSystem;
+            const String* path;
+        } context = { osFileSystem, &path };
+
+        osFileSystem->enumeratePathContents(
+            path.getBuffer(),
+            [](SlangPathType pathType, const char* fileName, void* userData)
+            {
+                auto ctx = (Context*)userData;
+                if (pathType == SLANG_PATH_TYPE_FILE)
+                {
+                    ctx->fileSystem->remove(Path::combine(*ctx->path, fileName).getBuffer());
+                }
+            },
+            &context);
+        osFileSystem->remove(path.getBuffer());
+    }
+};
+
+} // anonymous
+
+SLANG_UNIT_TEST(downstreamCompileCache)
+{
+    DownstreamCompileCacheTest test;
+
+    ComPtr<CountingDownstreamCompiler> compiler(new CountingDownstreamCompiler(DownstreamCompilerDesc(SLANG_PASS_THROUGH_GENERIC_C_CPP, 1, 0)));
+
+    const String headerPath = Path::combine(test.directory, "cache-test-header.h");
+    File::writeAllText(headerPath, "int header() { return 1; }\n");
+
+    test.setSource("#include \"cache-test-header.h\"\nint main() { return header(); }\n");
+
+    // An identical compile hits
+    {
+        SLANG_CHECK(test.compile(compiler) == "product 1");
+        SLANG_CHECK(test.compile(compiler) == "product 1");
+        SLANG_CHECK(compiler->m_compileCount == 1);
+    }
+
+    // Changing the source misses
+    {
+        test.setSource("#include \"cache-test-header.h\"\nint main() { return header() + 1; }\n");
+        SLANG_CHECK(test.compile(compiler) == "product 2");
+        SLANG_CHECK(test.compile(compiler) == "product 2");
+        SLANG_CHECK(compiler->m_compileCount == 2);
+    }
+
+    // Changing an included header misses
+    {
+        File::writeAllText(headerPath, "int header() { return 2; }\n");
+        SLANG_CHECK(test.compile(compiler) == "product 3");
+        SLANG_CHECK(test.compile(compiler) == "product 3");
+        SLANG_CHECK(compiler->m_compileCount == 3);
+    }
+
+    // Changing an option misses
+    {
+        test.options.optimizationLevel = DownstreamCompileOptions::OptimizationLevel::Maximal;
+        SLANG_CHECK(test.compile(compiler) == "product 4");
+        SLANG_CHECK(test.compile(compiler) == "product 4");
+        SLANG_CHECK(compiler->m_compileCount == 4);
+    }
+
+    // Changing the compiler version misses
+    {
+        ComPtr<CountingDownstreamCompiler> newerCompiler(new CountingDownstreamCompiler(DownstreamCompilerDesc(SLANG_PASS_THROUGH_GENERIC_C_CPP, 1, 1)));
+        SLANG_CHECK(test.compile(newerCompiler) == "product 1");
+        SLANG_CHECK(newerCompiler->m_compileCount == 1);
+
+        // The products of both versions are held
+        SLANG_CHECK(test.compile(compiler) == "product 4");
+        SLANG_CHECK(compiler->m_compileCount == 4);
+    }
+
+    // Compiles that fail are not cached
+    {
+        test.options.optimizationLevel = DownstreamCompileOptions::OptimizationLevel::None;
+
+        compiler->m_failCompile = true;
+        SLANG_CHECK(test.compile(compiler) == "");
+        SLANG_CHECK(compiler->m_compileCount == 5);
+        compiler->m_failCompile = false;
+
+        SLANG_CHECK(test.compile(compiler) == "product 6");
+        SLANG_CHECK(compiler->m_compileCount == 6);
+    }
+
+    // Compiles that produce errors are not cached
+    {
+        test.options.optimizationLevel = DownstreamCompileOptions::OptimizationLevel::High;
+
+        compiler->m_produceError = true;
+        SLANG_CHECK(test.compile(compiler) == "product 7");
+        SLANG_CHECK(test.compile(compiler) == "product 8");
+        SLANG_CHECK(compiler->m_compileCount == 8);
+        compiler->m_produceError = false;
+
+        SLANG_CHECK(test.compile(compiler) == "product 9");
+        SLANG_CHECK(test.compile(compiler) == "product 9");
+        SLANG_CHECK(compiler->m_compileCount == 9);
+    }
+}
@@ -0,0 +1,135 @@
+// unit-test-incremental-simplification.cpp
+
+#include "../../slang.h"
+#include "../../slang-com-ptr.h"
+
+#include "../../source/core/slang-basic.h"
+
+#include "tools/unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Entry points whose simplification depends on changes made to other functions
+static const char kIncrementalSimplificationSource[] = R"(
+    RWStructuredBuffer<int> gBuffer;
+
+    static const int kScale = 3;
+
+    // Has a local variable until SSA is constructed, after which it is found to be free of side
+    // effects (ReadNone), which makes the calls to it in its callers candidates for removal
+    int pure(int x)
+    {
+        int acc = 0;
+        for (int i = 0; i < 3; i++)
+            acc += x * i;
+        return acc;
+    }
+
+    // Only changes in the iteration after `pure` is found to be ReadNone, as nothing else in it
+    // can be simplified
+    int callsPure(int x)
+    {
+        return pure(x) + pure(x);
+    }
+
+    int scaleBy<let N : int>(int value)
+    {
+        return value * N;
+    }
+
+    int branchy(int value)
+    {
+        if (kScale > 2)
+            return scaleBy<kScale>(value) + 1;
+        return value - 1;
+    }
+
+    [shader("compute")]
+    [numthreads(4, 1, 1)]
+    void readNoneMain(uint3 tid : SV_DispatchThreadID)
+    {
+        gBuffer[tid.x] = callsPure(int(tid.x)) + pure(int(tid.y));
+    }
+
+    [shader("compute")]
+    [numthreads(4, 1, 1)]
+    void constantMain(uint3 tid : SV_DispatchThreadID)
+    {
+        int unused = callsPure(int(tid.y));
+        gBuffer[tid.x] = branchy(int(tid.x)) + scaleBy<2>(kScale);
+    }
+)";
+
+static const char* const kIncrementalSimplificationEntryPointNames[] = { "readNoneMain", "constantMain" };
+static const SlangCompileTarget kIncrementalSimplificationTargets[] = { SLANG_HLSL, SLANG_GLSL };
+
+    /// Compile the entry points for all of the targets, with the incremental driver of IR simplification
+    /// or with a full rescan on each iteration, and output the code for each entry point and target
+static SlangResult _compileWithIncrementalSimplification(SlangSession* session, bool incremental, List<String>& outCodes)
+{
+    auto request = spCreateCompileRequest(session);
+
+    for (auto target : kIncrementalSimplificationTargets)
+    {
+        spAddCodeGenTarget(request, target);
+    }
+
+    SlangResult res = SLANG_OK;
+    if (!incremental)
+    {
+        const char* args[] = { "-disable-incremental-simplification" };
+        res = spProcessCommandLineArguments(request, args, int(SLANG_COUNT_OF(args)));
+    }
+
+    const int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "incrementalSimplification");
+    spAddTranslationUnitSourceString(request, translationUnitIndex, "incremental-simplification.slang", kIncrementalSimplificationSource);
+
+    for (auto entryPointName : kIncrementalSimplificationEntryPointNames)
+    {
+        spAddEntryPoint(request, translationUnitIndex, entryPointName, SLANG_STAGE_COMPUTE);
+    }
+
+    if (SLANG_SUCCEEDED(res))
+    {
+        res = spCompile(request);
+    }
+    for (Index i = 0; SLANG_SUCCEEDED(res) && i < SLANG_COUNT_OF(kIncrementalSimplificationEntryPointNames); ++i)
+    {
+        for (Index j = 0; SLANG_SUCCEEDED(res) && j < SLANG_COUNT_OF(kIncrementalSimplificationTargets); ++j)
+        {
+            ComPtr<ISlangBlob> codeBlob;
+            res = spGetEntryPointCodeBlob(request, int(i), int(j), codeBlob.writeRef());
+            if (SLANG_SUCCEEDED(res))
+            {
+                const char* code = (const char*)codeBlob->getBufferPointer();
+                outCodes.add(String(code, code + codeBlob->getBufferSize()));
+            }
+        }
+    }
+
+    spDestroyCompileRequest(request);
+    return res;
+}
+
+// Test that the incremental driver of IR simplification, which only revisits the functions that
+// changed (or were affected by a change, such as the callers of a function found to be free of
+// side effects), reaches the same fixed point as revisiting every function on each iteration.
+SLANG_UNIT_TEST(incrementalSimplification)
+{
+    auto session = spCreateSession();
+
+    List<String> expectedCodes;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compileWithIncrementalSimplification(session, false, expectedCodes)));
+    SLANG_CHECK_ABORT(expectedCodes.getCount() == SLANG_COUNT_OF(kIncrementalSimplificationEntryPointNames) * SLANG_COUNT_OF(kIncrementalSimplificationTargets));
+
+    for (auto& code : expectedCodes)
+    {
+        SLANG_CHECK(code.getLength() > 0);
+    }
+
+    List<String> codes;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compileWithIncrementalSimplification(session, true, codes)));
+    SLANG_CHECK(codes == expectedCodes);
+
+    spDestroySession(session);
+}
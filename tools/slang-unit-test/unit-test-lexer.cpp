@@ -0,0 +1,169 @@
+// unit-test-lexer.cpp
+
+#include "source/core/slang-basic.h"
+#include "source/core/slang-char-scan-util.h"
+#include "source/core/slang-random-generator.h"
+
+#include "source/compiler-core/slang-lexer.h"
+#include "source/compiler-core/slang-source-loc.h"
+#include "source/compiler-core/slang-diagnostic-sink.h"
+#include "source/compiler-core/slang-name.h"
+
+#include "tools/unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+namespace { // anonymous
+
+// Everything needed to lex some text
+struct LexerEnv
+{
+    LexerEnv()
+    {
+        sourceManager.initialize(nullptr, nullptr);
+        namePool.setRootNamePool(&rootNamePool);
+    }
+
+    List<Token> lexAll(const String& text)
+    {
+        SourceFile* sourceFile = sourceManager.createSourceFileWithString(PathInfo::makeFromString("lexer-test"), text);
+        SourceView* sourceView = sourceManager.createSourceView(sourceFile, nullptr, SourceLoc::fromRaw(0));
+
+        Lexer lexer;
+        lexer.initialize(sourceView, &sink, &namePool, sourceManager.getMemoryArena());
+
+        List<Token> tokens;
+        for (;;)
+        {
+            const Token token = lexer.lexToken();
+            tokens.add(token);
+            if (token.type == TokenType::EndOfFile)
+            {
+                break;
+            }
+        }
+        return tokens;
+    }
+
+    SourceManager sourceManager;
+    DiagnosticSink sink;
+    RootNamePool rootNamePool;
+    NamePool namePool;
+};
+
+} // anonymous
+
+// The scalar definitions the scanning functions must agree with
+static bool _isIdentifierChar(char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_'; }
+static bool _isHorizontalWhitespace(char c) { return c == ' ' || c == '\t'; }
+
+template <typename Func>
+static const char* _skipWhile(const char* cursor, const char* end, const Func& func)
+{
+    while (cursor < end && func(*cursor))
+    {
+        ++cursor;
+    }
+    return cursor;
+}
+
+SLANG_UNIT_TEST(charScanUtil)
+{
+    RefPtr<RandomGenerator> rand = RandomGenerator::create(0x5eed);
+
+    // Characters that are (and aren't) matched by the scans, including ones with the top bit set
+    const char alphabet[] = { ' ', '\t', '\n', '\r', '\\', '*', '/', '"', '\'', '_', 'a', 'z', 'A', 'Z', '0', '9', '@', '[', '`', '{', char(0x80), char(0xe1), char(0xff), 0 };
+    const Index alphabetCount = SLANG_COUNT_OF(alphabet);
+
+    List<char> text;
+    for (Index run = 0; run < 200; ++run)
+    {
+        // Mostly runs of a single class of characters, such that scans go across whole blocks
+        text.clear();
+        const Index length = Index(rand->nextInt32() & 127);
+        while (text.getCount() < length)
+        {
+            const char c = alphabet[Index(uint32_t(rand->nextInt32())) % alphabetCount];
+            const Index repeat = Index(rand->nextInt32() & 31) + 1;
+            for (Index i = 0; i < repeat; ++i)
+            {
+                text.add(c);
+            }
+        }
+
+        const char* begin = text.getBuffer();
+        const char* end = begin + text.getCount();
+
+        for (const char* cursor = begin; cursor <= end; ++cursor)
+        {
+            SLANG_CHECK(CharScanUtil::skipHorizontalWhitespace(cursor, end) == _skipWhile(cursor, end, _isHorizontalWhitespace));
+            SLANG_CHECK(CharScanUtil::skipIdentifierChars(cursor, end) == _skipWhile(cursor, end, _isIdentifierChar));
+
+            SLANG_CHECK(CharScanUtil::findFirstOf(cursor, end, '\n', '\r') == _skipWhile(cursor, end, [](char c) { return c != '\n' && c != '\r'; }));
+            SLANG_CHECK(CharScanUtil::findFirstOf(cursor, end, '\n', '\r', '\\') == _skipWhile(cursor, end, [](char c) { return c != '\n' && c != '\r' && c != '\\'; }));
+            SLANG_CHECK(CharScanUtil::findFirstOf(cursor, end, '"', '\\', '\n', char(0xff)) == _skipWhile(cursor, end, [](char c) { return c != '"' && c != '\\' && c != '\n' && c != char(0xff); }));
+        }
+    }
+}
+
+SLANG_UNIT_TEST(lexer)
+{
+    LexerEnv env;
+
+    // Long tokens, such that they are scanned in blocks
+    {
+        const String identifier = "a_very_long_identifier_name_0123456789_ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+        const String space = "                \t\t\t\t                ";
+        const String lineComment = "// A line comment that is long enough to need more than one block";
+        const String blockComment = "/* A block comment ** with stars\n and \r\n newlines * / in it */";
+        const String stringLiteral = "\"A string with \\\"escapes\\\" in it, that is long enough to need several blocks\"";
+
+        StringBuilder buf;
+        buf << identifier << space << lineComment << "\n" << blockComment << stringLiteral << identifier;
+
+        const List<Token> tokens = env.lexAll(buf);
+        SLANG_CHECK(tokens.getCount() == 8);
+        if (tokens.getCount() == 8)
+        {
+            SLANG_CHECK(tokens[0].type == TokenType::Identifier && tokens[0].getContent() == identifier.getUnownedSlice());
+            SLANG_CHECK(tokens[1].type == TokenType::WhiteSpace && tokens[1].getContent() == space.getUnownedSlice());
+            SLANG_CHECK(tokens[2].type == TokenType::LineComment && tokens[2].getContent() == lineComment.getUnownedSlice());
+            SLANG_CHECK(tokens[3].type == TokenType::NewLine);
+            SLANG_CHECK(tokens[4].type == TokenType::BlockComment && tokens[4].getContent() == blockComment.getUnownedSlice());
+            SLANG_CHECK(tokens[5].type == TokenType::StringLiteral && tokens[5].getContent() == stringLiteral.getUnownedSlice());
+            SLANG_CHECK(tokens[6].type == TokenType::Identifier && tokens[6].getContent() == identifier.getUnownedSlice());
+            SLANG_CHECK(tokens[7].type == TokenType::EndOfFile);
+        }
+    }
+
+    // Escaped newlines inside of tokens
+    {
+        const List<Token> tokens = env.lexAll("abc\\\ndef // comment \\\r\n continued\n/* a *\\\n/\"x\\\ny\"");
+        SLANG_CHECK(tokens.getCount() == 7);
+        if (tokens.getCount() == 7)
+        {
+            SLANG_CHECK(tokens[0].type == TokenType::Identifier && (tokens[0].flags & TokenFlag::ScrubbingNeeded));
+            SLANG_CHECK(tokens[1].type == TokenType::WhiteSpace);
+            SLANG_CHECK(tokens[2].type == TokenType::LineComment && tokens[2].getContent().endsWith(toSlice("continued")));
+            SLANG_CHECK(tokens[3].type == TokenType::NewLine);
+            SLANG_CHECK(tokens[4].type == TokenType::BlockComment && (tokens[4].flags & TokenFlag::ScrubbingNeeded));
+            SLANG_CHECK(tokens[5].type == TokenType::StringLiteral && (tokens[5].flags & TokenFlag::ScrubbingNeeded));
+            SLANG_CHECK(tokens[6].type == TokenType::EndOfFile);
+        }
+    }
+
+    // Line break offsets
+    {
+        SourceFile* sourceFile = env.sourceManager.createSourceFileWithString(PathInfo::makeFromString("lines"), "a\nb\r\nc\n\rd\r\re\n");
+        const auto& offsets = sourceFile->getLineBreakOffsets();
+        const uint32_t expected[] = { 0, 2, 5, 8, 10, 11, 13 };
+        SLANG_CHECK(offsets.getCount() == SLANG_COUNT_OF(expected));
+        if (offsets.getCount() == SLANG_COUNT_OF(expected))
+        {
+            for (Index i = 0; i < offsets.getCount(); ++i)
+            {
+                SLANG_CHECK(offsets[i] == expected[i]);
+            }
+        }
+    }
+}
@@ -0,0 +1,139 @@
+// unit-test-link-once.cpp
+
+#include "../../slang.h"
+#include "../../slang-com-ptr.h"
+
+#include "../../source/core/slang-basic.h"
+
+#include "tools/unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Entry points that share generic functions (specialized with the same and with different
+// arguments), global parameters and global constants, along with code only one of them uses
+static const char kLinkOnceSource[] = R"(
+    static const int kScale = 3;
+
+    RWStructuredBuffer<int> sharedBuffer;
+    RWStructuredBuffer<float> floatBuffer;
+    Texture2D<float4> onlyUsedByC;
+
+    interface IOp
+    {
+        int apply(int value);
+    }
+    struct AddOp : IOp
+    {
+        int amount;
+        int apply(int value) { return value + amount; }
+    }
+    struct MulOp : IOp
+    {
+        int apply(int value) { return value * kScale; }
+    }
+
+    int twice<T : IOp>(T op, int value)
+    {
+        return op.apply(op.apply(value));
+    }
+
+    int helper(int value) { return value * kScale + 1; }
+
+    [shader("compute")]
+    [numthreads(4, 1, 1)]
+    void computeA(uint3 tid : SV_DispatchThreadID)
+    {
+        AddOp op = { 2 };
+        int result = twice(op, int(tid.x));
+        sharedBuffer[tid.x] = helper(result);
+    }
+
+    [shader("compute")]
+    [numthreads(4, 1, 1)]
+    void computeB(uint3 tid : SV_DispatchThreadID)
+    {
+        MulOp op;
+        int result = twice(op, int(tid.x));
+        sharedBuffer[tid.x] = result;
+        floatBuffer[tid.x] = float(helper(result));
+    }
+
+    [shader("compute")]
+    [numthreads(8, 1, 1)]
+    void computeC(uint3 tid : SV_DispatchThreadID)
+    {
+        AddOp op = { int(tid.y) };
+        int result = twice(op, int(tid.x));
+        floatBuffer[tid.x] = onlyUsedByC.Load(int3(tid.x, 0, 0)).x + float(result);
+    }
+)";
+
+static const char* const kLinkOnceEntryPointNames[] = { "computeA", "computeB", "computeC" };
+static const SlangCompileTarget kLinkOnceTargets[] = { SLANG_HLSL, SLANG_GLSL };
+
+    /// Compile the entry points for all of the targets, and output the code for each entry point and target
+static SlangResult _compileLinkOnce(SlangSession* session, SlangTargetFlags targetFlags, int codeGenThreadCount, List<String>& outCodes)
+{
+    auto request = spCreateCompileRequest(session);
+
+    for (Index i = 0; i < SLANG_COUNT_OF(kLinkOnceTargets); ++i)
+    {
+        const int targetIndex = spAddCodeGenTarget(request, kLinkOnceTargets[i]);
+        spSetTargetFlags(request, targetIndex, targetFlags);
+    }
+
+    spSetCodeGenThreadCount(request, codeGenThreadCount);
+
+    const int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "linkOnce");
+    spAddTranslationUnitSourceString(request, translationUnitIndex, "link-once.slang", kLinkOnceSource);
+
+    for (auto entryPointName : kLinkOnceEntryPointNames)
+    {
+        spAddEntryPoint(request, translationUnitIndex, entryPointName, SLANG_STAGE_COMPUTE);
+    }
+
+    SlangResult res = spCompile(request);
+    for (Index i = 0; SLANG_SUCCEEDED(res) && i < SLANG_COUNT_OF(kLinkOnceEntryPointNames); ++i)
+    {
+        for (Index j = 0; SLANG_SUCCEEDED(res) && j < SLANG_COUNT_OF(kLinkOnceTargets); ++j)
+        {
+            ComPtr<ISlangBlob> codeBlob;
+            res = spGetEntryPointCodeBlob(request, int(i), int(j), codeBlob.writeRef());
+            if (SLANG_SUCCEEDED(res))
+            {
+                const char* code = (const char*)codeBlob->getBufferPointer();
+                outCodes.add(String(code, code + codeBlob->getBufferSize()));
+            }
+        }
+    }
+
+    spDestroyCompileRequest(request);
+    return res;
+}
+
+// Test that the code generated for each entry point when the program is linked once per
+// target (-link-once) is the same as when each entry point is linked on its own.
+SLANG_UNIT_TEST(linkOnce)
+{
+    auto session = spCreateSession();
+
+    List<String> expectedCodes;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compileLinkOnce(session, 0, 1, expectedCodes)));
+    SLANG_CHECK_ABORT(expectedCodes.getCount() == SLANG_COUNT_OF(kLinkOnceEntryPointNames) * SLANG_COUNT_OF(kLinkOnceTargets));
+
+    for (auto& code : expectedCodes)
+    {
+        SLANG_CHECK(code.getLength() > 0);
+    }
+
+    // With serial codegen, and with entry points extracted from the shared link on several threads at once
+    const int codeGenThreadCounts[] = { 1, 4 };
+    for (auto codeGenThreadCount : codeGenThreadCounts)
+    {
+        List<String> codes;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compileLinkOnce(session, SLANG_TARGET_FLAG_LINK_ONCE, codeGenThreadCount, codes)));
+        SLANG_CHECK(codes == expectedCodes);
+    }
+
+    spDestroySession(session);
+}
@@ -0,0 +1,151 @@
+// unit-test-linkage-hash.cpp
+
+#include "../../slang.h"
+#include "../../slang-com-ptr.h"
+
+#include "../../source/core/slang-basic.h"
+
+#include "tools/unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+static const char kLinkageHashSource[] = R"(
+    [shader("compute")]
+    [numthreads(4, 1, 1)]
+    void computeMain(uint3 tid : SV_DispatchThreadID, uniform RWStructuredBuffer<int> buffer)
+    {
+        buffer[tid.x] = int(tid.x) * 2;
+    })";
+
+namespace { // anonymous
+
+// The target options the hash of the linkage covers
+struct LinkageHashOptions
+{
+    SlangProfileID profile = SLANG_PROFILE_UNKNOWN;
+    SlangTargetFlags flags = 0;
+    SlangFloatingPointMode floatingPointMode = SLANG_FLOATING_POINT_MODE_DEFAULT;
+    SlangLineDirectiveMode lineDirectiveMode = SLANG_LINE_DIRECTIVE_MODE_DEFAULT;
+    int cpuSIMDLaneCount = 0;
+};
+
+} // anonymous
+
+static void _applyOptions(SlangCompileRequest* request, const LinkageHashOptions& options)
+{
+    spSetTargetProfile(request, 0, options.profile);
+    spSetTargetFlags(request, 0, options.flags);
+    spSetTargetFloatingPointMode(request, 0, options.floatingPointMode);
+    spSetTargetLineDirectiveMode(request, 0, options.lineDirectiveMode);
+    spSetTargetCPUSIMDLaneCount(request, 0, options.cpuSIMDLaneCount);
+}
+
+    /// Create a request for a SPIR-V target (which uses a downstream compiler and so a prelude) with options,
+    /// and check it without generating code
+static SlangCompileRequest* _createRequest(SlangSession* session, const LinkageHashOptions& options)
+{
+    auto request = spCreateCompileRequest(session);
+
+    spAddCodeGenTarget(request, SLANG_SPIRV);
+    _applyOptions(request, options);
+    spSetCompileFlags(request, SLANG_COMPILE_FLAG_NO_CODEGEN);
+
+    const int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "linkageHash");
+    spAddTranslationUnitSourceString(request, translationUnitIndex, "linkage-hash.slang", kLinkageHashSource);
+    spAddEntryPoint(request, translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    if (SLANG_FAILED(spCompile(request)))
+    {
+        spDestroyCompileRequest(request);
+        return nullptr;
+    }
+    return request;
+}
+
+static List<uint8_t> _getEntryPointHash(SlangCompileRequest* request)
+{
+    List<uint8_t> hash;
+
+    ComPtr<slang::IComponentType> program;
+    if (SLANG_SUCCEEDED(spCompileRequest_getProgramWithEntryPoints(request, program.writeRef())))
+    {
+        ComPtr<slang::IBlob> hashBlob;
+        program->getEntryPointHash(0, 0, hashBlob.writeRef());
+        if (hashBlob)
+        {
+            hash.addRange((const uint8_t*)hashBlob->getBufferPointer(), Index(hashBlob->getBufferSize()));
+        }
+    }
+    return hash;
+}
+
+    /// Get the hash of a new request with options
+static List<uint8_t> _getNewRequestHash(SlangSession* session, const LinkageHashOptions& options)
+{
+    List<uint8_t> hash;
+    if (auto request = _createRequest(session, options))
+    {
+        hash = _getEntryPointHash(request);
+        spDestroyCompileRequest(request);
+    }
+    return hash;
+}
+
+// Test that the hash of an entry point is recalculated when a target or global session option that
+// goes into the (memoized) hash of the linkage is changed after the hash has been calculated.
+SLANG_UNIT_TEST(linkageHash)
+{
+    // Global session options are changed, so the test has a session of its own
+    auto session = spCreateSession();
+
+    LinkageHashOptions options;
+    auto request = _createRequest(session, options);
+    SLANG_CHECK_ABORT(request);
+
+    List<uint8_t> hash = _getEntryPointHash(request);
+    SLANG_CHECK_ABORT(hash.getCount() > 0);
+    SLANG_CHECK(_getEntryPointHash(request) == hash);
+
+    // Check the hash after options have been changed is different from the hash before, and the
+    // same as the hash of a new request with the changed options
+    auto checkChanged = [&]()
+    {
+        const List<uint8_t> newHash = _getEntryPointHash(request);
+        SLANG_CHECK(newHash != hash);
+        SLANG_CHECK(newHash == _getNewRequestHash(session, options));
+        hash = newHash;
+    };
+
+    options.profile = spFindProfile(session, "glsl_450");
+    _applyOptions(request, options);
+    checkChanged();
+
+    options.flags = SLANG_TARGET_FLAG_GENERATE_WHOLE_PROGRAM;
+    _applyOptions(request, options);
+    checkChanged();
+
+    options.floatingPointMode = SLANG_FLOATING_POINT_MODE_FAST;
+    _applyOptions(request, options);
+    checkChanged();
+
+    options.lineDirectiveMode = SLANG_LINE_DIRECTIVE_MODE_NONE;
+    _applyOptions(request, options);
+    checkChanged();
+
+    options.cpuSIMDLaneCount = 4;
+    _applyOptions(request, options);
+    checkChanged();
+
+    // The prelude of the downstream compiler used for the target
+    session->setLanguagePrelude(SLANG_SOURCE_LANGUAGE_GLSL, "// linkage hash test prelude\n");
+    checkChanged();
+
+    // Where the downstream compiler is found (so its version) may change the hash, depending on
+    // whether a compiler is available, but the hash must match one calculated afresh
+    session->setDownstreamCompilerPath(SLANG_PASS_THROUGH_GLSLANG, "linkage-hash-test-no-compiler");
+    hash = _getEntryPointHash(request);
+    SLANG_CHECK(hash == _getNewRequestHash(session, options));
+
+    spDestroyCompileRequest(request);
+    spDestroySession(session);
+}
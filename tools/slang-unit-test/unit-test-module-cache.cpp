@@ -0,0 +1,304 @@
+// unit-test-module-cache.cpp
+
+#include "../../slang.h"
+#include "../../slang-com-ptr.h"
+
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-file-system.h"
+
+#include "tools/unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+namespace { // anonymous
+
+// Creates a directory holding a module to import, and a module cache directory, and removes them afterwards
+struct ModuleCacheTestFiles
+{
+    ModuleCacheTestFiles(const char* name)
+    {
+        osFileSystem = OSFileSystem::getMutableSingleton();
+        directory = Path::simplify(Path::getParentDirectory(Path::getExecutablePath()) + "/" + name);
+        cacheDirectory = Path::combine(directory, "cache");
+
+        remove();
+        Path::createDirectory(directory);
+    }
+    ~ModuleCacheTestFiles()
+    {
+        remove();
+    }
+
+    void writeFile(const char* fileName, const char* contents)
+    {
+        File::writeAllText(Path::combine(directory, fileName), contents);
+    }
+
+    Count getCacheFileCount()
+    {
+        Count count = 0;
+        osFileSystem->enumeratePathContents(
+            cacheDirectory.getBuffer(),
+            [](SlangPathType, const char*, void* userData) { (*(Count*)userData)++; },
+            &count);
+        return count;
+    }
+
+    void remove()
+    {
+        _removeContents(cacheDirectory);
+        osFileSystem->remove(cacheDirectory.getBuffer());
+        _removeContents(directory);
+        osFileSystem->remove(directory.getBuffer());
+    }
+
+    ISlangMutableFileSystem* osFileSystem;
+    String directory;
+    String cacheDirectory;
+
+protected:
+    void _removeContents(const String& path)
+    {
+        struct Context
+        {
+            ISlangMutableFileSystem* fileSystem;
+            const String* path;
+        } context = { osFileSystem, &path };
+
+        osFileSystem->enumeratePathContents(
+            path.getBuffer(),
+            [](SlangPathType pathType, const char* fileName, void* userData)
+            {
+                auto ctx = (Context*)userData;
+                if (pathType == SLANG_PATH_TYPE_FILE)
+                {
+                    ctx->fileSystem->remove(Path::combine(*ctx->path, fileName).getBuffer());
+                }
+            },
+            &context);
+    }
+};
+
+struct CompileOutput
+{
+    String code;
+    String diagnostics;
+    List<String> entryPointNames;
+};
+
+struct LoadedModuleInfo
+{
+    SlangInt32 definedEntryPointCount = 0;
+    List<uint8_t> entryPointHash;
+    String perfTrace;
+};
+
+} // anonymous
+
+static SlangResult _compileWithModuleCache(SlangSession* session, ModuleCacheTestFiles& files, CompileOutput& out)
+{
+    const String mainPath = Path::combine(files.directory, "module-cache-main.slang");
+
+    const char* args[] =
+    {
+        mainPath.getBuffer(),
+        "-target", "hlsl",
+        "-I", files.directory.getBuffer(),
+        "-module-cache-path", files.cacheDirectory.getBuffer(),
+    };
+
+    auto request = spCreateCompileRequest(session);
+
+    SlangResult res = spProcessCommandLineArguments(request, args, int(SLANG_COUNT_OF(args)));
+    if (SLANG_SUCCEEDED(res))
+    {
+        res = spCompile(request);
+    }
+    if (SLANG_SUCCEEDED(res))
+    {
+        out.diagnostics = spGetDiagnosticOutput(request);
+
+        SlangReflection* reflection = spGetReflection(request);
+        const SlangUInt entryPointCount = spReflection_getEntryPointCount(reflection);
+        for (SlangUInt i = 0; i < entryPointCount; ++i)
+        {
+            out.entryPointNames.add(spReflectionEntryPoint_getName(spReflection_getEntryPointByIndex(reflection, i)));
+        }
+
+        ComPtr<ISlangBlob> codeBlob;
+        res = spGetEntryPointCodeBlob(request, 0, 0, codeBlob.writeRef());
+        if (SLANG_SUCCEEDED(res))
+        {
+            out.code = String((const char*)codeBlob->getBufferPointer(), (const char*)codeBlob->getBufferPointer() + codeBlob->getBufferSize());
+        }
+    }
+
+    spDestroyCompileRequest(request);
+    return res;
+}
+
+// Test that compiling with a module that is read from the module cache gives the same
+// entry points, code and diagnostics (including the warnings of the imported module)
+// as compiling the module.
+SLANG_UNIT_TEST(moduleCacheCompile)
+{
+    ModuleCacheTestFiles files("module-cache-compile-test");
+
+    // The imported module produces a warning for the implicit conversion
+    files.writeFile("module-cache-helper.slang", R"(
+        int helper(float value)
+        {
+            int truncated = value;
+            return truncated * 2;
+        })");
+
+    files.writeFile("module-cache-main.slang", R"(
+        import module_cache_helper;
+
+        [shader("compute")]
+        [numthreads(4, 1, 1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID, uniform RWStructuredBuffer<int> buffer)
+        {
+            buffer[tid.x] = helper(float(tid.x) * 0.5f);
+        }
+
+        [shader("compute")]
+        [numthreads(4, 1, 1)]
+        void otherMain(uint3 tid : SV_DispatchThreadID, uniform RWStructuredBuffer<int> buffer)
+        {
+            buffer[tid.x] = helper(float(tid.x));
+        })");
+
+    auto session = spCreateSession();
+
+    // The first compile checks the module and writes it to the cache
+    CompileOutput coldOutput;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compileWithModuleCache(session, files, coldOutput)));
+
+    const Count cacheFileCount = files.getCacheFileCount();
+    SLANG_CHECK(cacheFileCount > 0);
+
+    // The second reads the module from the cache
+    CompileOutput warmOutput;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compileWithModuleCache(session, files, warmOutput)));
+
+    // Nothing new should have been written
+    SLANG_CHECK(files.getCacheFileCount() == cacheFileCount);
+
+    SLANG_CHECK(coldOutput.code.getLength() > 0);
+    SLANG_CHECK(coldOutput.code == warmOutput.code);
+
+    SLANG_CHECK(coldOutput.entryPointNames.getCount() == 2);
+    SLANG_CHECK(coldOutput.entryPointNames == warmOutput.entryPointNames);
+
+    // The warning from the imported module is output when it is read from the cache
+    SLANG_CHECK(coldOutput.diagnostics.indexOf("module-cache-helper.slang") >= 0);
+    SLANG_CHECK(coldOutput.diagnostics == warmOutput.diagnostics);
+
+    spDestroySession(session);
+}
+
+    /// Load the module called moduleName in a new session using the module cache, and get its defined
+    /// entry points, the hash of its first entry point and the session's perf trace summary
+static SlangResult _loadModuleWithModuleCache(slang::IGlobalSession* globalSession, ModuleCacheTestFiles& files, const char* moduleName, LoadedModuleInfo& out)
+{
+    slang::TargetDesc targetDesc;
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    const char* searchPaths[] = { files.directory.getBuffer() };
+
+    slang::SessionDesc sessionDesc;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.targetCount = 1;
+    sessionDesc.flags = slang::kSessionFlag_EnablePerfTrace;
+    sessionDesc.searchPaths = searchPaths;
+    sessionDesc.searchPathCount = SLANG_COUNT_OF(searchPaths);
+    sessionDesc.moduleCachePath = files.cacheDirectory.getBuffer();
+
+    ComPtr<slang::ISession> session;
+    SLANG_RETURN_ON_FAIL(globalSession->createSession(sessionDesc, session.writeRef()));
+
+    ComPtr<slang::IBlob> diagnostics;
+    slang::IModule* module = session->loadModule(moduleName, diagnostics.writeRef());
+    if (!module)
+    {
+        return SLANG_FAIL;
+    }
+
+    out.definedEntryPointCount = module->getDefinedEntryPointCount();
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    SLANG_RETURN_ON_FAIL(module->getDefinedEntryPoint(0, entryPoint.writeRef()));
+
+    slang::IComponentType* components[] = { module, entryPoint };
+    ComPtr<slang::IComponentType> composite;
+    SLANG_RETURN_ON_FAIL(session->createCompositeComponentType(components, SLANG_COUNT_OF(components), composite.writeRef()));
+
+    ComPtr<slang::IComponentType> program;
+    SLANG_RETURN_ON_FAIL(composite->link(program.writeRef()));
+
+    ComPtr<slang::IBlob> hashBlob;
+    program->getEntryPointHash(0, 0, hashBlob.writeRef());
+    if (!hashBlob)
+    {
+        return SLANG_FAIL;
+    }
+    out.entryPointHash.addRange((const uint8_t*)hashBlob->getBufferPointer(), Index(hashBlob->getBufferSize()));
+
+    ComPtr<slang::IBlob> traceBlob;
+    SLANG_RETURN_ON_FAIL(session->getPerfTrace(SLANG_PERF_TRACE_FORMAT_SUMMARY, traceBlob.writeRef()));
+    out.perfTrace = String((const char*)traceBlob->getBufferPointer(), (const char*)traceBlob->getBufferPointer() + traceBlob->getBufferSize());
+
+    return SLANG_OK;
+}
+
+// Test that a module loaded with `ISession::loadModule` in a session created with a module cache
+// path is read from the cache by a later session, and has the same entry points as when it was compiled.
+SLANG_UNIT_TEST(moduleCacheLoadModule)
+{
+    ModuleCacheTestFiles files("module-cache-load-module-test");
+
+    files.writeFile("module-cache-entry-points.slang", R"(
+        int scale(int value) { return value * 3; }
+
+        [shader("compute")]
+        [numthreads(4, 1, 1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID, uniform RWStructuredBuffer<int> buffer)
+        {
+            buffer[tid.x] = scale(int(tid.x));
+        }
+
+        [shader("compute")]
+        [numthreads(8, 1, 1)]
+        void otherMain(uint3 tid : SV_DispatchThreadID, uniform RWStructuredBuffer<int> buffer)
+        {
+            buffer[tid.x] = scale(int(tid.y));
+        })");
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(slang::createGlobalSession(globalSession.writeRef())));
+
+    // The first session compiles the module and writes it to the cache
+    LoadedModuleInfo coldInfo;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_loadModuleWithModuleCache(globalSession, files, "module_cache_entry_points", coldInfo)));
+    SLANG_CHECK(coldInfo.perfTrace.indexOf("frontend:writeModuleCache") >= 0);
+
+    const Count cacheFileCount = files.getCacheFileCount();
+    SLANG_CHECK(cacheFileCount > 0);
+
+    // The second session reads it from the cache, without parsing, checking or writing it
+    LoadedModuleInfo warmInfo;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_loadModuleWithModuleCache(globalSession, files, "module_cache_entry_points", warmInfo)));
+    SLANG_CHECK(warmInfo.perfTrace.indexOf("frontend:readModuleCache") >= 0);
+    SLANG_CHECK(warmInfo.perfTrace.indexOf("frontend:parse") < 0);
+    SLANG_CHECK(warmInfo.perfTrace.indexOf("frontend:check") < 0);
+    SLANG_CHECK(warmInfo.perfTrace.indexOf("frontend:writeModuleCache") < 0);
+    SLANG_CHECK(files.getCacheFileCount() == cacheFileCount);
+
+    SLANG_CHECK(coldInfo.definedEntryPointCount == 2);
+    SLANG_CHECK(warmInfo.definedEntryPointCount == coldInfo.definedEntryPointCount);
+
+    SLANG_CHECK(coldInfo.entryPointHash.getCount() > 0);
+    SLANG_CHECK(warmInfo.entryPointHash == coldInfo.entryPointHash);
+}
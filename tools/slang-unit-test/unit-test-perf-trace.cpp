@@ -0,0 +1,140 @@
+// unit-test-perf-trace.cpp
+
+#include "../../slang.h"
+#include "../../slang-com-ptr.h"
+
+#include "../../source/core/slang-basic.h"
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-writer.h"
+
+#include "../../source/compiler-core/slang-json-lexer.h"
+#include "../../source/compiler-core/slang-json-parser.h"
+#include "../../source/compiler-core/slang-json-value.h"
+
+#include "tools/unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+static const char kPerfTraceSource[] = R"(
+    struct Params { float scale; }
+
+    float scaled(Params params, float value) { return params.scale * value; }
+
+    [shader("compute")]
+    [numthreads(4, 1, 1)]
+    void computeMain(uint3 tid : SV_DispatchThreadID, uniform Params params, uniform RWStructuredBuffer<float> buffer)
+    {
+        buffer[tid.x] = scaled(params, sin(float(tid.x)));
+    })";
+
+    /// Parse text as JSON into container
+static SlangResult _parseJSON(const String& text, SourceManager* sourceManager, DiagnosticSink* sink, JSONContainer* container, JSONValue& outValue)
+{
+    SourceFile* sourceFile = sourceManager->createSourceFileWithString(PathInfo::makeUnknown(), text);
+    SourceView* sourceView = sourceManager->createSourceView(sourceFile, nullptr, SourceLoc());
+
+    JSONLexer lexer;
+    lexer.init(sourceView, sink);
+
+    JSONBuilder builder(container);
+    JSONParser parser;
+    SLANG_RETURN_ON_FAIL(parser.parse(&lexer, sourceView, &builder, sink));
+
+    outValue = builder.getRootValue();
+    return SLANG_OK;
+}
+
+// Test that compiling with -trace-file writes a trace in the Chrome "Trace Event Format", with an
+// event for each phase and IR pass, and -report-perf writes a summary of it.
+SLANG_UNIT_TEST(perfTrace)
+{
+    const String tracePath = Path::simplify(Path::getParentDirectory(Path::getExecutablePath()) + "/perf-trace-test.json");
+    File::remove(tracePath);
+
+    auto session = spCreateSession();
+    auto request = spCreateCompileRequest(session);
+
+    StringBuilder summary;
+    RefPtr<StringWriter> summaryWriter(new StringWriter(&summary, 0));
+    spSetWriter(request, SLANG_WRITER_CHANNEL_STD_ERROR, summaryWriter);
+
+    const char* args[] = { "-report-perf", "-trace-file", tracePath.getBuffer() };
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(spProcessCommandLineArguments(request, args, int(SLANG_COUNT_OF(args)))));
+
+    spAddCodeGenTarget(request, SLANG_HLSL);
+    const int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "perfTrace");
+    spAddTranslationUnitSourceString(request, translationUnitIndex, "perf-trace.slang", kPerfTraceSource);
+    spAddEntryPoint(request, translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(spCompile(request)));
+
+    spDestroyCompileRequest(request);
+    spDestroySession(session);
+
+    // The summary is aggregated by name, so holds each phase once
+    SLANG_CHECK(summary.getLength() > 0);
+    SLANG_CHECK(summary.indexOf(UnownedStringSlice("linkAndOptimizeIR")) >= 0);
+
+    String traceText;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::readAllText(tracePath, traceText)));
+    File::remove(tracePath);
+
+    SourceManager sourceManager;
+    sourceManager.initialize(nullptr, nullptr);
+    DiagnosticSink sink(&sourceManager, nullptr);
+    RefPtr<JSONContainer> container = new JSONContainer(&sourceManager);
+
+    JSONValue root;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_parseJSON(traceText, &sourceManager, &sink, container, root)));
+    SLANG_CHECK_ABORT(root.getKind() == JSONValue::Kind::Object);
+
+    const JSONValue traceEvents = container->findObjectValue(root, container->getKey(UnownedStringSlice("traceEvents")));
+    SLANG_CHECK_ABORT(traceEvents.getKind() == JSONValue::Kind::Array);
+
+    const JSONKey nameKey = container->getKey(UnownedStringSlice("name"));
+    const JSONKey phaseKey = container->getKey(UnownedStringSlice("ph"));
+    const JSONKey timeKey = container->getKey(UnownedStringSlice("ts"));
+    const JSONKey durationKey = container->getKey(UnownedStringSlice("dur"));
+    const JSONKey argsKey = container->getKey(UnownedStringSlice("args"));
+    const JSONKey instCountBeforeKey = container->getKey(UnownedStringSlice("instCountBefore"));
+
+    auto events = container->getArray(traceEvents);
+    SLANG_CHECK_ABORT(events.getCount() > 0);
+
+    bool hasLinkAndOptimize = false;
+    Index irPassCount = 0;
+    for (const auto& event : events)
+    {
+        SLANG_CHECK_ABORT(event.getKind() == JSONValue::Kind::Object);
+
+        // Every event is a complete event ("X") with a start time and duration
+        const JSONValue name = container->findObjectValue(event, nameKey);
+        const JSONValue phase = container->findObjectValue(event, phaseKey);
+        const JSONValue time = container->findObjectValue(event, timeKey);
+        const JSONValue duration = container->findObjectValue(event, durationKey);
+        SLANG_CHECK_ABORT(name.getKind() == JSONValue::Kind::String);
+        SLANG_CHECK(phase.getKind() == JSONValue::Kind::String && container->getString(phase) == "X");
+        SLANG_CHECK(time.isValid() && container->asFloat(time) >= 0.0);
+        SLANG_CHECK(duration.isValid() && container->asFloat(duration) >= 0.0);
+
+        if (container->getString(name) == "linkAndOptimizeIR")
+        {
+            hasLinkAndOptimize = true;
+        }
+
+        // IR passes record the instruction counts of the module
+        const JSONValue eventArgs = container->findObjectValue(event, argsKey);
+        if (eventArgs.isValid())
+        {
+            SLANG_CHECK_ABORT(eventArgs.getKind() == JSONValue::Kind::Object);
+            const JSONValue instCountBefore = container->findObjectValue(eventArgs, instCountBeforeKey);
+            if (instCountBefore.isValid() && container->asInteger(instCountBefore) > 0)
+            {
+                irPassCount++;
+            }
+        }
+    }
+
+    SLANG_CHECK(hasLinkAndOptimize);
+    SLANG_CHECK(irPassCount > 0);
+}
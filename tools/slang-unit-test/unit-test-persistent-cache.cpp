@@ -157,6 +157,13 @@ struct PersistentCacheTest
         return cache->getEntryFileName(entry.key);
     }
 
+    // Helper to remove an entry from the index of the cache, as a read does when it finds the
+    // entry file is missing.
+    void removeMissingEntry(const Entry& entry)
+    {
+        cache->appendEntryRecord(PersistentCache::RecordOp::Remove, entry.key);
+    }
+
     // Get the absolute filename of the cache index file.
     String getIndexFilename()
     {
@@ -355,6 +362,12 @@ struct CorruptionTest : public PersistentCacheTest
         writeEntry(entries[0]);
         SLANG_CHECK(readEntry(entries[0]) == true);
 
+        // Test that an entry is not removed from the index if its file was written again (by
+        // another process) after a read found it missing.
+        writeEntry(entries[0]);
+        removeMissingEntry(entries[0]);
+        SLANG_CHECK(readEntry(entries[0]) == true);
+
         // Test behavior when the index file is removed before reading.
         writeEntry(entries[0]);
         SLANG_CHECK(readEntry(entries[0]) == true);
@@ -427,7 +440,8 @@ struct CorruptionTest : public PersistentCacheTest
                 fs.seek(SeekOrigin::End, 0);
                 fs.write("x", 1);
             },
-            SLANG_E_INTERNAL_FAIL);
+            // A partial record at the end of the log is ignored
+            SLANG_OK);
     }
 };
 
@@ -585,6 +599,118 @@ struct StressTest : public PersistentCacheTest
     }
 };
 
+// Tests that reads scale with the number of entries and threads.
+// - write a large number of entries
+// - read them concurrently from a number of threads, through two cache instances sharing the
+//   cache directory (which is what multiple processes using the same cache do)
+// - write as many entries again, so that entries are evicted and the index is compacted
+// - check that the index file doesn't grow beyond a small multiple of the number of entries
+struct IndexScalingTest : public PersistentCacheTest
+{
+    // Maximum number of entries in the cache.
+    static const uint32_t kEntryCount = 4096;
+    // Number of parallel threads to read.
+    static const uint32_t kThreadCount = 8;
+    // Number of entries to read per thread.
+    static const uint32_t kReadCount = 8192;
+
+    List<Entry> entries;
+    RefPtr<PersistentCache> otherCache;
+
+    IndexScalingTest() : PersistentCacheTest(kEntryCount) {}
+
+    void run()
+    {
+        // Setup a list of entries to store in the cache.
+        for (size_t i = 0; i < kEntryCount * 2; ++i)
+        {
+            auto data = createRandomBlob(64);
+            auto key = SHA1::compute(data->getBufferPointer(), data->getBufferSize());
+            entries.add(Entry{ key, data });
+        }
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+
+        for (uint32_t i = 0; i < kEntryCount; ++i)
+        {
+            writeEntry(entries[i]);
+        }
+        SLANG_CHECK(cache->getStats().entryCount == kEntryCount);
+
+        auto writeTime = std::chrono::high_resolution_clock::now();
+
+        PersistentCache::Desc desc;
+        desc.directory = cacheDirectory.getBuffer();
+        desc.maxEntryCount = kEntryCount;
+        otherCache = new PersistentCache(desc);
+        SLANG_CHECK(otherCache->getStats().entryCount == kEntryCount);
+
+        std::atomic<uint32_t> readSuccess{0};
+        std::thread threads[kThreadCount];
+        for (uint32_t threadIndex = 0; threadIndex < kThreadCount; ++threadIndex)
+        {
+            threads[threadIndex] = std::thread(
+                [this, threadIndex, &readSuccess]()
+                {
+                    PersistentCache* threadCache = (threadIndex & 1) ? otherCache.Ptr() : cache.Ptr();
+                    for (uint32_t i = 0; i < kReadCount; ++i)
+                    {
+                        const Entry& entry = entries[(threadIndex * 7919 + i * 104729) % kEntryCount];
+                        ComPtr<ISlangBlob> data;
+                        if (threadCache->readEntry(entry.key, data.writeRef()) == SLANG_OK && isBlobEqual(data, entry.data))
+                        {
+                            readSuccess.fetch_add(1);
+                        }
+                    }
+                });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        SLANG_CHECK(readSuccess == kThreadCount * kReadCount);
+
+        auto readTime = std::chrono::high_resolution_clock::now();
+
+        for (uint32_t i = kEntryCount; i < kEntryCount * 2; ++i)
+        {
+            writeEntry(entries[i]);
+        }
+        SLANG_CHECK(cache->getStats().entryCount == kEntryCount);
+
+        // The most recently written entries are all in the cache, and are seen by the other instance.
+        for (uint32_t i = kEntryCount * 2 - 16; i < kEntryCount * 2; ++i)
+        {
+            ComPtr<ISlangBlob> data;
+            SLANG_CHECK(otherCache->readEntry(entries[i].key, data.writeRef()) == SLANG_OK);
+        }
+        SLANG_CHECK(otherCache->getStats().entryCount == kEntryCount);
+
+        // The log is compacted when it holds more records than the snapshot.
+        FileStream fs;
+        SLANG_CHECK(fs.init(getIndexFilename(), FileMode::Open) == SLANG_OK);
+        fs.seek(SeekOrigin::End, 0);
+        const Int64 recordSize = Int64(sizeof(PersistentCache::Key) + sizeof(uint32_t));
+        SLANG_CHECK(fs.getPosition() <= kEntryCount * 3 * recordSize);
+
+        auto endTime = std::chrono::high_resolution_clock::now();
+
+        auto toSeconds = [](std::chrono::high_resolution_clock::duration duration)
+        {
+            return std::chrono::duration_cast<std::chrono::milliseconds>(duration).count() / 1000.0;
+        };
+        SLANG_UNUSED(toSeconds);
+        LOG("Write %u entries: %.3fs\n", kEntryCount, toSeconds(writeTime - startTime));
+        LOG("Read %u entries on %u threads: %.3fs\n", kThreadCount * kReadCount, kThreadCount, toSeconds(readTime - writeTime));
+        LOG("Write %u entries with eviction: %.3fs\n", kEntryCount, toSeconds(endTime - readTime));
+    }
+
+    ~IndexScalingTest()
+    {
+        otherCache = nullptr;
+    }
+};
+
 SLANG_UNIT_TEST(persistentCacheBasic)
 {
     BasicTest test;
@@ -613,3 +739,13 @@ SLANG_UNIT_TEST(persistentCacheStress)
     StressTest test;
     test.run();
 }
+
+SLANG_UNIT_TEST(persistentCacheIndexScaling)
+{
+    // See persistentCacheStress.
+#if SLANG_PROCESSOR_ARM_64
+    SLANG_IGNORE_TEST
+#endif
+    IndexScalingTest test;
+    test.run();
+}
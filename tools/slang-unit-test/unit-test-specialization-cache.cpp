@@ -0,0 +1,200 @@
+// unit-test-specialization-cache.cpp
+
+#include "../../slang.h"
+#include "../../slang-com-ptr.h"
+
+#include "../../source/core/slang-basic.h"
+
+#include "tools/unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Entry points that share specializations of generics, of differentiable functions, and of
+// functions taking interface (existential) arguments, so that when each entry point is linked
+// on its own the specializations made for one of them can be reused by the others
+static const char kSpecializationCacheSource[] = R"(
+    RWStructuredBuffer<int> intBuffer;
+    RWStructuredBuffer<float> floatBuffer;
+
+    [anyValueSize(8)]
+    interface IOp
+    {
+        int apply(int value);
+    }
+    struct AddOp : IOp
+    {
+        int amount;
+        int apply(int value) { return value + amount; }
+    }
+    struct MulOp : IOp
+    {
+        int apply(int value) { return value * 3; }
+    }
+
+    IOp gOp;
+
+    int twice<T : IOp>(T op, int value)
+    {
+        return op.apply(op.apply(value));
+    }
+
+    int applyExistential(IOp op, int value)
+    {
+        return op.apply(value) + 1;
+    }
+
+    IOp makeOp(int value)
+    {
+        if (value > 2)
+        {
+            AddOp op = { value };
+            return op;
+        }
+        return MulOp();
+    }
+
+    [BackwardDifferentiable]
+    float poly<T : IOp>(T op, float x)
+    {
+        return x * x * float(op.apply(1)) + x;
+    }
+
+    // Shared generic specializations
+    [shader("compute")]
+    [numthreads(4, 1, 1)]
+    void genericA(uint3 tid : SV_DispatchThreadID)
+    {
+        AddOp op = { 2 };
+        intBuffer[tid.x] = twice(op, int(tid.x)) + twice(MulOp(), int(tid.y));
+    }
+
+    [shader("compute")]
+    [numthreads(4, 1, 1)]
+    void genericB(uint3 tid : SV_DispatchThreadID)
+    {
+        AddOp op = { int(tid.y) };
+        intBuffer[tid.x] = twice(op, int(tid.x));
+    }
+
+    // Forward and backward derivatives of a differentiable generic
+    [shader("compute")]
+    [numthreads(4, 1, 1)]
+    void autodiffA(uint3 tid : SV_DispatchThreadID)
+    {
+        AddOp op = { 2 };
+        floatBuffer[tid.x] = __fwd_diff(poly<AddOp>)(op, DifferentialPair<float>(float(tid.x), 1.0)).d;
+    }
+
+    [shader("compute")]
+    [numthreads(4, 1, 1)]
+    void autodiffB(uint3 tid : SV_DispatchThreadID)
+    {
+        AddOp op = { 2 };
+        var dpx = DifferentialPair<float>(float(tid.x), 0.0);
+        __bwd_diff(poly<AddOp>)(op, dpx, 1.0);
+        floatBuffer[tid.x] = dpx.d + __fwd_diff(poly<AddOp>)(op, DifferentialPair<float>(1.0, 1.0)).d;
+    }
+
+    // Interface typed arguments, from a global existential parameter and from local values
+    [shader("compute")]
+    [numthreads(4, 1, 1)]
+    void existentialA(uint3 tid : SV_DispatchThreadID)
+    {
+        intBuffer[tid.x] = applyExistential(gOp, int(tid.x)) + applyExistential(makeOp(int(tid.y)), 1);
+    }
+
+    [shader("compute")]
+    [numthreads(4, 1, 1)]
+    void existentialB(uint3 tid : SV_DispatchThreadID)
+    {
+        AddOp op = { 5 };
+        intBuffer[tid.x] = applyExistential(op, int(tid.x)) + twice(op, int(tid.y));
+    }
+)";
+
+static const char* const kSpecializationCacheEntryPointNames[] =
+{
+    "genericA", "genericB", "autodiffA", "autodiffB", "existentialA", "existentialB",
+};
+static const SlangCompileTarget kSpecializationCacheTargets[] = { SLANG_HLSL, SLANG_GLSL };
+
+    /// Compile the entry points for all of the targets, with or without the specialization cache,
+    /// and output the code for each entry point and target
+static SlangResult _compileWithSpecializationCache(SlangSession* session, bool useCache, int codeGenThreadCount, List<String>& outCodes)
+{
+    auto request = spCreateCompileRequest(session);
+
+    for (auto target : kSpecializationCacheTargets)
+    {
+        spAddCodeGenTarget(request, target);
+    }
+
+    spSetCodeGenThreadCount(request, codeGenThreadCount);
+
+    SlangResult res = SLANG_OK;
+    if (!useCache)
+    {
+        const char* args[] = { "-disable-specialization-cache" };
+        res = spProcessCommandLineArguments(request, args, int(SLANG_COUNT_OF(args)));
+    }
+
+    const int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "specializationCache");
+    spAddTranslationUnitSourceString(request, translationUnitIndex, "specialization-cache.slang", kSpecializationCacheSource);
+
+    for (auto entryPointName : kSpecializationCacheEntryPointNames)
+    {
+        spAddEntryPoint(request, translationUnitIndex, entryPointName, SLANG_STAGE_COMPUTE);
+    }
+
+    if (SLANG_SUCCEEDED(res))
+    {
+        res = spCompile(request);
+    }
+    for (Index i = 0; SLANG_SUCCEEDED(res) && i < SLANG_COUNT_OF(kSpecializationCacheEntryPointNames); ++i)
+    {
+        for (Index j = 0; SLANG_SUCCEEDED(res) && j < SLANG_COUNT_OF(kSpecializationCacheTargets); ++j)
+        {
+            ComPtr<ISlangBlob> codeBlob;
+            res = spGetEntryPointCodeBlob(request, int(i), int(j), codeBlob.writeRef());
+            if (SLANG_SUCCEEDED(res))
+            {
+                const char* code = (const char*)codeBlob->getBufferPointer();
+                outCodes.add(String(code, code + codeBlob->getBufferSize()));
+            }
+        }
+    }
+
+    spDestroyCompileRequest(request);
+    return res;
+}
+
+// Test that the code generated for each entry point is the same whether specializations made
+// for other entry points of the program are reused from the cache or not.
+SLANG_UNIT_TEST(specializationCache)
+{
+    auto session = spCreateSession();
+
+    List<String> expectedCodes;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compileWithSpecializationCache(session, false, 1, expectedCodes)));
+    SLANG_CHECK_ABORT(expectedCodes.getCount() == SLANG_COUNT_OF(kSpecializationCacheEntryPointNames) * SLANG_COUNT_OF(kSpecializationCacheTargets));
+
+    for (auto& code : expectedCodes)
+    {
+        SLANG_CHECK(code.getLength() > 0);
+    }
+
+    // With serial codegen, and with several entry points using the cache on different threads at once
+    const int codeGenThreadCounts[] = { 1, 4 };
+    for (auto codeGenThreadCount : codeGenThreadCounts)
+    {
+        List<String> codes;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compileWithSpecializationCache(session, true, codeGenThreadCount, codes)));
+        SLANG_CHECK(codes == expectedCodes);
+
+        List<String> uncachedCodes;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compileWithSpecializationCache(session, false, codeGenThreadCount, uncachedCodes)));
+        SLANG_CHECK(uncachedCodes == expectedCodes);
+    }
+
+    spDestroySession(session);
+}
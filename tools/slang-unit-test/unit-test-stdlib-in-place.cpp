@@ -0,0 +1,116 @@
+// unit-test-stdlib-in-place.cpp
+
+#include "../../slang.h"
+#include "../../slang-com-ptr.h"
+
+#include "../../source/core/slang-archive-file-system.h"
+#include "../../source/core/slang-riff.h"
+
+#include "../../source/slang/slang-serialize-types.h"
+
+#include "tools/unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// The four cc of the chunk holding the instructions of a serialized IR module (IRSerialBinary::kInstFourCc)
+static const FourCC kInstFourCc = SLANG_FOUR_CC('S', 'L', 'i', 'n');
+
+static void _findDataChunks(RiffContainer::ListChunk* list, List<RiffContainer::DataChunk*>& outChunks)
+{
+    for (RiffContainer::Chunk* chunk = list->getFirstContainedChunk(); chunk; chunk = chunk->m_next)
+    {
+        if (auto dataChunk = as<RiffContainer::DataChunk>(chunk))
+        {
+            outChunks.add(dataChunk);
+        }
+        else if (auto listChunk = as<RiffContainer::ListChunk>(chunk))
+        {
+            _findDataChunks(listChunk, outChunks);
+        }
+    }
+}
+
+static void _checkModuleIsReadableInPlace(ISlangFileSystemExt* fileSystem, const char* path)
+{
+    ComPtr<ISlangBlob> blob;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(fileSystem->loadFile(path, blob.writeRef())));
+
+    const uint8_t* const start = (const uint8_t*)blob->getBufferPointer();
+    const uint8_t* const end = start + blob->getBufferSize();
+
+    RiffContainer container;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(RiffUtil::readInPlace(start, blob->getBufferSize(), container)));
+
+    List<RiffContainer::DataChunk*> dataChunks;
+    _findDataChunks(container.getRoot(), dataChunks);
+
+    Index instChunkCount = 0;
+    for (auto dataChunk : dataChunks)
+    {
+        // Nothing should be compressed
+        SLANG_CHECK(dataChunk->m_fourCC != SLANG_MAKE_COMPRESSED_FOUR_CC(dataChunk->m_fourCC));
+
+        if (dataChunk->m_fourCC != kInstFourCc)
+        {
+            continue;
+        }
+        instChunkCount++;
+
+        // The payload should reference the blob, and the entries (after the array header)
+        // should be aligned so they can be used in place.
+        auto data = dataChunk->getSingleData();
+        SLANG_CHECK_ABORT(data);
+
+        const uint8_t* payload = (const uint8_t*)data->getPayload();
+        SLANG_CHECK(payload >= start && payload + data->getSize() <= end);
+
+        const uint8_t* entries = payload + sizeof(SerialBinary::ArrayHeader);
+        SLANG_CHECK(((entries - start) & 7) == 0);
+    }
+
+    SLANG_CHECK(instChunkCount > 0);
+}
+
+SLANG_UNIT_TEST(stdLibInPlace)
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef())));
+
+    ComPtr<ISlangBlob> stdLibBlob;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(globalSession->saveStdLib(SLANG_ARCHIVE_TYPE_RIFF, stdLibBlob.writeRef())));
+
+    // The saved modules should be uncompressed, with IR arrays that can be referenced in place
+    {
+        ComPtr<ISlangFileSystemExt> archiveFileSystem;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(loadArchiveFileSystem(stdLibBlob->getBufferPointer(), stdLibBlob->getBufferSize(), archiveFileSystem)));
+
+        _checkModuleIsReadableInPlace(archiveFileSystem, "core.slang-module");
+        _checkModuleIsReadableInPlace(archiveFileSystem, "hlsl.slang-module");
+    }
+
+    // Load the saved stdlib into a new session, and check it can be used to generate code
+    ComPtr<slang::IGlobalSession> loadedGlobalSession;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(slang_createGlobalSessionWithoutStdLib(SLANG_API_VERSION, loadedGlobalSession.writeRef())));
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(loadedGlobalSession->loadStdLib(stdLibBlob->getBufferPointer(), stdLibBlob->getBufferSize())));
+
+    const char* source = R"(
+        [shader("compute")]
+        [numthreads(4, 1, 1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID, uniform RWStructuredBuffer<float> buffer)
+        {
+            buffer[tid.x] = sin(float(tid.x)) + dot(float3(tid), float3(1, 2, 3));
+        })";
+
+    auto request = spCreateCompileRequest(loadedGlobalSession);
+    spAddCodeGenTarget(request, SLANG_HLSL);
+    const int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "stdLibInPlace");
+    spAddTranslationUnitSourceString(request, translationUnitIndex, "stdLibInPlace.slang", source);
+
+    SLANG_CHECK(spCompile(request) == SLANG_OK);
+
+    ComPtr<ISlangBlob> codeBlob;
+    spGetEntryPointCodeBlob(request, 0, 0, codeBlob.writeRef());
+    SLANG_CHECK(codeBlob && codeBlob->getBufferSize() != 0);
+
+    spDestroyCompileRequest(request);
+}
@@ -0,0 +1,123 @@
+// unit-test-stdlib-ir-lazy.cpp
+
+#include "../../slang.h"
+#include "../../slang-com-ptr.h"
+
+#include "../../source/core/slang-basic.h"
+#include "../../source/core/slang-blob.h"
+
+#include "tools/unit-test/slang-unit-test.h"
+
+#include <atomic>
+#include <thread>
+
+using namespace Slang;
+
+// Uses stdlib functions and types, so linking needs the stdlib IR
+static const char kStdLibIRLazySource[] = R"(
+    [shader("compute")]
+    [numthreads(4, 1, 1)]
+    void computeMain(uint3 tid : SV_DispatchThreadID, uniform RWStructuredBuffer<float> buffer)
+    {
+        float3 v = float3(tid) * 0.5;
+        buffer[tid.x] = sin(v.x) + length(v) + dot(v, float3(1, 2, 3)) + clamp(v.y, 0.0, 1.0);
+    })";
+
+    /// Create a session with an HLSL target, and a program made from the module and its entry point
+static SlangResult _createProgram(slang::IGlobalSession* globalSession, ComPtr<slang::ISession>& outSession, ComPtr<slang::IComponentType>& outProgram)
+{
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    SLANG_RETURN_ON_FAIL(globalSession->createSession(sessionDesc, outSession.writeRef()));
+
+    ComPtr<slang::IBlob> diagnosticsBlob;
+    auto sourceBlob = StringBlob::create(String(kStdLibIRLazySource));
+    slang::IModule* module = outSession->loadModuleFromSource("stdlibIRLazy", "stdlib-ir-lazy.slang", sourceBlob, diagnosticsBlob.writeRef());
+    if (!module)
+    {
+        return SLANG_FAIL;
+    }
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    SLANG_RETURN_ON_FAIL(module->findEntryPointByName("computeMain", entryPoint.writeRef()));
+
+    slang::IComponentType* componentTypes[] = { module, entryPoint };
+    return outSession->createCompositeComponentType(componentTypes, SLANG_COUNT_OF(componentTypes), outProgram.writeRef(), diagnosticsBlob.writeRef());
+}
+
+static String _getCode(slang::IComponentType* program)
+{
+    ComPtr<slang::IBlob> codeBlob;
+    ComPtr<slang::IBlob> diagnosticsBlob;
+    if (SLANG_FAILED(program->getEntryPointCode(0, 0, codeBlob.writeRef(), diagnosticsBlob.writeRef())) || !codeBlob)
+    {
+        return String();
+    }
+    const char* code = (const char*)codeBlob->getBufferPointer();
+    return String(code, code + codeBlob->getBufferSize());
+}
+
+// Test that two sessions of a global session whose stdlib IR is created on first use can both
+// generate code (so create the stdlib IR) at the same time.
+SLANG_UNIT_TEST(stdLibIRLazy)
+{
+    // Load a saved stdlib, so that its IR is created on first use
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef())));
+
+    ComPtr<ISlangBlob> stdLibBlob;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(globalSession->saveStdLib(SLANG_ARCHIVE_TYPE_RIFF, stdLibBlob.writeRef())));
+
+    ComPtr<slang::IGlobalSession> lazyGlobalSession;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(slang_createGlobalSessionWithoutStdLib(SLANG_API_VERSION, lazyGlobalSession.writeRef())));
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(lazyGlobalSession->loadStdLib(stdLibBlob->getBufferPointer(), stdLibBlob->getBufferSize())));
+
+    // The front end doesn't need the stdlib IR, so the programs are created up front, and only
+    // code generation is done on the threads
+    const int kThreadCount = 2;
+    ComPtr<slang::ISession> sessions[kThreadCount];
+    ComPtr<slang::IComponentType> programs[kThreadCount];
+    for (int i = 0; i < kThreadCount; ++i)
+    {
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_createProgram(lazyGlobalSession, sessions[i], programs[i])));
+    }
+
+    String codes[kThreadCount];
+    std::atomic<int> readyCount{0};
+    std::thread threads[kThreadCount];
+    for (int i = 0; i < kThreadCount; ++i)
+    {
+        threads[i] = std::thread(
+            [&, i]()
+            {
+                // Start generating code on both threads at once
+                readyCount++;
+                while (readyCount.load() < kThreadCount)
+                {
+                    std::this_thread::yield();
+                }
+                codes[i] = _getCode(programs[i]);
+            });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    // The code should be the same as the code generated from a session on its own
+    ComPtr<slang::ISession> session;
+    ComPtr<slang::IComponentType> program;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_createProgram(lazyGlobalSession, session, program)));
+    const String expectedCode = _getCode(program);
+    SLANG_CHECK(expectedCode.getLength() > 0);
+
+    for (auto& code : codes)
+    {
+        SLANG_CHECK(code == expectedCode);
+    }
+}
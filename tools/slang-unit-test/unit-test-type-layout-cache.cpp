@@ -0,0 +1,161 @@
+// unit-test-type-layout-cache.cpp
+
+#include "../../slang.h"
+#include "../../slang-com-ptr.h"
+
+#include "../../source/core/slang-basic.h"
+
+#include "tools/unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// The layout of the contents of the constant buffer depends on both the scalar buffer layout
+// option and the matrix layout mode
+static const char kTypeLayoutCacheSource[] = R"(
+    struct Params
+    {
+        float scale;
+        float3 offset;
+        float2x3 transform;
+    }
+
+    ConstantBuffer<Params> gParams;
+    RWStructuredBuffer<float> gOutput;
+
+    [shader("compute")]
+    [numthreads(4, 1, 1)]
+    void computeMain(uint3 tid : SV_DispatchThreadID)
+    {
+        gOutput[tid.x] = gParams.scale + gParams.offset.x + gParams.transform[0][0];
+    })";
+
+namespace { // anonymous
+
+// The options that change the layout of the contents of buffers
+struct TypeLayoutCacheOptions
+{
+    bool forceScalarLayout = false;
+    SlangMatrixLayoutMode matrixLayoutMode = SLANG_MATRIX_LAYOUT_COLUMN_MAJOR;
+};
+
+} // anonymous
+
+static void _applyOptions(SlangCompileRequest* request, const TypeLayoutCacheOptions& options)
+{
+    spSetTargetForceGLSLScalarBufferLayout(request, 0, options.forceScalarLayout);
+    spSetMatrixLayoutMode(request, options.matrixLayoutMode);
+}
+
+    /// Create and check a request for a GLSL target with options, without generating code
+static SlangCompileRequest* _createRequest(SlangSession* session, const TypeLayoutCacheOptions& options)
+{
+    auto request = spCreateCompileRequest(session);
+
+    spAddCodeGenTarget(request, SLANG_GLSL);
+    _applyOptions(request, options);
+    spSetCompileFlags(request, SLANG_COMPILE_FLAG_NO_CODEGEN);
+
+    const int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "typeLayoutCache");
+    spAddTranslationUnitSourceString(request, translationUnitIndex, "type-layout-cache.slang", kTypeLayoutCacheSource);
+    spAddEntryPoint(request, translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    if (SLANG_FAILED(spCompile(request)))
+    {
+        spDestroyCompileRequest(request);
+        return nullptr;
+    }
+    return request;
+}
+
+    /// Get the offsets and size of the fields of `Params` in a new layout of the program of the request.
+    /// The program is composed afresh, so that its layout is made with the current options.
+static List<size_t> _getParamsLayout(SlangCompileRequest* request)
+{
+    List<size_t> layout;
+
+    ComPtr<slang::ISession> session;
+    ComPtr<slang::IModule> module;
+    ComPtr<slang::IComponentType> entryPoint;
+    if (SLANG_FAILED(spCompileRequest_getSession(request, session.writeRef())) ||
+        SLANG_FAILED(spCompileRequest_getModule(request, 0, module.writeRef())) ||
+        SLANG_FAILED(spCompileRequest_getEntryPoint(request, 0, entryPoint.writeRef())))
+    {
+        return layout;
+    }
+
+    slang::IComponentType* componentTypes[] = { module, entryPoint };
+    ComPtr<slang::IComponentType> program;
+    if (SLANG_FAILED(session->createCompositeComponentType(componentTypes, SLANG_COUNT_OF(componentTypes), program.writeRef())))
+    {
+        return layout;
+    }
+
+    auto programLayout = program->getLayout(0);
+    for (unsigned i = 0; programLayout && i < programLayout->getParameterCount(); ++i)
+    {
+        auto parameter = programLayout->getParameterByIndex(i);
+        if (parameter->getTypeLayout()->getKind() != slang::TypeReflection::Kind::ConstantBuffer)
+        {
+            continue;
+        }
+        auto elementTypeLayout = parameter->getTypeLayout()->getElementTypeLayout();
+        for (unsigned j = 0; j < elementTypeLayout->getFieldCount(); ++j)
+        {
+            layout.add(elementTypeLayout->getFieldByIndex(j)->getOffset());
+        }
+        layout.add(elementTypeLayout->getSize());
+    }
+    return layout;
+}
+
+    /// Get the layout of `Params` in a new request with options
+static List<size_t> _getNewRequestParamsLayout(SlangSession* session, const TypeLayoutCacheOptions& options)
+{
+    List<size_t> layout;
+    if (auto request = _createRequest(session, options))
+    {
+        layout = _getParamsLayout(request);
+        spDestroyCompileRequest(request);
+    }
+    return layout;
+}
+
+// Test that type layouts are made again when an option they depend on is changed after they
+// have been computed (and cached for the target).
+SLANG_UNIT_TEST(typeLayoutCache)
+{
+    auto session = spCreateSession();
+
+    TypeLayoutCacheOptions options;
+    auto request = _createRequest(session, options);
+    SLANG_CHECK_ABORT(request);
+
+    List<size_t> layout = _getParamsLayout(request);
+    SLANG_CHECK_ABORT(layout.getCount() == 4);
+    SLANG_CHECK(_getParamsLayout(request) == layout);
+
+    // Check the layout after an option has been changed is different from the layout before,
+    // and the same as the layout made by a new request with the changed options
+    auto checkChanged = [&]()
+    {
+        const List<size_t> newLayout = _getParamsLayout(request);
+        SLANG_CHECK(newLayout != layout);
+        SLANG_CHECK(newLayout == _getNewRequestParamsLayout(session, options));
+        layout = newLayout;
+    };
+
+    options.forceScalarLayout = true;
+    _applyOptions(request, options);
+    checkChanged();
+
+    options.matrixLayoutMode = SLANG_MATRIX_LAYOUT_ROW_MAJOR;
+    _applyOptions(request, options);
+    checkChanged();
+
+    options.forceScalarLayout = false;
+    _applyOptions(request, options);
+    checkChanged();
+
+    spDestroyCompileRequest(request);
+    spDestroySession(session);
+}